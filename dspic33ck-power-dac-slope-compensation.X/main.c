@@ -157,87 +157,182 @@
  * ********************************************************************* */
 
 // Digital Power Plug-In Module On-Board LED control
-#define LED_INTERVAL    5000
+#define LED_INTERVAL    500     // LED toggle interval in [ms]
 volatile uint16_t dbgled_cnt = 0;
 
+// Application state
+volatile uint16_t retval=1; // Global function return verification variable
+volatile uint16_t test_level=1; // Active DAC slope test level (3 = adaptive slope compensation)
+volatile bool sw_pressed = false; // On-board push button state of the most recent button task call
+struct TIMING_TRANSACTION_s op_point; // PWM timing and DAC slope update transaction
+struct SLOPECTRL_s slope_ctrl; // Adaptive slope controller of DAC slope test level #3
+
+/* ********************************************************************* *
+ * Application Tasks
+ * ********************************************************************* */
+
+// 100 us task: Clear device debug pin
+static void TASK_DebugPin(void)
+{
+    p33c_Gpio_Clear(DBGPIN); // Clear device debug pin
+}
+
+// 1 ms task: Count milliseconds until on-board LED needs to be toggled
+static void TASK_Led(void)
+{
+    if(++dbgled_cnt >= LED_INTERVAL)
+    {
+        dbgled_cnt = 0;     // Reset LED toggle counter
+        p33c_Gpio_Toggle(DBGLED); // Toggle on-board LED
+    }
+}
+
+// 10 ms task: Switch DAC slope test level when on-board push button is released
+static void TASK_Button(void)
+{
+    // Sampling the push button every 10 ms debounces its contacts
+    if (p33c_Gpio_Read(SW) == SW_PRESSED)
+    {
+        sw_pressed = true;
+        return;
+    }
+    if (!sw_pressed)
+        return;
+    sw_pressed = false;
+
+    // Load active PWM timing and DAC slope settings
+    retval &= TIMING_Load(&op_point);
+
+    // Stage new operating point
+    switch (test_level)   // If DAC is set to test level #1, switch to #2
+    {
+        case 1:
+            op_point.DACxDATH = DACOUT_VALUE_HIGH_2; // Decrease the DAC Lower value to increase the Slope rate
+            op_point.SLPxDAT = SLP_SLEW_RATE_2; // DAC slope rate is set to 400mV/uS
+            test_level = 2;
+            break;
+
+        case 2:     // Adaptive slope compensation, applied by the slope control task
+            retval &= SLOPECTRL_Initialize(&slope_ctrl);
+            test_level = 3;
+            break;
+
+        default:    // Set DAC to test level #1
+            op_point.SLPxDAT = SLP_SLEW_RATE_1; // DAC slope rate is set to 200mV/uS
+            op_point.DACxDATH = DACOUT_VALUE_HIGH_1; // Decrease the DAC Lower value to increase the Slope rate
+            pwm_ctrl.ramp = 0; // Fixed test levels are not raised by the control loop
+            test_level = 1;
+            break;
+    }
+
+    // Apply all staged settings within one PWM cycle
+    if (test_level != 3)
+        retval &= TIMING_Commit(&op_point);
+
+    p33c_Gpio_Set(DBGPIN); // Set debug pin as oscilloscope trigger
+}
+
+// 10 ms task: Apply the adaptive slope compensation of the nominal operating point (DAC slope test level #3)
+static void TASK_SlopeControl(void)
+{
+    if (test_level == 3)
+        retval &= SLOPECTRL_Update(&slope_ctrl, SLOPECTRL_VIN_NOMINAL, SLOPECTRL_VOUT_NOMINAL);
+}
+
+// 10 ms task: Update mean execution times of the profiler region table
+static void TASK_Profile(void)
+{
+    p33c_Profile_Update();
+}
+
+// 1 ms task: Record a register snapshot of the control loop and transmit telemetry records by DMA
+static void TASK_Telemetry(void)
+{
+    retval &= TELEMETRY_Record();
+    retval &= TELEMETRY_Transmit();
+}
+
+// Task table: tasks of equal rate are executed in table order, offsets distribute slower tasks across ticks
+struct SCHED_TASK_s task_table[] = {
+    { .function = &TASK_DebugPin,     .period = SCHED_RATE_100US, .offset = 0 },
+    { .function = &TASK_Led,          .period = SCHED_RATE_1MS,   .offset = 1 },
+    { .function = &TASK_Telemetry,    .period = SCHED_RATE_1MS,   .offset = 3 },
+    { .function = &TASK_Button,       .period = SCHED_RATE_10MS,  .offset = 5 },
+    { .function = &TASK_SlopeControl, .period = SCHED_RATE_10MS,  .offset = 6 },
+    { .function = &TASK_Profile,      .period = SCHED_RATE_10MS,  .offset = 7 }
+};
 
 /*
                          Main application
  */
 int main(void)
 {
-    volatile uint16_t retval=1; // Local function return verification variable
-    volatile uint16_t test_level=1;
+    // Keep the crash record of a previous trap, clear the record after power-on reset
+    retval &= CRASH_Initialize();
     
-    // initialize the device
-    SYSTEM_Initialize();
+    // Start the cycle-count profiler before any instrumented code is executed
+    // (its timer also measures the boot time and the initialization stages)
+    retval &= p33c_Profile_Initialize();
     
-    // User PWM Initialization
-    retval &= PWM_Initialize();
+    // Select the cold boot or warm restart path from the reset cause and the retained configuration image
+    retval &= BOOT_Initialize();
     
-    // User DAC Initialization
-    retval &= DAC_Initialize();
+    // Initialize the interrupt controller and start the clock switch and the auxiliary PLL,
+    // the PLLs lock while pins, PWM, DAC, ADC and UART are configured from the FRC oscillator
+    SYSTEM_InitializeStart();
     
-    // Initialize DP PIM and DP DevBoard function pins
-    _T1IF = 0;
-    DBGPIN_InitAsOutput();
-    DBGLED_InitAsOutput();
-    SW_InitAsInput();
-    TP03_InitAsOutput();
+    // Configure all device pins with one write per port register (replaces PIN_MANAGER_Initialize())
+    retval &= GPIO_Initialize();
     
-    // Enable PWM and DAC peripherals
-    retval &= PWM_Enable(); // Turn on PWM module and user-specified instance
-    retval &= DAC_Enable(); // Turn on DAC module and user-specified instance
+    // Warm restart: PWM and DAC are restored and enabled as soon as the auxiliary PLL
+    // has locked (falls back to the cold boot path on failure)
+    if (boot.path == BOOT_PATH_WARM)
+        BOOT_WarmStart();
     
-    /* main loop */
-    while (1)
+    if (boot.path == BOOT_PATH_COLD)
     {
-        while(!_T1IF);  // Wait for Timer1 to expire
-        _T1IF = 0;      // Reset interrupt flag bit
-        DBGPIN_Clear(); // Clear device debug pin
-        
-        // Count main-loop execution cycles until on-board LED needs to be toggled
-        if(++dbgled_cnt > LED_INTERVAL)
-        {
-            dbgled_cnt = 0;     // Reset LED toggle counter
-            DBGLED_Toggle();    // Toggle on-board LED
-        }
+        // User PWM Initialization
+        retval &= PWM_Initialize();
+
+        // User DAC Initialization
+        retval &= DAC_Initialize();
         
-        // Check if on-board push button has been pressed
-        if (SW_Read() == SW_PRESSED)
-        {
-            // Wait until switch is released
-            while(SW_Read() == SW_PRESSED); 
-
-            // Update PWM timing registers
-            switch (test_level)   // If DAC is set to test level #1, switch to #2
-            {
-                case 1:
-                    my_dac->DACxDATH.value = DACOUT_VALUE_HIGH_2; // Decrease the DAC Lower value to increase the Slope rate
-                    my_dac->SLPxDAT.value = SLP_SLEW_RATE_2; // DAC slope rate is set to 400mV/uS
-                    test_level = 2;
-                    break;
-
-                default:    // Set DAC to test level #1
-                    my_dac->SLPxDAT.value = SLP_SLEW_RATE_1; // DAC slope rate is set to 200mV/uS
-                    my_dac->DACxDATH.value = DACOUT_VALUE_HIGH_1; // Decrease the DAC Lower value to increase the Slope rate
-                    test_level = 1;
-                    break;
-            }
-
-            // 
-//            if(my_dac->SLPxDAT.bits.SLPDAT != SLP1DAT)
-//            {
-//                Nop();
-//                Nop();
-//                Nop();
-//                Nop();
-//            }
-            
-            DBGPIN_Set();  // Set debug pin as oscilloscope trigger
-            
-        }
+        // Retain the PWM and DAC configuration for warm restarts
+        retval &= BOOT_Capture();
         
+        // Turn on the PWM generator, the high resolution PWM clock locks while ADC and UART are initialized
+        retval &= PWM_EnableStart();
+    }
+    
+    // User ADC Initialization (PWM-triggered control loop input)
+    retval &= ADC_Initialize();
+    
+    // User telemetry stream Initialization (UART1 and DMA channel 0)
+    retval &= TELEMETRY_Initialize();
+    
+    // Enable PWM and DAC peripherals (already running after a warm restart)
+    if (boot.path == BOOT_PATH_COLD)
+    {
+        retval &= PWM_EnableWait(); // Release the outputs of the user-specified PWM instance (waits for AFPLLO)
+        retval &= DAC_Enable(); // Turn on DAC module and user-specified instance
+        retval &= BOOT_FirstEdge(); // Record boot to first PWM edge time
+    }
+    
+    // Wait for the system clock switch (Timer1, ADC and UART are clocked by FCY)
+    SYSTEM_InitializeWait();
+    
+    retval &= ADC_Enable(); // Turn on ADC module and control loop interrupt
+    retval &= TELEMETRY_Enable(); // Turn on UART1 and start recording telemetry records
+    
+    // Initialize and start the task scheduler on the Timer1 period (100 us)
+    retval &= SCHED_Initialize(task_table, (sizeof(task_table) / sizeof(task_table[0])));
+    retval &= SCHED_Start();
+    
+    /* main loop */
+    while (1)
+    {
+        // Wait for the next tick in Idle mode and execute all tasks due
+        SCHED_Execute();
     }
     
     return(1);  // If this line is ever reached, something really bad happened....
@@ -42,6 +42,15 @@
 #include "config/demo.h"
 #include "pwm.h"
 #include "dac.h"
+#include "adc.h"
+#include "gpio.h"
+#include "telemetry.h"
+#include "crash.h"
+#include "boot.h"
+#include "timing.h"
+#include "slope_ctrl.h"
+#include "sched.h"
+#include "common/p33c_profile.h"
 
 
 #endif	/* MAIN_APPLICATION_HEADER_H */
@@ -47,6 +47,13 @@
 #include "clock.h"
 
 void CLOCK_Initialize(void)
+{
+    CLOCK_Start();
+    // Wait for Clock switch to occur
+    while (!CLOCK_SystemPllLockStatusGet());
+}
+
+void CLOCK_Start(void)
 {
     // FRCDIV FRC/1; PLLPRE 1; DOZE 1:8; DOZEN disabled; ROI disabled; 
     CLKDIV = 0x3001;
@@ -56,12 +63,9 @@ void CLOCK_Initialize(void)
     OSCTUN = 0x00;
     // POST1DIV 1:4; VCODIV FVCO/4; POST2DIV 1:1; 
     PLLDIV = 0x41;
-    // APLLEN enabled; FRCSEL FRC; APLLPRE 1:1; 
-    ACLKCON1 = 0x8101;
-    // APLLFBDIV 125; 
-    APLLFBD1 = 0x7D;
-    // APOST1DIV 1:2; APOST2DIV 1:1; AVCODIV FVCO/4; 
-    APLLDIV1 = 0x21;
+    // Auxiliary PLL may already have been started by the application
+    if (!ACLKCON1bits.APLLEN)
+        CLOCK_AuxPllStart();
     // CANCLKEN disabled; CANCLKSEL No Clock Selected; CANCLKDIV Divide by 1; 
     CANCLKCON = 0x00;
     // ROEN disabled; ROSWEN disabled; ROSLP disabled; ROSEL FOSC; ROOUT disabled; ROSIDL disabled; 
@@ -91,9 +95,21 @@ void CLOCK_Initialize(void)
     // CF no clock failure; NOSC FRCPLL; CLKLOCK unlocked; OSWEN Switch is Complete; 
     __builtin_write_OSCCONH((uint8_t) (0x01));
     __builtin_write_OSCCONL((uint8_t) (0x01));
-    // Wait for Clock switch to occur
-    while (OSCCONbits.OSWEN != 0);
-    while (OSCCONbits.LOCK != 1);
+}
+
+bool CLOCK_SystemPllLockStatusGet(void)
+{
+    return ((OSCCONbits.OSWEN == 0) && (OSCCONbits.LOCK == 1));
+}
+
+void CLOCK_AuxPllStart(void)
+{
+    // APLLFBDIV 125; 
+    APLLFBD1 = 0x7D;
+    // APOST1DIV 1:2; APOST2DIV 1:1; AVCODIV FVCO/4; 
+    APLLDIV1 = 0x21;
+    // APLLEN enabled; FRCSEL FRC; APLLPRE 1:1; 
+    ACLKCON1 = 0x8101;
 }
 
 bool CLOCK_AuxPllLockStatusGet()
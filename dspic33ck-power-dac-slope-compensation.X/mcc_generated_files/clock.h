@@ -73,6 +73,78 @@
  */
 void CLOCK_Initialize(void);
 
+/**
+  @Summary
+    Starts the oscillator configuration without waiting for the clock switch.
+
+  @Description
+    This routine writes the clock configuration of CLOCK_Initialize(), starts 
+    the Auxiliary PLL and requests the switch to FRCPLL, but returns while the 
+    PLLs are still locking. The device keeps executing from FRC until the 
+    switch completes in hardware. Peripheral registers can be written in the 
+    meantime; use CLOCK_SystemPllLockStatusGet() and CLOCK_AuxPllLockStatusGet() 
+    before code that depends on FOSC or AFPLLO (see main.c).
+
+  @Param
+    None.
+
+  @Returns
+    None.
+ 
+  @Example 
+    <code>
+    CLOCK_Start();
+    GPIO_Initialize();
+    while (!CLOCK_SystemPllLockStatusGet());
+    </code>
+*/
+void CLOCK_Start(void);
+
+/**
+  @Summary
+    This API tells whether the clock switch to the system PLL is complete.
+
+  @Description
+    This routine returns true once the clock switch requested by CLOCK_Start() 
+    has completed (OSCCON.OSWEN = 0) and the system PLL is locked (OSCCON.LOCK = 1).
+
+  @Param
+    None.
+
+  @Returns
+    Returns true if the device is running from the locked system PLL else returns false.
+ 
+  @Example 
+    <code>
+    while (!CLOCK_SystemPllLockStatusGet());
+    </code>
+*/
+bool CLOCK_SystemPllLockStatusGet(void);
+
+/**
+  @Summary
+    Starts the Auxiliary PLL.
+
+  @Description
+    This routine configures and enables the Auxiliary PLL (FRC input), which 
+    provides the AFPLLO clock of the PWM and DAC modules. It does not wait for 
+    the PLL to lock. CLOCK_Start() calls this routine unless the 
+    Auxiliary PLL has already been enabled.
+
+  @Param
+    None.
+
+  @Returns
+    None.
+ 
+  @Example 
+    <code>
+    CLOCK_AuxPllStart();
+    while (!CLOCK_AuxPllLockStatusGet());
+    </code>
+*/
+void CLOCK_AuxPllStart(void);
+
 /**
   @Summary
     This API tells whether Auxiliary PLL is locked or not.
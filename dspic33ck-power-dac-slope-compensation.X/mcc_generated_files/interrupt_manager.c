@@ -52,4 +52,7 @@
 */
 void INTERRUPT_Initialize (void)
 {
+    //    ADCAN0: ADC AN0 Convert Done (control loop)
+    //    Priority: 6
+        _ADCAN0IP = 6;
 }
@@ -127,17 +127,38 @@
 #include "tmr1.h"
 #include "interrupt_manager.h"
 #include "traps.h"
+#include "boot.h"
 
 void SYSTEM_Initialize(void)
 {
     PIN_MANAGER_Initialize();
+    SYSTEM_InitializeStart();
+    SYSTEM_InitializeWait();
+}
+
+void SYSTEM_InitializeStart(void)
+{
+    // Port registers are not configured here: main() calls GPIO_Initialize() (gpio.c) after this function
+    BOOT_STAGE_BEGIN(BOOT_STAGE_INTERRUPT);
     INTERRUPT_Initialize();
-    CLOCK_Initialize();
+    BOOT_STAGE_END(BOOT_STAGE_INTERRUPT);
+    BOOT_STAGE_BEGIN(BOOT_STAGE_CLOCK); // ends in SYSTEM_InitializeWait()
+    CLOCK_Start();
+}
+
+void SYSTEM_InitializeWait(void)
+{
+    // Wait for the clock switch requested by CLOCK_Start()
+    while (!CLOCK_SystemPllLockStatusGet())
+        BOOT_Mark();
+    BOOT_ClockSwitched(); // boot time is counted in PLL instruction cycles from here
+    BOOT_STAGE_END(BOOT_STAGE_CLOCK);
+    BOOT_STAGE_BEGIN(BOOT_STAGE_TMR1);
     TMR1_Initialize();
+    BOOT_STAGE_END(BOOT_STAGE_TMR1);
     INTERRUPT_GlobalEnable();
     SYSTEM_CORCONModeOperatingSet(CORCON_MODE_PORVALUES);
 }
-
 /**
  End of File
 */
\ No newline at end of file
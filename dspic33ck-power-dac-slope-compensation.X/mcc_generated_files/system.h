@@ -127,11 +127,45 @@ inline static uint32_t SYSTEM_DeviceIdRegisterAddressGet(void)
     none
  * @Description
     Initializes the device to the default states configured in the
- *                  MCC GUI
+ *                  MCC GUI, including the port registers (PIN_MANAGER_Initialize()),
+ *                  and waits for the clock switch. main() of this demo calls 
+ *                  SYSTEM_InitializeStart(), GPIO_Initialize() and 
+ *                  SYSTEM_InitializeWait() instead, so the pins are configured 
+ *                  with one write per port register while the PLLs lock.
  * @Example
     SYSTEM_Initialize(void);
  */
 void SYSTEM_Initialize(void);
+
+/**
+ * @Param
+    none
+ * @Returns
+    none
+ * @Description
+    First part of SYSTEM_Initialize() without the pin manager: initializes
+ *                  the interrupt controller and starts the oscillator configuration 
+ *                  (CLOCK_Start()) without waiting for the clock switch. The port 
+ *                  registers are not configured; the caller configures them, e.g. 
+ *                  by GPIO_Initialize(), and other peripheral registers while the 
+ *                  PLLs lock.
+ * @Example
+    SYSTEM_InitializeStart(void);
+ */
+void SYSTEM_InitializeStart(void);
+
+/**
+ * @Param
+    none
+ * @Returns
+    none
+ * @Description
+    Second part of SYSTEM_Initialize(): waits for the clock switch to the 
+ *                  system PLL, then initializes Timer1 and enables interrupts.
+ * @Example
+    SYSTEM_InitializeWait(void);
+ */
+void SYSTEM_InitializeWait(void);
 #endif	/* SYSTEM_H */
 /**
  End of File
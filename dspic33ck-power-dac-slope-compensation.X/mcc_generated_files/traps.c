@@ -47,6 +47,7 @@
 */
 #include <xc.h>
 #include "traps.h"
+#include "crash.h"
 
 #define ERROR_HANDLER __attribute__((interrupt, no_auto_psv, keep, section("error_handler")))
 #define FAILSAFE_STACK_GUARDSIZE 8
@@ -78,7 +79,7 @@ void __attribute__((weak)) TRAPS_halt_on_error(uint16_t code)
  */
 inline static void use_failsafe_stack(void)
 {
-    static uint8_t failsafe_stack[32];
+    static uint8_t failsafe_stack[64]; // CRASH_StackError(): two call levels, no stack variables
     asm volatile (
         "   mov    %[pstack], W15\n"
         :
@@ -92,9 +93,24 @@ inline static void use_failsafe_stack(void)
 }
 
 
+/**
+ * Turns off all PWM outputs and writes the crash record before the trap flag 
+ * is cleared, passing the stack pointer of the trap handler
+ */
+inline static void record_trap(uint16_t code)
+{
+    uint16_t sp;
+    asm volatile (
+        "   mov    W15, %[sp]\n"
+        : [sp]"=r"(sp)
+    );
+    CRASH_Trap(code, (const uint16_t*)sp);
+}
+
 /** Oscillator Fail Trap vector**/
 void ERROR_HANDLER _OscillatorFail(void)
 {
+    record_trap(TRAPS_OSC_FAIL);
     INTCON1bits.OSCFAIL = 0;  //Clear the trap flag
     TRAPS_halt_on_error(TRAPS_OSC_FAIL);
 }
@@ -106,24 +122,28 @@ void ERROR_HANDLER _StackError(void)
      * we set the stack pointer to a safe place.
      */
     use_failsafe_stack(); 
+    CRASH_StackError(TRAPS_STACK_ERR); // safe state and trap code only, completed at startup
     INTCON1bits.STKERR = 0;  //Clear the trap flag
     TRAPS_halt_on_error(TRAPS_STACK_ERR);
 }
 /** Address error Trap vector**/
 void ERROR_HANDLER _AddressError(void)
 {
+    record_trap(TRAPS_ADDRESS_ERR);
     INTCON1bits.ADDRERR = 0;  //Clear the trap flag
     TRAPS_halt_on_error(TRAPS_ADDRESS_ERR);
 }
 /** Math Error Trap vector**/
 void ERROR_HANDLER _MathError(void)
 {
+    record_trap(TRAPS_MATH_ERR);
     INTCON1bits.MATHERR = 0;  //Clear the trap flag
     TRAPS_halt_on_error(TRAPS_MATH_ERR);
 }
 /** Generic Hard Trap vector**/
 void ERROR_HANDLER _HardTrapError(void)
 {
+    record_trap(TRAPS_HARD_ERR);
     INTCON4bits.SGHT = 0;  //Clear the trap flag
     TRAPS_halt_on_error(TRAPS_HARD_ERR);
 }
@@ -132,6 +152,7 @@ void ERROR_HANDLER _SoftTrapError(void)
 {
     if(INTCON3bits.NAE)
     {
+      record_trap(TRAPS_NVM_ERR);
       INTCON3bits.NAE = 0;  //Clear the trap flag
       TRAPS_halt_on_error(TRAPS_NVM_ERR);
     }
@@ -139,6 +160,7 @@ void ERROR_HANDLER _SoftTrapError(void)
     #ifdef _DMT
     if(INTCON3bits.DMT)
     {
+      record_trap(TRAPS_DMT_ERR);
       INTCON3bits.DMT = 0;  //Clear the trap flag
       TRAPS_halt_on_error(TRAPS_DMT_ERR);
     }
@@ -147,6 +169,7 @@ void ERROR_HANDLER _SoftTrapError(void)
     #ifdef DAE
     if(INTCON3bits.DAE)
     {
+      record_trap(TRAPS_DAE_ERR);
       INTCON3bits.DAE = 0;  //Clear the trap flag
       TRAPS_halt_on_error(TRAPS_DAE_ERR);
     }
@@ -154,12 +177,14 @@ void ERROR_HANDLER _SoftTrapError(void)
 
     if(INTCON3bits.DOOVR)
     {
+      record_trap(TRAPS_DOOVR_ERR);
       INTCON3bits.DOOVR = 0;  //Clear the trap flag
       TRAPS_halt_on_error(TRAPS_DOOVR_ERR);
     }
 
     if(INTCON3bits.APLL)
     {
+      record_trap(TRAPS_APLL_ERR);
       INTCON3bits.APLL = 0;  //Clear the trap flag
       TRAPS_halt_on_error(TRAPS_APLL_ERR);
     }
@@ -0,0 +1,135 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: adc.c 
+ * Comments: Configuration of the PWM-triggered ADC input of the control loop
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+#include "adc.h"
+
+/* @@ADC_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Configures the dedicated ADC core 0 for PWM-triggered conversions of AN0
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     Input AN0 is sampled by ADC Trigger 1 of the leading PWM generator, which 
+ *     is the PGxTRIGB compare event also starting the slope compensation ramp. 
+ *     Each completed conversion raises the ADCAN0 interrupt serviced by the 
+ *     control loop in pwm.c. The analog function of the pin is configured by
+ *     GPIO_Initialize(). The ADC remains turned off until ADC_Enable() 
+ *     is called.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t ADC_Initialize(void) {
+
+    volatile uint16_t retval=1;
+
+    // ADCON1L/H: ADC CONTROL REGISTER 1
+    ADCON1L = 0x0000; // ADC module is off
+    ADCON1H = 0x0000; 
+    ADCON1Hbits.FORM = 0;   // Integer data output format
+    
+    // ADCON3L/H: ADC CONTROL REGISTER 3
+    ADCON3L = 0x0000;
+    ADCON3H = 0x0000;
+    ADCON3Lbits.REFSEL = 0b000; // Reference voltage: AVDD/AVSS
+    ADCON3Hbits.CLKSEL = 0b01;  // ADC module clock source: FOSC
+    ADCON3Hbits.CLKDIV = 0;     // ADC module clock divider: 1:1
+    
+    // ADCON5H: ADC CONTROL REGISTER 5 HIGH
+    ADCON5Hbits.WARMTIME = 0b1111; // ADC core power-up delay: 32768 source clock periods
+    
+    // ADCORE0L/H: DEDICATED ADC CORE 0 CONTROL REGISTER
+    ADCORE0L = 0x0000;
+    ADCORE0H = 0x0000;
+    ADCORE0Lbits.SAMC = ADC_SAMPLE_TIME;    // Sampling time in [TAD]
+    ADCORE0Hbits.RES  = 0b11;               // 12-bit resolution
+    ADCORE0Hbits.ADCS = ADC_CORE_CLOCK_DIV; // Core clock = FOSC / (2 * ADCS)
+    ADCORE0Hbits.EISEL = 0b000;             // Early interrupt: 1 TAD before the end of conversion (not used)
+    
+    // AN0: single-ended, unsigned, edge triggered
+    ADMOD0Lbits.SIGN0 = 0;
+    ADMOD0Lbits.DIFF0 = 0;
+    ADLVLTRGLbits.LVLEN0 = 0;
+    
+    // AN0 trigger source and interrupt
+    ADTRIG0Lbits.TRGSRC0 = ADC_TRGSRC_PWM_TRIG1(PWM_GENERATOR);
+    ADIELbits.IE0 = 1;  // Common ADC interrupt enable for AN0 (ADCAN0 interrupt)
+    _ADCAN0IF = 0;
+    
+    return(retval); // Return 1=success, 0=failure
+}
+
+/* @@ADC_Enable
+ * ********************************************************************************
+ * Summary:
+ *     Turns on the ADC module, powers up the dedicated ADC core 0 and enables 
+ *     the ADCAN0 interrupt
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, the ADC core did not become ready
+ *     1 = success
+ * 
+ * Description:
+ *     The interrupt priority is set by INTERRUPT_Initialize().
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t ADC_Enable(void) {
+
+    volatile uint16_t retval=1;
+    volatile uint16_t timeout=0;
+
+    ADCON1Lbits.ADON = 1;   // Turn on ADC module
+    
+    ADCON5Lbits.C0PWR = 1;  // Power up dedicated ADC core 0
+    while ((!ADCON5Lbits.C0RDY) && (timeout++ < ADC_POWER_UP_TIMEOUT));
+    retval &= (uint16_t)(ADCON5Lbits.C0RDY);
+    
+    ADCON3Hbits.C0EN = 1;   // Enable dedicated ADC core 0
+
+    _ADCAN0IF = 0;
+    _ADCAN0IE = 1;          // Enable the control loop interrupt
+    
+    return(retval); // Return 1=success, 0=failure
+}
+
+// ________________________
+// end of file
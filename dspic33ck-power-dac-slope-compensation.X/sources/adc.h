@@ -0,0 +1,56 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: adc.h 
+ * Comments: Header file of the user-configuration source file adc.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_ADC_INITIALIZATION_H
+#define	XC_ADC_INITIALIZATION_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+ /* *********************************************************************************
+ * ADC DECLARATIONS
+ * *********************************************************************************
+ * The feedback signal of the control loop is converted by the dedicated ADC core 0
+ * (input AN0), which is triggered by ADC Trigger 1 of the leading PWM generator.
+ * ********************************************************************************/
+
+#define ADC_TRGSRC_PWM_TRIG1(pg)    (0b00100 + (((pg) - 1U) << 1)) // ADTRIGxL.TRGSRC code of PWMx ADC Trigger 1
+#define ADC_POWER_UP_TIMEOUT        50000U  // Maximum number of polling cycles waiting for the ADC core to be ready
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern volatile uint16_t ADC_Initialize(void);
+extern volatile uint16_t ADC_Enable(void);
+
+
+#endif	/* XC_ADC_INITIALIZATION_H */
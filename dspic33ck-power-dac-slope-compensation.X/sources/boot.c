@@ -0,0 +1,507 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: boot.c 
+ * Comments: Reset-cause aware selection of the cold boot and warm restart path
+ *           with retained PWM/DAC configuration image
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+#include "boot.h"
+#include "pwm.h"
+#include "dac.h"
+#include "crash.h"
+#include "../mcc_generated_files/clock.h"
+#include "../mcc_generated_files/reset.h"
+
+#define BOOT_BUILD_STRING       __DATE__ " " __TIME__ // Firmware build identification
+
+BOOT_PERSISTENT struct BOOT_IMAGE_s boot_image; // Retained configuration image (persistent RAM)
+volatile struct BOOT_STATUS_s boot; // Boot status
+
+#if (BOOT_PROFILE_ENABLE)
+volatile struct BOOT_PROFILE_s boot_profile; // Boot profile table
+#endif
+
+// CRC-16/CCITT-FALSE remainders of all 4-bit values (polynomial 0x1021)
+static const uint16_t boot_crc_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/* @@BOOT_Crc16
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the CRC-16/CCITT-FALSE checksum of a block of bytes
+ * 
+ * Parameters:
+ *     const uint8_t* data: Pointer to the first byte
+ *     uint16_t length: Number of bytes
+ * 
+ * Returns:
+ *     Checksum of the block
+ * 
+ * ********************************************************************************/
+
+static uint16_t BOOT_Crc16(const uint8_t* data, uint16_t length)
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        crc = (crc << 4) ^ boot_crc_table[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ boot_crc_table[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+
+    return(crc);
+}
+
+/* @@BOOT_Validate
+ * ********************************************************************************
+ * Summary:
+ *     Checks if a retained configuration image is valid
+ * 
+ * Parameters:
+ *     const struct BOOT_IMAGE_s* image: Pointer to the image
+ * 
+ * Returns:
+ *     0 = the image is invalid (not captured, corrupted or of another layout)
+ *     1 = the image is valid
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t BOOT_Validate(const struct BOOT_IMAGE_s* image)
+{
+    if (image == NULL)
+        return(0);
+
+    return((image->magic == BOOT_IMAGE_MAGIC) && (image->version == BOOT_IMAGE_VERSION) &&
+           (image->size == sizeof(struct BOOT_IMAGE_s)) && 
+           (image->crc == BOOT_Crc16((const uint8_t*)image, offsetof(struct BOOT_IMAGE_s, crc))));
+}
+
+/* @@BOOT_GetBuild
+ * ********************************************************************************
+ * Summary:
+ *     Returns the identifier of the running firmware build
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     Checksum of the build date and time
+ * 
+ * ********************************************************************************/
+
+uint16_t BOOT_GetBuild(void)
+{
+    static const char build[] = BOOT_BUILD_STRING;
+    
+    return(BOOT_Crc16((const uint8_t*)build, sizeof(build) - 1));
+}
+
+/* @@BOOT_Decide
+ * ********************************************************************************
+ * Summary:
+ *     Selects the boot path from the reset cause and the retained image
+ * 
+ * Parameters:
+ *     uint16_t rcon: Reset cause flags (RCON)
+ *     const struct BOOT_IMAGE_s* image: Pointer to the retained image
+ *     uint16_t build: Identifier of the running firmware build
+ *     uint16_t crashes: Trap counter of the crash record (0 = no valid record)
+ * 
+ * Returns:
+ *     Reason of the selection (BOOT_REASON_e). The warm restart path is 
+ *     selected by BOOT_REASON_WARM only.
+ * 
+ * Description:
+ *     The rules are applied in the following order:
+ * 
+ *       1. POR or BOR set: cold (retained RAM undefined)
+ *       2. TRAPR, IOPUWR or CM set: cold (fault)
+ *       3. EXTR set or neither WDTO nor SWR set: cold (external reset)
+ *       4. image invalid: cold
+ *       5. image of another firmware build or PWM generator/DAC instance: cold
+ *       6. trap recorded since the image has been captured: cold (fault)
+ *       7. otherwise: warm
+ * 
+ *     This function does not access any register.
+ * 
+ * ********************************************************************************/
+
+uint16_t BOOT_Decide(uint16_t rcon, const struct BOOT_IMAGE_s* image, uint16_t build, uint16_t crashes)
+{
+    if (rcon & (BOOT_RCON_POR | BOOT_RCON_BOR))
+        return(BOOT_REASON_POWER_ON);
+    if (rcon & (BOOT_RCON_TRAPR | BOOT_RCON_IOPUWR | BOOT_RCON_CM))
+        return(BOOT_REASON_FAULT);
+    if ((rcon & BOOT_RCON_EXTR) || (!(rcon & (BOOT_RCON_WDTO | BOOT_RCON_SWR))))
+        return(BOOT_REASON_EXTERNAL);
+    if (!BOOT_Validate(image))
+        return(BOOT_REASON_NO_IMAGE);
+    if ((image->build != build) || (image->pg_instance != PWM_GENERATOR) || 
+        (image->dac_instance != DAC_INSTANCE))
+        return(BOOT_REASON_BUILD);
+    if (image->crashes != crashes)
+        return(BOOT_REASON_FAULT);
+
+    return(BOOT_REASON_WARM);
+}
+
+/* @@BOOT_Mark
+ * ********************************************************************************
+ * Summary:
+ *     Adds the time since the previous call to the boot time
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     The 16-bit profiler timer overflows after 16 ms before and after 655 us
+ *     after the clock switch, so this function has to be called at least once
+ *     within these intervals. The clock switch completes in the background 
+ *     after CLOCK_Start(); the interval in which it is first seen completed is
+ *     still counted with the FRC instruction cycle (upper bound of the boot time).
+ * 
+ * ********************************************************************************/
+
+void BOOT_Mark(void)
+{
+    uint16_t now = BOOT_TIMER_READ();
+
+    boot.elapsed_ns += (uint32_t)((uint16_t)(now - boot.last)) * boot.tick_ns;
+    boot.last = now;
+
+    if ((boot.tick_ns != BOOT_TICK_NS_PLL) && (CLOCK_SystemPllLockStatusGet()))
+    {
+        boot.tick_ns = BOOT_TICK_NS_PLL;
+    }
+}
+
+/* @@BOOT_ClockSwitched
+ * ********************************************************************************
+ * Summary:
+ *     Switches the boot time measurement to the PLL instruction cycle
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     Called by SYSTEM_InitializeWait() when the clock switch requested by 
+ *     CLOCK_Start() has completed. The time since the previous call of 
+ *     BOOT_Mark() is counted with the FRC instruction cycle unless BOOT_Mark()
+ *     has already seen the completed switch.
+ * 
+ * ********************************************************************************/
+
+void BOOT_ClockSwitched(void)
+{
+    BOOT_Mark();
+    boot.tick_ns = BOOT_TICK_NS_PLL;
+}
+
+#if (BOOT_PROFILE_ENABLE)
+/* @@BOOT_StageBegin
+ * ********************************************************************************
+ * Summary:
+ *     Records the entry of an initialization stage
+ * 
+ * Parameters:
+ *     uint16_t stage: Initialization stage (BOOT_STAGE_ID_e)
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     Called by the instrumentation macro BOOT_STAGE_BEGIN(). Stages outside 
+ *     the range of the boot profile table are ignored.
+ * 
+ * ********************************************************************************/
+
+void BOOT_StageBegin(uint16_t stage)
+{
+    if (stage >= BOOT_STAGE_COUNT)
+        return;
+
+    BOOT_Mark();
+    boot_profile.stage[stage].start_ns = boot.elapsed_ns;
+}
+
+/* @@BOOT_StageEnd
+ * ********************************************************************************
+ * Summary:
+ *     Records the completion of an initialization stage
+ * 
+ * Parameters:
+ *     uint16_t stage: Initialization stage (BOOT_STAGE_ID_e)
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     Called by the instrumentation macro BOOT_STAGE_END(). The time since the 
+ *     most recent stage entry is added to the execution time of the stage.
+ * 
+ * ********************************************************************************/
+
+void BOOT_StageEnd(uint16_t stage)
+{
+    if (stage >= BOOT_STAGE_COUNT)
+        return;
+
+    BOOT_Mark();
+    boot_profile.stage[stage].time_ns += (boot.elapsed_ns - boot_profile.stage[stage].start_ns);
+    boot_profile.stage[stage].count++;
+}
+#endif
+
+/* @@BOOT_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Reads the reset cause and selects the boot path
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     Starts the boot time measurement, clears the boot profile table, reads 
+ *     and clears the reset cause flags, so the next reset reports its own cause
+ *     only, and selects the boot path by BOOT_Decide(). The profiler timer and
+ *     the crash record have to be initialized before this function is called.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t BOOT_Initialize(void)
+{
+    uint16_t crashes;
+#if (BOOT_PROFILE_ENABLE)
+    uint16_t i;
+#endif
+
+    boot.tick_ns = BOOT_TICK_NS_FRC;
+    boot.last = BOOT_TIMER_READ();
+    boot.elapsed_ns = 0;
+    boot.first_edge_ns = 0;
+
+#if (BOOT_PROFILE_ENABLE)
+    for (i = 0; i < BOOT_STAGE_COUNT; i++)
+    {
+        boot_profile.stage[i].start_ns = 0;
+        boot_profile.stage[i].time_ns = 0;
+        boot_profile.stage[i].count = 0;
+    }
+    boot_profile.first_edge_ns = 0;
+#endif
+
+    boot.rcon = RESET_GetCause();
+    RCON &= ~BOOT_RCON_CAUSES;
+
+    crashes = (CRASH_Validate(&crash_record)) ? crash_record.count : 0;
+    boot.reason = BOOT_Decide(boot.rcon, &boot_image, BOOT_GetBuild(), crashes);
+    boot.path = (boot.reason == BOOT_REASON_WARM) ? BOOT_PATH_WARM : BOOT_PATH_COLD;
+
+#if (BOOT_PROFILE_ENABLE)
+    boot_profile.path = boot.path;
+    boot_profile.reason = boot.reason;
+#endif
+
+    return(1);
+}
+
+/* @@BOOT_Capture
+ * ********************************************************************************
+ * Summary:
+ *     Captures the PWM and DAC configuration in the retained image
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     Called on the cold boot path after PWM_Initialize() and DAC_Initialize() 
+ *     and before PWM and DAC are enabled. The warm restart statistics of a 
+ *     valid image of the same build are kept.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t BOOT_Capture(void)
+{
+    uint16_t build = BOOT_GetBuild();
+    uint16_t warm_count = 0;
+    uint32_t warm_ns = 0;
+
+    if ((BOOT_Validate(&boot_image)) && (boot_image.build == build))
+    {
+        warm_count = boot_image.warm_count;
+        warm_ns = boot_image.warm_ns;
+    }
+
+    boot_image.magic = BOOT_IMAGE_MAGIC;
+    boot_image.version = BOOT_IMAGE_VERSION;
+    boot_image.size = sizeof(struct BOOT_IMAGE_s);
+    boot_image.build = build;
+    boot_image.crashes = (CRASH_Validate(&crash_record)) ? crash_record.count : 0;
+    boot_image.pg_instance = PWM_GENERATOR;
+    boot_image.dac_instance = DAC_INSTANCE;
+    boot_image.warm_count = warm_count;
+    boot_image.cold_ns = 0;
+    boot_image.warm_ns = warm_ns;
+
+    p33c_PwmModule_ConfigReadRef(&boot_image.pwm);
+    p33c_PwmGenerator_ConfigReadRef(PWM_GENERATOR, &boot_image.pg);
+    p33c_DacModule_ConfigReadRef(&boot_image.dac_module);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &boot_image.dac);
+
+    boot_image.crc = BOOT_Crc16((const uint8_t*)&boot_image, offsetof(struct BOOT_IMAGE_s, crc));
+    BOOT_Mark();
+
+    return(1);
+}
+
+/* @@BOOT_FirstEdge
+ * ********************************************************************************
+ * Summary:
+ *     Records the boot to first PWM edge time
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     Called when PWM and DAC have been enabled. The time is stored in the 
+ *     boot status and, if the image is valid, in the image as time of the 
+ *     boot path taken.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t BOOT_FirstEdge(void)
+{
+    BOOT_Mark();
+    boot.first_edge_ns = boot.elapsed_ns;
+
+#if (BOOT_PROFILE_ENABLE)
+    boot_profile.path = boot.path;
+    boot_profile.reason = boot.reason;
+    boot_profile.first_edge_ns = boot.first_edge_ns;
+#endif
+
+    if (BOOT_Validate(&boot_image))
+    {
+        if (boot.path == BOOT_PATH_WARM)
+        {
+            boot_image.warm_ns = boot.first_edge_ns;
+            boot_image.warm_count++;
+        }
+        else
+        {
+            boot_image.cold_ns = boot.first_edge_ns;
+        }
+        boot_image.crc = BOOT_Crc16((const uint8_t*)&boot_image, offsetof(struct BOOT_IMAGE_s, crc));
+    }
+
+    return(1);
+}
+
+/* @@BOOT_WarmStart
+ * ********************************************************************************
+ * Summary:
+ *     Executes the warm restart path up to the first PWM edge
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = warm restart failed, the cold boot path has been selected
+ *     1 = PWM and DAC are running
+ * 
+ * Description:
+ *     Restores the PWM and DAC register sets from the retained image while 
+ *     the auxiliary PLL locks and enables PWM and DAC once AFPLLO is available.
+ *     SYSTEM_InitializeStart() has to be called before to start the PLLs and 
+ *     SYSTEM_InitializeWait() afterwards. When the 
+ *     auxiliary PLL does not lock within BOOT_APLL_TIMEOUT_US or PWM and DAC 
+ *     cannot be enabled, PWM and DAC are turned off, the image is invalidated
+ *     and the cold boot path is selected.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t BOOT_WarmStart(void)
+{
+    volatile uint16_t retval=1;
+    uint32_t limit;
+
+    retval &= PWM_Restore(&boot_image.pwm, &boot_image.pg);
+    retval &= DAC_Restore(&boot_image.dac_module, &boot_image.dac);
+
+    BOOT_Mark();
+    limit = boot.elapsed_ns + (BOOT_APLL_TIMEOUT_US * 1000UL);
+    while ((retval) && (!CLOCK_AuxPllLockStatusGet()))
+    {
+        BOOT_Mark();
+        if (boot.elapsed_ns > limit)
+            retval = 0;
+    }
+
+    if (retval)
+        retval &= PWM_Enable();
+    if (retval)
+        retval &= DAC_Enable();
+
+    if (retval)
+    {
+        BOOT_FirstEdge();
+    }
+    else
+    {
+        p33c_PwmGenerator_Disable(p33c_PwmGenerator_GetHandle(PWM_GENERATOR));
+        DAC_Disable();
+        boot_image.magic = 0;
+        boot.path = BOOT_PATH_COLD;
+        boot.reason = BOOT_REASON_WARM_FAILED;
+    }
+
+    return(retval);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,233 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: boot.h 
+ * Comments: Header file of the reset-cause aware boot path selection boot.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_BOOT_PATH_H
+#define	XC_BOOT_PATH_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "common/p33c_pwm.h"
+#include "common/p33c_dac.h"
+#include "common/p33c_profile.h"
+
+ /* *********************************************************************************
+ * BOOT PATH DECLARATIONS
+ * *********************************************************************************
+ * On both paths the clock switch to the system PLL and the auxiliary PLL are 
+ * started first (SYSTEM_InitializeStart()) and lock in the background while the 
+ * pins and the PWM and DAC register sets are configured. Code only waits where
+ * the clocks are needed: PWM and DAC wait for AFPLLO when they are enabled, 
+ * Timer1, ADC and UART wait for the system clock (SYSTEM_InitializeWait()).
+ * 
+ * After a power-on, brown-out or external (MCLR) reset the device runs the cold 
+ * boot path: the PWM and DAC register sets are built by PWM_Initialize() and 
+ * DAC_Initialize() and the resulting register sets are captured in the retained
+ * configuration image before the peripherals are enabled.
+ * 
+ * After a watchdog or software reset the retained image is still valid, as it is
+ * located in persistent RAM. The warm restart path writes the retained register 
+ * sets with one block write per peripheral and enables PWM and DAC as soon as 
+ * the auxiliary PLL (AFPLLO clock of PWM and DAC) has locked, without waiting 
+ * for the system clock switch. Trap conflict, illegal opcode and configuration
+ * mismatch resets, traps recorded since the image has been captured (crash.c) and 
+ * images of a different firmware build always select the cold boot path. A failed 
+ * warm restart invalidates the image and falls back to the cold boot path.
+ * 
+ * The time from BOOT_Initialize() to the release of the PWM outputs is measured
+ * with the profiler timer (SCCP1), which counts instruction cycles of the FRC 
+ * oscillator before and of the PLL after the clock switch, and is kept in the 
+ * image for the cold and the warm path.
+ * ********************************************************************************/
+
+#define BOOT_IMAGE_MAGIC        0xB0C7U // Image identifier
+#define BOOT_IMAGE_VERSION      1U      // Image layout version
+
+#define BOOT_TICK_NS_FRC        250U    // Instruction cycle in [ns] before the clock switch (FRC 8 MHz, FCY = 4 MHz)
+#define BOOT_TICK_NS_PLL        P33C_PROFILE_TICK_NS // Instruction cycle in [ns] after the clock switch (FCY = 100 MHz)
+#define BOOT_APLL_TIMEOUT_US    1000U   // Auxiliary PLL lock timeout of the warm restart path in [us]
+
+#define BOOT_TIMER_READ()       P33C_PROFILE_TIMER_READ() // Free-running timer in [instruction cycles]
+
+#if defined (__P33C_HOST__)
+// Host model: PWM and DAC register writes of the initialization and restore functions
+#define BOOT_HOST_WRITES(n)     { p33c_HostSfrWrites += (n); }
+#else
+#define BOOT_HOST_WRITES(n)     { }
+#endif
+
+#define BOOT_REGSET_WRITES(s)   (sizeof(s) / sizeof(uint16_t)) // Register writes of a register set transfer
+
+// Reset cause flags of RCON
+#define BOOT_RCON_POR           0x0001U // Power-on reset
+#define BOOT_RCON_BOR           0x0002U // Brown-out reset
+#define BOOT_RCON_WDTO          0x0010U // Watchdog timer time-out reset
+#define BOOT_RCON_SWR           0x0040U // Software reset (RESET instruction)
+#define BOOT_RCON_EXTR          0x0080U // External reset (MCLR)
+#define BOOT_RCON_CM            0x0200U // Configuration mismatch reset
+#define BOOT_RCON_IOPUWR        0x4000U // Illegal opcode or uninitialized W register reset
+#define BOOT_RCON_TRAPR         0x8000U // Trap conflict reset
+#define BOOT_RCON_CAUSES        (BOOT_RCON_POR | BOOT_RCON_BOR | BOOT_RCON_WDTO | BOOT_RCON_SWR | \
+                                 BOOT_RCON_EXTR | BOOT_RCON_CM | BOOT_RCON_IOPUWR | BOOT_RCON_TRAPR)
+
+#if defined (__P33C_HOST__)
+#define BOOT_PERSISTENT
+#else
+#define BOOT_PERSISTENT         __attribute__((persistent)) // Not initialized by the C runtime startup code
+#endif
+
+/* Boot path */
+enum BOOT_PATH_e {
+    BOOT_PATH_COLD = 0,         // Full clock switch and PWM/DAC initialization
+    BOOT_PATH_WARM = 1          // PWM/DAC restored from the retained image before the clock switch
+};
+typedef enum BOOT_PATH_e BOOT_PATH_t;
+
+/* Reason of the boot path selection */
+enum BOOT_REASON_e {
+    BOOT_REASON_POWER_ON = 0,   // Power-on or brown-out reset (retained RAM undefined)
+    BOOT_REASON_FAULT = 1,      // Trap conflict, illegal opcode, configuration mismatch or trap recorded
+    BOOT_REASON_EXTERNAL = 2,   // External reset (MCLR) or no reset cause flag
+    BOOT_REASON_NO_IMAGE = 3,   // Retained image invalid
+    BOOT_REASON_BUILD = 4,      // Retained image of a different firmware build or configuration
+    BOOT_REASON_WARM_FAILED = 5,// Warm restart failed, image invalidated
+    BOOT_REASON_WARM = 6        // Watchdog or software reset with valid image
+};
+typedef enum BOOT_REASON_e BOOT_REASON_t;
+
+/* Retained configuration image */
+struct BOOT_IMAGE_s {
+    uint16_t magic;         // Image identifier (BOOT_IMAGE_MAGIC)
+    uint16_t version;       // Image layout version (BOOT_IMAGE_VERSION)
+    uint16_t size;          // Image size in [byte]
+    uint16_t build;         // Firmware build identifier (checksum of build date and time)
+    uint16_t crashes;       // Trap counter of the crash record when the image was captured
+    uint16_t pg_instance;   // Index of the user PWM generator (PWM_GENERATOR)
+    uint16_t dac_instance;  // Index of the user DAC instance (DAC_INSTANCE)
+    uint16_t warm_count;    // Number of warm restarts using this image
+    uint32_t cold_ns;       // Boot to first PWM edge of the most recent cold boot in [ns]
+    uint32_t warm_ns;       // Boot to first PWM edge of the most recent warm restart in [ns] (0 = none)
+    struct P33C_PWM_MODULE_s pwm; // PWM module register set
+    struct P33C_PWM_GENERATOR_s pg; // User PWM generator register set (generator turned off)
+    struct P33C_DAC_MODULE_s dac_module; // DAC module register set
+    struct P33C_DAC_INSTANCE_s dac; // User DAC instance register set (DAC turned off)
+    uint16_t crc;           // CRC-16/CCITT-FALSE of all preceding bytes
+};
+typedef struct BOOT_IMAGE_s BOOT_IMAGE_t;
+
+/* Boot status */
+struct BOOT_STATUS_s {
+    uint16_t rcon;          // Reset cause flags read at startup
+    uint16_t path;          // Selected boot path (BOOT_PATH_e)
+    uint16_t reason;        // Reason of the selection (BOOT_REASON_e)
+    uint16_t tick_ns;       // Timer period of the current system clock in [ns]
+    uint16_t last;          // Most recent timer reading
+    uint32_t elapsed_ns;    // Time since BOOT_Initialize() in [ns]
+    uint32_t first_edge_ns; // Boot to first PWM edge in [ns] (0 = PWM not enabled yet)
+};
+typedef struct BOOT_STATUS_s BOOT_STATUS_t;
+
+/* *********************************************************************************
+ * BOOT STAGE PROFILER
+ * *********************************************************************************
+ * Every initialization stage between reset and the first PWM edge is enclosed by 
+ * BOOT_STAGE_BEGIN() and BOOT_STAGE_END(). The start time (relative to 
+ * BOOT_Initialize()), the execution time and the number of executions of every 
+ * stage are recorded in the boot profile table boot_profile, which can be read
+ * with the debugger after startup. The stages are timed with the boot timer, so 
+ * stages before the clock switch are resolved in FRC instruction cycles. The 
+ * CLOCK stage overlaps the stages executed while the PLLs lock.
+ * 
+ * The instrumentation is compiled out by defining BOOT_PROFILE_ENABLE = 0.
+ * ********************************************************************************/
+
+#ifndef BOOT_PROFILE_ENABLE
+#define BOOT_PROFILE_ENABLE     1       // 1 = boot stages are recorded, 0 = instrumentation macros are empty
+#endif
+
+/* Initialization stages */
+enum BOOT_STAGE_ID_e {
+    BOOT_STAGE_PINS = 0,        // GPIO_Initialize(): pin manager (port registers of all device pins)
+    BOOT_STAGE_INTERRUPT,       // INTERRUPT_Initialize(): interrupt priorities
+    BOOT_STAGE_CLOCK,           // CLOCK_Start() until the clock switch to the system PLL is complete (runs in the background)
+    BOOT_STAGE_TMR1,            // TMR1_Initialize(): scheduler timebase
+    BOOT_STAGE_PWM,             // PWM_Initialize() or PWM_Restore(): PWM module and generator configuration
+    BOOT_STAGE_HRRDY,           // PWM_EnableStart() until the high resolution PWM clock is ready
+    BOOT_STAGE_DAC,             // DAC_Initialize() or DAC_Restore(): DAC module and instance configuration
+    BOOT_STAGE_COUNT            // Number of initialization stages
+};
+typedef enum BOOT_STAGE_ID_e BOOT_STAGE_ID_t;
+
+/* Timing of one initialization stage */
+struct BOOT_STAGE_s {
+    uint32_t start_ns;      // Most recent stage entry since BOOT_Initialize() in [ns]
+    uint32_t time_ns;       // Execution time of all passes in [ns]
+    uint16_t count;         // Number of passes since BOOT_Initialize() (0 = stage not executed)
+};
+typedef struct BOOT_STAGE_s BOOT_STAGE_t;
+
+/* Boot profile table */
+struct BOOT_PROFILE_s {
+    uint16_t path;          // Boot path of the recorded startup (BOOT_PATH_e)
+    uint16_t reason;        // Reason of the boot path selection (BOOT_REASON_e)
+    uint32_t first_edge_ns; // Boot to first PWM edge in [ns]
+    struct BOOT_STAGE_s stage[BOOT_STAGE_COUNT]; // Stage timing
+};
+typedef struct BOOT_PROFILE_s BOOT_PROFILE_t;
+
+#if (BOOT_PROFILE_ENABLE)
+  #define BOOT_STAGE_BEGIN(id)      { BOOT_StageBegin(id); }
+  #define BOOT_STAGE_END(id)        { BOOT_StageEnd(id); }
+#else
+  #define BOOT_STAGE_BEGIN(id)      { }
+  #define BOOT_STAGE_END(id)        { }
+#endif
+
+extern struct BOOT_IMAGE_s boot_image; // Retained configuration image (persistent RAM)
+extern volatile struct BOOT_STATUS_s boot; // Boot status
+
+extern volatile uint16_t BOOT_Validate(const struct BOOT_IMAGE_s* image);
+extern uint16_t BOOT_GetBuild(void);
+extern uint16_t BOOT_Decide(uint16_t rcon, const struct BOOT_IMAGE_s* image, uint16_t build, uint16_t crashes);
+extern volatile uint16_t BOOT_Initialize(void);
+extern volatile uint16_t BOOT_Capture(void);
+extern volatile uint16_t BOOT_WarmStart(void);
+extern void BOOT_Mark(void);
+extern void BOOT_ClockSwitched(void);
+extern volatile uint16_t BOOT_FirstEdge(void);
+
+#if (BOOT_PROFILE_ENABLE)
+extern volatile struct BOOT_PROFILE_s boot_profile; // Boot profile table
+extern void BOOT_StageBegin(uint16_t stage);
+extern void BOOT_StageEnd(uint16_t stage);
+#endif
+
+#endif	/* XC_BOOT_PATH_H */
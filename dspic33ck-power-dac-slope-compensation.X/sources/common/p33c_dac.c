@@ -26,6 +26,7 @@
 #include <stddef.h> // include standard definition data types
 
 #include "p33c_dac.h"
+#include "p33c_profile.h"
 
 /* @@p33c_DacModule_Dispose
  * ********************************************************************************
@@ -56,7 +57,7 @@ volatile uint16_t p33c_DacModule_Dispose(void)
 {
     volatile uint16_t retval=1;
     
-    retval = p33c_DacModule_ConfigWrite(dacModuleConfigClear);
+    retval = p33c_DacModule_ConfigWriteRef(&dacModuleConfigClear);
     
     return(retval);
 }
@@ -129,6 +130,90 @@ volatile uint16_t p33c_DacModule_ConfigWrite(
     
 }
 
+/* @@p33c_DacModule_ConfigReadRef
+ * ********************************************************************************
+ * Summary:
+ *     Reads the current DAC module base configuration into a user variable
+ * 
+ * Parameters:
+ *     struct P33C_DAC_MODULE_s* dacModuleConfig:
+ *          Pointer to the register image receiving the DAC module configuration
+ * 
+ * Returns:
+ *     0 = failure, reading DAC module was not successful
+ *     1 = success, reading DAC module was successful
+ * 
+ * Description:
+ *     This function copies all DAC module base registers directly into the 
+ *     register image referenced by dacModuleConfig without returning the 
+ *     register set by value through the stack.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_DacModule_ConfigReadRef(struct P33C_DAC_MODULE_s* dacModuleConfig)
+{
+    volatile uint16_t* sfr;
+    uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer protection
+    if (dacModuleConfig == NULL)
+        return(0);
+
+    // Set pointers to DAC module base registers and user register image
+    sfr = (volatile uint16_t*)p33c_DacModule_GetHandle();
+    img = (uint16_t*)dacModuleConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_DAC_MODULE_s) / sizeof(uint16_t)); i++)
+        img[i] = sfr[i];
+    
+    return(1);
+    
+}
+
+/* @@p33c_DacModule_ConfigWriteRef
+ * ********************************************************************************
+ * Summary:
+ *     Writes a user-defined configuration to the DAC module base registers
+ * 
+ * Parameters:
+ *     const volatile struct P33C_DAC_MODULE_s* dacModuleConfig:
+ *          Pointer to the register image holding the DAC module configuration
+ * 
+ * Returns:
+ *     0 = failure, writing DAC module was not successful
+ *     1 = success, writing DAC module was successful
+ * 
+ * Description:
+ *     This function writes the DAC module configuration referenced by 
+ *     dacModuleConfig directly to the DAC module base registers without
+ *     passing the register image by value through the stack.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_DacModule_ConfigWriteRef(const volatile struct P33C_DAC_MODULE_s* dacModuleConfig)
+{
+    volatile uint16_t* sfr;
+    const volatile uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer protection
+    if (dacModuleConfig == NULL)
+        return(0);
+
+    // Set pointers to DAC module base registers and user register image
+    sfr = (volatile uint16_t*)p33c_DacModule_GetHandle();
+    img = (const volatile uint16_t*)dacModuleConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_DAC_MODULE_s) / sizeof(uint16_t)); i++)
+        sfr[i] = img[i];
+    
+    return(1);
+    
+}
+
 
 /* ============================================================================== */
 /* ============================================================================== */
@@ -164,7 +249,7 @@ volatile uint16_t p33c_DacInstance_Dispose(volatile uint16_t dacInstance)
 {
     volatile uint16_t retval=1;
     
-    retval = p33c_DacInstance_ConfigWrite(dacInstance, dacConfigClear);
+    retval = p33c_DacInstance_ConfigWriteRef(dacInstance, &dacConfigClear);
     
     return(retval);
 }
@@ -231,15 +316,117 @@ volatile uint16_t p33c_DacInstance_ConfigWrite(
     volatile uint16_t retval=1;
     volatile struct P33C_DAC_INSTANCE_s* dac;    
 
+    P33C_PROFILE_BEGIN(P33C_PROFILE_DAC_WRITE);
+    
     // Set pointer to memory address of desired DAC instance
     dac = (volatile struct P33C_DAC_INSTANCE_s*) 
         ((volatile uint8_t*) &DAC1CONL + ((dacInstance - 1) * P33C_DAC_SFR_OFFSET));
     *dac = dacConfig;
     
+    P33C_PROFILE_END(P33C_PROFILE_DAC_WRITE);
+    
     return(retval);
     
 }
 
+/* @@p33c_DacInstance_ConfigReadRef
+ * ********************************************************************************
+ * Summary:
+ *     Reads the current configuration of a DAC instance into a user variable
+ * 
+ * Parameters:
+ *     uint16_t dacInstance:
+ *          Instance of the DAC (e.g. 1 = DAC1, 2 = DAC2, etc.)
+ *     struct P33C_DAC_INSTANCE_s* dacConfig:
+ *          Pointer to the register image receiving the DAC instance configuration
+ * 
+ * Returns:
+ *     0 = failure, reading DAC instance was not successful
+ *     1 = success, reading DAC instance was successful
+ * 
+ * Description:
+ *     This function copies all registers of the specified DAC instance directly 
+ *     into the register image referenced by dacConfig without returning the 
+ *     register set by value through the stack.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_DacInstance_ConfigReadRef(
+        uint16_t dacInstance, 
+        struct P33C_DAC_INSTANCE_s* dacConfig
+)
+{
+    volatile uint16_t* sfr;
+    uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer and instance range protection
+    if ((dacConfig == NULL) || (dacInstance == 0) || (dacInstance > P33C_DAC_COUNT))
+        return(0);
+
+    // Set pointers to memory address of desired DAC instance and user register image
+    sfr = (volatile uint16_t*)p33c_DacInstance_GetHandle(dacInstance);
+    img = (uint16_t*)dacConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_DAC_INSTANCE_s) / sizeof(uint16_t)); i++)
+        img[i] = sfr[i];
+    
+    return(1);
+    
+}
+
+/* @@p33c_DacInstance_ConfigWriteRef
+ * ********************************************************************************
+ * Summary:
+ *     Writes a user-defined configuration to a DAC instance
+ * 
+ * Parameters:
+ *     uint16_t dacInstance:
+ *          Instance of the DAC (e.g. 1 = DAC1, 2 = DAC2, etc.)
+ *     const volatile struct P33C_DAC_INSTANCE_s* dacConfig:
+ *          Pointer to the register image holding the DAC instance configuration
+ * 
+ * Returns:
+ *     0 = failure, writing DAC instance was not successful
+ *     1 = success, writing DAC instance was successful
+ * 
+ * Description:
+ *     This function writes the DAC instance configuration referenced by dacConfig
+ *     directly to the given DAC instance registers without passing the register 
+ *     image by value through the stack.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_DacInstance_ConfigWriteRef(
+        uint16_t dacInstance, 
+        const volatile struct P33C_DAC_INSTANCE_s* dacConfig
+)
+{
+    volatile uint16_t* sfr;
+    const volatile uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer and instance range protection
+    if ((dacConfig == NULL) || (dacInstance == 0) || (dacInstance > P33C_DAC_COUNT))
+        return(0);
+
+    P33C_PROFILE_BEGIN(P33C_PROFILE_DAC_WRITE_REF);
+    
+    // Set pointers to memory address of desired DAC instance and user register image
+    sfr = (volatile uint16_t*)p33c_DacInstance_GetHandle(dacInstance);
+    img = (const volatile uint16_t*)dacConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_DAC_INSTANCE_s) / sizeof(uint16_t)); i++)
+        sfr[i] = img[i];
+    
+    P33C_PROFILE_END(P33C_PROFILE_DAC_WRITE_REF);
+    
+    return(1);
+    
+}
+
 /* ============================================================================== */
 /* ============================================================================== */
 /* ============================================================================== */
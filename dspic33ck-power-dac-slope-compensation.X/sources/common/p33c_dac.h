@@ -102,24 +102,28 @@
     }; // PDM DAC INSTANCE REGISTER SET
     typedef struct P33C_DAC_INSTANCE_s P33C_DAC_INSTANCE_t; // PDM DAC INSTANCE REGISTER SET
     
-    #define P33C_DAC_SFR_OFFSET  ((uint16_t)&DAC2CONL - (uint16_t)&DAC1CONL)
+    #define P33C_DAC_SFR_OFFSET  ((uint16_t)((volatile uint8_t*)&DAC2CONL - (volatile uint8_t*)&DAC1CONL))
 
 #endif
 
 // Declare macro for getting start memory address of DAC module data structure
 #define p33c_DacModule_GetHandle()      (P33C_DAC_MODULE_t*)&DACCTRL1L
 
-// Declare macro for getting start memory address of DAC instance data structure
+// Determine number of available DAC instances on the selected device
 #if defined (DAC4CONL)
-#define p33c_DacInstance_GetHandle(x)   (P33C_DAC_INSTANCE_t*)&DAC1CONL, (P33C_DAC_INSTANCE_t*)&DAC2CONL, \
-                                        (P33C_DAC_INSTANCE_t*)&DAC3CONL, (P33C_DAC_INSTANCE_t*)&DAC4CONL
+#define P33C_DAC_COUNT  4   // Number of available DAC instances
 #elif defined (DAC3CONL)
-#define p33c_DacInstance_GetHandle(x)   (P33C_DAC_INSTANCE_t*)&DAC1CONL, (P33C_DAC_INSTANCE_t*)&DAC2CONL, \
-                                        (P33C_DAC_INSTANCE_t*)&DAC3CONL
+#define P33C_DAC_COUNT  3   // Number of available DAC instances
 #elif defined (DAC2CONL)
-#define p33c_DacInstance_GetHandle(x)   (P33C_DAC_INSTANCE_t*)&DAC1CONL, (P33C_DAC_INSTANCE_t*)&DAC2CONL
-#elif defined (DAC1CONL)
-#define p33c_DacInstance_GetHandle(x)   (P33C_DAC_INSTANCE_t*)&DAC1CONL 
+#define P33C_DAC_COUNT  2   // Number of available DAC instances
+#else
+#define P33C_DAC_COUNT  1   // Number of available DAC instances
+#endif
+
+// Declare macro for getting start memory address of DAC instance data structure
+#if defined (DAC1CONL)
+#define p33c_DacInstance_GetHandle(x)   ((P33C_DAC_INSTANCE_t*)((volatile uint8_t*)&DAC1CONL + \
+                                        (((x) - 1) * P33C_DAC_SFR_OFFSET)))
 #else
 #pragma message "warning: no DAC instance support for the selected device"
 #endif
@@ -135,6 +139,13 @@ extern volatile uint16_t p33c_DacModule_ConfigWrite(
                     volatile struct P33C_DAC_MODULE_s dacConfig
                 );
 
+extern volatile uint16_t p33c_DacModule_ConfigReadRef(
+                    struct P33C_DAC_MODULE_s* dacModuleConfig
+                );
+extern volatile uint16_t p33c_DacModule_ConfigWriteRef(
+                    const volatile struct P33C_DAC_MODULE_s* dacModuleConfig
+                );
+
 
 extern volatile uint16_t p33c_DacInstance_Dispose(
                     volatile uint16_t dacInstance
@@ -149,6 +160,16 @@ extern volatile uint16_t p33c_DacInstance_ConfigWrite(
                     volatile struct P33C_DAC_INSTANCE_s dacConfig
                 );
 
+extern volatile uint16_t p33c_DacInstance_ConfigReadRef(
+                    uint16_t dacInstance, 
+                    struct P33C_DAC_INSTANCE_s* dacConfig
+                );
+
+extern volatile uint16_t p33c_DacInstance_ConfigWriteRef(
+                    uint16_t dacInstance, 
+                    const volatile struct P33C_DAC_INSTANCE_s* dacConfig
+                );
+
 /* ********************************************************************************************* * 
  * DAC INSTANCE CONFIGURATION TEMPLATES
  * ********************************************************************************************* */
@@ -0,0 +1,180 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "p33c_gpio.h"
+
+/* @@p33c_GpioPins_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Configures a list of device pins from a constant pin configuration table
+ * 
+ * Parameters:
+ *     const struct P33C_GPIO_PIN_CONFIG_s* pinConfig: pointer to the first table entry
+ *     uint16_t count: number of table entries
+ * 
+ * Returns:
+ *     0 = failure, at least one table entry is invalid and has been skipped
+ *     1 = success, all pins have been configured
+ * 
+ * Description:
+ *     This function walks through a table of pin descriptors and applies the 
+ *     configuration mode of each entry to the port registers of the pin:
+ * 
+ *         - P33C_GPIO_MODE_OUTPUT_LOW:  LATx = 0, TRISx = 0
+ *         - P33C_GPIO_MODE_OUTPUT_HIGH: LATx = 1, TRISx = 0
+ *         - P33C_GPIO_MODE_INPUT:       LATx = 1, TRISx = 1
+ *         - P33C_GPIO_MODE_ANALOG:      ANSELx = 1, LATx = 1, TRISx = 1
+ * 
+ *     Like the InitAsOutput() and InitAsInput() macros of the pinmap headers, 
+ *     digital modes leave the ANSELx bit unchanged. The pin options 
+ *     P33C_GPIO_PULL_UP, P33C_GPIO_PULL_DOWN and P33C_GPIO_OPEN_DRAIN set the
+ *     CNPUx, CNPDx and ODCx bit, pins without option keep these bits unchanged.
+ *     The latch is always written before the direction to prevent glitches on 
+ *     pins turning into outputs. Entries with invalid port index or mode, 
+ *     pull-up and pull-down enabled at the same time as well as the analog 
+ *     mode applied to digital-only pins are skipped and reported as failure.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_GpioPins_Initialize(
+        const struct P33C_GPIO_PIN_CONFIG_s* pinConfig,
+        volatile uint16_t count
+)
+{
+    volatile uint16_t retval=1;
+    volatile P33C_GPIO_INSTANCE_t* gpio;
+    uint16_t mask, mode;
+    uint16_t i;
+
+    if (pinConfig == NULL)
+        return(0);
+
+    for (i = 0; i < count; i++)
+    {
+        mode = (pinConfig[i].mode & P33C_GPIO_MODE_MASK);
+        
+        // Reject invalid table entries
+        if ((pinConfig[i].pin.port > P33C_GPIO_PORT_E) || (pinConfig[i].pin.bit > 15) ||
+            (mode > P33C_GPIO_MODE_ANALOG) || (pinConfig[i].mode & 0x80U) ||
+            ((pinConfig[i].mode & P33C_GPIO_PULL_UP) && (pinConfig[i].mode & P33C_GPIO_PULL_DOWN)) ||
+            ((mode == P33C_GPIO_MODE_ANALOG) && (!pinConfig[i].pin.analog)))
+        {
+            retval = 0;
+            continue;
+        }
+
+        // Set pointer to memory address of the port register set of this pin
+        gpio = p33c_GpioInstance_GetHandle(pinConfig[i].pin.port);
+        mask = (uint16_t)(1U << pinConfig[i].pin.bit);
+
+        // Pin options, analog function and latch first, then direction
+        if (pinConfig[i].mode & P33C_GPIO_OPEN_DRAIN)
+            gpio->ODCx |= mask;
+        if (pinConfig[i].mode & P33C_GPIO_PULL_UP)
+            gpio->CNPUx |= mask;
+        if (pinConfig[i].mode & P33C_GPIO_PULL_DOWN)
+            gpio->CNPDx |= mask;
+
+        if (mode == P33C_GPIO_MODE_ANALOG)
+            gpio->ANSELx |= mask;
+
+        if (mode == P33C_GPIO_MODE_OUTPUT_LOW)
+            gpio->LATx &= ~mask;
+        else
+            gpio->LATx |= mask;
+
+        if ((mode == P33C_GPIO_MODE_INPUT) || (mode == P33C_GPIO_MODE_ANALOG))
+            gpio->TRISx |= mask;
+        else
+            gpio->TRISx &= ~mask;
+    }
+
+    return(retval);
+}
+
+/* @@p33c_GpioPorts_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Writes precomputed register values to the port register sets
+ * 
+ * Parameters:
+ *     const struct P33C_GPIO_PORT_CONFIG_s* portConfig: pointer to the first table entry
+ *     uint16_t count: number of table entries
+ * 
+ * Returns:
+ *     0 = failure, at least one table entry has an invalid port index and has been skipped
+ *     1 = success, all ports have been configured
+ * 
+ * Description:
+ *     Each table entry holds the complete values of the LATx, ODCx, CNPUx, CNPDx,
+ *     ANSELx and TRISx registers of one port, usually folded from a board pin 
+ *     list at compile time by p33c_GpioPort_Config(). Every register is written 
+ *     exactly once as a whole without reading it back, so all pins of a port 
+ *     change their configuration with the same instruction. Latch, open-drain,
+ *     pull-up/down and analog select registers are written before the direction
+ *     register to prevent glitches on pins turning into outputs.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_GpioPorts_Initialize(
+        const struct P33C_GPIO_PORT_CONFIG_s* portConfig,
+        volatile uint16_t count
+)
+{
+    volatile uint16_t retval=1;
+    volatile P33C_GPIO_INSTANCE_t* gpio;
+    uint16_t i;
+
+    if (portConfig == NULL)
+        return(0);
+
+    for (i = 0; i < count; i++)
+    {
+        // Reject invalid port index
+        if (portConfig[i].port > P33C_GPIO_PORT_E)
+        {
+            retval = 0;
+            continue;
+        }
+
+        // Set pointer to memory address of the port register set
+        gpio = p33c_GpioInstance_GetHandle(portConfig[i].port);
+
+        // One write per register, direction last
+        gpio->LATx = portConfig[i].LATx;
+        gpio->ODCx = portConfig[i].ODCx;
+        gpio->CNPUx = portConfig[i].CNPUx;
+        gpio->CNPDx = portConfig[i].CNPDx;
+        gpio->ANSELx = portConfig[i].ANSELx;
+        gpio->TRISx = portConfig[i].TRISx;
+    }
+
+    return(retval);
+}
+
+// ________________________
+// end of file
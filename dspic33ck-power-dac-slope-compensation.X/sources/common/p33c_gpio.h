@@ -0,0 +1,275 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/*@@p33c_gpio.h
+ * ************************************************************************************************
+ * Summary:
+ * Generic General Purpose Input/Output Driver Module (header file)
+ *
+ * Description:
+ * This header file declares the port register set of a GPIO instance (PORTA, PORTB, ...), the
+ * constant pin descriptor used by the generated pin tables (e.g. ma330048_r30_pins.h) and the
+ * pin accessor macros operating on these descriptors. 
+ * 
+ * A pin descriptor is declared as object-like macro <NAME>_PIN, which expands into the list
+ * 'port letter, bit, RPn, analog, ADC core, ANx input'. All accessors take the signal name 
+ * without the _PIN suffix (e.g. p33c_Gpio_Set(DBGPIN)) and resolve the descriptor entirely at 
+ * compile time. On the target, p33c_Gpio_Set(), _Clear() and _Toggle() compile into one single 
+ * bset/bclr/btg instruction on the latch register. Board signals are declared as aliases of 
+ * other descriptors (e.g. #define TP05_PIN ECP05_PIN) and are resolved by the preprocessor.
+ * 
+ * Descriptors can be collected in constant tables of type P33C_GPIO_PIN_s, which are used by
+ * p33c_GpioPins_Initialize() to configure multiple pins in one table-driven pass.
+ * 
+ * Alternatively, the pins of a board pin list are folded into one precomputed register value
+ * per port and register at compile time (see p33c_GpioPort_Config()), which are written by
+ * p33c_GpioPorts_Initialize() with one single write access per port register.
+ * 
+ * See Also:
+ *	p33c_gpio.c, p33c_pingen.c (host tool generating the pin tables)
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef P33C_GPIO_SFR_ABSTRACTION_H
+#define	P33C_GPIO_SFR_ABSTRACTION_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+
+// GENERIC GPIO INSTANCE SPECIAL FUNCTION REGISTER SET
+#ifndef P33C_GPIO_INSTANCE_s    
+
+    struct P33C_GPIO_INSTANCE_s {
+        uint16_t ANSELx;    // ANSELx: ANALOG SELECT REGISTER
+        uint16_t TRISx;     // TRISx: DATA DIRECTION REGISTER
+        uint16_t PORTx;     // PORTx: INPUT DATA REGISTER
+        uint16_t LATx;      // LATx: OUTPUT DATA LATCH REGISTER
+        uint16_t ODCx;      // ODCx: OPEN-DRAIN ENABLE REGISTER
+        uint16_t CNPUx;     // CNPUx: CHANGE NOTIFICATION PULL-UP ENABLE REGISTER
+        uint16_t CNPDx;     // CNPDx: CHANGE NOTIFICATION PULL-DOWN ENABLE REGISTER
+        uint16_t CNCONx;    // CNCONx: CHANGE NOTIFICATION CONTROL REGISTER
+        uint16_t CNEN0x;    // CNEN0x: INTERRUPT CHANGE NOTIFICATION ENABLE REGISTER
+        uint16_t CNSTATx;   // CNSTATx: INTERRUPT CHANGE NOTIFICATION STATUS REGISTER
+        uint16_t CNEN1x;    // CNEN1x: INTERRUPT CHANGE NOTIFICATION EDGE SELECT REGISTER
+        uint16_t CNFx;      // CNFx: INTERRUPT CHANGE NOTIFICATION FLAG REGISTER
+    }; // GPIO INSTANCE REGISTER SET
+    typedef struct P33C_GPIO_INSTANCE_s P33C_GPIO_INSTANCE_t; // GPIO INSTANCE REGISTER SET
+    
+    #define P33C_GPIO_SFR_OFFSET  ((uint16_t)((volatile uint8_t*)&ANSELB - (volatile uint8_t*)&ANSELA))
+
+#endif
+
+// Declare macro for getting start memory address of GPIO instance data structure (0 = PORTA, 1 = PORTB, ...)
+#define p33c_GpioInstance_GetHandle(x)  ((volatile P33C_GPIO_INSTANCE_t*)((volatile uint8_t*)&ANSELA + \
+                                        ((x) * P33C_GPIO_SFR_OFFSET)))
+
+// Port indices used in pin descriptor tables
+#define P33C_GPIO_PORT_A    0U
+#define P33C_GPIO_PORT_B    1U
+#define P33C_GPIO_PORT_C    2U
+#define P33C_GPIO_PORT_D    3U
+#define P33C_GPIO_PORT_E    4U
+
+// CONSTANT PIN DESCRIPTOR
+    
+    struct P33C_GPIO_PIN_s {
+        uint8_t port;       // Port index (0 = PORTA, 1 = PORTB, ...)
+        uint8_t bit;        // Bit position within the port registers
+        uint8_t rp;         // Number of Remappable Pin RPn (0 = pin is not remappable)
+        uint8_t analog;     // 1 = pin is analog input and has an ANSELx bit, 0 = digital pin only
+        uint8_t adc_core;   // ADC core index (last index = shared core), valid when analog = 1
+        uint8_t adc_input;  // ANx input number, valid when analog = 1
+    }; // CONSTANT PIN DESCRIPTOR
+    typedef struct P33C_GPIO_PIN_s P33C_GPIO_PIN_t; // CONSTANT PIN DESCRIPTOR
+
+// Pin configuration modes of the table-driven pin initialization
+#define P33C_GPIO_MODE_OUTPUT_LOW   0U  // digital output, latch cleared
+#define P33C_GPIO_MODE_OUTPUT_HIGH  1U  // digital output, latch set
+#define P33C_GPIO_MODE_INPUT        2U  // digital input, latch set
+#define P33C_GPIO_MODE_ANALOG       3U  // analog input, latch set
+#define P33C_GPIO_MODE_MASK         0x0FU // mask of the configuration mode
+
+// Pin options which may be added to the configuration mode (e.g. P33C_GPIO_MODE_INPUT | P33C_GPIO_PULL_UP)
+#define P33C_GPIO_PULL_UP           0x10U // weak pull-up enabled (CNPUx = 1)
+#define P33C_GPIO_PULL_DOWN         0x20U // weak pull-down enabled (CNPDx = 1)
+#define P33C_GPIO_OPEN_DRAIN        0x40U // open-drain output (ODCx = 1)
+
+// PIN CONFIGURATION TABLE ENTRY
+    
+    struct P33C_GPIO_PIN_CONFIG_s {
+        struct P33C_GPIO_PIN_s pin; // Constant pin descriptor
+        uint8_t mode;               // Pin configuration mode (P33C_GPIO_MODE_xxx)
+        uint8_t : 8;                // (reserved)
+    }; // PIN CONFIGURATION TABLE ENTRY
+    typedef struct P33C_GPIO_PIN_CONFIG_s P33C_GPIO_PIN_CONFIG_t; // PIN CONFIGURATION TABLE ENTRY
+
+// PORT CONFIGURATION TABLE ENTRY
+    
+    struct P33C_GPIO_PORT_CONFIG_s {
+        uint16_t port;      // Port index (0 = PORTA, 1 = PORTB, ...)
+        uint16_t LATx;      // LATx: OUTPUT DATA LATCH REGISTER value
+        uint16_t ODCx;      // ODCx: OPEN-DRAIN ENABLE REGISTER value
+        uint16_t CNPUx;     // CNPUx: CHANGE NOTIFICATION PULL-UP ENABLE REGISTER value
+        uint16_t CNPDx;     // CNPDx: CHANGE NOTIFICATION PULL-DOWN ENABLE REGISTER value
+        uint16_t ANSELx;    // ANSELx: ANALOG SELECT REGISTER value
+        uint16_t TRISx;     // TRISx: DATA DIRECTION REGISTER value
+    }; // PORT CONFIGURATION TABLE ENTRY
+    typedef struct P33C_GPIO_PORT_CONFIG_s P33C_GPIO_PORT_CONFIG_t; // PORT CONFIGURATION TABLE ENTRY
+
+/* ********************************************************************************************* * 
+ * PIN ACCESSOR MACROS
+ * ********************************************************************************************* */
+
+// Descriptor expansion: the first level pastes the _PIN suffix, the second level expands 
+// the descriptor into its argument list before the operation macro is invoked
+#define P33C_GPIO_CALL(op, desc)        op(desc)
+#define P33C_GPIO_CALL1(op, desc, arg)  op(desc, arg)
+
+// Operations on the expanded argument list 'port, bit, rp, analog, core, input'
+#if defined (__P33C_HOST__)
+#define P33C_GPIO_BSET_(reg, port, bit)     { reg##port |= (uint16_t)(1U << (bit)); }
+#define P33C_GPIO_BCLR_(reg, port, bit)     { reg##port &= (uint16_t)~(1U << (bit)); }
+#define P33C_GPIO_BTG_(reg, port, bit)      { reg##port ^= (uint16_t)(1U << (bit)); }
+#else
+#define P33C_GPIO_BSET_(reg, port, bit)     { asm volatile ("bset _" #reg #port ", #" #bit " \n"); }
+#define P33C_GPIO_BCLR_(reg, port, bit)     { asm volatile ("bclr _" #reg #port ", #" #bit " \n"); }
+#define P33C_GPIO_BTG_(reg, port, bit)      { asm volatile ("btg  _" #reg #port ", #" #bit " \n"); }
+#endif
+
+#define P33C_GPIO_SET_(port, bit, rp, an, core, input)      P33C_GPIO_BSET_(LAT, port, bit)
+#define P33C_GPIO_CLEAR_(port, bit, rp, an, core, input)    P33C_GPIO_BCLR_(LAT, port, bit)
+#define P33C_GPIO_TOGGLE_(port, bit, rp, an, core, input)   P33C_GPIO_BTG_(LAT, port, bit)
+#define P33C_GPIO_READ_(port, bit, rp, an, core, input)     ((uint16_t)((PORT##port >> (bit)) & 0x0001U))
+#define P33C_GPIO_WRITE_(port, bit, rp, an, core, input, state) \
+            { if (state) P33C_GPIO_BSET_(LAT, port, bit) else P33C_GPIO_BCLR_(LAT, port, bit) }
+#define P33C_GPIO_OUTPUT_(port, bit, rp, an, core, input)   { P33C_GPIO_BCLR_(LAT, port, bit) P33C_GPIO_BCLR_(TRIS, port, bit) }
+#define P33C_GPIO_INPUT_(port, bit, rp, an, core, input)    { P33C_GPIO_BSET_(LAT, port, bit) P33C_GPIO_BSET_(TRIS, port, bit) }
+#define P33C_GPIO_ANALOG_(port, bit, rp, an, core, input)   \
+            { P33C_GPIO_BSET_(ANSEL, port, bit) P33C_GPIO_BSET_(LAT, port, bit) P33C_GPIO_BSET_(TRIS, port, bit) }
+#define P33C_GPIO_RP_(port, bit, rp, an, core, input)       (rp)
+#define P33C_GPIO_IS_ANALOG_(port, bit, rp, an, core, input) (an)
+#define P33C_GPIO_ADCCORE_(port, bit, rp, an, core, input)  (core)
+#define P33C_GPIO_ADC_AN_INPUT_(port, bit, rp, an, core, input) (input)
+#define P33C_GPIO_MASK_(port, bit, rp, an, core, input)     ((uint16_t)(1U << (bit)))
+#define P33C_GPIO_PIN_(port, bit, rp, an, core, input)      { P33C_GPIO_PORT_##port, (bit), (rp), (an), (core), (input) }
+
+// Public pin accessors, 'pin' is the signal name without the _PIN suffix (e.g. DBGPIN, TP05)
+#define p33c_Gpio_Set(pin)          P33C_GPIO_CALL(P33C_GPIO_SET_, pin##_PIN)       // Sets the pin latch (single bset)
+#define p33c_Gpio_Clear(pin)        P33C_GPIO_CALL(P33C_GPIO_CLEAR_, pin##_PIN)     // Clears the pin latch (single bclr)
+#define p33c_Gpio_Toggle(pin)       P33C_GPIO_CALL(P33C_GPIO_TOGGLE_, pin##_PIN)    // Toggles the pin latch (single btg)
+#define p33c_Gpio_Read(pin)         P33C_GPIO_CALL(P33C_GPIO_READ_, pin##_PIN)      // Returns the pin input level (0/1)
+#define p33c_Gpio_Write(pin, state) P33C_GPIO_CALL1(P33C_GPIO_WRITE_, pin##_PIN, state) // Sets or clears the pin latch
+#define p33c_Gpio_InitAsOutput(pin) P33C_GPIO_CALL(P33C_GPIO_OUTPUT_, pin##_PIN)    // Digital output, latch LOW
+#define p33c_Gpio_InitAsInput(pin)  P33C_GPIO_CALL(P33C_GPIO_INPUT_, pin##_PIN)     // Digital input, latch HIGH
+#define p33c_Gpio_InitAnalog(pin)   P33C_GPIO_CALL(P33C_GPIO_ANALOG_, pin##_PIN)    // Analog input (analog pins only)
+#define p33c_Gpio_GetRP(pin)        P33C_GPIO_CALL(P33C_GPIO_RP_, pin##_PIN)        // Number of Remappable Pin RPn
+#define p33c_Gpio_IsAnalog(pin)     P33C_GPIO_CALL(P33C_GPIO_IS_ANALOG_, pin##_PIN) // 1 = pin is analog input
+#define p33c_Gpio_GetAdcCore(pin)   P33C_GPIO_CALL(P33C_GPIO_ADCCORE_, pin##_PIN)   // ADC core index
+#define p33c_Gpio_GetAdcInput(pin)  P33C_GPIO_CALL(P33C_GPIO_ADC_AN_INPUT_, pin##_PIN) // ANx input number
+#define p33c_Gpio_GetMask(pin)      P33C_GPIO_CALL(P33C_GPIO_MASK_, pin##_PIN)      // Port register bit mask
+#define p33c_Gpio_Descriptor(pin)   P33C_GPIO_CALL(P33C_GPIO_PIN_, pin##_PIN)       // P33C_GPIO_PIN_s initializer
+
+/* ********************************************************************************************* * 
+ * PORT CONFIGURATION FOLDING MACROS
+ * ********************************************************************************************* 
+ * A board pin list is declared as X-macro taking an entry macro and two context arguments, 
+ * with one entry per pin:
+ * 
+ *   #define BOARD_PINS(entry, reg, port) \
+ *       entry(reg, port, DBGPIN, P33C_GPIO_MODE_OUTPUT_LOW) \
+ *       entry(reg, port, SW,     P33C_GPIO_MODE_INPUT | P33C_GPIO_PULL_UP)
+ * 
+ * p33c_GpioPort_Fold() folds all pins of the list located on the given port into one register
+ * value at compile time. Bits of other pins keep the given default value, while the bits of 
+ * listed pins are set or cleared in the same way as p33c_GpioPins_Initialize() would modify 
+ * them. p33c_GpioPort_Config() declares the initializer of a complete port configuration 
+ * table entry, p33c_GpioPin_Config() declares the pin configuration table entry of each pin
+ * of the list.
+ * ********************************************************************************************* */
+
+// Register bits set and cleared by a configuration mode
+#define P33C_GPIO_FSET_LAT_(mode)   (((mode) & P33C_GPIO_MODE_MASK) != P33C_GPIO_MODE_OUTPUT_LOW)
+#define P33C_GPIO_FCLR_LAT_(mode)   (((mode) & P33C_GPIO_MODE_MASK) == P33C_GPIO_MODE_OUTPUT_LOW)
+#define P33C_GPIO_FSET_TRIS_(mode)  (((mode) & P33C_GPIO_MODE_MASK) >= P33C_GPIO_MODE_INPUT)
+#define P33C_GPIO_FCLR_TRIS_(mode)  (((mode) & P33C_GPIO_MODE_MASK) < P33C_GPIO_MODE_INPUT)
+#define P33C_GPIO_FSET_ANSEL_(mode) (((mode) & P33C_GPIO_MODE_MASK) == P33C_GPIO_MODE_ANALOG)
+#define P33C_GPIO_FCLR_ANSEL_(mode) (0)
+#define P33C_GPIO_FSET_ODC_(mode)   (((mode) & P33C_GPIO_OPEN_DRAIN) != 0)
+#define P33C_GPIO_FCLR_ODC_(mode)   (0)
+#define P33C_GPIO_FSET_CNPU_(mode)  (((mode) & P33C_GPIO_PULL_UP) != 0)
+#define P33C_GPIO_FCLR_CNPU_(mode)  (0)
+#define P33C_GPIO_FSET_CNPD_(mode)  (((mode) & P33C_GPIO_PULL_DOWN) != 0)
+#define P33C_GPIO_FCLR_CNPD_(mode)  (0)
+
+// List entries contributing the register bit of one pin, if located on port 'p'
+#define P33C_GPIO_CALL2(op, desc, a, b) op(desc, a, b)
+#define P33C_GPIO_FOLD_BIT_(port, bit, rp, an, core, input, p, cond) \
+            ((((P33C_GPIO_PORT_##port) == (p)) && (cond)) ? (uint16_t)(1U << (bit)) : 0U)
+#define P33C_GPIO_FOLD_SET_(reg, p, pin, mode) \
+            P33C_GPIO_CALL2(P33C_GPIO_FOLD_BIT_, pin##_PIN, p, P33C_GPIO_FSET_##reg##_(mode)) |
+#define P33C_GPIO_FOLD_CLR_(reg, p, pin, mode) \
+            P33C_GPIO_CALL2(P33C_GPIO_FOLD_BIT_, pin##_PIN, p, P33C_GPIO_FCLR_##reg##_(mode)) |
+#define P33C_GPIO_PIN_CONFIG_(reg, p, name, cfg) { .pin = p33c_Gpio_Descriptor(name), .mode = (cfg) },
+
+// Masks of the register bits set and cleared by the pins of a list on port 'p' (reg = LAT, TRIS, ...)
+#define p33c_GpioPort_SetMask(list, reg, p) ((uint16_t)(list(P33C_GPIO_FOLD_SET_, reg, p) 0U))
+#define p33c_GpioPort_ClearMask(list, reg, p) ((uint16_t)(list(P33C_GPIO_FOLD_CLR_, reg, p) 0U))
+
+// Register value of port 'p' with all pins of a list applied to the default value
+#define p33c_GpioPort_Fold(list, reg, p, value) \
+            ((uint16_t)(((uint16_t)(value) & (uint16_t)~p33c_GpioPort_ClearMask(list, reg, p)) | \
+                        p33c_GpioPort_SetMask(list, reg, p)))
+
+// Port configuration table entry of port 'p' from the register default values and a pin list
+#define p33c_GpioPort_Config(list, p, lat, odc, cnpu, cnpd, ansel, tris) { \
+            .port   = (p), \
+            .LATx   = p33c_GpioPort_Fold(list, LAT, (p), (lat)), \
+            .ODCx   = p33c_GpioPort_Fold(list, ODC, (p), (odc)), \
+            .CNPUx  = p33c_GpioPort_Fold(list, CNPU, (p), (cnpu)), \
+            .CNPDx  = p33c_GpioPort_Fold(list, CNPD, (p), (cnpd)), \
+            .ANSELx = p33c_GpioPort_Fold(list, ANSEL, (p), (ansel)), \
+            .TRISx  = p33c_GpioPort_Fold(list, TRIS, (p), (tris)) }
+
+// Pin configuration table entries of all pins of a list
+#define p33c_GpioPin_Config(list)   list(P33C_GPIO_PIN_CONFIG_, 0, 0)
+
+/* ********************************************************************************************* * 
+ * API FUNCTION PROTOTYPES
+ * ********************************************************************************************* */
+
+extern volatile uint16_t p33c_GpioPins_Initialize(
+                    const struct P33C_GPIO_PIN_CONFIG_s* pinConfig,
+                    volatile uint16_t count
+                );
+
+extern volatile uint16_t p33c_GpioPorts_Initialize(
+                    const struct P33C_GPIO_PORT_CONFIG_s* portConfig,
+                    volatile uint16_t count
+                );
+
+
+#endif	/* P33C_GPIO_SFR_ABSTRACTION_H */
+// END OF FILE
@@ -0,0 +1,227 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/*@@p33c_profile.c
+ * ************************************************************************************************
+ * Summary:
+ * Generic Cycle-Count Profiler (source file)
+ *
+ * Description:
+ * This source file configures the free-running profiler timer and records the execution 
+ * times measured by the instrumentation macros declared in p33c_profile.h.
+ * 
+ * See Also:
+ *	p33c_profile.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "p33c_profile.h"
+
+struct P33C_PROFILE_s p33c_profile; // Profiler region table
+
+// Clears the statistics of all code regions
+static void p33c_Profile_Clear(void)
+{
+    uint16_t i, j;
+
+    for (i = 0; i < P33C_PROFILE_REGION_COUNT; i++)
+    {
+        p33c_profile.region[i].start = 0;
+        p33c_profile.region[i].min   = 0;
+        p33c_profile.region[i].max   = 0;
+        p33c_profile.region[i].mean  = 0;
+        p33c_profile.region[i].count = 0;
+        p33c_profile.region[i].sum   = 0;
+        for (j = 0; j < P33C_PROFILE_HISTOGRAM_SIZE; j++)
+            p33c_profile.region[i].histogram[j] = 0;
+    }
+    
+    return;
+}
+
+/* @@p33c_Profile_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Starts the profiler timer, clears all region statistics and measures the
+ *     instrumentation overhead
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, the profiler timer is not running
+ *     1 = success
+ * 
+ * Description:
+ *     SCCP1 is configured as free-running 16-bit timer clocked by the instruction 
+ *     clock (FCY) without prescaler. Regions of up to 65535 cycles are measured
+ *     correctly across timer rollovers. The overhead of an empty region is
+ *     determined as the minimum of P33C_PROFILE_CALIBRATION empty regions 
+ *     instrumented with P33C_PROFILE_BEGIN()/P33C_PROFILE_END(), so it 
+ *     includes the region table access of the macros, and is subtracted from 
+ *     all subsequent measurements. The overhead is zero when the 
+ *     instrumentation macros are disabled.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_Profile_Initialize(void)
+{
+    volatile uint16_t retval=1;
+    uint16_t i;
+
+    // SCCP1: 16-bit timer, FCY clock input, 1:1 prescaler, period 0xFFFF
+    CCP1CON1L = 0x0000;
+    CCP1CON1Lbits.CLKSEL = 0b000; // Clock source: FCY
+    CCP1CON1Lbits.TMRPS  = 0b00;  // Prescaler 1:1
+    CCP1CON1Lbits.T32    = 0;     // 16-bit time base
+    CCP1CON1Lbits.CCSEL  = 0;     // Output compare/timer mode
+    CCP1CON1Lbits.MOD    = 0b0000; // 16-bit timer
+    CCP1PRL = 0xFFFF;
+    CCP1CON1Lbits.CCPON  = 1;     // Start timer
+    
+    retval &= (uint16_t)(CCP1CON1Lbits.CCPON);
+
+    // Measure the execution time of an empty region with the instrumentation macros
+    p33c_Profile_Clear();
+    p33c_profile.overhead = 0;
+    for (i = 0; i < P33C_PROFILE_CALIBRATION; i++)
+    {
+        P33C_PROFILE_BEGIN(0);
+        P33C_PROFILE_END(0);
+    }
+    p33c_profile.overhead = p33c_profile.region[0].min; // zero if the macros are disabled
+    
+    p33c_Profile_Clear();
+    
+    return(retval);
+}
+
+/* @@p33c_Profile_Record
+ * ********************************************************************************
+ * Summary:
+ *     Records one pass of a code region
+ * 
+ * Parameters:
+ *     uint16_t id:
+ *          Index of the code region (enum P33C_PROFILE_ID_e)
+ *     uint16_t cycles:
+ *          Measured execution time including the instrumentation overhead in [cycles]
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     This function is called by P33C_PROFILE_END(). It is executed after the 
+ *     timer has been read and does not add to the execution time of the region.
+ *     The mean value is not calculated here to keep the recording time short 
+ *     (see p33c_Profile_Update()).
+ * 
+ * ********************************************************************************/
+
+void p33c_Profile_Record(uint16_t id, uint16_t cycles)
+{
+    struct P33C_PROFILE_REGION_s* region;
+    uint16_t bin, value;
+
+    if (id >= P33C_PROFILE_REGION_COUNT)
+        return;
+    region = &p33c_profile.region[id];
+
+    cycles = (cycles > p33c_profile.overhead) ? (cycles - p33c_profile.overhead) : 0;
+    
+    if ((region->count == 0) || (cycles < region->min))
+        region->min = cycles;
+    if (cycles > region->max)
+        region->max = cycles;
+
+    // Halve count and sum before the sum overflows, the mean value is preserved
+    if ((region->sum > (0xFFFFFFFFUL - cycles)) || (region->count == 0xFFFFFFFFUL))
+    {
+        region->sum >>= 1;
+        region->count >>= 1;
+    }
+    region->sum += cycles;
+    region->count++;
+    
+    // log2 histogram bin
+    bin = 0;
+    value = cycles;
+    while (value > 1)
+    {
+        value >>= 1;
+        bin++;
+    }
+    if (region->histogram[bin] < 0xFFFF)
+        region->histogram[bin]++;
+
+    return;
+}
+
+/* @@p33c_Profile_Update
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the mean execution time of all code regions
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     This function is called periodically from a low-priority task to keep 
+ *     the mean values in the region table up to date. Regions recorded by 
+ *     interrupt service routines update the 32-bit sum and count at any time, 
+ *     so both are copied with all interrupts masked before the division.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_Profile_Update(void)
+{
+    volatile uint16_t retval=1;
+    uint32_t mean, sum, count;
+    uint16_t i, ipl;
+
+    for (i = 0; i < P33C_PROFILE_REGION_COUNT; i++)
+    {
+        // Consistent snapshot of sum and count
+        ipl = SRbits.IPL;
+        SRbits.IPL = 7;
+        sum = p33c_profile.region[i].sum;
+        count = p33c_profile.region[i].count;
+        SRbits.IPL = ipl;
+        
+        if (count == 0)
+            continue;
+        mean = (sum / count);
+        p33c_profile.region[i].mean = (mean > 0xFFFF) ? 0xFFFF : (uint16_t)mean;
+    }
+    
+    return(retval);
+}
+
+// ________________________
+// end of file
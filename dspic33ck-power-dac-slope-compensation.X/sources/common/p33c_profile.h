@@ -0,0 +1,121 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/*@@p33c_profile.h
+ * ************************************************************************************************
+ * Summary:
+ * Generic Cycle-Count Profiler (header file)
+ *
+ * Description:
+ * This header file declares the instrumentation macros and the region table of the cycle-count
+ * profiler. Code regions are enclosed by P33C_PROFILE_BEGIN() and P33C_PROFILE_END(). The 
+ * execution time of every pass is measured in instruction cycles of the free-running SCCP1 
+ * timer and recorded as minimum, maximum, mean and log2 histogram in the RAM table p33c_profile,
+ * which can be read by a debugger watch window (see watch-profiler.xwatch). In host builds the 
+ * SCCP1 timer register reads the monotonic clock of the host in units of 10 ns.
+ * 
+ * Regions are not reentrant: a region must not be entered by interrupt service routines when
+ * it is instrumented in the main context as well. Nested regions of different ids are allowed;
+ * the outer region includes the recording time of the inner region.
+ *
+ * See Also:
+ *	p33c_profile.c
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef P33C_PROFILER_H
+#define	P33C_PROFILER_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#ifndef P33C_PROFILE_ENABLE
+#define P33C_PROFILE_ENABLE         1       // 1 = instrumentation macros are compiled, 0 = instrumentation macros are empty
+#endif
+
+#define P33C_PROFILE_HISTOGRAM_SIZE 16U     // Number of log2 histogram bins; bin n counts passes of 2^n ... 2^(n+1)-1 cycles (bin 0: 0 ... 1)
+#define P33C_PROFILE_CALIBRATION    16U     // Number of empty regions measured to determine the instrumentation overhead
+#define P33C_PROFILE_TICK_NS        10U     // Profiler timer period in [ns] (FCY = 100 MHz)
+
+#define P33C_PROFILE_TIMER_READ()   ((uint16_t)CCP1TMRL) // Free-running 16-bit profiler timer
+
+/* Instrumented code regions */
+enum P33C_PROFILE_ID_e {
+    P33C_PROFILE_PWMGEN_WRITE = 0,  // p33c_PwmGenerator_ConfigWrite()
+    P33C_PROFILE_PWMGEN_WRITE_REF,  // p33c_PwmGenerator_ConfigWriteRef()
+    P33C_PROFILE_DAC_WRITE,         // p33c_DacInstance_ConfigWrite()
+    P33C_PROFILE_DAC_WRITE_REF,     // p33c_DacInstance_ConfigWriteRef()
+    P33C_PROFILE_DAC_INITIALIZE,    // DAC_Initialize()
+    P33C_PROFILE_MAIN_LOOP,         // Main loop body: all tasks of one scheduler tick (without idle time)
+    P33C_PROFILE_TELEMETRY_PUSH,    // TELEMETRY_Record(): telemetry frame push of the 1 ms task
+    P33C_PROFILE_REGION_COUNT       // Number of instrumented code regions
+};
+typedef enum P33C_PROFILE_ID_e P33C_PROFILE_ID_t;
+
+/* Statistics of one code region */
+struct P33C_PROFILE_REGION_s {
+    uint16_t start;         // Timer value at region entry
+    uint16_t min;           // Minimum execution time in [cycles]
+    uint16_t max;           // Maximum execution time in [cycles]
+    uint16_t mean;          // Mean execution time in [cycles], updated by p33c_Profile_Update()
+    uint32_t count;         // Number of recorded passes (halved together with sum before overflow)
+    uint32_t sum;           // Sum of all recorded execution times in [cycles]
+    uint16_t histogram[P33C_PROFILE_HISTOGRAM_SIZE]; // log2 histogram of the execution times (saturating)
+};
+typedef struct P33C_PROFILE_REGION_s P33C_PROFILE_REGION_t;
+
+/* Profiler region table */
+struct P33C_PROFILE_s {
+    uint16_t overhead;      // Execution time of an empty region subtracted from every pass in [cycles]
+    struct P33C_PROFILE_REGION_s region[P33C_PROFILE_REGION_COUNT]; // Region statistics
+};
+typedef struct P33C_PROFILE_s P33C_PROFILE_t;
+
+/* ********************************************************************************************* * 
+ * INSTRUMENTATION MACROS
+ * ********************************************************************************************* */
+
+#if (P33C_PROFILE_ENABLE)
+  #define P33C_PROFILE_BEGIN(id)    { p33c_profile.region[(id)].start = P33C_PROFILE_TIMER_READ(); }
+  #define P33C_PROFILE_END(id)      { p33c_Profile_Record((id), \
+                                        (uint16_t)(P33C_PROFILE_TIMER_READ() - p33c_profile.region[(id)].start)); }
+#else
+  #define P33C_PROFILE_BEGIN(id)    { }
+  #define P33C_PROFILE_END(id)      { }
+#endif
+
+/* ********************************************************************************************* * 
+ * API FUNCTION PROTOTYPES
+ * ********************************************************************************************* */
+
+extern struct P33C_PROFILE_s p33c_profile;
+
+extern volatile uint16_t p33c_Profile_Initialize(void);
+extern void p33c_Profile_Record(uint16_t id, uint16_t cycles);
+extern volatile uint16_t p33c_Profile_Update(void);
+
+
+#endif	/* P33C_PROFILER_H */
+// END OF FILE
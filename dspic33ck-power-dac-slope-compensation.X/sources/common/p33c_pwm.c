@@ -26,7 +26,7 @@
 #include <stddef.h> // include standard definition data types
 
 #include "p33c_pwm.h"
-
+#include "p33c_profile.h"
 
 /* @@p33c_PwmModule_Initialize
  * ********************************************************************************
@@ -57,7 +57,7 @@ volatile uint16_t p33c_PwmModule_Initialize(void)
 {
     volatile uint16_t retval=1;
     
-    retval = p33c_PwmModule_ConfigWrite(pwmConfigDefault);
+    retval = p33c_PwmModule_ConfigWriteRef(&pwmConfigDefault);
     
     return(retval);
 }
@@ -91,7 +91,7 @@ volatile uint16_t p33c_PwmModule_Dispose(void)
 {
     volatile uint16_t retval=1;
     
-    retval = p33c_PwmModule_ConfigWrite(pwmConfigClear);
+    retval = p33c_PwmModule_ConfigWriteRef(&pwmConfigClear);
     
     return(retval);
 }
@@ -165,6 +165,92 @@ volatile uint16_t p33c_PwmModule_ConfigWrite(volatile struct P33C_PWM_MODULE_s p
     
 }
 
+/* @@p33c_PwmModule_ConfigReadRef
+ * ********************************************************************************
+ * Summary:
+ *     Reads the current PWM base module configuration into a user variable
+ * 
+ * Parameters:
+ *     struct P33C_PWM_MODULE_s* pwmConfig:
+ *          Pointer to the register image receiving the PWM module configuration
+ * 
+ * Returns:
+ *     0 = failure, reading PWM module was not successful
+ *     1 = success, reading PWM module was successful
+ * 
+ * Description:
+ *     This function copies all PWM module base registers directly into the 
+ *     register image referenced by pwmConfig. In contrast to function
+ *     p33c_PwmModule_ConfigRead(), the register set is not returned by value
+ *     and therefore not copied through the stack.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_PwmModule_ConfigReadRef(struct P33C_PWM_MODULE_s* pwmConfig)
+{
+    volatile uint16_t* sfr;
+    uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer protection
+    if (pwmConfig == NULL)
+        return(0);
+
+    // Set pointers to PWM module base registers and user register image
+    sfr = (volatile uint16_t*)p33c_PwmModule_GetHandle();
+    img = (uint16_t*)pwmConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_PWM_MODULE_s) / sizeof(uint16_t)); i++)
+        img[i] = sfr[i];
+    
+    return(1);
+    
+}
+
+/* @@p33c_PwmModule_ConfigWriteRef
+ * ********************************************************************************
+ * Summary:
+ *     Writes a user-defined configuration to the PWM base module registers
+ * 
+ * Parameters:
+ *     const volatile struct P33C_PWM_MODULE_s* pwmConfig:
+ *          Pointer to the register image holding the PWM module configuration
+ * 
+ * Returns:
+ *     0 = failure, writing PWM module was not successful
+ *     1 = success, writing PWM module was successful
+ * 
+ * Description:
+ *     This function writes the PWM module configuration referenced by pwmConfig
+ *     directly to the PWM module base registers. In contrast to function
+ *     p33c_PwmModule_ConfigWrite(), the register image is not passed by value
+ *     and therefore not copied through the stack before being written.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_PwmModule_ConfigWriteRef(const volatile struct P33C_PWM_MODULE_s* pwmConfig)
+{
+    volatile uint16_t* sfr;
+    const volatile uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer protection
+    if (pwmConfig == NULL)
+        return(0);
+
+    // Set pointers to PWM module base registers and user register image
+    sfr = (volatile uint16_t*)p33c_PwmModule_GetHandle();
+    img = (const volatile uint16_t*)pwmConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_PWM_MODULE_s) / sizeof(uint16_t)); i++)
+        sfr[i] = img[i];
+    
+    return(1);
+    
+}
+
 /* @@p33c_PwmGenerator_ConfigWrite
  * ********************************************************************************
  * Summary:
@@ -228,15 +314,215 @@ volatile uint16_t p33c_PwmGenerator_ConfigWrite(
     volatile uint16_t retval=1;
     volatile struct P33C_PWM_GENERATOR_s* pg;    
 
+    P33C_PROFILE_BEGIN(P33C_PROFILE_PWMGEN_WRITE);
+    
     // Set pointer to memory address of desired PWM instance
     pg = (volatile struct P33C_PWM_GENERATOR_s*) 
         ((volatile uint8_t*) &PG1CONL + ((pgInstance - 1) * P33C_PWMGEN_SFR_OFFSET));
     *pg = pgConfig;
     
+    P33C_PROFILE_END(P33C_PROFILE_PWMGEN_WRITE);
+    
     return(retval);
     
 }
 
+/* @@p33c_PwmGenerator_ConfigReadRef
+ * ********************************************************************************
+ * Summary:
+ *     Reads the current configuration of a given PWM generator into a user variable
+ * 
+ * Parameters:
+ *     uint16_t pgInstance:
+ *          Instance of the PWM generator (e.g. 1 = PG1, 2=PG2, etc.)
+ *     struct P33C_PWM_GENERATOR_s* pgConfig:
+ *          Pointer to the register image receiving the PWM generator configuration
+ * 
+ * Returns:
+ *     0 = failure, reading PWM generator was not successful
+ *     1 = success, reading PWM generator was successful
+ * 
+ * Description:
+ *     This function copies all registers of the specified PWM generator instance 
+ *     (e.g. PG2) directly into the register image referenced by pgConfig. In 
+ *     contrast to function p33c_PwmGenerator_ConfigRead(), the register set is 
+ *     not returned by value and therefore not copied through the stack.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_PwmGenerator_ConfigReadRef(
+        uint16_t pgInstance, 
+        struct P33C_PWM_GENERATOR_s* pgConfig
+)
+{
+    volatile uint16_t* sfr;
+    uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer and instance range protection
+    if ((pgConfig == NULL) || (pgInstance == 0) || (pgInstance > P33C_PG_COUNT))
+        return(0);
+
+    // Set pointers to memory address of desired PWM instance and user register image
+    sfr = (volatile uint16_t*)p33c_PwmGenerator_GetHandle(pgInstance);
+    img = (uint16_t*)pgConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_PWM_GENERATOR_s) / sizeof(uint16_t)); i++)
+        img[i] = sfr[i];
+    
+    return(1);
+    
+}
+
+/* @@p33c_PwmGenerator_ConfigWriteRef
+ * ********************************************************************************
+ * Summary:
+ *     Writes a user-defined configuration to a given PWM generator
+ * 
+ * Parameters:
+ *     uint16_t pgInstance:
+ *          Instance of the PWM generator (e.g. 1 = PG1, 2=PG2, etc.)
+ *     const volatile struct P33C_PWM_GENERATOR_s* pgConfig:
+ *          Pointer to the register image holding the PWM generator configuration
+ * 
+ * Returns:
+ *     0 = failure, writing PWM generator was not successful
+ *     1 = success, writing PWM generator was successful
+ * 
+ * Description:
+ *     This function writes the PWM generator configuration referenced by pgConfig
+ *     directly to the given PWM generator peripheral instance (e.g. PG2). In 
+ *     contrast to function p33c_PwmGenerator_ConfigWrite(), the register image 
+ *     is not passed by value and therefore not copied through the stack before
+ *     being written. This makes this function the preferred choice for restoring
+ *     a PWM generator configuration at runtime, e.g. when re-arming a power stage 
+ *     after a fault.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_PwmGenerator_ConfigWriteRef(
+        uint16_t pgInstance, 
+        const volatile struct P33C_PWM_GENERATOR_s* pgConfig
+)
+{
+    volatile uint16_t* sfr;
+    const volatile uint16_t* img;
+    uint16_t i;
+
+    // Null-pointer and instance range protection
+    if ((pgConfig == NULL) || (pgInstance == 0) || (pgInstance > P33C_PG_COUNT))
+        return(0);
+
+    P33C_PROFILE_BEGIN(P33C_PROFILE_PWMGEN_WRITE_REF);
+    
+    // Set pointers to memory address of desired PWM instance and user register image
+    sfr = (volatile uint16_t*)p33c_PwmGenerator_GetHandle(pgInstance);
+    img = (const volatile uint16_t*)pgConfig;
+
+    // Copy register set word by word
+    for (i = 0; i < (sizeof(struct P33C_PWM_GENERATOR_s) / sizeof(uint16_t)); i++)
+        sfr[i] = img[i];
+    
+    P33C_PROFILE_END(P33C_PROFILE_PWMGEN_WRITE_REF);
+    
+    return(1);
+    
+}
+
+/* @@p33c_PwmGenerator_ConfigWriteDelta
+ * ********************************************************************************
+ * Summary:
+ *     Writes only those registers of a PWM generator which differ from a shadow copy
+ * 
+ * Parameters:
+ *     uint16_t pgInstance:
+ *          Instance of the PWM generator (e.g. 1 = PG1, 2=PG2, etc.)
+ *     const volatile struct P33C_PWM_GENERATOR_s* pgConfig:
+ *          Pointer to the register image holding the new PWM generator configuration
+ *     struct P33C_PWM_GENERATOR_s* pgShadow:
+ *          Pointer to the shadow copy of the last configuration written to pgInstance
+ * 
+ * Returns:
+ *     n = number of PWM generator registers which have been written
+ *         (0 = no changes or invalid parameters)
+ * 
+ * Description:
+ *     This function compares the new PWM generator configuration referenced by 
+ *     pgConfig word by word with the shadow copy referenced by pgShadow. Only 
+ *     registers whose value differs from the shadow copy are written to the given 
+ *     PWM generator and updated in the shadow copy. All other registers are not
+ *     accessed. When only single timing registers like PGxDC, PGxTRIGB or PGxTRIGC 
+ *     change at runtime, this reduces the number of SFR bus writes from the full 
+ *     register set to the number of registers actually changed.
+ * 
+ *     The shadow copy is owned by the caller. It has to be initialized with the
+ *     current register contents, e.g. by calling p33c_PwmGenerator_ConfigReadRef(),
+ *     before this function is called for the first time. Registers changed by 
+ *     other functions after this point are not tracked by the shadow copy.
+ * 
+ *     PGxSTAT and PGxCAP are excluded from the comparison and from the shadow 
+ *     copy. PGxSTAT holds status bits maintained by hardware, including the 
+ *     self-clearing UPDREQ bit, and PGxCAP is read-only. Writing them from a 
+ *     register image would overwrite live status or latch a stale UPDREQ=1 in 
+ *     the shadow copy, which would suppress every later identical request.
+ * 
+ *     Please note:
+ *     Timing registers (PGxPHASE through PGxDTH) are transferred to the PWM 
+ *     generator at the next update event. When at least one of them has been 
+ *     written, this function sets the UPDREQ bit after the last timing register 
+ *     write, so the new values are always transferred as one consistent set.
+ * 
+ * ********************************************************************************/
+
+#define P33C_PWM_DELTA_IDX(reg) (uint16_t)(offsetof(struct P33C_PWM_GENERATOR_s, reg) / sizeof(uint16_t))
+
+volatile uint16_t p33c_PwmGenerator_ConfigWriteDelta(
+        uint16_t pgInstance, 
+        const volatile struct P33C_PWM_GENERATOR_s* pgConfig,
+        struct P33C_PWM_GENERATOR_s* pgShadow
+)
+{
+    volatile uint16_t* sfr;
+    const volatile uint16_t* img;
+    uint16_t* shd;
+    uint16_t i, count=0, timing=0;
+
+    // Null-pointer and instance range protection
+    if ((pgConfig == NULL) || (pgShadow == NULL) || 
+        (pgInstance == 0) || (pgInstance > P33C_PG_COUNT))
+        return(0);
+
+    // Set pointers to PWM instance registers, new register image and shadow copy
+    sfr = (volatile uint16_t*)p33c_PwmGenerator_GetHandle(pgInstance);
+    img = (const volatile uint16_t*)pgConfig;
+    shd = (uint16_t*)pgShadow;
+
+    // Only write registers which have changed, skipping status and capture registers
+    for (i = 0; i < (sizeof(struct P33C_PWM_GENERATOR_s) / sizeof(uint16_t)); i++)
+    {
+        if ((i == P33C_PWM_DELTA_IDX(PGxSTAT)) || (i == P33C_PWM_DELTA_IDX(PGxCAP)))
+            continue;
+        
+        if (img[i] != shd[i])
+        {
+            sfr[i] = img[i];
+            shd[i] = img[i];
+            count++;
+            
+            if (i >= P33C_PWM_DELTA_IDX(PGxPHASE))
+                timing++;
+        }
+    }
+    
+    // Request the transfer of the new timing register set at the next update event
+    if (timing > 0)
+        ((volatile struct P33C_PWM_GENERATOR_s*)sfr)->PGxSTAT.bits.UPDREQ = 1;
+    
+    return(count);
+    
+}
+
 /* @@p33c_PwmGenerator_Initialize
  * ********************************************************************************
  * Summary:
@@ -271,7 +557,7 @@ volatile uint16_t p33c_PwmGenerator_Initialize(volatile uint16_t pgInstance)
     retval &= p33c_PwmGenerator_Disable(pg);
 
     // Reset all SFRs to default
-    p33c_PwmGenerator_ConfigWrite(pgInstance, pgConfigClear);
+    p33c_PwmGenerator_ConfigWriteRef(pgInstance, &pgConfigClear);
     
     /* PWM GENERATOR CONTROL REGISTER LOW */
     pg->PGxCONL.bits.ON = 0;         // Disable PWM generator
@@ -308,7 +594,7 @@ volatile uint16_t p33c_PwmGenerator_Dispose(volatile uint16_t pgInstance)
     volatile uint16_t retval=1;
     
     // Clear all registers of pgInstance
-    p33c_PwmGenerator_ConfigWrite(pgInstance, pgConfigClear);
+    p33c_PwmGenerator_ConfigWriteRef(pgInstance, &pgConfigClear);
     
     return(retval);
 }
@@ -319,25 +605,103 @@ volatile uint16_t p33c_PwmGenerator_Dispose(volatile uint16_t pgInstance)
  *     Enables a given PWM generator with output pins disabled
  * 
  * Parameters:
- *     volatile uint16_t pgInstance:
- *          Instance of the PWM generator (e.g. 1 = PG1, 2=PG2, etc.)
+ *     volatile struct P33C_PWM_GENERATOR_s* pg:
+ *          Pointer to the PWM generator instance SFR set
  * 
  * Returns:
  *     0 = failure, enabling PWM generator was not successful
  *     1 = success, enabling PWM generator was successful
  * 
  * Description:
- *     This function enables the PWM Generator and adds delay before enabling  
- *     PWM output pins. After having successfully enabled the generator,
+ *     This function enables the PWM Generator and waits up to 
+ *     P33C_PWM_ENABLE_TIMEOUT_US for the high resolution PWM clock before 
+ *     enabling PWM output pins. After having successfully enabled the generator,
  *     users need to call function PWM_Generator_Resume to allow the PWM 
- *     generator 
+ *     generator to drive its outputs. The non-blocking functions 
+ *     p33c_PwmGenerator_EnableStart() and p33c_PwmGenerator_EnablePoll() 
+ *     allow enabling multiple generators at the same time.
  * 
  * ********************************************************************************/
 
 volatile uint16_t p33c_PwmGenerator_Enable(volatile struct P33C_PWM_GENERATOR_s* pg)
 {
-    volatile uint16_t retval=1;
-    volatile uint16_t timeout=0;
+    struct P33C_PWM_ENABLE_s request;
+    
+    if (!p33c_PwmGenerator_EnableStart(&request, pg, P33C_PWM_ENABLE_TIMEOUT_US, NULL))
+        return(0);
+    
+    while (p33c_PwmGenerator_EnablePoll(&request) == P33C_PWM_ENABLE_PENDING);
+    
+    return(request.state == P33C_PWM_ENABLE_READY);
+    
+}
+
+// Starts the free-running enable timeout timer (SCCP1) unless it is already running
+static void p33c_PwmTimer_Start(void)
+{
+    if (CCP1CON1Lbits.CCPON)
+        return;
+    
+    // SCCP1: 16-bit timer, FCY clock input, 1:1 prescaler, period 0xFFFF (see p33c_Profile_Initialize())
+    CCP1CON1L = 0x0000;
+    CCP1PRL = 0xFFFF;
+    CCP1CON1Lbits.CCPON = 1;
+}
+
+// Returns the period of the enable timeout timer of the current system clock in [ns]
+static uint16_t p33c_PwmTimer_GetTickNs(void)
+{
+    uint16_t cosc = OSCCONbits.COSC;
+    
+    // FRCPLL or PRIPLL
+    return(((cosc == 0b001) || (cosc == 0b011)) ? P33C_PWM_TICK_NS_PLL : P33C_PWM_TICK_NS_FRC);
+}
+
+/* @@p33c_PwmGenerator_EnableStart
+ * ********************************************************************************
+ * Summary:
+ *     Turns on a given PWM generator without waiting for the PWM clock
+ * 
+ * Parameters:
+ *     struct P33C_PWM_ENABLE_s* request:
+ *          Enable request object, owned by the driver until completion
+ *     volatile struct P33C_PWM_GENERATOR_s* pg:
+ *          Pointer to the PWM generator instance SFR set
+ *     uint16_t timeout_us:
+ *          Time granted to the high resolution PWM clock to become ready in [us]
+ *     P33C_PWM_ENABLE_CALLBACK_t callback:
+ *          Function called on completion of the request (NULL = none)
+ * 
+ * Returns:
+ *     0 = failure, invalid request object or PWM generator
+ *     1 = success, request started
+ * 
+ * Description:
+ *     The output pins of the PWM generator are overridden and assigned to the
+ *     I/O module before the generator is turned on and an update of its timing
+ *     registers is requested. A PWM generator operating in High-Resolution mode
+ *     remains in this state until p33c_PwmGenerator_EnablePoll() has detected 
+ *     the ready high resolution PWM clock. The request of a generator in 
+ *     standard resolution mode is completed immediately.
+ * 
+ * ********************************************************************************/
+
+uint16_t p33c_PwmGenerator_EnableStart(struct P33C_PWM_ENABLE_s* request,
+            volatile struct P33C_PWM_GENERATOR_s* pg, uint16_t timeout_us, 
+            P33C_PWM_ENABLE_CALLBACK_t callback)
+{
+    // Null-pointer protection
+    if ((request == NULL) || (pg == NULL))
+        return(0);
+    
+    request->pg = pg;
+    request->callback = callback;
+    request->elapsed_ns = 0;
+    request->timeout_ns = (uint32_t)timeout_us * 1000UL;
+    p33c_PwmTimer_Start();
+    request->tick_ns = p33c_PwmTimer_GetTickNs();
+    request->last = P33C_PWM_TIMER_READ();
+    request->state = P33C_PWM_ENABLE_PENDING;
     
     // Set PWM generator override bits to prevent signals being generated outside the device
     pg->PGxIOCONL.bits.OVRENH = 1;
@@ -352,21 +716,89 @@ volatile uint16_t p33c_PwmGenerator_Enable(volatile struct P33C_PWM_GENERATOR_s*
     
     // enforce update of timing registers
     pg->PGxSTAT.bits.UPDREQ = 1;
-   
-    // If high resolution mode is enabled, check if clock has locked in without errors
-    if(pg->PGxCONL.bits.HREN)
+    
+    // Standard resolution mode does not depend on the high resolution PWM clock
+    if (!pg->PGxCONL.bits.HREN)
     {
-        while((!PCLKCONbits.HRRDY) && (timeout++<5000));
-         if ((timeout >= 5000) || (PCLKCONbits.HRERR)) // if there is an error
-            return(0);  // return ERROR     
-        
+        pg->PGxIOCONH.bits.PENH = 1;
+        pg->PGxIOCONH.bits.PENL = 1;
+        request->state = P33C_PWM_ENABLE_READY;
+        if (request->callback != NULL)
+            request->callback(request);
     }
     
-    // Assign GPIO ownership to given PWM generator 
-    pg->PGxIOCONH.bits.PENH = 1;
-    pg->PGxIOCONH.bits.PENL = 1;
+    return(1);
     
-    return(retval);       
+}
+
+/* @@p33c_PwmGenerator_EnablePoll
+ * ********************************************************************************
+ * Summary:
+ *     Advances a pending PWM generator enable request
+ * 
+ * Parameters:
+ *     struct P33C_PWM_ENABLE_s* request:
+ *          Enable request object started by p33c_PwmGenerator_EnableStart()
+ * 
+ * Returns:
+ *     State of the request (P33C_PWM_ENABLE_STATE_t)
+ * 
+ * Description:
+ *     When the high resolution PWM clock is ready, the output pins are assigned
+ *     to the PWM generator and the request is completed. A clock error or an 
+ *     expired timeout terminate the request, leaving the output pins under I/O 
+ *     module control. The completion callback is called by the poll call 
+ *     detecting the completion. Completed requests are not changed.
+ * 
+ * ********************************************************************************/
+
+uint16_t p33c_PwmGenerator_EnablePoll(struct P33C_PWM_ENABLE_s* request)
+{
+    uint16_t now, tick_ns, tick_min;
+    
+    // Null-pointer protection
+    if (request == NULL)
+        return(P33C_PWM_ENABLE_IDLE);
+    
+    if (request->state != P33C_PWM_ENABLE_PENDING)
+        return(request->state);
+    
+    // An interval spanning a clock switch is counted with the shorter timer period;
+    // the system clock is sampled before and after the timer read, as the clock
+    // switch may complete in between
+    tick_min = p33c_PwmTimer_GetTickNs();
+    now = P33C_PWM_TIMER_READ();
+    tick_ns = p33c_PwmTimer_GetTickNs();
+    if (tick_ns < tick_min) tick_min = tick_ns;
+    if (request->tick_ns < tick_min) tick_min = request->tick_ns;
+    request->elapsed_ns += (uint32_t)((uint16_t)(now - request->last)) * tick_min;
+    request->last = now;
+    request->tick_ns = tick_ns;
+    
+    if (PCLKCONbits.HRERR)
+    {
+        request->state = P33C_PWM_ENABLE_ERROR;
+    }
+    else if (PCLKCONbits.HRRDY)
+    {
+        // Assign GPIO ownership to given PWM generator 
+        request->pg->PGxIOCONH.bits.PENH = 1;
+        request->pg->PGxIOCONH.bits.PENL = 1;
+        request->state = P33C_PWM_ENABLE_READY;
+    }
+    else if (request->elapsed_ns >= request->timeout_ns)
+    {
+        request->state = P33C_PWM_ENABLE_TIMEOUT;
+    }
+    else
+    {
+        return(P33C_PWM_ENABLE_PENDING);
+    }
+    
+    if (request->callback != NULL)
+        request->callback(request);
+    
+    return(request->state);
     
 }
  
@@ -594,7 +1026,7 @@ volatile uint16_t p33c_PwmGenerator_GetInstance(volatile struct P33C_PWM_GENERAT
 
     // Capture Instance: set pointer to memory address of desired PWM instance
     retval = (volatile uint16_t)
-        (((volatile uint16_t)&pg->PGxCONL - (volatile uint16_t)&PG1CONL) / P33C_PWMGEN_SFR_OFFSET) + 1;
+        (((volatile uint8_t*)&pg->PGxCONL - (volatile uint8_t*)&PG1CONL) / P33C_PWMGEN_SFR_OFFSET) + 1;
             
     if (retval > P33C_PG_COUNT)
         return(0); // PWM generator not member of a valid group 
@@ -613,7 +1045,7 @@ volatile uint16_t p33c_PwmGenerator_GetGroup(volatile struct P33C_PWM_GENERATOR_
 
     // Get group of PWM generator
     pgInstance = (volatile uint16_t)
-        (((volatile uint16_t)&pg->PGxCONL - (volatile uint16_t)&PG1CONL) / P33C_PWMGEN_SFR_OFFSET + 1);
+        (((volatile uint8_t*)&pg->PGxCONL - (volatile uint8_t*)&PG1CONL) / P33C_PWMGEN_SFR_OFFSET + 1);
     
     // Verify PWM generator group is valid and available
     if (pgInstance > P33C_PG_COUNT)
@@ -626,9 +1058,97 @@ volatile uint16_t p33c_PwmGenerator_GetGroup(volatile struct P33C_PWM_GENERATOR_
     return(retval);
 }
 
+/* @@p33c_PwmGenerator_GetSyncRoute
+ * ********************************************************************************
+ * Summary:
+ *     Determines the synchronization route between two PWM generators
+ * 
+ * Parameters:
+ *   uint16_t pgCount:
+ *      Number of PWM generators of the device (P33C_PG_COUNT)
+ * 
+ *   uint16_t pgMotherInstance:
+ *      Instance of the triggering PWM generator (sync trigger provider)
+ * 
+ *   uint16_t pgMotherTriggerOutput:
+ *      Trigger output selection of sync trigger provider PWM generator
+ *          0 = EOC/SOC
+ *          1 = PGxTRIGA
+ *          2 = PGxTRIGB
+ *          3 = PGxTRIGC
+ * 
+ *   uint16_t pgChildInstance:
+ *      Instance of the triggered PWM generator (sync trigger receiver)
+ * 
+ *   struct P33C_PWM_SYNC_ROUTE_s* route:
+ *      Pointer to the route descriptor receiving the result
+ * 
+ * Returns:
+ *     0 = failure, the PWM generators cannot be synchronized
+ *     1 = success, the route descriptor has been filled in
+ * 
+ * Description:
+ *      This function validates the PWM generator instances and the trigger
+ *      output and returns the register settings and the estimated propagation
+ *      delay of the synchronization route without accessing any register.
+ *      PWM generators of the same group are synchronized directly (SOCS), 
+ *      PWM generators of different groups through the PCI Sync function of
+ *      the child PWM generator, which is driven by the PWM output of the 
+ *      mother PWM generator rather than by its trigger output. A PWM generator 
+ *      cannot be synchronized to itself. On failure, the route of the 
+ *      descriptor is P33C_PWM_SYNC_NONE.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_PwmGenerator_GetSyncRoute(
+                            volatile uint16_t pgCount,
+                            volatile uint16_t pgMotherInstance, 
+                            volatile uint16_t pgMotherTriggerOutput,
+                            volatile uint16_t pgChildInstance,
+                            struct P33C_PWM_SYNC_ROUTE_s* route
+    )
+{
+    // Null-pointer protection
+    if (route == NULL)
+        return(0);
+    
+    route->route = P33C_PWM_SYNC_NONE;
+    route->mother = pgMotherInstance;
+    route->child = pgChildInstance;
+    route->trigger = pgMotherTriggerOutput;
+    route->socs = 0b0000;
+    route->pwmpci = 0b000;
+    route->delay = 0;
+    
+    // Verify PWM generator instances and trigger output are valid
+    if ((pgMotherInstance == 0) || (pgMotherInstance > pgCount) || (pgMotherInstance > P33C_PG_COUNT) ||
+        (pgChildInstance == 0) || (pgChildInstance > pgCount) || (pgChildInstance > P33C_PG_COUNT) ||
+        (pgMotherInstance == pgChildInstance) || (pgMotherTriggerOutput > 0b011))
+        return(0);
+    
+    if (((pgMotherInstance - 1) >> 2) == ((pgChildInstance - 1) >> 2))
+    {
+        // Both PWM generators are member of the same group: direct synchronization
+        route->route = P33C_PWM_SYNC_DIRECT;
+        route->socs = (((pgMotherInstance - 1) & 0x0003) + 1);
+        route->delay = P33C_PWM_SYNC_DELAY_DIRECT;
+    }
+    else
+    {
+        // Synchronization across PWM generator groups is routed through the PCI Sync function
+        route->route = P33C_PWM_SYNC_PCI;
+        route->socs = 0b1111;
+        route->pwmpci = (pgMotherInstance - 1);
+        route->delay = P33C_PWM_SYNC_DELAY_PCI;
+    }
+    
+    return(1);
+}
+
 /* @@p33c_PwmGenerator_SyncGenerators
  * ********************************************************************************
  * Summary:
+ *     Synchronizes a child PWM generator to the trigger output of a mother PWM generator
  * 
  * Parameters:
  *   struct P33C_PWM_GENERATOR_s pgHandleMother:
@@ -649,8 +1169,63 @@ volatile uint16_t p33c_PwmGenerator_GetGroup(volatile struct P33C_PWM_GENERATOR_
  *          false = synchronization trigger synchronizes Child PWM generator at EOC/SOC
  * 
  * Returns:
- *     0 = failure, disabling PWM generator was not successful
- *     1 = success, disabling PWM generator was successful
+ *     0 = failure, the PWM generators cannot be synchronized, no register has been changed
+ *     1 = success, synchronization has been configured
+ * 
+ * Description:
+ *      This function configures the synchronization of two PWM generators
+ *      by calling p33c_PwmGenerator_SyncGeneratorsRoute() without route 
+ *      descriptor. Use p33c_PwmGenerator_SyncGeneratorsRoute() when the 
+ *      selected route and its propagation delay are required.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t p33c_PwmGenerator_SyncGenerators(
+                            volatile struct P33C_PWM_GENERATOR_s* pgHandleMother, 
+                            volatile uint16_t pgMotherTriggerOutput,
+                            volatile struct P33C_PWM_GENERATOR_s* pgHandleChild,
+                            volatile bool ChildImmediateUpdate
+    )
+{
+    volatile uint16_t retval=1;
+    
+    retval &= p33c_PwmGenerator_SyncGeneratorsRoute(pgHandleMother, pgMotherTriggerOutput,
+                            pgHandleChild, ChildImmediateUpdate, NULL);
+    
+    return(retval);
+}
+
+/* @@p33c_PwmGenerator_SyncGeneratorsRoute
+ * ********************************************************************************
+ * Summary:
+ *     Synchronizes a child PWM generator to the trigger output of a mother PWM generator
+ *     and returns the selected synchronization route
+ * 
+ * Parameters:
+ *   struct P33C_PWM_GENERATOR_s pgHandleMother:
+ *      PWM generator object of triggering PWM generator (sync trigger provider)
+ * 
+ *   uint16_t pgMotherTriggerOutput:
+ *      Trigger output selection of sync trigger provider PWM generator
+ *          0 = EOC/SOC
+ *          1 = PGxTRIGA
+ *          2 = PGxTRIGB
+ *          3 = PGxTRIGC
+ *      
+ *   struct P33C_PWM_GENERATOR_s pgHandleChild
+ *      PWM generator object of triggered PWM generator (sync trigger receiver)
+ * 
+ *   bool EnableImmesiate
+ *          true = synchronization trigger synchronizes Child PWM generator at trigger edge
+ *          false = synchronization trigger synchronizes Child PWM generator at EOC/SOC
+ * 
+ *   struct P33C_PWM_SYNC_ROUTE_s* route
+ *      Pointer to a route descriptor receiving the selected synchronization 
+ *      route and its expected propagation delay (optional, may be NULL)
+ * 
+ * Returns:
+ *     0 = failure, the PWM generators cannot be synchronized, no register has been changed
+ *     1 = success, synchronization has been configured
  * 
  * Description:
  *      This function sets the synchronization triggers of two PWM generators, 
@@ -667,30 +1242,43 @@ volatile uint16_t p33c_PwmGenerator_GetGroup(volatile struct P33C_PWM_GENERATOR_
  *      of immediate synchronization or synchronization of the SOC event is set 
  *      by parameter ChildImmediateUpdate.
  * 
+ *      The route is determined by p33c_PwmGenerator_GetSyncRoute(). When the 
+ *      PWM generators are members of different groups, the PCI Sync function
+ *      of the Child PWM generator is used. PWMPCI routes the PWM output of the
+ *      Mother PWM generator to the PCI logic of the Child, which is then 
+ *      started by the PWMxH rising edge of the Mother; the selected trigger 
+ *      output only applies to the direct route. Callers placing the trigger 
+ *      event of the Mother PWM generator at a specific point in time have to 
+ *      compensate the delay returned in the route descriptor. The delays 
+ *      (P33C_PWM_SYNC_DELAY_DIRECT/PCI) are unmeasured estimates.
+ * 
  * ********************************************************************************/
 
-volatile uint16_t p33c_PwmGenerator_SyncGenerators(
+volatile uint16_t p33c_PwmGenerator_SyncGeneratorsRoute(
                             volatile struct P33C_PWM_GENERATOR_s* pgHandleMother, 
                             volatile uint16_t pgMotherTriggerOutput,
                             volatile struct P33C_PWM_GENERATOR_s* pgHandleChild,
-                            volatile bool ChildImmediateUpdate
+                            volatile bool ChildImmediateUpdate,
+                            struct P33C_PWM_SYNC_ROUTE_s* route
     )
 {
     volatile uint16_t retval=1;
-    volatile uint16_t pgMotherInstance=0, pgChildInstance=0;
-    volatile uint16_t pgMotherGroup=0, pgChildGroup=0;
-    volatile uint16_t pgInstance;
+    struct P33C_PWM_SYNC_ROUTE_s sync;
     
     // Null-pointer protection
     if ((pgHandleMother == NULL) || (pgHandleChild == NULL))
         return(0);
     
-    // Capture PWM generator instances and groups for given handles
-    pgMotherInstance = p33c_PwmGenerator_GetInstance(pgHandleMother);
-    pgMotherGroup = p33c_PwmGenerator_GetGroup(pgHandleMother);
+    // Capture PWM generator instances and select synchronization route
+    retval = p33c_PwmGenerator_GetSyncRoute(P33C_PG_COUNT, 
+                    p33c_PwmGenerator_GetInstance(pgHandleMother), pgMotherTriggerOutput,
+                    p33c_PwmGenerator_GetInstance(pgHandleChild), &sync);
     
-    pgChildInstance = p33c_PwmGenerator_GetInstance(pgHandleChild);
-    pgChildGroup = p33c_PwmGenerator_GetGroup(pgHandleChild);
+    if (route != NULL)
+        *route = sync;
+    
+    if (!retval)
+        return(0); // Exit if PWM generators cannot be synchronized
     
     // Enable update trigger broadcast in Mother PWM
     // PWM generator broadcasts software set/clear of the UPDREQ status bit and EOC signal
@@ -701,7 +1289,7 @@ volatile uint16_t p33c_PwmGenerator_SyncGenerators(
     // 0b010 = PGxTRIGB compare event is the PWM Generator trigger
     // 0b001 = PGxTRIGA compare event is the PWM Generator trigger
     // 0b000 = EOC event is the PWM Generator trigger
-    pgHandleMother->PGxEVTL.bits.PGTRGSEL = (pgMotherTriggerOutput & 0x0003);  
+    pgHandleMother->PGxEVTL.bits.PGTRGSEL = sync.trigger;  
 
     // Configure child PWM in slaved mode, incorporating immediate of EOC selection
     pgHandleChild->PGxCONH.bits.UPDMOD = (0b010 | ChildImmediateUpdate); // Slaved SOC update 
@@ -722,32 +1310,18 @@ volatile uint16_t p33c_PwmGenerator_SyncGenerators(
     
     */
     
-   if (pgMotherGroup == pgChildGroup)
-   { 
-       // If both PWM generators are member of the same group, 
-       // direct synchronization can be used
-       
-       if (pgMotherGroup == 1)
-           pgHandleChild->PGxCONH.bits.SOCS = pgMotherInstance;
-       else if (pgMotherGroup == 2)
-           pgHandleChild->PGxCONH.bits.SOCS = (pgMotherInstance - 4);
-       else
-           return(0); // Exit if PWM generator group is out of range
-       
-   }
-   else
-   {
+    pgHandleChild->PGxCONH.bits.SOCS = sync.socs;
+    
+    if (sync.route == P33C_PWM_SYNC_PCI)
+    {
         // Synchronization across PWM generator groups need to be routed 
         // through the PCI Sync function 
-        
-        pgInstance = p33c_PwmGenerator_GetInstance(pgHandleChild);
-        
-        pgHandleChild->PGxCONH.bits.SOCS = 0b1111; 
         pgHandleChild->PGxSPCIL.bits.PSS = 0b00001; // Internally connected to the output of PWMPCI[2:0] MUX
-        pgHandleChild->PGxLEBH.bits.PWMPCI = pgInstance; 
+        pgHandleChild->PGxSPCIL.bits.PSYNC = 0;     // PCI source is not synchronized to EOC
+        pgHandleChild->PGxSPCIH.bits.ACP = 0b001;   // Rising-edge acceptance
+        pgHandleChild->PGxLEBH.bits.PWMPCI = sync.pwmpci; // Mother PWM generator is made available to PCI logic
     }
     
-    
     return(retval);       
 
 }
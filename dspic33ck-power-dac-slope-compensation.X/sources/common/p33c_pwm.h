@@ -50,6 +50,8 @@
 #include <stdbool.h> // include standard boolean data types
 #include <stddef.h> // include standard definition data types
 
+#include "p33c_profile.h"
+
 //#ifndef __dsPIC33C__
 //   #error "peripheral driver p33c_pwm.h does not support the selected device"
 //#endif
@@ -322,7 +324,7 @@
     typedef struct P33C_PWM_GENERATOR_s P33C_PWM_GENERATOR_t;
     
     // PWM generator instance Special Function Register set address offset
-    #define P33C_PWMGEN_SFR_OFFSET  ((volatile uint16_t)&PG2CONL - (volatile uint16_t)&PG1CONL)
+    #define P33C_PWMGEN_SFR_OFFSET  ((volatile uint16_t)((volatile uint8_t*)&PG2CONL - (volatile uint8_t*)&PG1CONL))
 
 #endif
 
@@ -333,15 +335,109 @@
 // Macro declaration to access PWM instance data structure memory address
 #if defined (PG8CONL)
 #define P33C_PG_COUNT   8   // Determine number of available PWM generators on the selected device
-#define p33c_PwmGenerator_GetHandle(x)  (P33C_PWM_GENERATOR_t*)&PG1CONL, (P33C_PWM_GENERATOR_t*)&PG2CONL, \
-                                        (P33C_PWM_GENERATOR_t*)&PG3CONL, (P33C_PWM_GENERATOR_t*)&PG4CONL, \
-                                        (P33C_PWM_GENERATOR_t*)&PG5CONL, (P33C_PWM_GENERATOR_t*)&PG6CONL, \
-                                        (P33C_PWM_GENERATOR_t*)&PG7CONL, (P33C_PWM_GENERATOR_t*)&PG8CONL
 #elif defined (PG4CONL)
 #define P33C_PG_COUNT   4   // Determine number of available PWM generators on the selected device
-#define p33c_PwmGenerator_GetHandle(x)  (P33C_PWM_GENERATOR_t*)&PG1CONL, (P33C_PWM_GENERATOR_t*)&PG2CONL, \
-                                        (P33C_PWM_GENERATOR_t*)&PG3CONL, (P33C_PWM_GENERATOR_t*)&PG4CONL
 #endif
+#define p33c_PwmGenerator_GetHandle(x)  ((P33C_PWM_GENERATOR_t*)((volatile uint8_t*)&PG1CONL + \
+                                        (((x) - 1) * P33C_PWMGEN_SFR_OFFSET)))
+
+/* PWM GENERATOR SYNCHRONIZATION ROUTING
+ * =====================================
+ * 
+ * A PWM generator can be triggered by the trigger output (PGTRGSEL) of another 
+ * PWM generator of the same group (PG1-PG4 or PG5-PG8) through its start-of-cycle 
+ * selection (SOCS). PWM generators of different groups can only be synchronized
+ * through the PCI Sync function of the child PWM generator. PWMPCI makes the PWM
+ * output of the mother PWM generator available to the PCI logic of the child, so
+ * the child is started by the PWMxH rising edge of the mother and not by its 
+ * trigger output (PGTRGSEL); moving PGxTRIGA/B/C of the mother has no effect on 
+ * this route.
+ * 
+ * The propagation delays below are ESTIMATES, not measured values: they count the 
+ * register stages of the trigger path in PWM clock cycles (fPGx) from the trigger 
+ * event (direct route) or the PWMxH rising edge (PCI route) of the mother PWM 
+ * generator to the start of cycle of the child PWM generator. The direct route is 
+ * estimated at one PWM clock cycle (start-of-cycle trigger register), the PCI route 
+ * adds the PWMPCI multiplexer register, the two-stage input synchronizer and the 
+ * acceptance edge detector. Both values have to be confirmed on hardware before 
+ * they are used for timing-critical compensation.
+ * 
+ */
+
+#define P33C_PWM_SYNC_DELAY_DIRECT  1U  // Estimated (unmeasured) propagation delay of the direct sync route in [PWM clock cycles]
+#define P33C_PWM_SYNC_DELAY_PCI     5U  // Estimated (unmeasured) propagation delay of the PCI sync route in [PWM clock cycles]
+#define P33C_PWM_HRES_COUNTS        8U  // Timing register counts per PWM clock cycle in High-Resolution mode
+
+enum P33C_PWM_SYNC_ROUTE_e {
+    P33C_PWM_SYNC_NONE   = 0,   // No valid synchronization route
+    P33C_PWM_SYNC_DIRECT = 1,   // Start-of-cycle selection of a PWM generator of the same group
+    P33C_PWM_SYNC_PCI    = 2    // PCI Sync function (PWM generators of different groups)
+};
+typedef enum P33C_PWM_SYNC_ROUTE_e P33C_PWM_SYNC_ROUTE_TYPE_t;
+
+struct P33C_PWM_SYNC_ROUTE_s {
+    uint16_t route;     // Synchronization route (P33C_PWM_SYNC_ROUTE_TYPE_t)
+    uint16_t mother;    // Mother PWM generator instance (sync trigger provider)
+    uint16_t child;     // Child PWM generator instance (sync trigger receiver)
+    uint16_t trigger;   // Trigger output of the mother PWM generator (PGTRGSEL)
+    uint16_t socs;      // Start-of-cycle selection of the child PWM generator (SOCS)
+    uint16_t pwmpci;    // PCI source selection of the child PWM generator (PWMPCI, PCI route only)
+    uint16_t delay;     // Estimated propagation delay from trigger event (PCI: mother PWMxH edge) to child SOC in [PWM clock cycles]
+};
+typedef struct P33C_PWM_SYNC_ROUTE_s P33C_PWM_SYNC_ROUTE_t;
+
+/* NON-BLOCKING PWM GENERATOR ENABLE
+ * =================================
+ * 
+ * A PWM generator operating in High-Resolution mode must not drive its output 
+ * pins before the high resolution PWM clock is ready (PCLKCON.HRRDY). 
+ * p33c_PwmGenerator_EnableStart() turns on the generator with its outputs 
+ * overridden and owned by the I/O module and returns immediately. Each call of 
+ * p33c_PwmGenerator_EnablePoll() checks the PWM clock status: the output pins 
+ * are assigned to the generator as soon as HRRDY is set, the request fails when
+ * HRERR is set or the timeout has expired. The completion callback of the 
+ * request is called once by the poll function. Any number of generators can be
+ * enabled at the same time, each by its own request.
+ * 
+ * Timeouts are given in microseconds and measured with the free-running SCCP1
+ * timer clocked by FCY, which p33c_PwmGenerator_EnableStart() starts if it is not
+ * running yet (it is shared with the profiler, see p33c_profile.c). The timer 
+ * period is derived from the current system clock (OSCCON.COSC) by every poll, 
+ * as requests may be pending during the clock switch from the FRC oscillator to 
+ * the PLL. The interval in which the clock has changed is counted with the 
+ * shorter PLL period, so a timeout never expires early. Pending requests have to 
+ * be polled at least once per timer overflow period (65536 timer ticks, 655 us 
+ * at FCY = 100 MHz).
+ * 
+ */
+
+#define P33C_PWM_ENABLE_TIMEOUT_US  500U // Timeout of the blocking p33c_PwmGenerator_Enable() in [us]
+#define P33C_PWM_TIMER_READ()       P33C_PROFILE_TIMER_READ() // Free-running 16-bit timer of the enable timeout
+#define P33C_PWM_TICK_NS_FRC        250U    // Timer period while the FRC oscillator is the system clock in [ns] (FCY = 4 MHz)
+#define P33C_PWM_TICK_NS_PLL        P33C_PROFILE_TICK_NS // Timer period while the PLL is the system clock in [ns] (FCY = 100 MHz)
+
+enum P33C_PWM_ENABLE_STATE_e {
+    P33C_PWM_ENABLE_IDLE    = 0,    // No request started
+    P33C_PWM_ENABLE_PENDING = 1,    // Generator turned on, waiting for the high resolution PWM clock
+    P33C_PWM_ENABLE_READY   = 2,    // Output pins assigned to the generator
+    P33C_PWM_ENABLE_TIMEOUT = 3,    // High resolution PWM clock not ready within the timeout
+    P33C_PWM_ENABLE_ERROR   = 4     // High resolution PWM clock error (HRERR)
+};
+typedef enum P33C_PWM_ENABLE_STATE_e P33C_PWM_ENABLE_STATE_t;
+
+struct P33C_PWM_ENABLE_s;
+typedef void (*P33C_PWM_ENABLE_CALLBACK_t)(struct P33C_PWM_ENABLE_s* request);
+
+struct P33C_PWM_ENABLE_s {
+    volatile struct P33C_PWM_GENERATOR_s* pg; // PWM generator to be enabled
+    uint16_t state;             // Request state (P33C_PWM_ENABLE_STATE_t)
+    uint16_t last;              // Timer value of the most recent poll
+    uint16_t tick_ns;           // Timer period of the system clock seen by the most recent poll in [ns]
+    uint32_t elapsed_ns;        // Time since the start of the request in [ns]
+    uint32_t timeout_ns;        // Timeout in [ns]
+    P33C_PWM_ENABLE_CALLBACK_t callback; // Completion callback (NULL = none)
+};
+typedef struct P33C_PWM_ENABLE_s P33C_PWM_ENABLE_t;
     
 /* ********************************************************************************************* * 
  * API FUNCTION PROTOTYPES
@@ -357,6 +453,9 @@
 extern volatile struct P33C_PWM_MODULE_s p33c_PwmModule_ConfigRead(void);
 extern volatile uint16_t p33c_PwmModule_ConfigWrite(volatile struct P33C_PWM_MODULE_s pwmConfig);
 
+extern volatile uint16_t p33c_PwmModule_ConfigReadRef(struct P33C_PWM_MODULE_s* pwmConfig);
+extern volatile uint16_t p33c_PwmModule_ConfigWriteRef(const volatile struct P33C_PWM_MODULE_s* pwmConfig);
+
 // PWM Module higher functions
 extern volatile uint16_t p33c_PwmModule_Initialize(void); 
 extern volatile uint16_t p33c_PwmModule_Dispose(void);
@@ -370,6 +469,14 @@ extern volatile struct P33C_PWM_GENERATOR_s p33c_PwmGenerator_ConfigRead(volatil
 extern volatile uint16_t p33c_PwmGenerator_ConfigWrite(volatile uint16_t pgInstance, 
                             volatile struct P33C_PWM_GENERATOR_s pgConfig);
 
+extern volatile uint16_t p33c_PwmGenerator_ConfigReadRef(uint16_t pgInstance, 
+                            struct P33C_PWM_GENERATOR_s* pgConfig);
+extern volatile uint16_t p33c_PwmGenerator_ConfigWriteRef(uint16_t pgInstance, 
+                            const volatile struct P33C_PWM_GENERATOR_s* pgConfig);
+extern volatile uint16_t p33c_PwmGenerator_ConfigWriteDelta(uint16_t pgInstance, 
+                            const volatile struct P33C_PWM_GENERATOR_s* pgConfig, 
+                            struct P33C_PWM_GENERATOR_s* pgShadow);
+
 //extern volatile struct P33C_PWM_GENERATOR_s* p33c_PwmGenerator_GetHandle(volatile uint16_t pgInstance); // Replaced by macro
 extern volatile uint16_t p33c_PwmGenerator_GetInstance(volatile struct P33C_PWM_GENERATOR_s* pg);
 extern volatile uint16_t p33c_PwmGenerator_GetGroup(volatile struct P33C_PWM_GENERATOR_s* pg);
@@ -380,6 +487,10 @@ extern volatile uint16_t p33c_PwmGenerator_Initialize(volatile uint16_t pgInstan
 extern volatile uint16_t p33c_PwmGenerator_Dispose(volatile uint16_t pgInstance);
 
 extern volatile uint16_t p33c_PwmGenerator_Enable(volatile struct P33C_PWM_GENERATOR_s* pg);
+extern uint16_t p33c_PwmGenerator_EnableStart(struct P33C_PWM_ENABLE_s* request,
+                            volatile struct P33C_PWM_GENERATOR_s* pg, uint16_t timeout_us, 
+                            P33C_PWM_ENABLE_CALLBACK_t callback);
+extern uint16_t p33c_PwmGenerator_EnablePoll(struct P33C_PWM_ENABLE_s* request);
 extern volatile uint16_t p33c_PwmGenerator_Disable(volatile struct P33C_PWM_GENERATOR_s* pg);
 extern volatile uint16_t p33c_PwmGenerator_Resume(volatile struct P33C_PWM_GENERATOR_s* pg);
 extern volatile uint16_t p33c_PwmGenerator_Suspend(volatile struct P33C_PWM_GENERATOR_s* pg);
@@ -392,6 +503,14 @@ extern volatile uint16_t p33c_PwmGenerator_SetDutyCycle(volatile struct P33C_PWM
 extern volatile uint16_t p33c_PwmGenerator_SetDeadTimes(volatile struct P33C_PWM_GENERATOR_s* pg, 
                             volatile uint16_t dead_time_rising, volatile uint16_t dead_time_falling);
 
+extern volatile uint16_t p33c_PwmGenerator_GetSyncRoute(
+        volatile uint16_t pgCount,
+        volatile uint16_t pgMotherInstance, 
+        volatile uint16_t pgMotherTriggerOutput,
+        volatile uint16_t pgChildInstance,
+        struct P33C_PWM_SYNC_ROUTE_s* route
+    );
+
 volatile uint16_t p33c_PwmGenerator_SyncGenerators(
         volatile struct P33C_PWM_GENERATOR_s* pgHandleMother, 
         volatile uint16_t pgMotherTriggerOutput,
@@ -399,9 +518,18 @@ volatile uint16_t p33c_PwmGenerator_SyncGenerators(
         volatile bool ChildImmediateUpdate
     );
 
+volatile uint16_t p33c_PwmGenerator_SyncGeneratorsRoute(
+        volatile struct P33C_PWM_GENERATOR_s* pgHandleMother, 
+        volatile uint16_t pgMotherTriggerOutput,
+        volatile struct P33C_PWM_GENERATOR_s* pgHandleChild,
+        volatile bool ChildImmediateUpdate,
+        struct P33C_PWM_SYNC_ROUTE_s* route
+    );
+
 /* ********************************************************************************************* * 
  * PWM GENERATOR CONFIGURATION TEMPLATES
  * ********************************************************************************************* */
+
 extern volatile struct P33C_PWM_MODULE_s pwmConfigClear;
 extern volatile struct P33C_PWM_MODULE_s pwmConfigDefault;
 
@@ -23,6 +23,10 @@
  * File:   demo.h
  * Author: M91406
  * Comments: 
+ *   User settings of the demo application given in physical units and the 
+ *   register values derived from them at compile time. All conversions use 
+ *   integer arithmetic only, are range-checked by the pre-compiler and do not 
+ *   require the floating point or math libraries.
  * Revision history: 
  */
 
@@ -35,63 +39,329 @@
 #include <stdint.h> // include standard integer data types
 #include <stdbool.h> // include standard boolean data types
 #include <stddef.h> // include standard definition data types
-#include <math.h>  // include standard math library
+
+/* *********************************************************************************
+ * USER SETTINGS
+ * *********************************************************************************
+ * All settings are integer numbers given in the units stated in their names and
+ * comments. Please do not add decimal points or type casts as these settings are
+ * evaluated by the pre-compiler.
+ * ********************************************************************************/
 
 // Clock settings
-#define CPU_CLOCK               (float) 100e+6  // CPU clock frequency in [Hz]
-#define PWM_CLOCK               (float) 4.0e+9  // PWM timebase clock in [Hz]
-#define AUX_CLOCK               (float) 500e+6  // Auxiliary Clock Frequency in [Hz]
+#define CPU_CLOCK               100000000   // CPU clock frequency in [Hz]
+#define PWM_CLOCK               4000000000  // PWM timebase clock in [Hz]
+#define AUX_CLOCK               500000000   // Auxiliary Clock Frequency in [Hz]
 
 // Default DAC peripheral declarations
-#define DAC_REFERENCE           (float) 3.300   // DAC reference voltage (usually AVDD)
-#define DAC_RESOLUTION          (float)12.000   // DAC resolution in [bit]
-#define DAC_TRANSITION_TIME     (float)340e-9   // Transition Mode Time setting DA09 specified in data sheet
-#define DAC_STEADY_STATE_TIME   (float)550e-9   // Steady-State Time setting DA10 specified in data sheet
-#define DAC_LEADING_EDGE_BLNK   (float)120e-9   // DAC LEading Edge Blanking period
-#define DAC_VOLTAGE_MAX         (float) 3.135   // Maximum DAC output voltage specification in data sheet, DA09
-#define DAC_VOLTAGE_MIN         (float) 0.625   // Minimum DAC output voltage specification in data sheet, DA10
-
+#define DAC_REFERENCE_MV        3300    // DAC reference voltage (usually AVDD) in [mV]
+#define DAC_RESOLUTION          12      // DAC resolution in [bit]
+#define DAC_TRANSITION_TIME_NS  340     // Transition Mode Time setting DA09 specified in data sheet in [ns]
+#define DAC_STEADY_STATE_TIME_NS 550    // Steady-State Time setting DA10 specified in data sheet in [ns]
+#define DAC_LEADING_EDGE_BLNK_NS 120    // DAC Leading Edge Blanking period in [ns]
+#define DAC_VOLTAGE_MAX_MV      3135    // Maximum DAC output voltage specification in data sheet, DA09, in [mV]
+#define DAC_VOLTAGE_MIN_MV      625     // Minimum DAC output voltage specification in data sheet, DA10, in [mV]
 
 // PWM declarations
-#define PWM_GENERATOR           1U // Specify index of leading PWM generator instance (1=PG1, 2=PG2, etc)
-#define PWM_FREQUENCY           (float) 200e+3  // Default PWM frequency
-#define PWM_DUTY_RATIO          (float) 0.25    // Default duty ratio setting
-#define PWM_DEADTIME_RISING     (float) 50e-9   // Default rising edge dead time setting
-#define PWM_DEADTIME_FALLING    (float) 80e-9   // Default falling edge dead time setting
-
-// PWM Conversion Macros
-#define PWM_RESOLUTION          (float)(1.0 / PWM_CLOCK) // Up to 250 ps PWM resolution 
-#define PWM_PERIOD              (uint16_t)(float)((1.0 / PWM_FREQUENCY) / PWM_RESOLUTION) // Default PWM period
-#define PWM_DUTY_CYCLE          (uint16_t)(PWM_PERIOD * PWM_DUTY_RATIO) // Default duty cycle value
-#define PWM_DEAD_TIME_RE        (uint16_t)(PWM_DEADTIME_RISING  / PWM_RESOLUTION) // Default duty cycle value
-#define PWM_DEAD_TIME_FE        (uint16_t)(PWM_DEADTIME_FALLING / PWM_RESOLUTION) // Default duty cycle value
+#define PWM_GENERATOR           1U      // Specify index of leading PWM generator instance (1=PG1, 2=PG2, etc)
+#define PWM_FREQUENCY           200000  // Default PWM frequency in [Hz]
+#define PWM_DUTY_RATIO_PERMIL   250     // Default duty ratio setting in [0.1%]
+#define PWM_DEADTIME_RISING_NS  50      // Default rising edge dead time setting in [ns]
+#define PWM_DEADTIME_FALLING_NS 80      // Default falling edge dead time setting in [ns]
 
 // DAC declarations 
-#define DAC_INSTANCE            1U // Specify index of DAC instance (1=DAC1, 2=DAC2, etc)
-#define DAC_VOLTAGE_HIGH_1      (float) 1.800 // Demo-mode DAC level #1
-#define DAC_VOLTAGE_HIGH_2      (float) 2.500 // Demo-mode DAC level #2
-#define SLOPE_START_DELAY       (float) 0.10  // Delay in {%] until the slope compensation ramp starts
-#define SLOPE_STOP_DELAY        (float) 0.90  // Delay in [%] until the slope compensation ramp stops
-#define SLOPE_SLEW_RATE_1       (float) 0.200 // Delay in [V/s] 
-#define SLOPE_SLEW_RATE_2       (float) 0.400 // Delay in [V/s] 
-
-// DAC Conversion Macros
-#define DAC_GRANULARITY         (float)(DAC_REFERENCE / pow(2.0, DAC_RESOLUTION)) // DAC granularity in [V/tick]
-#define DAC_CLOCK_FREQUENCY     (float) AUX_CLOCK   // DAC input clock in [Hz]
-#define DAC_CLOCK_PERIOD        (float)(2.0 / DAC_CLOCK_FREQUENCY) // DAC input clock (period) selected in [sec]
-#define DAC_TMODTIME            (uint16_t)((DAC_TRANSITION_TIME * DAC_CLOCK_FREQUENCY) / 2.0)   // DAC Reset Transition Mode Period
-#define DAC_SSTIME              (uint16_t)((DAC_STEADY_STATE_TIME * DAC_CLOCK_FREQUENCY) / 2.0) // Settling time period
-#define DAC_TMCB                (uint16_t)((DAC_LEADING_EDGE_BLNK * DAC_CLOCK_FREQUENCY) / 2.0) // DACx Leading-Edge Blanking
-
-#define SLP_TRIG_START          (uint16_t)(PWM_PERIOD * SLOPE_START_DELAY) // Delay in {sec] until the slope compensation ramp starts
-#define SLP_TRIG_STOP           (uint16_t)(PWM_PERIOD * SLOPE_STOP_DELAY) // Delay in {sec] until the slope compensation ramp stops
-#define SLP_SLEW_RATE_1         (uint16_t)((16.0 * (SLOPE_SLEW_RATE_1 / DAC_GRANULARITY)) / (1.0e-6 / DAC_CLOCK_PERIOD)) // SLOPE DATA in [<DAC ticks>/<CLK-ticks>] representing [V/usec]
-#define SLP_SLEW_RATE_2         (uint16_t)((16.0 * (SLOPE_SLEW_RATE_2 / DAC_GRANULARITY)) / (1.0e-6 / DAC_CLOCK_PERIOD)) // SLOPE DATA in [<DAC ticks>/<CLK-ticks>] representing [V/usec]
-#define SLP_PERIOD              (float)((SLOPE_STOP_DELAY-SLOPE_START_DELAY)*PWM_PERIOD) // Slope duration from START to STOP
-
-#define DACOUT_VALUE_HIGH_1     (uint16_t)(DAC_VOLTAGE_HIGH_1 / DAC_GRANULARITY)
-#define DACOUT_VALUE_HIGH_2     (uint16_t)(DAC_VOLTAGE_HIGH_2 / DAC_GRANULARITY)
+#define DAC_INSTANCE            1U      // Specify index of DAC instance (1=DAC1, 2=DAC2, etc)
+#define DAC_VOLTAGE_HIGH_1_MV   1800    // Demo-mode DAC level #1 in [mV]
+#define DAC_VOLTAGE_HIGH_2_MV   2500    // Demo-mode DAC level #2 in [mV]
+#define SLOPE_START_DELAY_PERMIL 100    // Delay in [0.1%] of the PWM period until the slope compensation ramp starts
+#define SLOPE_STOP_DELAY_PERMIL 900     // Delay in [0.1%] of the PWM period until the slope compensation ramp stops
+#define SLOPE_SLEW_RATE_1_MV_US 200     // Slope slew rate #1 in [mV/us] 
+#define SLOPE_SLEW_RATE_2_MV_US 400     // Slope slew rate #2 in [mV/us] 
 
+// Power stage declarations (adaptive slope compensation)
+#define POWER_STAGE_INDUCTANCE_NH   10000   // Power stage inductance in [nH]
+#define CURRENT_SENSE_GAIN_MV_A     330     // Current sense gain in [mV/A]
+#define VIN_FEEDBACK_FS_MV          60000   // Input voltage represented by a full scale Q15 feedback value in [mV]
+#define VOUT_FEEDBACK_FS_MV         20000   // Output voltage represented by a full scale Q15 feedback value in [mV]
+#define VIN_NOMINAL_MV              48000   // Nominal input voltage fed forward to the adaptive slope controller in [mV]
+#define VOUT_NOMINAL_MV             12000   // Nominal output voltage fed forward to the adaptive slope controller in [mV]
 
-#endif	/* DEMO_CODE_SETUP_H */
+// ADC declarations (PWM-triggered control loop)
+#define ADC_REFERENCE_MV        3300    // ADC reference voltage (AVDD) in [mV]
+#define ADC_RESOLUTION          12      // ADC resolution in [bit]
+#define ADC_CORE_CLOCK          50000000 // Dedicated ADC core clock in [Hz] (TAD = 20 ns)
+#define ADC_SAMPLE_TIME_TAD     5       // Sampling time of the dedicated ADC core in [TAD] (minimum 2)
+#define ADC_CONVERSION_TIME_TAD 14      // Conversion time of a 12-bit result in [TAD]
+#define CONTROL_IRQ_LATENCY_TCY 10      // Interrupt entry latency including context save in [CPU cycles]
+#define CONTROL_REFERENCE_MV    1650    // Feedback voltage reference of the control loop in [mV]
+#define CONTROL_KI_SHIFT        4       // Integral gain of the control loop as 2^-n [DAC ticks per ADC tick and PWM cycle]
+
+// Telemetry stream declarations (UART1 TX on test point TP05)
+#define TELEMETRY_BAUDRATE      1000000 // UART baud rate in [baud]
+#define TELEMETRY_DECIMATION    200     // Number of control loop executions per telemetry frame (one frame per 1 ms task call)
+
+/* *********************************************************************************
+ * CONVERSION SETTINGS
+ * ********************************************************************************/
+
+#define DEMO_ROUND_FLOOR        0       // Derived register values are truncated
+#define DEMO_ROUND_NEAREST      1       // Derived register values are rounded to the nearest integer
+#define DEMO_ROUND_CEIL         2       // Derived register values are rounded up
+
+#define DEMO_ROUNDING           DEMO_ROUND_NEAREST // Rounding mode of all derived register values
+#define DEMO_QERR_LIMIT_PPM     10000   // Quantization error in [ppm] above which the build issues a message
+
+/* *********************************************************************************
+ * CONVERSION MACROS
+ * *********************************************************************************
+ * DEMO_DIV(n, d) divides the ideal numerator n by the denominator d using the
+ * selected rounding mode. DEMO_QERR_PPM(v, n, d) returns the deviation of the 
+ * derived register value v from the ideal value n/d in [ppm] (positive numbers = 
+ * register value is larger than the ideal value). All calculations are performed 
+ * in 64-bit signed integer arithmetic and are resolved at compile time.
+ * ********************************************************************************/
+
+#if (DEMO_ROUNDING == DEMO_ROUND_FLOOR)
+  #define DEMO_DIV(n, d)        ((1LL * (n)) / (d))
+#elif (DEMO_ROUNDING == DEMO_ROUND_NEAREST)
+  #define DEMO_DIV(n, d)        (((1LL * (n)) + ((d) / 2)) / (d))
+#elif (DEMO_ROUNDING == DEMO_ROUND_CEIL)
+  #define DEMO_DIV(n, d)        (((1LL * (n)) + (d) - 1) / (d))
+#else
+  #error "invalid rounding mode selected (DEMO_ROUNDING)"
+#endif
+
+#define DEMO_QERR_PPM(v, n, d)  ((((1LL * (v)) * (d) - (1LL * (n))) * 1000000LL) / (1LL * (n)))
+#define DEMO_ABS(x)             (((x) < 0) ? -(x) : (x))
+
+// Parametric conversions of user settings into register values. They are used 
+// for the default settings below and can also be evaluated at runtime (e.g. by
+// host-side parameter sweeps) to obtain the values the firmware would program.
+#define DEMO_PWM_PERIOD(f_hz)                   DEMO_DIV(1LL * PWM_CLOCK, 1LL * (f_hz))
+#define DEMO_PWM_RATIO(f_hz, permil)            DEMO_DIV(1LL * PWM_CLOCK * (permil), 1000LL * (f_hz))
+#define DEMO_SLP_SLEW_RATE(mv_us)               DEMO_DIV(16LL * (mv_us) * DAC_FULL_SCALE * DAC_CLOCK_DIVIDER * 1000000LL, \
+                                                    1LL * DAC_REFERENCE_MV * DAC_CLOCK_FREQUENCY)
+#define DEMO_DACOUT_VALUE(mv)                   DEMO_DIV(1LL * (mv) * DAC_FULL_SCALE, 1LL * DAC_REFERENCE_MV)
+#define DEMO_SLP_RAMP_DROP(slpdat, slp_period)  DEMO_DIV(1LL * (slpdat) * (slp_period) * DAC_CLOCK_FREQUENCY, \
+                                                    16LL * DAC_CLOCK_DIVIDER * PWM_CLOCK)
+
+// PWM Conversion Macros (numerators and denominators of ideal values)
+#define PWM_PERIOD_N            (1LL * PWM_CLOCK)
+#define PWM_PERIOD_D            (1LL * PWM_FREQUENCY)
+#define PWM_DUTY_CYCLE_N        (1LL * PWM_CLOCK * PWM_DUTY_RATIO_PERMIL)
+#define PWM_DUTY_CYCLE_D        (1000LL * PWM_FREQUENCY)
+#define PWM_DEAD_TIME_RE_N      (1LL * PWM_CLOCK * PWM_DEADTIME_RISING_NS)
+#define PWM_DEAD_TIME_FE_N      (1LL * PWM_CLOCK * PWM_DEADTIME_FALLING_NS)
+#define PWM_DEAD_TIME_D         (1000000000LL)
+
+#define PWM_PERIOD_RAW          DEMO_PWM_PERIOD(PWM_FREQUENCY) // Default PWM period
+#define PWM_DUTY_CYCLE_RAW      DEMO_PWM_RATIO(PWM_FREQUENCY, PWM_DUTY_RATIO_PERMIL) // Default duty cycle value
+#define PWM_DEAD_TIME_RE_RAW    DEMO_DIV(PWM_DEAD_TIME_RE_N, PWM_DEAD_TIME_D) // Default rising edge dead time value
+#define PWM_DEAD_TIME_FE_RAW    DEMO_DIV(PWM_DEAD_TIME_FE_N, PWM_DEAD_TIME_D) // Default falling edge dead time value
+
+// DAC Conversion Macros (numerators and denominators of ideal values)
+#define DAC_CLOCK_FREQUENCY     AUX_CLOCK   // DAC input clock in [Hz]
+#define DAC_CLOCK_DIVIDER       2           // DAC clock period = DAC_CLOCK_DIVIDER / DAC_CLOCK_FREQUENCY
+#define DAC_FULL_SCALE          (1LL << DAC_RESOLUTION) // DAC full scale in [ticks]
+
+#define DAC_TMODTIME_N          (1LL * DAC_TRANSITION_TIME_NS * DAC_CLOCK_FREQUENCY)
+#define DAC_SSTIME_N            (1LL * DAC_STEADY_STATE_TIME_NS * DAC_CLOCK_FREQUENCY)
+#define DAC_TMCB_N              (1LL * DAC_LEADING_EDGE_BLNK_NS * DAC_CLOCK_FREQUENCY)
+#define DAC_TIME_D              (1000000000LL * DAC_CLOCK_DIVIDER)
+
+#define DAC_TMODTIME_RAW        DEMO_DIV(DAC_TMODTIME_N, DAC_TIME_D) // DAC Reset Transition Mode Period
+#define DAC_SSTIME_RAW          DEMO_DIV(DAC_SSTIME_N, DAC_TIME_D)   // Settling time period
+#define DAC_TMCB_RAW            DEMO_DIV(DAC_TMCB_N, DAC_TIME_D)     // DACx Leading-Edge Blanking
+
+#define SLP_TRIG_START_N        (1LL * PWM_CLOCK * SLOPE_START_DELAY_PERMIL)
+#define SLP_TRIG_STOP_N         (1LL * PWM_CLOCK * SLOPE_STOP_DELAY_PERMIL)
+#define SLP_TRIG_D              (1000LL * PWM_FREQUENCY)
+
+#define SLP_TRIG_START_RAW      DEMO_PWM_RATIO(PWM_FREQUENCY, SLOPE_START_DELAY_PERMIL) // Slope compensation ramp start trigger location
+#define SLP_TRIG_STOP_RAW       DEMO_PWM_RATIO(PWM_FREQUENCY, SLOPE_STOP_DELAY_PERMIL)  // Slope compensation ramp stop trigger location
+#define SLP_PERIOD_RAW          (SLP_TRIG_STOP_RAW - SLP_TRIG_START_RAW) // Slope duration from START to STOP in [PWM ticks]
+
+// SLPxDAT is given in [DAC ticks/DAC clock period] with 4 fractional bits:
+// SLPDAT = 16 * slew rate [V/s] / DAC granularity [V/tick] * DAC clock period [s]
+#define SLP_SLEW_RATE_1_N       (16LL * SLOPE_SLEW_RATE_1_MV_US * DAC_FULL_SCALE * DAC_CLOCK_DIVIDER * 1000000LL)
+#define SLP_SLEW_RATE_2_N       (16LL * SLOPE_SLEW_RATE_2_MV_US * DAC_FULL_SCALE * DAC_CLOCK_DIVIDER * 1000000LL)
+#define SLP_SLEW_RATE_D         (1LL * DAC_REFERENCE_MV * DAC_CLOCK_FREQUENCY)
+
+#define SLP_SLEW_RATE_1_RAW     DEMO_SLP_SLEW_RATE(SLOPE_SLEW_RATE_1_MV_US) // Slope data representing slew rate #1
+#define SLP_SLEW_RATE_2_RAW     DEMO_SLP_SLEW_RATE(SLOPE_SLEW_RATE_2_MV_US) // Slope data representing slew rate #2
+
+#define DACOUT_VALUE_HIGH_1_N   (1LL * DAC_VOLTAGE_HIGH_1_MV * DAC_FULL_SCALE)
+#define DACOUT_VALUE_HIGH_2_N   (1LL * DAC_VOLTAGE_HIGH_2_MV * DAC_FULL_SCALE)
+#define DACOUT_VALUE_D          (1LL * DAC_REFERENCE_MV)
+
+#define DACOUT_VALUE_HIGH_1_RAW DEMO_DACOUT_VALUE(DAC_VOLTAGE_HIGH_1_MV)
+#define DACOUT_VALUE_HIGH_2_RAW DEMO_DACOUT_VALUE(DAC_VOLTAGE_HIGH_2_MV)
+#define DACOUT_VALUE_MIN_RAW    DEMO_DACOUT_VALUE(DAC_VOLTAGE_MIN_MV)
+#define DACOUT_VALUE_MAX_RAW    DEMO_DACOUT_VALUE(DAC_VOLTAGE_MAX_MV)
 
+// DAC ramp amplitude in [DAC ticks] = SLPDAT / 16 * slope duration in [DAC clock periods]
+#define SLP_RAMP_DROP_1_RAW     DEMO_SLP_RAMP_DROP(SLP_SLEW_RATE_1_RAW, SLP_PERIOD_RAW)
+#define SLP_RAMP_DROP_2_RAW     DEMO_SLP_RAMP_DROP(SLP_SLEW_RATE_2_RAW, SLP_PERIOD_RAW)
+
+// ADC and control loop conversion macros. The feedback is sampled by the same PWM 
+// ADC Trigger 1 event (PGxTRIGB) which starts the slope compensation ramp.
+#define ADC_FULL_SCALE          (1LL << ADC_RESOLUTION) // ADC full scale in [ticks]
+#define ADC_CORE_CLOCK_DIV_RAW  DEMO_DIV(2LL * CPU_CLOCK, 2LL * ADC_CORE_CLOCK) // ADCORExH.ADCS: core clock = FOSC / (2 * ADCS)
+#define ADC_SAMPLE_TIME_RAW     (ADC_SAMPLE_TIME_TAD - 2) // ADCORExL.SAMC: sampling time = SAMC + 2 TAD
+
+#define CONTROL_TRIGGER_RAW     SLP_TRIG_START_RAW // ADC trigger location in [PWM ticks]
+#define CONTROL_ADC_LATENCY_RAW DEMO_DIV(1LL * PWM_CLOCK * (ADC_SAMPLE_TIME_TAD + ADC_CONVERSION_TIME_TAD), \
+                                    1LL * ADC_CORE_CLOCK) // Trigger to conversion complete in [PWM ticks]
+#define CONTROL_IRQ_LATENCY_RAW (1LL * CONTROL_IRQ_LATENCY_TCY * (PWM_CLOCK / CPU_CLOCK)) // Conversion complete to ISR entry in [PWM ticks]
+#define CONTROL_DEADLINE_RAW    (PWM_PERIOD_RAW - CONTROL_TRIGGER_RAW) // Trigger to next start of cycle in [PWM ticks]
+#define CONTROL_REFERENCE_RAW   DEMO_DIV(1LL * CONTROL_REFERENCE_MV * ADC_FULL_SCALE, 1LL * ADC_REFERENCE_MV)
+
+// Telemetry conversion macros. Every frame of 28 bytes is transmitted as 280 bits 
+// (8 data bits framed by one start and one stop bit).
+#define TELEMETRY_BRG_RAW       (DEMO_DIV(1LL * CPU_CLOCK, 4LL * TELEMETRY_BAUDRATE) - 1) // UxBRG (BRGH = 1): baud rate = FCY / (4 * (UxBRG + 1))
+#define TELEMETRY_BITRATE_RAW   DEMO_DIV(280LL * PWM_FREQUENCY, 1LL * TELEMETRY_DECIMATION) // Required line bit rate in [bit/s]
+
+/* *********************************************************************************
+ * DERIVED REGISTER VALUES
+ * ********************************************************************************/
+
+#define PWM_PERIOD              ((uint16_t)PWM_PERIOD_RAW)          // Default PWM period
+#define PWM_DUTY_CYCLE          ((uint16_t)PWM_DUTY_CYCLE_RAW)      // Default duty cycle value
+#define PWM_DEAD_TIME_RE        ((uint16_t)PWM_DEAD_TIME_RE_RAW)    // Default rising edge dead time value
+#define PWM_DEAD_TIME_FE        ((uint16_t)PWM_DEAD_TIME_FE_RAW)    // Default falling edge dead time value
+
+#define DAC_TMODTIME            ((uint16_t)DAC_TMODTIME_RAW)        // DAC Reset Transition Mode Period
+#define DAC_SSTIME              ((uint16_t)DAC_SSTIME_RAW)          // Settling time period
+#define DAC_TMCB                ((uint16_t)DAC_TMCB_RAW)            // DACx Leading-Edge Blanking
+
+#define SLP_TRIG_START          ((uint16_t)SLP_TRIG_START_RAW)      // Slope compensation ramp start trigger location
+#define SLP_TRIG_STOP           ((uint16_t)SLP_TRIG_STOP_RAW)       // Slope compensation ramp stop trigger location
+#define SLP_PERIOD              ((uint16_t)SLP_PERIOD_RAW)          // Slope duration from START to STOP in [PWM ticks]
+#define SLP_SLEW_RATE_1         ((uint16_t)SLP_SLEW_RATE_1_RAW)     // SLOPE DATA in [<DAC ticks>/<CLK-ticks>] representing slew rate #1
+#define SLP_SLEW_RATE_2         ((uint16_t)SLP_SLEW_RATE_2_RAW)     // SLOPE DATA in [<DAC ticks>/<CLK-ticks>] representing slew rate #2
+
+#define DACOUT_VALUE_HIGH_1     ((uint16_t)DACOUT_VALUE_HIGH_1_RAW) // DAC level #1 in [DAC ticks]
+#define DACOUT_VALUE_HIGH_2     ((uint16_t)DACOUT_VALUE_HIGH_2_RAW) // DAC level #2 in [DAC ticks]
+#define ADC_CORE_CLOCK_DIV      ((uint16_t)ADC_CORE_CLOCK_DIV_RAW)  // Dedicated ADC core clock divider (ADCS)
+#define ADC_SAMPLE_TIME         ((uint16_t)ADC_SAMPLE_TIME_RAW)     // Dedicated ADC core sampling time (SAMC)
+#define CONTROL_LATENCY         ((uint16_t)(CONTROL_ADC_LATENCY_RAW + CONTROL_IRQ_LATENCY_RAW)) // Trigger to ISR entry in [PWM ticks]
+#define CONTROL_DEADLINE        ((uint16_t)CONTROL_DEADLINE_RAW)    // Latest update after the ADC trigger in [PWM ticks]
+#define CONTROL_REFERENCE       ((uint16_t)CONTROL_REFERENCE_RAW)   // Control loop reference in [ADC ticks]
+#define CONTROL_DAC_MIN         ((uint16_t)(DACOUT_VALUE_MIN_RAW + SLP_RAMP_DROP_1_RAW)) // Lowest DAC level output by the control loop (slew rate #1) in [DAC ticks]
+#define CONTROL_DAC_MAX         ((uint16_t)DACOUT_VALUE_MAX_RAW)    // Highest DAC level output by the control loop in [DAC ticks]
+#define TELEMETRY_BRG           ((uint16_t)TELEMETRY_BRG_RAW)       // Telemetry UART baud rate generator (UxBRG)
+
+/* *********************************************************************************
+ * QUANTIZATION ERRORS
+ * *********************************************************************************
+ * Deviation of each derived register value from its ideal value in [ppm]
+ * ********************************************************************************/
+
+#define PWM_PERIOD_QERR_PPM         DEMO_QERR_PPM(PWM_PERIOD_RAW, PWM_PERIOD_N, PWM_PERIOD_D)
+#define PWM_DUTY_CYCLE_QERR_PPM     DEMO_QERR_PPM(PWM_DUTY_CYCLE_RAW, PWM_DUTY_CYCLE_N, PWM_DUTY_CYCLE_D)
+#define PWM_DEAD_TIME_RE_QERR_PPM   DEMO_QERR_PPM(PWM_DEAD_TIME_RE_RAW, PWM_DEAD_TIME_RE_N, PWM_DEAD_TIME_D)
+#define PWM_DEAD_TIME_FE_QERR_PPM   DEMO_QERR_PPM(PWM_DEAD_TIME_FE_RAW, PWM_DEAD_TIME_FE_N, PWM_DEAD_TIME_D)
+#define DAC_TMODTIME_QERR_PPM       DEMO_QERR_PPM(DAC_TMODTIME_RAW, DAC_TMODTIME_N, DAC_TIME_D)
+#define DAC_SSTIME_QERR_PPM         DEMO_QERR_PPM(DAC_SSTIME_RAW, DAC_SSTIME_N, DAC_TIME_D)
+#define DAC_TMCB_QERR_PPM           DEMO_QERR_PPM(DAC_TMCB_RAW, DAC_TMCB_N, DAC_TIME_D)
+#define SLP_TRIG_START_QERR_PPM     DEMO_QERR_PPM(SLP_TRIG_START_RAW, SLP_TRIG_START_N, SLP_TRIG_D)
+#define SLP_TRIG_STOP_QERR_PPM      DEMO_QERR_PPM(SLP_TRIG_STOP_RAW, SLP_TRIG_STOP_N, SLP_TRIG_D)
+#define SLP_SLEW_RATE_1_QERR_PPM    DEMO_QERR_PPM(SLP_SLEW_RATE_1_RAW, SLP_SLEW_RATE_1_N, SLP_SLEW_RATE_D)
+#define SLP_SLEW_RATE_2_QERR_PPM    DEMO_QERR_PPM(SLP_SLEW_RATE_2_RAW, SLP_SLEW_RATE_2_N, SLP_SLEW_RATE_D)
+#define DACOUT_VALUE_HIGH_1_QERR_PPM DEMO_QERR_PPM(DACOUT_VALUE_HIGH_1_RAW, DACOUT_VALUE_HIGH_1_N, DACOUT_VALUE_D)
+#define DACOUT_VALUE_HIGH_2_QERR_PPM DEMO_QERR_PPM(DACOUT_VALUE_HIGH_2_RAW, DACOUT_VALUE_HIGH_2_N, DACOUT_VALUE_D)
+
+/* *********************************************************************************
+ * PLAUSIBILITY AND RANGE CHECKS
+ * ********************************************************************************/
+
+#if ((PWM_CLOCK % CPU_CLOCK) != 0)
+  #error "PWM clock must be an integer multiple of the CPU clock"
+#endif
+
+#if ((PWM_PERIOD_RAW < 0x0010) || (PWM_PERIOD_RAW > 0xFFFF))
+  #error "PWM period out of range (PGxPER); please check PWM_FREQUENCY"
+#endif
+#if ((PWM_DUTY_CYCLE_RAW < 0) || (PWM_DUTY_CYCLE_RAW > PWM_PERIOD_RAW))
+  #error "PWM duty cycle out of range (PGxDC); please check PWM_DUTY_RATIO_PERMIL"
+#endif
+#if ((PWM_DEAD_TIME_RE_RAW > 0x3FFF) || (PWM_DEAD_TIME_FE_RAW > 0x3FFF))
+  #error "PWM dead time out of range (PGxDTH/PGxDTL, 14-bit)"
+#endif
+
+#if (DAC_TMODTIME_RAW > 0x03FF)
+  #error "DAC transition mode time out of range (DACCTRL2L.TMODTIME, 10-bit)"
+#endif
+#if (DAC_SSTIME_RAW > 0x03FF)
+  #error "DAC steady-state time out of range (DACCTRL2H.SSTIME, 10-bit)"
+#endif
+#if (DAC_TMCB_RAW > 0x03FF)
+  #error "DAC leading edge blanking period out of range (DACxCONH.TMCB, 10-bit)"
+#endif
+
+#if (SLP_TRIG_START_RAW >= SLP_TRIG_STOP_RAW) || (SLP_TRIG_STOP_RAW > PWM_PERIOD_RAW)
+  #error "slope start/stop trigger locations out of range (PGxTRIGB/PGxTRIGC)"
+#endif
+#if ((SLP_SLEW_RATE_1_RAW < 1) || (SLP_SLEW_RATE_1_RAW > 0xFFFF) || \
+     (SLP_SLEW_RATE_2_RAW < 1) || (SLP_SLEW_RATE_2_RAW > 0xFFFF))
+  #error "slope slew rate out of range (SLPxDAT)"
+#endif
+
+#if ((DACOUT_VALUE_HIGH_1_RAW > (DAC_FULL_SCALE - 1)) || (DACOUT_VALUE_HIGH_2_RAW > (DAC_FULL_SCALE - 1)))
+  #error "DAC output level out of range (DACxDATH)"
+#endif
+#if ((DACOUT_VALUE_HIGH_1_RAW > DACOUT_VALUE_MAX_RAW) || (DACOUT_VALUE_HIGH_2_RAW > DACOUT_VALUE_MAX_RAW))
+  #error "DAC output level exceeds maximum output voltage specification (DAC_VOLTAGE_MAX_MV)"
+#endif
+#if (((DACOUT_VALUE_HIGH_1_RAW - SLP_RAMP_DROP_1_RAW) < DACOUT_VALUE_MIN_RAW) || \
+     ((DACOUT_VALUE_HIGH_2_RAW - SLP_RAMP_DROP_2_RAW) < DACOUT_VALUE_MIN_RAW))
+  #error "DAC ramp falls below minimum output voltage specification (DAC_VOLTAGE_MIN_MV)"
+#endif
+
+#if (((2LL * CPU_CLOCK) % (2LL * ADC_CORE_CLOCK)) != 0) || (ADC_CORE_CLOCK_DIV_RAW < 1) || (ADC_CORE_CLOCK_DIV_RAW > 0x7F)
+  #error "ADC core clock not available (ADCORExH.ADCS); please check ADC_CORE_CLOCK"
+#endif
+#if ((ADC_SAMPLE_TIME_TAD < 2) || (ADC_SAMPLE_TIME_RAW > 0x03FF))
+  #error "ADC sampling time out of range (ADCORExL.SAMC, 10-bit)"
+#endif
+#if ((CONTROL_ADC_LATENCY_RAW + CONTROL_IRQ_LATENCY_RAW) >= CONTROL_DEADLINE_RAW)
+  #error "control loop interrupt cannot update the PWM within the switching cycle of its ADC trigger"
+#endif
+#if ((CONTROL_REFERENCE_RAW < 1) || (CONTROL_REFERENCE_RAW > (ADC_FULL_SCALE - 1)))
+  #error "control loop reference out of range (ADC)"
+#endif
+
+#if (((1LL * CPU_CLOCK) % (4LL * TELEMETRY_BAUDRATE)) != 0) || (TELEMETRY_BRG_RAW < 0) || (TELEMETRY_BRG_RAW > 0xFFFF)
+  #error "telemetry baud rate not available (UxBRG); please check TELEMETRY_BAUDRATE"
+#endif
+#if ((TELEMETRY_DECIMATION < 1) || (TELEMETRY_BITRATE_RAW > TELEMETRY_BAUDRATE))
+  #error "telemetry frame rate exceeds the UART baud rate; please check TELEMETRY_DECIMATION"
+#endif
+#if (TELEMETRY_DECIMATION < DEMO_DIV(1LL * PWM_FREQUENCY, 1000LL))
+  #error "telemetry frames are recorded by the 1 ms task; please check TELEMETRY_DECIMATION"
+#endif
+
+#if ((DEMO_ABS(PWM_PERIOD_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(PWM_DUTY_CYCLE_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(SLP_TRIG_START_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(SLP_TRIG_STOP_QERR_PPM) > DEMO_QERR_LIMIT_PPM))
+  #pragma message "warning: PWM timing quantization error exceeds DEMO_QERR_LIMIT_PPM"
+#endif
+#if ((DEMO_ABS(PWM_DEAD_TIME_RE_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(PWM_DEAD_TIME_FE_QERR_PPM) > DEMO_QERR_LIMIT_PPM))
+  #pragma message "warning: PWM dead time quantization error exceeds DEMO_QERR_LIMIT_PPM"
+#endif
+#if ((DEMO_ABS(DAC_TMODTIME_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(DAC_SSTIME_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(DAC_TMCB_QERR_PPM) > DEMO_QERR_LIMIT_PPM))
+  #pragma message "warning: DAC timing quantization error exceeds DEMO_QERR_LIMIT_PPM"
+#endif
+#if ((DEMO_ABS(SLP_SLEW_RATE_1_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(SLP_SLEW_RATE_2_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(DACOUT_VALUE_HIGH_1_QERR_PPM) > DEMO_QERR_LIMIT_PPM) || \
+     (DEMO_ABS(DACOUT_VALUE_HIGH_2_QERR_PPM) > DEMO_QERR_LIMIT_PPM))
+  #pragma message "warning: DAC slope quantization error exceeds DEMO_QERR_LIMIT_PPM"
+#endif
+
+
+#endif	/* DEMO_CODE_SETUP_H */
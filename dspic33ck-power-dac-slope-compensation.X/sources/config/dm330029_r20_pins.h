@@ -0,0 +1,122 @@
+/* ***********************************************************************************************
+ * File:        dm330029_r20_pins.h
+ * Comments:    Hardware abstraction layer device pin descriptors
+ * Board ID:    DM330029_R20
+ *
+ * Description:
+ * This file has been generated from dm330029_r20_pinmap.h by p33c_pingen (sources/host/tools).
+ * Do not edit this file; edit the pinmap header and run the generator again.
+ *
+ * Each pin descriptor <NAME>_PIN expands into 'port, bit, RPn, analog, ADC core, ANx input'
+ * and is used with the pin accessors of p33c_gpio.h (e.g. p33c_Gpio_Set(DBGPIN)).
+ * DM330029_R20_PIN_LIST(pin) calls pin(NAME) for each pin declared in this file.
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __DM330029_R20_PINS_H__
+#define __DM330029_R20_PINS_H__
+
+#define DM330029_PINMAP_VERSION "R20"
+#ifndef PINDIR_INPUT
+    #define PINDIR_INPUT 1
+#endif
+#ifndef PINDIR_OUTPUT
+    #define PINDIR_OUTPUT 0
+#endif
+#ifndef PINSTATE_HIGH
+    #define PINSTATE_HIGH 1
+#endif
+#ifndef PINSTATE_LOW
+    #define PINSTATE_LOW 0
+#endif
+#ifndef PINCFG_OPEN_DRAIN
+    #define PINCFG_OPEN_DRAIN 1
+#endif
+#ifndef PINCFG_PUSH_PULL
+    #define PINCFG_PUSH_PULL 0
+#endif
+#ifndef LED_ON
+    #define LED_ON 0
+#endif
+#ifndef LED_OFF
+    #define LED_OFF 1
+#endif
+#ifndef SW_PRESSED
+    #define SW_PRESSED 0
+#endif
+#ifndef SW_OPEN
+    #define SW_OPEN 1
+#endif
+
+#define TP03_PIN             ECP03_PIN // Device Pin #3 is TP03
+#define TP04_PIN             ECP04_PIN // Device Pin #4 is TP04
+#define TP05_PIN             ECP05_PIN // Device Pin #5 is TP05
+#define TP06_PIN             ECP06_PIN // Device Pin #6 is TP06
+#define TP07_PIN             ECP07_PIN // Device Pin #7 is TP07
+#define TP08_PIN             ECP08_PIN // Device Pin #8 is TP08
+#define TP09_PIN             ECP09_PIN // Device Pin #9 is TP09
+#define TP10_PIN             ECP10_PIN // Device Pin #10 is TP10
+#define TP11_PIN             ECP11_PIN // Device Pin #11 is TP11
+#define TP12_PIN             ECP12_PIN // Device Pin #12 is TP12
+#define TP13_PIN             ECP13_PIN // Device Pin #13 is TP13
+#define TP14_PIN             ECP14_PIN // Device Pin #14 is TP14
+#define TP15_PIN             ECP15_PIN // Device Pin #15 is TP15
+#define TP16_PIN             ECP16_PIN // Device Pin #16 is TP16
+#define TP17_PIN             ECP17_PIN // Device Pin #17 is TP17
+#define TP18_PIN             ECP18_PIN // Device Pin #18 is TP18
+#define TP19_PIN             ECP19_PIN // Device Pin #19 is TP19
+#define TP20_PIN             ECP20_PIN // Device Pin #20 is TP20
+#define TP23_PIN             ECP23_PIN // Device Pin #23 is TP23
+#define TP24_PIN             ECP24_PIN // Device Pin #24 is TP24
+#define TP25_PIN             ECP25_PIN // Device Pin #25 is TP25
+#define TP26_PIN             ECP26_PIN // Device Pin #26 is TP26
+#define TP27_PIN             ECP27_PIN // Device Pin #27 is TP27
+#define TP28_PIN             ECP28_PIN // Device Pin #28 is TP28
+#define TP29_PIN             ECP29_PIN // Device Pin #29 is TP29
+#define TP30_PIN             ECP30_PIN // Device Pin #30 is TP30
+#define TP31_PIN             ECP31_PIN // Device Pin #31 is TP31
+#define TP32_PIN             ECP32_PIN // Device Pin #32 is TP32
+#define TP33_PIN             ECP33_PIN // Device Pin #33 is TP33
+#define TP34_PIN             ECP34_PIN // Device Pin #34 is TP34
+#define TP35_PIN             ECP35_PIN // Device Pin #35 is TP35
+#define TP36_PIN             ECP36_PIN // Device Pin #36 is TP36
+#define TP37_PIN             ECP37_PIN // Device Pin #37 is TP37
+#define TP38_PIN             ECP38_PIN // Device Pin #38 is TP38
+#define TP39_PIN             ECP39_PIN // Device Pin #39 is TP39
+#define TP40_PIN             ECP40_PIN // Device Pin #40 is TP40
+#define TP41_PIN             ECP41_PIN // Device Pin #41 is TP41
+#define TP42_PIN             ECP42_PIN // Device Pin #42 is TP42
+#define TP43_PIN             ECP43_PIN // Device Pin #43 is TP43
+#define TP44_PIN             ECP44_PIN // Device Pin #44 is TP44
+#define TP45_PIN             ECP45_PIN // Device Pin #45 is TP45
+#define TP46_PIN             ECP46_PIN // Device Pin #46 is TP46
+#define TP47_PIN             ECP47_PIN // Device Pin #47 is TP47
+#define TP48_PIN             ECP48_PIN // Device Pin #48 is TP48
+#define TP49_PIN             ECP49_PIN // Device Pin #49 is TP49
+#define TP50_PIN             ECP50_PIN // Device Pin #50 is TP50
+#define TP51_PIN             ECP51_PIN // Device Pin #51 is TP51
+#define TP52_PIN             ECP52_PIN // Device Pin #52 is TP52
+#define TP53_PIN             ECP53_PIN // Device Pin #53 is TP53
+#define TP54_PIN             ECP55_PIN // Device Pin #54 is TP54
+#define TP55_PIN             ECP55_PIN // Device Pin #55 is TP55
+#define TP56_PIN             ECP56_PIN // Device Pin #56 is TP56
+#define MIKRO_AN_PIN         TP12_PIN // Device Pin #61 is MIKRO_AN
+#define MIKRO_MCLR_PIN       MCLR_PIN // Device Pin #62 is MIKRO_MCLR
+#define MIKRO_CS_PIN         TP48_PIN // Device Pin #63 is MIKRO_CS
+#define MIKRO_SCK_PIN        TP32_PIN // Device Pin #64 is MIKRO_SCK
+#define MIKRO_MISO_PIN       TP24_PIN // Device Pin #65 is MIKRO_MISO
+#define MIKRO_MOSI_PIN       TP36_PIN // Device Pin #66 is MIKRO_MOSI
+#define MIKRO_SDA_PIN        TP55_PIN // Device Pin #67 is MIKRO_SDA
+#define MIKRO_SCL_PIN        TP53_PIN // Device Pin #68 is MIKRO_SCL
+#define MIKRO_SER1_PIN       TP50_PIN // Device Pin #69 is MIKRO_SER1
+#define MIKRO_SER0_PIN       TP39_PIN // Device Pin #70 is MIKRO_SER0
+#define MIKRO_PWM_PIN        TP45_PIN // Device Pin #71 is MIKRO_PWM
+#define SW_PIN               TP27_PIN // Device Pin #72 is SW
+#define LED_RD_PIN           TP52_PIN // Device Pin #73 is LED_RD
+#define LED_GN_PIN           TP54_PIN // Device Pin #74 is LED_GN
+#define DACOUT_PIN           TP03_PIN // Device Pin #75 is DACOUT
+
+#define DM330029_R20_PIN_LIST(pin)
+
+#endif	/* __DM330029_R20_PINS_H__ */
@@ -27,8 +27,13 @@
  * Selective header file inclusions with signal and peripheral assignment based on 
  * common macros defined in project properties for selected hardware and MCU devices.
  * 
+ * Board signals are declared by the compact pin descriptor headers (*_pins.h), which are
+ * generated from the pinmap headers (*_pinmap.h) by the host tool p33c_pingen. Pins are
+ * accessed with the pin accessors of p33c_gpio.h, e.g. p33c_Gpio_Toggle(DBGLED).
+ * 
  * Revision history: 
  * 1.0  initial release
+ * 1.1  pin descriptor headers replace the pinmap headers
  */
 
 // This is a guard condition so that contents of this file are not included
@@ -46,16 +51,19 @@
 // Include peripehral assignments and signal levels of this demo
 #include "demo.h"
 
+// Include generic GPIO driver with pin accessors
+#include "../common/p33c_gpio.h"
+
 // include hardware abstraction layer header file for the 
 // Digital Power Development Board (Part-No. DM330029)
 #if defined (__DM330029_R20__)
-    #include "dm330029_r20_pinmap.h"
+    #include "dm330029_r20_pins.h"
 #endif
 
 #if defined (__MA330048_dsPIC33CK_DPPIM__)
-    #include "ma330048_r30_pinmap.h"
+    #include "ma330048_r30_pins.h"
 #elif defined (__MA330049_dsPIC33CH_DPPIM__)
-    #include "MA330049_R10_pinmap.h"
+    #include "ma330049_r10_pins.h"
 #else
     #pragma message "selected device not available"
 #endif
@@ -0,0 +1,213 @@
+/* ***********************************************************************************************
+ * File:        ma330048_r30_pins.h
+ * Comments:    Hardware abstraction layer device pin descriptors
+ * Board ID:    MA330048_R30
+ *
+ * Description:
+ * This file has been generated from ma330048_r30_pinmap.h by p33c_pingen (sources/host/tools).
+ * Do not edit this file; edit the pinmap header and run the generator again.
+ *
+ * Each pin descriptor <NAME>_PIN expands into 'port, bit, RPn, analog, ADC core, ANx input'
+ * and is used with the pin accessors of p33c_gpio.h (e.g. p33c_Gpio_Set(DBGPIN)).
+ * MA330048_R30_PIN_LIST(pin) calls pin(NAME) for each pin declared in this file.
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __MA330048_R30_PINS_H__
+#define __MA330048_R30_PINS_H__
+
+#define MA330048_PINMAP_VERSION "R30"
+#ifndef PINDIR_INPUT
+    #define PINDIR_INPUT 1
+#endif
+#ifndef PINDIR_OUTPUT
+    #define PINDIR_OUTPUT 0
+#endif
+#ifndef PINSTATE_HIGH
+    #define PINSTATE_HIGH 1
+#endif
+#ifndef PINSTATE_LOW
+    #define PINSTATE_LOW 0
+#endif
+#ifndef PINCFG_OPEN_DRAIN
+    #define PINCFG_OPEN_DRAIN 1
+#endif
+#ifndef PINCFG_PUSH_PULL
+    #define PINCFG_PUSH_PULL 0
+#endif
+#ifndef LED_ON
+    #define LED_ON 0
+#endif
+#ifndef LED_OFF
+    #define LED_OFF 1
+#endif
+
+#define CLKI_PIN             B, 0, 32, 1, 2, 5 // Device Pin #28 is RB0
+#define DBGLED_PIN           D, 15, 79, 0, 0, 0 // Device Pin #8 is RD15
+#define DBGPIN_PIN           D, 12, 76, 0, 0, 0 // Device Pin #21 is RD12
+#define ECP03_PIN            A, 3, 0, 1, 2, 3 // Device Pin #17 is RA3
+#define ECP04_PIN            C, 3, 51, 1, 2, 15 // Device Pin #27 is RC3
+#define ECP05_PIN            B, 8, 40, 1, 2, 10 // Device Pin #48 is RB8
+#define ECP06_PIN            B, 2, 34, 1, 0, 0 // Device Pin #33 is RB2
+#define ECP08_PIN            A, 4, 0, 1, 2, 4 // Device Pin #18 is RA4
+#define ECP09_PIN            C, 6, 54, 1, 2, 17 // Device Pin #24 is RC6
+#define ECP10_PIN            B, 7, 39, 1, 2, 2 // Device Pin #47 is RB7
+#define ECP11_PIN            A, 1, 0, 1, 1, 1 // Device Pin #15 is RA1
+#define ECP12_PIN            A, 0, 0, 1, 0, 0 // Device Pin #14 is RA0
+#define ECP13_PIN            D, 11, 75, 1, 2, 19 // Device Pin #30 is RD11
+#define ECP14_PIN            C, 7, 55, 1, 2, 16 // Device Pin #32 is RC7
+#define ECP15_PIN            D, 10, 74, 1, 2, 18 // Device Pin #31 is RD10
+#define ECP16_PIN            C, 0, 48, 1, 2, 12 // Device Pin #13 is RC0
+#define ECP17_PIN            C, 2, 50, 1, 2, 14 // Device Pin #23 is RC2
+#define ECP18_PIN            C, 1, 49, 1, 2, 13 // Device Pin #22 is RC1
+#define ECP19_PIN            A, 2, 0, 1, 2, 9 // Device Pin #16 is RA2
+#define ECP20_PIN            B, 1, 33, 1, 2, 6 // Device Pin #29 is RB1
+#define ECP23_PIN            B, 9, 41, 1, 2, 11 // Device Pin #49 is RB9
+#define ECP24_PIN            C, 8, 56, 0, 0, 0 // Device Pin #36 is RC8
+#define ECP25_PIN            C, 10, 58, 0, 0, 0 // Device Pin #52 is RC10
+#define ECP26_PIN            D, 14, 78, 0, 0, 0 // Device Pin #11 is RD14
+#define ECP27_PIN            C, 11, 59, 0, 0, 0 // Device Pin #53 is RC11
+#define ECP28_PIN            D, 9, 73, 0, 0, 0 // Device Pin #38 is RD9
+#define ECP31_PIN            C, 14, 62, 0, 0, 0 // Device Pin #5 is RC14
+#define ECP32_PIN            C, 9, 57, 0, 0, 0 // Device Pin #37 is RC9
+#define ECP33_PIN            C, 15, 63, 0, 0, 0 // Device Pin #6 is RC15
+#define ECP34_PIN            D, 5, 69, 0, 0, 0 // Device Pin #44 is RD5
+#define ECP35_PIN            C, 4, 52, 0, 0, 0 // Device Pin #50 is RC4
+#define ECP36_PIN            D, 6, 70, 0, 0, 0 // Device Pin #43 is RD6
+#define ECP37_PIN            B, 10, 42, 0, 0, 0 // Device Pin #61 is RB10
+#define ECP38_PIN            C, 5, 53, 0, 0, 0 // Device Pin #51 is RC5
+#define ECP39_PIN            D, 2, 66, 0, 0, 0 // Device Pin #58 is RD2
+#define ECP40_PIN            B, 13, 45, 0, 0, 0 // Device Pin #64 is RB13
+#define ECP41_PIN            B, 11, 43, 0, 0, 0 // Device Pin #62 is RB11
+#define ECP42_PIN            B, 12, 44, 0, 0, 0 // Device Pin #63 is RB12
+#define ECP43_PIN            D, 1, 65, 0, 0, 0 // Device Pin #59 is RD1
+#define ECP44_PIN            D, 0, 64, 0, 0, 0 // Device Pin #60 is RD0
+#define ECP45_PIN            B, 14, 46, 0, 0, 0 // Device Pin #1 is RB14
+#define ECP46_PIN            C, 12, 60, 0, 0, 0 // Device Pin #3 is RC12
+#define ECP47_PIN            B, 15, 47, 0, 0, 0 // Device Pin #2 is RB15
+#define ECP48_PIN            C, 13, 61, 0, 0, 0 // Device Pin #4 is RC13
+#define ECP50_PIN            D, 7, 71, 0, 0, 0 // Device Pin #42 is RD7
+#define ECP51_PIN            B, 4, 36, 0, 0, 0 // Device Pin #35 is RB4
+#define ECP52_PIN            D, 8, 72, 0, 0, 0 // Device Pin #39 is RD8
+#define ECP53_PIN            B, 6, 38, 0, 0, 0 // Device Pin #46 is RB6
+#define ECP54_PIN            D, 13, 77, 0, 0, 0 // Device Pin #12 is RD13
+#define ECP55_PIN            B, 5, 37, 0, 0, 0 // Device Pin #45 is RB5
+#define ECP56_PIN            B, 3, 35, 1, 2, 8 // Device Pin #34 is RB3
+#define SCL_PIN              B, 6, 38, 0, 0, 0 // Device Pin #46 is RB6
+#define SDA_PIN              B, 5, 37, 0, 0, 0 // Device Pin #45 is RB5
+#define UART_RX_PIN          D, 4, 68, 0, 0, 0 // Device Pin #54 is RD4
+#define UART_TX_PIN          D, 3, 67, 0, 0, 0 // Device Pin #55 is RD3
+
+#define RPOR_U1TX        0b000001 // RPn tied to UART1 Transmit
+#define RPOR_U1RTS       0b000010 // RPn tied to UART1 Request-to-Send
+#define RPOR_U2TX        0b000011 // RPn tied to UART2 Transmit
+#define RPOR_U2RTS       0b000100 // RPn tied to UART2 Request-to-Send
+#define RPOR_SDO1        0b000101 // RPn tied to SPI1 Data Output
+#define RPOR_SCK1        0b000110 // RPn tied to SPI1 Clock Output
+#define RPOR_SS1         0b000111 // RPn tied to SPI1 Slave Select
+#define RPOR_SDO2        0b001000 // RPn tied to SPI2 Data Output
+#define RPOR_SCK2        0b001001 // RPn tied to SPI2 Clock Output
+#define RPOR_SS2         0b001010 // RPn tied to SPI2 Slave Select
+#define RPOR_SDO3        0b001011 // RPn tied to SPI3 Data Output
+#define RPOR_SCK3        0b001100 // RPn tied to SPI3 Clock Output
+#define RPOR_SS3         0b001101 // RPn tied to SPI3 Slave Select
+#define RPOR_REFCLKO     0b001110 // RPn tied to Reference Clock Output
+#define RPOR_OCM1        0b001111 // RPn tied to SCCP1 Output
+#define RPOR_OCM2        0b010000 // RPn tied to SCCP2 Output
+#define RPOR_OCM3        0b010001 // RPn tied to SCCP3 Output
+#define RPOR_OCM4        0b010010 // RPn tied to SCCP4 Output
+#define RPOR_OCM5        0b010011 // RPn tied to SCCP5 Output
+#define RPOR_OCM6        0b010100 // RPn tied to SCCP6 Output
+#define RPO_CAN1         0b010101 // RPn tied to CAN1 Output
+#define RPO_CMP1         0b010111 // RPn tied to Comparator 1 Output
+#define RPO_CMP2         0b011000 // RPn tied to Comparator 2 Output
+#define RPO_CMP3         0b011001 // RPn tied to Comparator 3 Output
+#define RPO_U3TX         0b011011 // RPn tied to UART3 Transmit
+#define RPO_U3RTS        0b011100 // RPn tied to UART3 Request-to-Send
+#define RPO_PWM4H        0b100010 // RPn tied to PWM4H Output
+#define RPO_PWM4L        0b100011 // RPn tied to PWM4L Output
+#define RPO_PWMEA        0b100100 // RPn tied to PWM Event A Output
+#define RPO_PWMEB        0b100101 // RPn tied to PWM Event B Output
+#define RPO_QEICMP1      0b100110 // RPn tied to QEI1 Comparator Output
+#define RPO_QEICMP2      0b100111 // RPn tied to QEI2 Comparator Output
+#define RPO_CLC1OUT      0b101000 // RPn tied to CLC1 Output
+#define RPO_CLC2OUT      0b101001 // RPn tied to CLC2 Output
+#define RPO_OCM7         0b101010 // RPn tied to SCCP7 Output
+#define RPO_OCM8         0b101011 // RPn tied to SCCP8 Output
+#define RPO_PWMEC        0b101100 // RPn tied to PWM Event C Output
+#define RPO_PWMED        0b101101 // RPn tied to PWM Event D Output
+#define RPO_PTGTRG24     0b101110 // PTG Trigger Output 24
+#define RPO_PTGTRG25     0b101111 // PTG Trigger Output 25
+#define RPO_SENT1OUT     0b110000 // RPn tied to SENT1 Output
+#define RPO_SENT2OUT     0b110001 // RPn tied to SENT2 Output
+#define RPO_MCCP9A       0b110010 // RPn tied to MCCP9 Output A
+#define RPO_MCCP9B       0b110011 // RPn tied to MCCP9 Output B
+#define RPO_MCCP9C       0b110100 // RPn tied to MCCP9 Output C
+#define RPO_MCCP9D       0b110101 // RPn tied to MCCP9 Output D
+#define RPO_MCCP9E       0b110110 // RPn tied to MCCP9 Output E
+#define RPO_MCCP9F       0b110111 // RPn tied to MCCP9 Output F
+#define RPO_CLC3OUT      0b111011 // RPn tied to CLC4  Output
+#define RPO_CLC4OUT      0b111100 // RPn tied to CLC4  Output
+#define RPO_U1DTR        0b111101 // RPn tied to UART1 DTR
+#define RPO_U2DTR        0b111110 // RPn tied to UART2 DTR
+#define RPO_U3DTR        0b111111 // RPn tied to UART3 DTR
+
+#define MA330048_R30_PIN_LIST(pin) \
+    pin(CLKI) \
+    pin(DBGLED) \
+    pin(DBGPIN) \
+    pin(ECP03) \
+    pin(ECP04) \
+    pin(ECP05) \
+    pin(ECP06) \
+    pin(ECP08) \
+    pin(ECP09) \
+    pin(ECP10) \
+    pin(ECP11) \
+    pin(ECP12) \
+    pin(ECP13) \
+    pin(ECP14) \
+    pin(ECP15) \
+    pin(ECP16) \
+    pin(ECP17) \
+    pin(ECP18) \
+    pin(ECP19) \
+    pin(ECP20) \
+    pin(ECP23) \
+    pin(ECP24) \
+    pin(ECP25) \
+    pin(ECP26) \
+    pin(ECP27) \
+    pin(ECP28) \
+    pin(ECP31) \
+    pin(ECP32) \
+    pin(ECP33) \
+    pin(ECP34) \
+    pin(ECP35) \
+    pin(ECP36) \
+    pin(ECP37) \
+    pin(ECP38) \
+    pin(ECP39) \
+    pin(ECP40) \
+    pin(ECP41) \
+    pin(ECP42) \
+    pin(ECP43) \
+    pin(ECP44) \
+    pin(ECP45) \
+    pin(ECP46) \
+    pin(ECP47) \
+    pin(ECP48) \
+    pin(ECP50) \
+    pin(ECP51) \
+    pin(ECP52) \
+    pin(ECP53) \
+    pin(ECP54) \
+    pin(ECP55) \
+    pin(ECP56) \
+    pin(SCL) \
+    pin(SDA) \
+    pin(UART_RX) \
+    pin(UART_TX)
+
+#endif	/* __MA330048_R30_PINS_H__ */
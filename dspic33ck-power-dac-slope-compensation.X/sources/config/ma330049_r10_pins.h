@@ -0,0 +1,168 @@
+/* ***********************************************************************************************
+ * File:        ma330049_r10_pins.h
+ * Comments:    Hardware abstraction layer device pin descriptors
+ * Board ID:    MA330049_R10
+ *
+ * Description:
+ * This file has been generated from ma330049_r10_pinmap.h by p33c_pingen (sources/host/tools).
+ * Do not edit this file; edit the pinmap header and run the generator again.
+ *
+ * Each pin descriptor <NAME>_PIN expands into 'port, bit, RPn, analog, ADC core, ANx input'
+ * and is used with the pin accessors of p33c_gpio.h (e.g. p33c_Gpio_Set(DBGPIN)).
+ * MA330049_R10_PIN_LIST(pin) calls pin(NAME) for each pin declared in this file.
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __MA330049_R10_PINS_H__
+#define __MA330049_R10_PINS_H__
+
+#define MA330049_PINMAP_VERSION "R10"
+#ifndef PINDIR_INPUT
+    #define PINDIR_INPUT 1
+#endif
+#ifndef PINDIR_OUTPUT
+    #define PINDIR_OUTPUT 0
+#endif
+#ifndef PINSTATE_HIGH
+    #define PINSTATE_HIGH 1
+#endif
+#ifndef PINSTATE_LOW
+    #define PINSTATE_LOW 0
+#endif
+#ifndef PINCFG_OPEN_DRAIN
+    #define PINCFG_OPEN_DRAIN 1
+#endif
+#ifndef PINCFG_PUSH_PULL
+    #define PINCFG_PUSH_PULL 0
+#endif
+#ifndef LED_ON
+    #define LED_ON 0
+#endif
+#ifndef LED_OFF
+    #define LED_OFF 1
+#endif
+
+#if defined (__P33SMPS_CH_MSTR__)
+
+#define DBGLED_PIN           D, 15, 0, 0, 0, 0 // Device Pin #8 is RD15
+#define DBGPIN_PIN           D, 13, 0, 0, 0, 0 // Device Pin #12 is RD13
+#define ECP03_PIN            B, 2, 34, 1, 0, 7 // Device Pin #33 is RB2
+#define ECP04_PIN            C, 7, 55, 0, 0, 0 // Device Pin #32 is RC7
+#define ECP05_PIN            C, 0, 48, 1, 0, 12 // Device Pin #13 is RC0
+#define ECP06_PIN            C, 2, 50, 1, 0, 14 // Device Pin #23 is RC2
+#define ECP08_PIN            C, 3, 51, 0, 0, 0 // Device Pin #27 is RC3
+#define ECP09_PIN            D, 11, 0, 0, 0, 0 // Device Pin #30 is RD11
+#define ECP10_PIN            C, 1, 49, 1, 0, 13 // Device Pin #22 is RC1
+#define ECP11_PIN            A, 2, 0, 1, 0, 2 // Device Pin #16 is RA2
+#define ECP12_PIN            A, 3, 0, 1, 0, 3 // Device Pin #17 is RA3
+#define ECP13_PIN            A, 1, 0, 1, 0, 1 // Device Pin #15 is RA1
+#define ECP14_PIN            A, 4, 0, 1, 0, 4 // Device Pin #18 is RA4
+#define ECP15_PIN            A, 0, 0, 1, 0, 0 // Device Pin #14 is RA0
+#define ECP16_PIN            D, 10, 0, 0, 0, 0 // Device Pin #31 is RD10
+#define ECP17_PIN            D, 12, 0, 0, 0, 0 // Device Pin #21 is RD12
+#define ECP18_PIN            C, 6, 54, 0, 0, 0 // Device Pin #24 is RC6
+#define ECP20_PIN            B, 1, 33, 1, 0, 6 // Device Pin #29 is RB1
+#define ECP24_PIN            C, 8, 56, 0, 0, 0 // Device Pin #36 is RC8
+#define ECP25_PIN            B, 12, 44, 0, 0, 0 // Device Pin #63 is RB12
+#define ECP26_PIN            D, 14, 0, 0, 0, 0 // Device Pin #11 is RD14
+#define ECP27_PIN            B, 13, 45, 0, 0, 0 // Device Pin #64 is RB13
+#define ECP28_PIN            D, 9, 0, 0, 0, 0 // Device Pin #38 is RD9
+#define ECP31_PIN            D, 6, 70, 0, 0, 0 // Device Pin #43 is RD6
+#define ECP32_PIN            C, 9, 57, 0, 0, 0 // Device Pin #37 is RC9
+#define ECP33_PIN            D, 5, 69, 0, 0, 0 // Device Pin #44 is RD5
+#define ECP34_PIN            B, 11, 43, 0, 0, 0 // Device Pin #62 is RB11
+#define ECP35_PIN            B, 14, 46, 0, 0, 0 // Device Pin #1 is RB14
+#define ECP36_PIN            B, 10, 42, 0, 0, 0 // Device Pin #61 is RB10
+#define ECP37_PIN            D, 4, 68, 0, 0, 0 // Device Pin #54 is RD4
+#define ECP38_PIN            B, 15, 47, 0, 0, 0 // Device Pin #2 is RB15
+#define ECP39_PIN            D, 2, 66, 0, 0, 0 // Device Pin #58 is RD2
+#define ECP40_PIN            C, 5, 53, 0, 0, 0 // Device Pin #51 is RC5
+#define ECP41_PIN            D, 3, 67, 0, 0, 0 // Device Pin #55 is RD3
+#define ECP42_PIN            C, 4, 52, 0, 0, 0 // Device Pin #50 is RC4
+#define ECP43_PIN            D, 1, 65, 0, 0, 0 // Device Pin #59 is RD1
+#define ECP44_PIN            D, 0, 64, 0, 0, 0 // Device Pin #60 is RD0
+#define ECP45_PIN            C, 10, 58, 0, 0, 0 // Device Pin #52 is RC10
+#define ECP46_PIN            C, 12, 60, 0, 0, 0 // Device Pin #3 is RC12
+#define ECP47_PIN            C, 11, 59, 0, 0, 0 // Device Pin #53 is RC11
+#define ECP48_PIN            C, 13, 61, 0, 0, 0 // Device Pin #4 is RC13
+#define ECP50_PIN            D, 7, 71, 0, 0, 0 // Device Pin #42 is RD7
+#define ECP52_PIN            D, 8, 0, 0, 0, 0 // Device Pin #39 is RD8
+#define PGC_PIN              B, 4, 36, 0, 0, 0 // Device Pin #35 is RB4
+#define PGD_PIN              B, 3, 35, 1, 0, 8 // Device Pin #34 is RB3
+#define SCL_PIN              B, 6, 38, 0, 0, 0 // Device Pin #46 is RB6
+#define SDA_PIN              B, 5, 37, 0, 0, 0 // Device Pin #45 is RB5
+#define UART_RX_PIN          C, 15, 63, 0, 0, 0 // Device Pin #6 is RC15
+#define UART_TX_PIN          C, 14, 62, 0, 0, 0 // Device Pin #5 is RC14
+#define DP28_PIN             B, 0, 32, 1, 0, 5 // Device Pin #28 is RB0
+#define DP47_PIN             B, 7, 39, 1, 0, 9 // Device Pin #47 is RB7
+#define DP48_PIN             B, 8, 40, 1, 0, 10 // Device Pin #48 is RB8
+#define DP49_PIN             B, 9, 41, 1, 0, 11 // Device Pin #49 is RB9
+#define ECP51_PIN            PGC_PIN // Device Pin #35 is RB4
+#define ECP53_PIN            SCL_PIN // Device Pin #46 is RB6
+#define ECP54_PIN            DBGPIN_PIN // Device Pin #12 is RD13
+#define ECP55_PIN            SDA_PIN // Device Pin #45 is RB5
+#define ECP56_PIN            PGD_PIN // Device Pin #34 is RB3
+
+#define MA330049_R10_PIN_LIST(pin) \
+    pin(DBGLED) \
+    pin(DBGPIN) \
+    pin(ECP03) \
+    pin(ECP04) \
+    pin(ECP05) \
+    pin(ECP06) \
+    pin(ECP08) \
+    pin(ECP09) \
+    pin(ECP10) \
+    pin(ECP11) \
+    pin(ECP12) \
+    pin(ECP13) \
+    pin(ECP14) \
+    pin(ECP15) \
+    pin(ECP16) \
+    pin(ECP17) \
+    pin(ECP18) \
+    pin(ECP20) \
+    pin(ECP24) \
+    pin(ECP25) \
+    pin(ECP26) \
+    pin(ECP27) \
+    pin(ECP28) \
+    pin(ECP31) \
+    pin(ECP32) \
+    pin(ECP33) \
+    pin(ECP34) \
+    pin(ECP35) \
+    pin(ECP36) \
+    pin(ECP37) \
+    pin(ECP38) \
+    pin(ECP39) \
+    pin(ECP40) \
+    pin(ECP41) \
+    pin(ECP42) \
+    pin(ECP43) \
+    pin(ECP44) \
+    pin(ECP45) \
+    pin(ECP46) \
+    pin(ECP47) \
+    pin(ECP48) \
+    pin(ECP50) \
+    pin(ECP52) \
+    pin(PGC) \
+    pin(PGD) \
+    pin(SCL) \
+    pin(SDA) \
+    pin(UART_RX) \
+    pin(UART_TX) \
+    pin(DP28) \
+    pin(DP47) \
+    pin(DP48) \
+    pin(DP49)
+
+#elif defined (__P33SMPS_CH_SLV1__)
+
+#define MA330049_R10_PIN_LIST(pin)
+
+#endif
+
+#endif	/* __MA330049_R10_PINS_H__ */
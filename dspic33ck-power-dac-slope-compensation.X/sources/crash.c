@@ -0,0 +1,321 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: crash.c 
+ * Comments: Persistent crash forensics record of the trap handlers with PWM 
+ *           generator safe state and PWM/DAC register snapshot
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "crash.h"
+
+#if defined (__P33C_HOST__)
+// Host timing model: simulated instruction cycles of the steps of the safe state path
+#define CRASH_HOST_CYCLES(n)    p33c_HostTimer_Advance(n)
+#undef  CRASH_TIMER_READ
+#define CRASH_TIMER_READ()      ((uint16_t)p33c_HostTimer_GetCycles())
+#else
+#define CRASH_HOST_CYCLES(n)
+#endif
+
+#define CRASH_CYCLES_ENTRY      16U     // Trap exception processing, handler prologue and call
+#define CRASH_CYCLES_TEST       5U      // Test of the ON bit of one PWM generator (load, test, branch, loop)
+#define CRASH_CYCLES_OVERRIDE   6U      // Read-modify-write of PGxIOCONL of one running PWM generator
+#define CRASH_CYCLES_EXIT       2U      // Loop exit and timestamp
+
+CRASH_PERSISTENT struct CRASH_RECORD_s crash_record; // Crash record (persistent RAM)
+
+// CRC-16/CCITT-FALSE remainders of all 4-bit values (polynomial 0x1021)
+static const uint16_t crash_crc_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/* @@CRASH_Crc16
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the CRC-16/CCITT-FALSE checksum of a crash record
+ * 
+ * Parameters:
+ *     const struct CRASH_RECORD_s* record: Pointer to the record
+ * 
+ * Returns:
+ *     Checksum of all bytes of the record preceding the checksum field
+ * 
+ * ********************************************************************************/
+
+static uint16_t CRASH_Crc16(const struct CRASH_RECORD_s* record)
+{
+    const uint8_t* data = (const uint8_t*)record;
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+
+    for (i = 0; i < offsetof(struct CRASH_RECORD_s, crc); i++)
+    {
+        crc = (crc << 4) ^ crash_crc_table[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ crash_crc_table[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+
+    return(crc);
+}
+
+/* @@CRASH_Validate
+ * ********************************************************************************
+ * Summary:
+ *     Checks if a crash record is valid
+ * 
+ * Parameters:
+ *     const struct CRASH_RECORD_s* record: Pointer to the record
+ * 
+ * Returns:
+ *     0 = the record is invalid (no trap recorded or corrupted record)
+ *     1 = the record is valid
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t CRASH_Validate(const struct CRASH_RECORD_s* record)
+{
+    if (record == NULL)
+        return(0);
+
+    return((record->magic == CRASH_RECORD_MAGIC) && (record->version == CRASH_RECORD_VERSION) &&
+           (record->size == sizeof(struct CRASH_RECORD_s)) && (record->crc == CRASH_Crc16(record)));
+}
+
+/* @@CRASH_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Validates the crash record at startup
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     A valid crash record of a previous trap is kept unchanged for inspection.
+ *     A partial record of the stack error trap (CRASH_RECORD_MAGIC_STACK) is 
+ *     completed: the trap counter is continued, the fields which are not 
+ *     captured by CRASH_StackError() are cleared and the checksum is added.
+ *     The content of the persistent RAM is random after a power-on reset, so 
+ *     an invalid record is cleared. This function has to be called before the 
+ *     first trap can occur.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t CRASH_Initialize(void)
+{
+    uint16_t i;
+
+    if ((crash_record.magic == CRASH_RECORD_MAGIC_STACK) && 
+        (crash_record.version == CRASH_RECORD_VERSION) && 
+        (crash_record.size == sizeof(struct CRASH_RECORD_s)))
+    {
+        crash_record.magic = CRASH_RECORD_MAGIC;
+        crash_record.count++;
+        crash_record.sp = 0;
+        for (i = 0; i < CRASH_STACK_DEPTH; i++)
+            crash_record.stack[i] = 0;
+        for (i = 0; i < (sizeof(crash_record.pg) >> 1); i++)
+            ((uint16_t*)crash_record.pg)[i] = 0;
+        for (i = 0; i < (sizeof(crash_record.dac) >> 1); i++)
+            ((uint16_t*)crash_record.dac)[i] = 0;
+        crash_record.crc = CRASH_Crc16(&crash_record);
+    }
+
+    if (!CRASH_Validate(&crash_record))
+    {
+        for (i = 0; i < (sizeof(crash_record) >> 1); i++)
+            ((uint16_t*)&crash_record)[i] = 0;
+    }
+
+    return(1);
+}
+
+/* @@CRASH_SafeState
+ * ********************************************************************************
+ * Summary:
+ *     Drives all running PWM generators into their safe override state
+ * 
+ * Parameters:
+ *     uint16_t* ioconl: 
+ *          Pointer to the array receiving the previous PGxIOCONL values 
+ *          (P33C_PG_COUNT elements)
+ * 
+ * Returns:
+ *     Bit mask of the PWM generators running at the time of the call (bit 0 = PG1)
+ * 
+ * Description:
+ *     PGxIOCONL of every running PWM generator is written once with both 
+ *     output overrides enabled, override data LOW and immediate override 
+ *     synchronization, so the outputs are turned off within the PWM cycle. 
+ *     All other bits of PGxIOCONL are kept. Generators which are turned off 
+ *     are not changed.
+ * 
+ * ********************************************************************************/
+
+uint16_t CRASH_SafeState(uint16_t* ioconl)
+{
+    volatile struct P33C_PWM_GENERATOR_s* pg;
+    uint16_t i, active = 0;
+
+    for (i = 0; i < P33C_PG_COUNT; i++)
+    {
+        pg = p33c_PwmGenerator_GetHandle(i + 1);
+        CRASH_HOST_CYCLES(CRASH_CYCLES_TEST);
+        
+        ioconl[i] = pg->PGxIOCONL.value;
+        if (pg->PGxCONL.bits.ON)
+        {
+            pg->PGxIOCONL.value = ((ioconl[i] & ~CRASH_IOCONL_OVR_MASK) | CRASH_IOCONL_OVR_SAFE);
+            active |= (1U << i);
+            CRASH_HOST_CYCLES(CRASH_CYCLES_OVERRIDE);
+        }
+    }
+
+    CRASH_HOST_CYCLES(CRASH_CYCLES_EXIT);
+    return(active);
+}
+
+/* @@CRASH_Trap
+ * ********************************************************************************
+ * Summary:
+ *     Applies the PWM safe state and writes the crash record
+ * 
+ * Parameters:
+ *     uint16_t code:
+ *          Trap error code (TRAPS_ERROR_CODE)
+ *     const uint16_t* sp:
+ *          Stack pointer (W15) of the trap handler (NULL = stack not captured)
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     This function is called by the trap handlers before the trap flag is 
+ *     cleared. The safe state of the PWM generators is applied first and the
+ *     time from the entry of this function to the safe state is recorded. 
+ *     The trap counter is continued when the previous record is valid. The 
+ *     stack is not read when the stack pointer is NULL. The stack error trap 
+ *     calls CRASH_StackError() instead.
+ * 
+ * ********************************************************************************/
+
+void CRASH_Trap(uint16_t code, const uint16_t* sp)
+{
+    uint16_t ioconl[P33C_PG_COUNT];
+    uint16_t start, safe, active, count, i;
+
+    start = CRASH_TIMER_READ();
+    CRASH_HOST_CYCLES(CRASH_CYCLES_ENTRY); // host timing model includes the trap entry
+
+    // Power stage first: turn off all PWM outputs
+    active = CRASH_SafeState(ioconl);
+    safe = CRASH_TIMER_READ();
+
+    // Trap context (the previous record is checked before it is modified)
+    count = (CRASH_Validate(&crash_record)) ? crash_record.count : 0;
+    crash_record.magic = CRASH_RECORD_MAGIC;
+    crash_record.version = CRASH_RECORD_VERSION;
+    crash_record.size = sizeof(struct CRASH_RECORD_s);
+    crash_record.count = count + 1;
+    crash_record.code = code;
+    crash_record.intcon1 = INTCON1;
+    crash_record.intcon3 = INTCON3;
+    crash_record.intcon4 = INTCON4;
+    crash_record.sp = (uint16_t)(uintptr_t)sp;
+    crash_record.splim = SPLIM;
+    for (i = 0; i < CRASH_STACK_DEPTH; i++)
+        crash_record.stack[i] = (sp != NULL) ? sp[-1 - (int16_t)i] : 0;
+    crash_record.active = active;
+    crash_record.safe_cycles = (uint16_t)(safe - start);
+    crash_record.pclkcon = PCLKCON;
+
+    // PWM generator and DAC instance register sets
+    for (i = 0; i < P33C_PG_COUNT; i++)
+    {
+        crash_record.ioconl[i] = ioconl[i];
+        p33c_PwmGenerator_ConfigReadRef(i + 1, &crash_record.pg[i]);
+    }
+    for (i = 0; i < P33C_DAC_COUNT; i++)
+        p33c_DacInstance_ConfigReadRef(i + 1, &crash_record.dac[i]);
+
+    crash_record.crc = CRASH_Crc16(&crash_record);
+}
+
+/* @@CRASH_StackError
+ * ********************************************************************************
+ * Summary:
+ *     Applies the PWM safe state and records the trap code of a stack error
+ * 
+ * Parameters:
+ *     uint16_t code:
+ *          Trap error code (TRAPS_ERROR_CODE)
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     This function is called by the stack error trap handler on the small
+ *     failsafe stack instead of CRASH_Trap(). It has no local arrays and only
+ *     calls CRASH_SafeState(), which writes the previous PGxIOCONL values 
+ *     directly into the crash record. Only the trap code, INTCON1/3/4, the
+ *     active generators and the safe state latency are recorded; the previous
+ *     record is not validated and no register sets and checksum are written.
+ *     The record is marked with CRASH_RECORD_MAGIC_STACK and completed by 
+ *     CRASH_Initialize() after the next reset, the trap counter is continued 
+ *     from the counter field without validation.
+ * 
+ * ********************************************************************************/
+
+void CRASH_StackError(uint16_t code)
+{
+    uint16_t start;
+
+    start = CRASH_TIMER_READ();
+    CRASH_HOST_CYCLES(CRASH_CYCLES_ENTRY); // host timing model includes the trap entry
+
+    // Power stage first: turn off all PWM outputs
+    crash_record.magic = 0; // incomplete until the trap context has been written
+    crash_record.active = CRASH_SafeState(crash_record.ioconl);
+    crash_record.safe_cycles = (uint16_t)(CRASH_TIMER_READ() - start);
+
+    // Trap context
+    crash_record.code = code;
+    crash_record.intcon1 = INTCON1;
+    crash_record.intcon3 = INTCON3;
+    crash_record.intcon4 = INTCON4;
+    crash_record.splim = SPLIM; // limit of the failsafe stack
+    crash_record.pclkcon = PCLKCON;
+    crash_record.version = CRASH_RECORD_VERSION;
+    crash_record.size = sizeof(struct CRASH_RECORD_s);
+    crash_record.magic = CRASH_RECORD_MAGIC_STACK;
+}
+
+// ________________________
+// end of file
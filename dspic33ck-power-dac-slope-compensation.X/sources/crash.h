@@ -0,0 +1,114 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: crash.h 
+ * Comments: Header file of the crash forensics record source file crash.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_CRASH_RECORD_H
+#define	XC_CRASH_RECORD_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "common/p33c_pwm.h"
+#include "common/p33c_dac.h"
+#include "common/p33c_profile.h"
+
+ /* *********************************************************************************
+ * CRASH FORENSICS RECORD DECLARATIONS
+ * *********************************************************************************
+ * Every trap handler of traps.c calls CRASH_Trap() before the trap flag is cleared.
+ * CRASH_Trap() first drives all running PWM generators into their safe override 
+ * state (both outputs LOW, override applied immediately instead of at the next 
+ * start of cycle), which takes a bounded number of instruction cycles independent
+ * of the state of the firmware: the generators are checked in a fixed loop without 
+ * waits. Then the trap context and the register sets of all PWM generators and DAC
+ * instances are copied into the crash record, which is protected by a checksum.
+ * 
+ * The crash record is located in persistent RAM, which is not initialized by the
+ * C runtime startup code, so it survives any reset except power-on and brown-out 
+ * resets. CRASH_Initialize() validates the record at startup; a valid record is 
+ * kept for inspection by the debugger or a host decoder until the next trap, 
+ * an invalid record is cleared.
+ * 
+ * The stack error trap runs on a 64-byte failsafe stack, which cannot hold the call
+ * chain of CRASH_Trap(). It calls CRASH_StackError() instead, which only applies 
+ * the safe state and records the trap code without stack variables. This partial 
+ * record is completed with the checksum by CRASH_Initialize() after the next reset.
+ * ********************************************************************************/
+
+#define CRASH_RECORD_MAGIC      0xC4A5U // Record identifier
+#define CRASH_RECORD_MAGIC_STACK 0xC4A6U // Partial record of the stack error trap (completed at startup)
+#define CRASH_RECORD_VERSION    1U      // Record layout version
+#define CRASH_STACK_DEPTH       8U      // Number of stack words captured below the stack pointer
+#define CRASH_SAFE_CYCLES_MAX   128U    // Upper limit of the trap to safe state latency in [instruction cycles]
+
+#define CRASH_TIMER_READ()      P33C_PROFILE_TIMER_READ() // Free-running timer in [instruction cycles]
+
+// Safe override state of PGxIOCONL: OVRENH=1, OVRENL=1, OVRDAT=0b00, OSYNC=0b01 (immediate)
+#define CRASH_IOCONL_OVR_MASK   0x3F00U // OVRENH, OVRENL, OVRDAT[1:0], OSYNC[1:0]
+#define CRASH_IOCONL_OVR_SAFE   0x3100U
+
+#if defined (__P33C_HOST__)
+#define CRASH_PERSISTENT
+#else
+#define CRASH_PERSISTENT        __attribute__((persistent)) // Not initialized by the C runtime startup code
+#endif
+
+/* Crash forensics record */
+struct CRASH_RECORD_s {
+    uint16_t magic;         // Record identifier (CRASH_RECORD_MAGIC)
+    uint16_t version;       // Record layout version (CRASH_RECORD_VERSION)
+    uint16_t size;          // Record size in [byte]
+    uint16_t count;         // Number of traps recorded since the record has been cleared
+    uint16_t code;          // Trap error code (TRAPS_ERROR_CODE)
+    uint16_t intcon1;       // INTCON1 at trap entry (OSCFAIL, STKERR, ADDRERR, MATHERR)
+    uint16_t intcon3;       // INTCON3 at trap entry (NAE, DOOVR, APLL, DAE)
+    uint16_t intcon4;       // INTCON4 at trap entry (SGHT)
+    uint16_t sp;            // Stack pointer (W15) of the trap handler
+    uint16_t splim;         // Stack pointer limit (SPLIM)
+    uint16_t stack[CRASH_STACK_DEPTH]; // Stack words below the stack pointer, most recent first (stack error: not captured)
+    uint16_t active;        // PWM generators running at trap entry (bit 0 = PG1)
+    uint16_t safe_cycles;   // Trap entry to safe state of all PWM generators in [instruction cycles]
+    uint16_t pclkcon;       // PWM clock control register (HRRDY, HRERR, LOCK)
+    uint16_t ioconl[P33C_PG_COUNT]; // PGxIOCONL before the safe override state has been applied
+    struct P33C_PWM_GENERATOR_s pg[P33C_PG_COUNT]; // PWM generator register sets (safe override state applied)
+    struct P33C_DAC_INSTANCE_s dac[P33C_DAC_COUNT]; // DAC instance register sets
+    uint16_t crc;           // CRC-16/CCITT-FALSE of all preceding bytes
+};
+typedef struct CRASH_RECORD_s CRASH_RECORD_t;
+
+extern struct CRASH_RECORD_s crash_record; // Crash record (persistent RAM)
+
+extern volatile uint16_t CRASH_Initialize(void);
+extern volatile uint16_t CRASH_Validate(const struct CRASH_RECORD_s* record);
+extern uint16_t CRASH_SafeState(uint16_t* ioconl);
+extern void CRASH_Trap(uint16_t code, const uint16_t* sp);
+extern void CRASH_StackError(uint16_t code);
+
+#endif	/* XC_CRASH_RECORD_H */
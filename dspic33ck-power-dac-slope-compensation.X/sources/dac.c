@@ -34,6 +34,8 @@
 
 #include "config/demo.h"
 #include "dac.h"
+#include "common/p33c_profile.h"
+#include "boot.h"
 
 /* Declaration of user-defined DAC instance */
 volatile struct P33C_DAC_INSTANCE_s* my_dac; // User-specified DAC instance
@@ -46,15 +48,18 @@ volatile uint16_t DAC_Initialize(void){
 
     volatile uint16_t retval=1;
 
+    BOOT_STAGE_BEGIN(BOOT_STAGE_DAC);
+    P33C_PROFILE_BEGIN(P33C_PROFILE_DAC_INITIALIZE);
+
     my_dac_module = p33c_DacModule_GetHandle();
-    retval &= p33c_DacModule_ConfigWrite(dacModuleConfigClear);
+    retval &= p33c_DacModule_ConfigWriteRef(&dacModuleConfigClear);
 
     my_dac_module->DacModuleCtrl1L.bits.CLKSEL =0b10;  // DAC Clock Source: AFPLLO  
-    my_dac_module->DacModuleCtrl2H.bits.SSTIME = (DAC_SSTIME & 0x0FFF); // Transition Mode Duration (default 0x55 = 340ns @ 500 MHz)     
-    my_dac_module->DacModuleCtrl2L.bits.TMODTIME = (DAC_TMODTIME  & 0x03FF); // Time from Start of Transition Mode until Steady-State Filter is Enabled (default 0x8A = 552ns @ 500 MHz)
+    my_dac_module->DacModuleCtrl2H.bits.SSTIME = DAC_SSTIME;   // Transition Mode Duration (default 0x55 = 340ns @ 500 MHz)     
+    my_dac_module->DacModuleCtrl2L.bits.TMODTIME = DAC_TMODTIME;   // Time from Start of Transition Mode until Steady-State Filter is Enabled (default 0x8A = 552ns @ 500 MHz)
 
     my_dac = p33c_DacInstance_GetHandle(DAC_INSTANCE); //// user-defined DAC 1 object 
-    retval &= p33c_DacInstance_ConfigWrite(DAC_INSTANCE, dacConfigClear);
+    retval &= p33c_DacInstance_ConfigWriteRef(DAC_INSTANCE, &dacConfigClear);
 
     #if defined (__MA330048_dsPIC33CK_DPPIM__)
     my_dac->SLPxCONL.bits.SLPSTOPA = 0b0001; // Slope Stop A Signal: PWM1 Trigger 2
@@ -68,10 +73,55 @@ volatile uint16_t DAC_Initialize(void){
     
     my_dac->DACxDATH.value = DACOUT_VALUE_HIGH_1;   // specifies the high DACx data value
     my_dac->DACxDATL.value = 0;  // In Hysteretic mode, Slope Generator mode and Triangle mode, this register specifies the low data value and/or limit for the DACx module
-    my_dac->DACxCONH.value = DAC_LEADING_EDGE_BLNK; // Set DAC Leading Edge Blanking period
+    my_dac->DACxCONH.bits.TMCB = DAC_TMCB; // Set DAC Leading Edge Blanking period
     
     my_dac->SLPxCONH.bits.SLOPEN = 1;      // Slope Function: Enable slope function; 
 
+    // Host model: module and instance register sets, 8 bit fields and 3 values written
+    BOOT_HOST_WRITES(BOOT_REGSET_WRITES(struct P33C_DAC_MODULE_s) + BOOT_REGSET_WRITES(struct P33C_DAC_INSTANCE_s) + 11U);
+
+    P33C_PROFILE_END(P33C_PROFILE_DAC_INITIALIZE);
+    BOOT_STAGE_END(BOOT_STAGE_DAC);
+
+    return(retval);
+
+}
+
+/* @@DAC_Restore
+ * ********************************************************************************
+ * Summary:
+ *     Applies a retained DAC module and DAC instance configuration
+ * 
+ * Parameters:
+ *     const struct P33C_DAC_MODULE_s* module: DAC module register set
+ *     const struct P33C_DAC_INSTANCE_s* config: Register set of the user DAC instance
+ * 
+ * Returns:
+ *     0 = failure
+ *     1 = success
+ * 
+ * Description:
+ *     Replaces DAC_Initialize() on the warm restart path (see boot.c). The DAC 
+ *     is turned on by DAC_Enable().
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t DAC_Restore(const struct P33C_DAC_MODULE_s* module, const struct P33C_DAC_INSTANCE_s* config) {
+
+    volatile uint16_t retval=1;
+
+    BOOT_STAGE_BEGIN(BOOT_STAGE_DAC);
+
+    my_dac_module = p33c_DacModule_GetHandle();
+    retval &= p33c_DacModule_ConfigWriteRef(module);
+
+    my_dac = p33c_DacInstance_GetHandle(DAC_INSTANCE);
+    retval &= p33c_DacInstance_ConfigWriteRef(DAC_INSTANCE, config);
+
+    BOOT_HOST_WRITES(BOOT_REGSET_WRITES(struct P33C_DAC_MODULE_s) + BOOT_REGSET_WRITES(struct P33C_DAC_INSTANCE_s));
+
+    BOOT_STAGE_END(BOOT_STAGE_DAC);
+
     return(retval);
 
 }
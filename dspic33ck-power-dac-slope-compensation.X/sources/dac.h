@@ -36,6 +36,7 @@
 #include "common/p33c_dac.h"
 
 extern volatile uint16_t DAC_Initialize(void);
+extern volatile uint16_t DAC_Restore(const struct P33C_DAC_MODULE_s* module, const struct P33C_DAC_INSTANCE_s* config);
 extern volatile uint16_t DAC_Enable(void);
 extern volatile uint16_t DAC_Disable(void);
 
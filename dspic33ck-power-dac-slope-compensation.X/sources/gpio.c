@@ -0,0 +1,83 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: gpio.c 
+ * Comments: Port register configuration of all device pins with the board pins
+ *           folded into one precomputed register value per port
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "gpio.h"
+#include "boot.h"
+
+// Port configuration table: default values of the MCC Pin Manager with the pins of GPIO_BOARD_PINS applied
+const struct P33C_GPIO_PORT_CONFIG_s gpio_port_config[GPIO_PORT_COUNT] = {
+    //                                     port               LATx    ODCx    CNPUx   CNPDx   ANSELx  TRISx
+    p33c_GpioPort_Config(GPIO_BOARD_PINS, P33C_GPIO_PORT_A, 0x0000, 0x0000, 0x0000, 0x0000, 0x001F, 0x001F),
+    p33c_GpioPort_Config(GPIO_BOARD_PINS, P33C_GPIO_PORT_B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0385, 0xFFFD),
+    p33c_GpioPort_Config(GPIO_BOARD_PINS, P33C_GPIO_PORT_C, 0x0000, 0x0000, 0x0000, 0x0000, 0x00CF, 0xFFFF),
+    p33c_GpioPort_Config(GPIO_BOARD_PINS, P33C_GPIO_PORT_D, 0x0000, 0x0000, 0x0000, 0x0000, 0x2C00, 0xFFFF)
+};
+
+/* @@GPIO_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Configures all device pins with one write access per port register
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, the port configuration table is invalid
+ *     1 = success
+ * 
+ * Description:
+ *     The port configuration table holds the LATx, ODCx, CNPUx, CNPDx, ANSELx 
+ *     and TRISx values of PORTA to PORTD, which have been folded at compile 
+ *     time from the default settings of the MCC Pin Manager and the function 
+ *     pins of GPIO_BOARD_PINS. This replaces the sequence of whole-port writes 
+ *     in PIN_MANAGER_Initialize() followed by read-modify-write accesses of the
+ *     individual pins. main() calls this function after SYSTEM_InitializeStart(),
+ *     which does not configure the pins, while the PLLs lock. SYSTEM_Initialize()
+ *     still calls PIN_MANAGER_Initialize() for applications using the MCC 
+ *     startup sequence.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t GPIO_Initialize(void) {
+
+    volatile uint16_t retval=1;
+
+    BOOT_STAGE_BEGIN(BOOT_STAGE_PINS);
+    retval &= p33c_GpioPorts_Initialize(gpio_port_config, GPIO_PORT_COUNT);
+    BOOT_STAGE_END(BOOT_STAGE_PINS);
+    
+    return(retval); // Return 1=success, 0=failure
+}
+
+// ________________________
+// end of file
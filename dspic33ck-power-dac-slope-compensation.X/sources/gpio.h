@@ -0,0 +1,67 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: gpio.h 
+ * Comments: Header file of the board pin configuration source file gpio.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_GPIO_INITIALIZATION_H
+#define	XC_GPIO_INITIALIZATION_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/hal.h"
+
+ /* *********************************************************************************
+ * BOARD PIN LIST
+ * *********************************************************************************
+ * DP PIM and DP DevBoard function pins used by this demo with their configuration
+ * mode (see p33c_gpio.h). The list is folded into the precomputed port register 
+ * values of gpio_port_config[] at compile time, so new pins only need to be added
+ * here. Pins not listed keep the default values of the port configuration table.
+ * ********************************************************************************/
+
+#define GPIO_BOARD_PINS(entry, reg, port) \
+    entry(reg, port, DBGPIN, P33C_GPIO_MODE_OUTPUT_LOW) /* Debug pin (oscilloscope trigger) */ \
+    entry(reg, port, DBGLED, P33C_GPIO_MODE_OUTPUT_LOW) /* On-board LED */ \
+    entry(reg, port, SW,     P33C_GPIO_MODE_INPUT)      /* On-board push button */ \
+    entry(reg, port, TP03,   P33C_GPIO_MODE_OUTPUT_LOW) /* Test point TP03 */ \
+    entry(reg, port, TP05,   P33C_GPIO_MODE_OUTPUT_LOW) /* Test point TP05: telemetry UART TX */
+
+#define GPIO_PORT_COUNT     4U  // Number of ports configured at startup (PORTA ... PORTD)
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern const struct P33C_GPIO_PORT_CONFIG_s gpio_port_config[GPIO_PORT_COUNT];
+
+extern volatile uint16_t GPIO_Initialize(void);
+
+
+#endif	/* XC_GPIO_INITIALIZATION_H */
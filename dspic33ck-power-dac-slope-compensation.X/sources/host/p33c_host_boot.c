@@ -0,0 +1,438 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_boot.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the cold boot and warm restart path selection
+ *
+ * Description:
+ * This source file verifies BOOT_Decide() for every combination of reset cause flags 
+ * against valid, corrupted, foreign and outdated retained configuration images and 
+ * runs the boot sequences of main() on the simulated register file:
+ *
+ *   - power-on reset: cold boot path, image captured after PWM_Initialize() and 
+ *     DAC_Initialize()
+ *   - software and watchdog reset: warm restart path, the PWM and DAC register sets
+ *     restored from the image equal the register sets of the cold boot path
+ *   - external reset, corrupted image, trap recorded since the image capture and 
+ *     failed warm restart (high resolution clock not ready): cold boot path
+ *   - power-on reset with PLL lock delays: pins, PWM and DAC are configured while 
+ *     the PLLs lock, PWM and DAC are enabled after the auxiliary PLL has locked and
+ *     before the system clock switch has completed; the boot to first PWM edge time
+ *     is compared with the sequential order (SYSTEM_Initialize() first)
+ *   - power-on reset with the system PLL locking before the auxiliary PLL: the 
+ *     clock switch completes while the PWM enable request is pending, the request
+ *     completes on HRRDY instead of timing out
+ *
+ * PCLKCON.HRRDY is set by the oscillator model when the auxiliary PLL locks 
+ * (p33c_host_clock.c). As PWM_Initialize() overwrites the simulated status bit, it is 
+ * set again afterwards if the auxiliary PLL has already locked, and is therefore also 
+ * restored from the image by the warm restart path. The failed warm restart is 
+ * simulated by an image with HRRDY cleared.
+ *
+ * The boot sequences run on simulated time (p33c_HostTimer_SetSimulated()): the lock
+ * delays and the profiler timer advance by a modelled cost of every timer and status 
+ * register read, so the comparison of the sequential and the overlapped order only
+ * depends on the simulated PLL lock delays and on the polls of the boot sequence and 
+ * not on the load of the host. The boot to first PWM edge times of both paths and the
+ * boot profile tables of the initialization stages are reported and checked for 
+ * consistency, the ADC and telemetry initialization is not included. As simulated time
+ * does not include the execution time of the register writes, the saving of the warm
+ * restart path is verified by the number of PWM and DAC register writes counted by the
+ * host model of the initialization and restore functions (BOOT_HOST_WRITES(), boot.h).
+ *
+ * See Also:
+ *	boot.c, p33c_host_clock.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <string.h>
+
+#include "config/demo.h"
+#include "boot.h"
+#include "pwm.h"
+#include "dac.h"
+#include "crash.h"
+#include "gpio.h"
+#include "../mcc_generated_files/system.h"
+#include "../mcc_generated_files/clock.h"
+#include "../mcc_generated_files/traps.h"
+#include "p33c_host_tlm.h"
+
+#define P33C_HOST_BOOT_VARIANTS 7U  // Number of retained image variants
+#define P33C_HOST_BOOT_PLL_LOCK_NS  500000UL // Simulated lock delay of the system PLL in [ns]
+#define P33C_HOST_BOOT_APLL_LOCK_NS 150000UL // Simulated lock delay of the auxiliary PLL in [ns]
+
+// Reset cause flags and unrelated RCON status bits (IDLE, SLEEP, VREGS) combined in the decision table
+static const uint16_t p33c_HostBootRconBits[11] = {
+    BOOT_RCON_POR, BOOT_RCON_BOR, BOOT_RCON_WDTO, BOOT_RCON_SWR, BOOT_RCON_EXTR,
+    BOOT_RCON_CM, BOOT_RCON_IOPUWR, BOOT_RCON_TRAPR, 0x0004U, 0x0008U, 0x0100U
+};
+
+/* Register sets compared between the boot paths */
+struct P33C_HOST_BOOT_REGS_s {
+    struct P33C_PWM_MODULE_s pwm;
+    struct P33C_PWM_GENERATOR_s pg;
+    struct P33C_DAC_MODULE_s dac_module;
+    struct P33C_DAC_INSTANCE_s dac;
+};
+
+/* Signs an image after one of its fields has been changed */
+static void p33c_HostBoot_Sign(struct BOOT_IMAGE_s* image)
+{
+    image->crc = p33c_HostTlm_Crc16((const uint8_t*)image, offsetof(struct BOOT_IMAGE_s, crc));
+}
+
+/* Derives an image variant from a valid image, returns the expected reason of a warm reset */
+static uint16_t p33c_HostBoot_Variant(struct BOOT_IMAGE_s* image, uint16_t variant)
+{
+    switch (variant)
+    {
+        case 1: image->magic ^= 0x0100U; return(BOOT_REASON_NO_IMAGE);
+        case 2: image->pg.PGxPER.value ^= 0x0001U; return(BOOT_REASON_NO_IMAGE); // not signed
+        case 3: image->version++; p33c_HostBoot_Sign(image); return(BOOT_REASON_NO_IMAGE);
+        case 4: image->build ^= 0x5555U; p33c_HostBoot_Sign(image); return(BOOT_REASON_BUILD);
+        case 5: image->pg_instance++; p33c_HostBoot_Sign(image); return(BOOT_REASON_BUILD);
+        case 6: image->crashes++; p33c_HostBoot_Sign(image); return(BOOT_REASON_FAULT);
+        default: return(BOOT_REASON_WARM);
+    }
+}
+
+/* Simulates a device reset: all registers reset, reset cause flags set */
+static void p33c_HostBoot_Reset(uint16_t rcon)
+{
+    p33c_HostSfr_Reset();
+    OSCCON = 0x0000; // device reset: FRC oscillator, no clock switch pending
+    RCON = rcon;
+}
+
+/* Executes the cold boot steps of PWM and DAC up to the first PWM edge */
+static void p33c_HostBoot_Cold(void)
+{
+    PWM_Initialize();
+    PCLKCONbits.HRRDY = ACLKCON1bits.APLLCK; // read-only status bit overwritten by PWM_Initialize()
+    DAC_Initialize();
+    BOOT_Capture();
+    PWM_EnableStart();
+    PWM_EnableWait();
+    DAC_Enable();
+    BOOT_FirstEdge();
+}
+
+/* Executes the boot sequence of main() up to the system clock switch (ADC and telemetry not included) */
+static void p33c_HostBoot_Run(void)
+{
+    BOOT_Initialize();
+    SYSTEM_InitializeStart();
+    GPIO_Initialize();
+
+    if (boot.path == BOOT_PATH_WARM)
+        BOOT_WarmStart();
+
+    if (boot.path == BOOT_PATH_COLD)
+        p33c_HostBoot_Cold();
+
+    SYSTEM_InitializeWait();
+}
+
+/* Executes the cold boot path with the blocking clock switch before the peripheral setup */
+static void p33c_HostBoot_RunSequential(void)
+{
+    BOOT_Initialize();
+    SYSTEM_Initialize();
+    GPIO_Initialize();
+    p33c_HostBoot_Cold();
+}
+
+#if (BOOT_PROFILE_ENABLE)
+static const char* p33c_HostBootStageName[BOOT_STAGE_COUNT] = {
+    "pins", "interrupt", "clock", "tmr1", "pwm", "hrrdy", "dac"
+};
+
+/* Prints the boot profile table and checks the stage timing for consistency */
+static uint16_t p33c_HostBoot_Profile(const char* name)
+{
+    const volatile struct BOOT_STAGE_s* st;
+    uint16_t i, k, ok = 1;
+    uint32_t end, sum = 0;
+
+    printf("  boot profile (%s, first PWM edge after %.2f us):\n", name, 
+                (double)boot_profile.first_edge_ns / 1000.0);
+    printf("    stage      start [us]  time [us]  passes\n");
+
+    for (i = 0; i < BOOT_STAGE_COUNT; i++)
+    {
+        st = &boot_profile.stage[i];
+        printf("    %-9s %11.2f %10.2f %7u\n", p33c_HostBootStageName[i], 
+                    (double)st->start_ns / 1000.0, (double)st->time_ns / 1000.0, (unsigned)st->count);
+
+        // Every stage is executed once, the stages do not overlap (except the 
+        // clock switch, which completes in the background)
+        ok &= (st->count == 1);
+        end = st->start_ns + st->time_ns;
+        for (k = 0; k < BOOT_STAGE_COUNT; k++)
+            if ((k != i) && (i != BOOT_STAGE_CLOCK) && (k != BOOT_STAGE_CLOCK) && 
+                (boot_profile.stage[k].start_ns >= st->start_ns))
+                ok &= (boot_profile.stage[k].start_ns >= end);
+        if (i != BOOT_STAGE_CLOCK)
+            sum += st->time_ns;
+    }
+    ok &= (boot_profile.path == boot.path) && (boot_profile.reason == boot.reason) && 
+          (boot_profile.first_edge_ns == boot.first_edge_ns) && (sum <= boot.elapsed_ns);
+    printf("    %s\n", (ok) ? "ok" : "FAILED");
+
+    return(ok);
+}
+#endif
+
+/* Reads the register sets of the user PWM generator and DAC instance */
+static void p33c_HostBoot_Read(struct P33C_HOST_BOOT_REGS_s* regs)
+{
+    p33c_PwmModule_ConfigReadRef(&regs->pwm);
+    p33c_PwmGenerator_ConfigReadRef(PWM_GENERATOR, &regs->pg);
+    p33c_DacModule_ConfigReadRef(&regs->dac_module);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &regs->dac);
+}
+
+/* Prints the result of one boot scenario */
+static uint16_t p33c_HostBoot_Check(const char* name, uint16_t path, uint16_t reason, uint16_t ok)
+{
+    ok &= (boot.path == path) && (boot.reason == reason) && ((RCON & BOOT_RCON_CAUSES) == 0);
+    printf("  %s: %s path (reason %u), first PWM edge after %.2f us, %s\n", name, 
+                (boot.path == BOOT_PATH_WARM) ? "warm" : "cold", (unsigned)boot.reason,
+                (double)boot.first_edge_ns / 1000.0, (ok) ? "ok" : "FAILED");
+    return(ok);
+}
+
+/* @@p33c_Host_VerifyBoot
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the boot path selection and the warm restart path
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure
+ *     1 = success
+ * 
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyBoot(void)
+{
+    static uint16_t sfr[P33C_HOST_SFR_SIZE >> 1];
+    struct BOOT_IMAGE_s valid, image;
+    struct P33C_HOST_BOOT_REGS_s cold, warm;
+    uint16_t combo, variant, rcon, expected, reason, i;
+    uint16_t cases = 0, errors = 0, warm_count = 0, ok, retval = 1;
+    uint32_t cold_ns, warm_ns, seq_ns, async_ns, cold_writes, warm_writes;
+    struct P33C_HOST_CLOCK_LOCK_s lock;
+
+    printf("boot path\n");
+
+    memcpy(sfr, (const void*)p33c_HostSfrFile, sizeof(sfr));
+    memset(&crash_record, 0, sizeof(crash_record));
+    p33c_HostTimer_SetSimulated(true);
+
+    // Power-on reset with undefined retained RAM: cold boot path, image captured
+    memset(&boot_image, 0xA5, sizeof(boot_image));
+    p33c_HostBoot_Reset(BOOT_RCON_POR | BOOT_RCON_BOR);
+    p33c_HostSfrWrites = 0;
+    p33c_HostBoot_Run();
+    p33c_HostBoot_Read(&cold);
+    cold_ns = boot.first_edge_ns;
+    cold_writes = p33c_HostSfrWrites;
+    ok = BOOT_Validate(&boot_image) && (boot_image.cold_ns == cold_ns) && (boot_image.warm_count == 0) &&
+         (my_pg1->PGxCONL.bits.ON) && (my_dac->DACxCONL.bits.DACEN);
+    retval &= p33c_HostBoot_Check("power-on reset", BOOT_PATH_COLD, BOOT_REASON_POWER_ON, ok);
+#if (BOOT_PROFILE_ENABLE)
+    retval &= p33c_HostBoot_Profile("cold boot");
+#endif
+    memcpy(&valid, &boot_image, sizeof(valid));
+
+    // Decision table: all reset cause combinations against all image variants
+    for (combo = 0; combo < (1U << 11); combo++)
+    {
+        rcon = 0;
+        for (i = 0; i < 11; i++)
+            rcon |= (combo & (1U << i)) ? p33c_HostBootRconBits[i] : 0;
+
+        for (variant = 0; variant < P33C_HOST_BOOT_VARIANTS; variant++)
+        {
+            memcpy(&image, &valid, sizeof(image));
+            expected = p33c_HostBoot_Variant(&image, variant);
+            if (rcon & (BOOT_RCON_POR | BOOT_RCON_BOR))
+                expected = BOOT_REASON_POWER_ON;
+            else if (rcon & (BOOT_RCON_TRAPR | BOOT_RCON_IOPUWR | BOOT_RCON_CM))
+                expected = BOOT_REASON_FAULT;
+            else if ((rcon & BOOT_RCON_EXTR) || (!(rcon & (BOOT_RCON_WDTO | BOOT_RCON_SWR))))
+                expected = BOOT_REASON_EXTERNAL;
+
+            reason = BOOT_Decide(rcon, &image, BOOT_GetBuild(), 0);
+            errors += (reason != expected);
+            warm_count += (reason == BOOT_REASON_WARM);
+            cases++;
+        }
+    }
+    ok = (errors == 0) && (warm_count == 24); // WDTO/SWR combinations with IDLE, SLEEP, VREGS x valid image
+    printf("  decision table: %u cases, %u warm, %u mismatches, %s\n", 
+                (unsigned)cases, (unsigned)warm_count, (unsigned)errors, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Software reset: warm restart path restores the register sets of the cold boot path
+    p33c_HostBoot_Reset(BOOT_RCON_SWR);
+    p33c_HostSfrWrites = 0;
+    p33c_HostBoot_Run();
+    p33c_HostBoot_Read(&warm);
+    warm_ns = boot.first_edge_ns;
+    warm_writes = p33c_HostSfrWrites;
+    ok = (memcmp(&cold, &warm, sizeof(cold)) == 0) && (boot_image.warm_count == 1) && 
+         (boot_image.warm_ns == warm_ns) && (boot_image.cold_ns == cold_ns) && (OSCCONbits.COSC == 0b001);
+    retval &= p33c_HostBoot_Check("software reset", BOOT_PATH_WARM, BOOT_REASON_WARM, ok);
+#if (BOOT_PROFILE_ENABLE)
+    // PWM and DAC are running before SYSTEM_InitializeWait()
+    retval &= p33c_HostBoot_Profile("warm restart") && 
+              (boot_profile.stage[BOOT_STAGE_TMR1].start_ns >= boot_profile.first_edge_ns);
+#endif
+
+    // Watchdog reset: warm restart path
+    p33c_HostBoot_Reset(BOOT_RCON_WDTO);
+    p33c_HostBoot_Run();
+    p33c_HostBoot_Read(&warm);
+    ok = (memcmp(&cold, &warm, sizeof(cold)) == 0) && (boot_image.warm_count == 2);
+    retval &= p33c_HostBoot_Check("watchdog reset", BOOT_PATH_WARM, BOOT_REASON_WARM, ok);
+
+    // External reset: cold boot path, warm restart statistics kept
+    p33c_HostBoot_Reset(BOOT_RCON_EXTR);
+    p33c_HostBoot_Run();
+    p33c_HostBoot_Read(&warm);
+    ok = (memcmp(&cold, &warm, sizeof(cold)) == 0) && (boot_image.warm_count == 2);
+    retval &= p33c_HostBoot_Check("external reset", BOOT_PATH_COLD, BOOT_REASON_EXTERNAL, ok);
+
+    // Trap recorded before a software reset: cold boot path, new image
+    CRASH_Trap(TRAPS_ADDRESS_ERR, NULL);
+    p33c_HostBoot_Reset(BOOT_RCON_SWR);
+    p33c_HostBoot_Run();
+    ok = (boot_image.crashes == 1);
+    retval &= p33c_HostBoot_Check("software reset after trap", BOOT_PATH_COLD, BOOT_REASON_FAULT, ok);
+
+    // Corrupted image: cold boot path
+    boot_image.dac.DACxDATH.value ^= 0x0001U;
+    p33c_HostBoot_Reset(BOOT_RCON_SWR);
+    p33c_HostBoot_Run();
+    retval &= p33c_HostBoot_Check("software reset, corrupted image", BOOT_PATH_COLD, BOOT_REASON_NO_IMAGE, 
+                    BOOT_Validate(&boot_image));
+
+    // High resolution clock not ready: warm restart fails, cold boot path captures a new image
+    boot_image.pwm.vPCLKCON.bits.HRRDY = 0; // restored PCLKCON value clears the simulated status bit
+    p33c_HostBoot_Sign(&boot_image);
+    p33c_HostBoot_Reset(BOOT_RCON_WDTO);
+    p33c_HostBoot_Run();
+    ok = BOOT_Validate(&boot_image) && (boot_image.warm_count == 0) && (boot_image.pwm.vPCLKCON.bits.HRRDY) &&
+         (my_pg1->PGxCONL.bits.ON) && (my_dac->DACxCONL.bits.DACEN);
+#if (BOOT_PROFILE_ENABLE)
+    // PWM and DAC stages of the failed warm restart and of the cold boot path
+    ok &= (boot_profile.stage[BOOT_STAGE_PWM].count == 2) && (boot_profile.stage[BOOT_STAGE_HRRDY].count == 2) &&
+          (boot_profile.stage[BOOT_STAGE_DAC].count == 2) && (boot_profile.stage[BOOT_STAGE_CLOCK].count == 1);
+#endif
+    retval &= p33c_HostBoot_Check("watchdog reset, no HRRDY", BOOT_PATH_COLD, BOOT_REASON_WARM_FAILED, ok);
+
+    // Power-on reset with PLL lock delays, sequential order: the clock switch blocks the peripheral setup
+    p33c_HostClock_PllLockNs = P33C_HOST_BOOT_PLL_LOCK_NS;
+    p33c_HostClock_ApllLockNs = P33C_HOST_BOOT_APLL_LOCK_NS;
+    p33c_HostBoot_Reset(BOOT_RCON_POR);
+    p33c_HostBoot_RunSequential();
+    seq_ns = boot.first_edge_ns;
+    ok = (pwm_enable.state == P33C_PWM_ENABLE_READY) && (seq_ns >= P33C_HOST_BOOT_PLL_LOCK_NS);
+    retval &= p33c_HostBoot_Check("power-on reset, PLL lock delays, sequential", BOOT_PATH_COLD, BOOT_REASON_POWER_ON, ok);
+
+    // Power-on reset with PLL lock delays: pins, PWM and DAC are configured while the PLLs lock,
+    // PWM and DAC are enabled once AFPLLO is available, the system clock switch completes afterwards
+    p33c_HostBoot_Reset(BOOT_RCON_POR);
+    p33c_HostBoot_Run();
+    memcpy(&lock, (const void*)&p33c_HostClockLock, sizeof(lock));
+    async_ns = boot.first_edge_ns;
+    ok = BOOT_Validate(&boot_image) && (pwm_enable.state == P33C_PWM_ENABLE_READY) && 
+         (my_pg1->PGxCONL.bits.ON) && (my_dac->DACxCONL.bits.DACEN) && (OSCCONbits.COSC == 0b001) &&
+         (lock.apll_lock_ns - lock.apll_start_ns >= P33C_HOST_BOOT_APLL_LOCK_NS) &&
+         (lock.pll_lock_ns - lock.pll_start_ns >= P33C_HOST_BOOT_PLL_LOCK_NS) &&
+         (async_ns >= P33C_HOST_BOOT_APLL_LOCK_NS) && (async_ns < P33C_HOST_BOOT_PLL_LOCK_NS);
+#if (BOOT_PROFILE_ENABLE)
+    // Register sets configured before the auxiliary PLL has locked, Timer1 after the clock switch
+    ok &= (boot_profile.stage[BOOT_STAGE_DAC].start_ns + boot_profile.stage[BOOT_STAGE_DAC].time_ns < 
+                P33C_HOST_BOOT_APLL_LOCK_NS) &&
+          (boot_profile.stage[BOOT_STAGE_PWM].start_ns < P33C_HOST_BOOT_APLL_LOCK_NS) &&
+          (boot_profile.stage[BOOT_STAGE_PINS].start_ns < P33C_HOST_BOOT_APLL_LOCK_NS) &&
+          (boot_profile.stage[BOOT_STAGE_CLOCK].start_ns + boot_profile.stage[BOOT_STAGE_CLOCK].time_ns >= 
+                P33C_HOST_BOOT_PLL_LOCK_NS) &&
+          (boot_profile.stage[BOOT_STAGE_TMR1].start_ns >= P33C_HOST_BOOT_PLL_LOCK_NS);
+#endif
+    retval &= p33c_HostBoot_Check("power-on reset, PLL lock delays, overlapped", BOOT_PATH_COLD, BOOT_REASON_POWER_ON, ok);
+#if (BOOT_PROFILE_ENABLE)
+    retval &= p33c_HostBoot_Profile("cold boot with PLL lock delays");
+#endif
+    ok = (async_ns < seq_ns);
+    printf("  boot to first PWM edge with %lu us PLL and %lu us auxiliary PLL lock delay: "
+           "sequential %.2f us, overlapped %.2f us, %s\n", 
+                P33C_HOST_BOOT_PLL_LOCK_NS / 1000UL, P33C_HOST_BOOT_APLL_LOCK_NS / 1000UL,
+                (double)seq_ns / 1000.0, (double)async_ns / 1000.0, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Power-on reset with the system PLL locking before the auxiliary PLL: the clock switch
+    // completes while the PWM enable request is pending, which must not shorten its timeout
+    p33c_HostClock_PllLockNs = P33C_HOST_BOOT_APLL_LOCK_NS;
+    p33c_HostClock_ApllLockNs = P33C_HOST_BOOT_PLL_LOCK_NS - 100000UL;
+    p33c_HostBoot_Reset(BOOT_RCON_POR);
+    p33c_HostBoot_Run();
+    ok = (pwm_enable.state == P33C_PWM_ENABLE_READY) && (my_pg1->PGxIOCONH.bits.PENH) &&
+         (OSCCONbits.COSC == 0b001) && (p33c_HostClockLock.pll_lock_ns < p33c_HostClockLock.apll_lock_ns) &&
+         (boot.first_edge_ns >= p33c_HostClock_ApllLockNs);
+    retval &= p33c_HostBoot_Check("power-on reset, system PLL locked first", BOOT_PATH_COLD, BOOT_REASON_POWER_ON, ok);
+    p33c_HostClock_PllLockNs = 0;
+    p33c_HostClock_ApllLockNs = 0;
+
+    // Warm restart path: register sets restored with one block write each instead of 
+    // clearing them and writing the individual bit fields
+    ok = (warm_writes > 0) && (warm_writes < cold_writes);
+    printf("  boot to first PWM edge (simulated time): cold %.2f us, warm %.2f us\n", 
+                (double)cold_ns / 1000.0, (double)warm_ns / 1000.0);
+    printf("  PWM and DAC register writes: cold %lu, warm %lu (%lu saved), %s\n", 
+                (unsigned long)cold_writes, (unsigned long)warm_writes, 
+                (unsigned long)(cold_writes - warm_writes), (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Restore the simulated register file and the time base
+    p33c_HostTimer_SetSimulated(false);
+    memcpy((void*)p33c_HostSfrFile, sfr, sizeof(sfr));
+    memset(&crash_record, 0, sizeof(crash_record));
+    memset(&boot_image, 0, sizeof(boot_image));
+
+    return(retval);
+}
+
+// ________________________
+// end of file
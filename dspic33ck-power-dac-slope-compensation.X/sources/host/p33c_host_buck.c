@@ -0,0 +1,278 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_buck.c
+ * ************************************************************************************************
+ * Summary:
+ * Host-side closed-loop peak current mode buck converter simulator
+ *
+ * Description:
+ * This source file simulates a synchronous buck converter operated in peak current mode 
+ * by the PWM generator and DAC slope generator configuration of the user code. The 
+ * register images are decoded by the PWM timebase simulator and the DAC slope generator
+ * model. Within each PWM cycle
+ *
+ *   - the inductor current rises with (Vin - Vout) / L while PWMxH is active and falls
+ *     with Vout / L for the rest of the period (continuous conduction, dead times and 
+ *     losses are neglected)
+ *   - the DAC output holds DACxDATH until the slope start signal (PGxTRIGB), ramps down 
+ *     by SLPxDAT per DAC clock until DACxDATL is reached and returns to DACxDATH at the 
+ *     slope stop A signal (PGxTRIGC)
+ *   - the comparator is blanked from the PWMxH rising edge until TMCB DAC clocks after 
+ *     the slope start signal. Afterwards, the first crossing of the sensed inductor 
+ *     current and the DAC output terminates the on-time, which is limited to PGxDC
+ *
+ * The DAC ramp is treated as continuous slope of SLPxDAT per DAC clock, transition 
+ * times of the DAC output are neglected. When an output capacitance is specified, the 
+ * output voltage is updated once per PWM cycle from the average inductor current and 
+ * the load current. Otherwise the output voltage is held constant, which represents 
+ * the operating point commonly used to study sub-harmonic oscillation of the current loop.
+ *
+ * See Also:
+ *	p33c_host_buck.h, p33c_host_pwmsim.c, p33c_host_dacsim.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <math.h>
+
+#include "config/demo.h"
+#include "p33c_host_buck.h"
+
+/* @@p33c_HostBuck_Load
+ * ********************************************************************************
+ * Summary:
+ *     Loads power stage parameters and register images into the buck simulator
+ *
+ * Parameters:
+ *     struct P33C_HOST_BUCK_s* buck:
+ *          Pointer to the simulator object
+ *     const struct P33C_HOST_BUCK_PLANT_s* plant:
+ *          Pointer to the power stage parameters
+ *     const struct P33C_PWM_GENERATOR_s* pgConfig:
+ *          Pointer to the PWM generator register image
+ *     const struct P33C_DAC_MODULE_s* dacModuleConfig:
+ *          Pointer to the DAC module register image
+ *     const struct P33C_DAC_INSTANCE_s* dacConfig:
+ *          Pointer to the DAC instance register image
+ *
+ * Returns:
+ *     0 = failure, the configuration is not supported by the simulator
+ *     1 = success, the simulator has been reset with zero inductor current
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostBuck_Load(struct P33C_HOST_BUCK_s* buck, 
+                const struct P33C_HOST_BUCK_PLANT_s* plant, 
+                const struct P33C_PWM_GENERATOR_s* pgConfig,
+                const struct P33C_DAC_MODULE_s* dacModuleConfig, 
+                const struct P33C_DAC_INSTANCE_s* dacConfig)
+{
+    struct P33C_HOST_PWMSIM_s pwm;
+    struct P33C_HOST_DACSIM_s dac;
+    double lsb;
+
+    if ((buck == NULL) || (plant == NULL))
+        return(0);
+    if ((plant->inductance <= 0.0) || (plant->sense_gain <= 0.0) || 
+        ((plant->capacitance > 0.0) && (plant->load <= 0.0)))
+        return(0);
+
+    if (!p33c_HostPwmSim_Load(&pwm, pgConfig))
+        return(0);
+    if (!p33c_HostDacSim_Load(&dac, dacModuleConfig, dacConfig))
+        return(0);
+    if (pwm.offset[PWMSIM_EVT_PWMH_ON] == P33C_HOST_PWMSIM_NO_EDGE)
+        return(0);
+
+    buck->plant  = *plant;
+    buck->period = (double)pwm.period;
+    buck->t_on   = (double)pwm.offset[PWMSIM_EVT_PWMH_ON];
+    buck->t_max  = (double)pwm.offset[PWMSIM_EVT_PWMH_OFF];
+    buck->t_start = (pwm.offset[PWMSIM_EVT_TRIGB] == P33C_HOST_PWMSIM_NO_EDGE) ? 
+                    buck->period : (double)pwm.offset[PWMSIM_EVT_TRIGB];
+    buck->t_stop  = (pwm.offset[PWMSIM_EVT_TRIGC] == P33C_HOST_PWMSIM_NO_EDGE) ? 
+                    buck->period : (double)pwm.offset[PWMSIM_EVT_TRIGC];
+
+    // Comparator blanking ends TMCB DAC clocks after the slope start signal
+    buck->t_blank = fmin(buck->t_start, buck->t_max) + ((double)dac.tmcb * (double)dac.clock);
+    if (buck->t_blank < buck->t_on) buck->t_blank = buck->t_on;
+
+    // DAC levels have 4 fractional bits
+    lsb = (double)DAC_REFERENCE_MV / ((double)DAC_FULL_SCALE * 16.0);
+    buck->v_high  = (double)dac.high * lsb;
+    buck->v_low   = (double)dac.low * lsb;
+    buck->v_slope = (dac.slopen) ? ((double)dac.slope * lsb / (double)dac.clock) : 0.0;
+    if ((dac.positive) || (buck->v_low > buck->v_high))
+        return(0);
+
+    buck->tick   = 1.0e6 / (double)PWM_CLOCK;
+    buck->i_l    = 0.0;
+    buck->v_out  = plant->vout;
+    buck->i_peak = 0.0;
+    buck->duty   = 0.0;
+    buck->cycle  = 0;
+
+    return(1);
+}
+
+/* @@p33c_HostBuck_Step
+ * ********************************************************************************
+ * Summary:
+ *     Simulates one PWM cycle
+ *
+ * Parameters:
+ *     struct P33C_HOST_BUCK_s* buck:
+ *          Pointer to a loaded simulator object
+ *
+ * Returns:
+ *     double: inductor current at the start of the next PWM cycle in [A]
+ *
+ * Description:
+ *     The DAC output is piecewise linear between the slope start, the ramp floor
+ *     and the slope stop signal. On each segment, the crossing of the sensed 
+ *     inductor current and the DAC output is solved directly.
+ *
+ * ********************************************************************************/
+
+double p33c_HostBuck_Step(struct P33C_HOST_BUCK_s* buck)
+{
+    double m1, m2, rs, t_off, t_ramp, t_floor, a, b, v_a, s, f_a, i_valley, i_avg, t_on_dur;
+    double seg_a[4], seg_b[4], seg_v[4], seg_s[4];
+    uint16_t i, n=0;
+
+    // Inductor current slopes in [A/PWM clock tick]
+    m1 = ((buck->plant.vin - buck->v_out) / buck->plant.inductance) * buck->tick;
+    m2 = (buck->v_out / buck->plant.inductance) * buck->tick;
+    rs = buck->plant.sense_gain;
+
+    // DAC output segments: hold, ramp, floor, hold after slope stop
+    t_ramp  = fmin(buck->t_start, buck->t_stop);
+    t_floor = (buck->v_slope > 0.0) ? 
+                (buck->t_start + ((buck->v_high - buck->v_low) / buck->v_slope)) : buck->period;
+    t_floor = fmin(t_floor, buck->t_stop);
+    seg_a[n] = 0.0;            seg_b[n] = t_ramp;       seg_v[n] = buck->v_high; seg_s[n] = 0.0;           n++;
+    seg_a[n] = t_ramp;         seg_b[n] = t_floor;      seg_v[n] = buck->v_high; seg_s[n] = buck->v_slope; n++;
+    seg_a[n] = t_floor;        seg_b[n] = buck->t_stop; seg_v[n] = buck->v_low;  seg_s[n] = 0.0;           n++;
+    seg_a[n] = buck->t_stop;   seg_b[n] = buck->period; seg_v[n] = buck->v_high; seg_s[n] = 0.0;           n++;
+
+    // Find the first comparator trip between end of blanking and maximum duty cycle
+    t_off = buck->t_max;
+    for (i = 0; i < n; i++)
+    {
+        a = fmax(seg_a[i], buck->t_blank);
+        b = fmin(seg_b[i], buck->t_max);
+        if (a >= b) continue;
+
+        v_a = seg_v[i] - (seg_s[i] * (a - seg_a[i]));
+        f_a = (rs * (buck->i_l + (m1 * (a - buck->t_on)))) - v_a;
+        if (f_a >= 0.0) { t_off = a; break; }
+
+        s = (rs * m1) + seg_s[i];
+        if ((s > 0.0) && ((a - (f_a / s)) < b)) { t_off = a - (f_a / s); break; }
+    }
+
+    // Inductor current at the end of the on-time and the end of the period
+    t_on_dur = t_off - buck->t_on;
+    buck->i_peak = buck->i_l + (m1 * t_on_dur);
+    i_valley = buck->i_peak - (m2 * (buck->period - t_on_dur));
+
+    // Output capacitor charge balance
+    if (buck->plant.capacitance > 0.0)
+    {
+        i_avg = ((0.5 * (buck->i_l + buck->i_peak) * t_on_dur) + 
+                 (0.5 * (buck->i_peak + i_valley) * (buck->period - t_on_dur))) / buck->period;
+        buck->v_out += ((i_avg - (buck->v_out / buck->plant.load)) * 
+                        (buck->period * buck->tick) / buck->plant.capacitance) * 1.0e6;
+    }
+
+    buck->duty = t_on_dur / buck->period;
+    buck->i_l = i_valley;
+    buck->cycle++;
+
+    return(i_valley);
+}
+
+/* @@p33c_HostBuck_Run
+ * ********************************************************************************
+ * Summary:
+ *     Simulates consecutive PWM cycles and checks for sub-harmonic oscillation
+ *
+ * Parameters:
+ *     struct P33C_HOST_BUCK_s* buck:
+ *          Pointer to a loaded simulator object
+ *     uint32_t settle:
+ *          Number of PWM cycles simulated before the evaluation starts
+ *     uint32_t cycles:
+ *          Number of PWM cycles evaluated
+ *     struct P33C_HOST_BUCK_RESULT_s* result:
+ *          Pointer to the result data structure
+ *
+ * Returns:
+ *     0 = failure
+ *     1 = success
+ *
+ * Description:
+ *     A stable current loop converges to the same valley current in every cycle.
+ *     Sub-harmonic oscillation shows as alternating valley currents, which is 
+ *     detected when the cycle-to-cycle deviation exceeds 
+ *     P33C_HOST_BUCK_SUBHARMONIC_LIMIT of the average peak current.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostBuck_Run(struct P33C_HOST_BUCK_s* buck, uint32_t settle, 
+                uint32_t cycles, struct P33C_HOST_BUCK_RESULT_s* result)
+{
+    uint32_t i;
+    double i_prev, i_next, duty=0.0, peak=0.0, valley=0.0, deviation=0.0;
+
+    if ((buck == NULL) || (result == NULL) || (cycles == 0))
+        return(0);
+
+    for (i = 0; i < settle; i++)
+        p33c_HostBuck_Step(buck);
+
+    i_prev = buck->i_l;
+    for (i = 0; i < cycles; i++)
+    {
+        i_next = p33c_HostBuck_Step(buck);
+        duty   += buck->duty;
+        peak   += buck->i_peak;
+        valley += i_next;
+        deviation = fmax(deviation, fabs(i_next - i_prev));
+        i_prev = i_next;
+    }
+
+    result->duty      = duty / (double)cycles;
+    result->i_peak    = peak / (double)cycles;
+    result->i_valley  = valley / (double)cycles;
+    result->deviation = deviation;
+    result->stable    = (isfinite(deviation) && 
+                        (deviation <= (P33C_HOST_BUCK_SUBHARMONIC_LIMIT * fabs(result->i_peak))));
+
+    return(1);
+}
+
+// ________________________
+// end of file
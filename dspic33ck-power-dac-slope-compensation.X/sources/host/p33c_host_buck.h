@@ -0,0 +1,114 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_buck.h
+ * ************************************************************************************************
+ * Summary:
+ * Host-side closed-loop peak current mode buck converter simulator (header file)
+ *
+ * Description:
+ * The buck simulator closes the peak current loop around the PWM generator and DAC 
+ * register images of the user configuration. The inductor current of the power stage 
+ * is compared against the DAC slope generator output; the comparator output terminates 
+ * the PWMxH on-time (PCI) and stops the ramp (SLPSTOPB). Inductor current and DAC 
+ * ramp are piecewise linear within a PWM cycle, so each switching cycle is solved 
+ * analytically, which allows simulating millions of switching cycles per second.
+ *
+ * All timestamps are given in [PWM clock ticks] of PWM_CLOCK declared in demo.h,
+ * currents in [A] and voltages in [mV].
+ *
+ * See Also:
+ *	p33c_host_buck.c, p33c_host_pwmsim.h, p33c_host_dacsim.h
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_BUCK_SIMULATOR_H
+#define	P33C_HOST_BUCK_SIMULATOR_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "common/p33c_pwm.h"
+#include "common/p33c_dac.h"
+#include "p33c_host_pwmsim.h"
+#include "p33c_host_dacsim.h"
+
+#define P33C_HOST_BUCK_SUBHARMONIC_LIMIT  1.0e-4    // Cycle-to-cycle current deviation relative to the peak current considered as sub-harmonic oscillation
+
+/* Power stage parameters */
+struct P33C_HOST_BUCK_PLANT_s {
+    double vin;             // Input voltage in [mV]
+    double vout;            // Initial output voltage in [mV]
+    double inductance;      // Inductance in [nH]
+    double sense_gain;      // Current sense gain in [mV/A]
+    double capacitance;     // Output capacitance in [nF] (0 = output voltage is held constant)
+    double load;            // Load resistance in [mOhm] (only used when capacitance > 0)
+};
+
+/* Buck simulator object */
+struct P33C_HOST_BUCK_s {
+    struct P33C_HOST_BUCK_PLANT_s plant; // Power stage parameters
+    double period;          // PWM period in [PWM clock ticks]
+    double t_on;            // PWMxH rising edge in [PWM clock ticks]
+    double t_max;           // PWMxH falling edge at maximum duty cycle in [PWM clock ticks]
+    double t_start;         // Slope start (PGxTRIGB) in [PWM clock ticks]
+    double t_stop;          // Slope stop A (PGxTRIGC) in [PWM clock ticks]
+    double t_blank;         // End of leading-edge blanking in [PWM clock ticks]
+    double v_high;          // DAC ramp start level in [mV]
+    double v_low;           // DAC ramp floor in [mV]
+    double v_slope;         // DAC ramp slope in [mV/PWM clock tick]
+    double tick;            // Duration of one PWM clock tick in [us]
+    double i_l;             // Inductor current at the PWMxH rising edge in [A]
+    double v_out;           // Output voltage in [mV]
+    double i_peak;          // Inductor peak current of the last cycle in [A]
+    double duty;            // Duty ratio of the last cycle
+    uint64_t cycle;         // Number of simulated PWM cycles
+};
+
+/* Result of a simulation run */
+struct P33C_HOST_BUCK_RESULT_s {
+    double duty;            // Average duty ratio
+    double i_peak;          // Average inductor peak current in [A]
+    double i_valley;        // Average inductor valley current in [A]
+    double deviation;       // Maximum cycle-to-cycle deviation of the valley current in [A]
+    bool stable;            // Flag indicating that no sub-harmonic oscillation has been detected
+};
+
+/* *********************************************************************************
+ * FUNCTION PROTOTYPES
+ * ********************************************************************************/
+
+extern uint16_t p33c_HostBuck_Load(struct P33C_HOST_BUCK_s* buck, 
+                    const struct P33C_HOST_BUCK_PLANT_s* plant, 
+                    const struct P33C_PWM_GENERATOR_s* pgConfig,
+                    const struct P33C_DAC_MODULE_s* dacModuleConfig, 
+                    const struct P33C_DAC_INSTANCE_s* dacConfig);
+extern double p33c_HostBuck_Step(struct P33C_HOST_BUCK_s* buck);
+extern uint16_t p33c_HostBuck_Run(struct P33C_HOST_BUCK_s* buck, uint32_t settle, 
+                    uint32_t cycles, struct P33C_HOST_BUCK_RESULT_s* result);
+
+
+#endif	/* P33C_HOST_BUCK_SIMULATOR_H */
+// END OF FILE
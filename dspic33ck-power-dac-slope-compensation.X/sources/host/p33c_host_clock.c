@@ -0,0 +1,201 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_clock.c
+ * ************************************************************************************************
+ * Summary:
+ * Simulated oscillator of the host build
+ *
+ * Description:
+ * This source file updates the status bits of the simulated oscillator registers declared 
+ * in the host device header sources/host/xc.h, so the MCC clock driver clock.c can be 
+ * executed in host builds. A clock switch requested by writing OSCCON.OSWEN through 
+ * __builtin_write_OSCCONL() is completed when OSCCON is accessed after the lock delay
+ * of the system PLL: COSC takes the value of NOSC, OSWEN is cleared and LOCK is set if 
+ * the new clock source is a PLL. The Auxiliary PLL is reported locked (ACLKCON1.APLLCK)
+ * once it has been enabled (APLLEN) for the lock delay of the auxiliary PLL.
+ *
+ * PCLKCON.HRRDY follows the auxiliary PLL, which provides the AFPLLO clock of the high 
+ * resolution PWM: the status bit reads 0 while the enabled auxiliary PLL is locking and
+ * is set when the lock is reported. While the auxiliary PLL is disabled, HRRDY is plain 
+ * memory and can be preset by the verification code.
+ *
+ * The lock delays p33c_HostClock_PllLockNs and p33c_HostClock_ApllLockNs are measured 
+ * with the time base of the host timer (monotonic clock of the host or simulated time, 
+ * see p33c_HostTimer_SetSimulated()) from the clock switch request and from the first
+ * access seeing the auxiliary PLL enabled (CLOCK_Start() writes ACLKCON1 before OSCCON).
+ * They are 0 by default (instant lock). The host clock times of both lock events are
+ * recorded in p33c_HostClockLock to verify the ordering of the boot sequence.
+ *
+ * See Also:
+ *	xc.h (host), clock.c, p33c_host_boot.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#define P33C_HOST_OSCCON_OSWEN  0x0001U // OSCCON.OSWEN
+#define P33C_HOST_OSCCON_LOCK   0x0020U // OSCCON.LOCK
+#define P33C_HOST_OSCCON_NOSC   8U      // OSCCON.NOSC bit position
+#define P33C_HOST_OSCCON_COSC   12U     // OSCCON.COSC bit position
+#define P33C_HOST_ACLKCON1_APLLCK 0x4000U // ACLKCON1.APLLCK
+#define P33C_HOST_ACLKCON1_APLLEN 0x8000U // ACLKCON1.APLLEN
+#define P33C_HOST_PCLKCON_HRRDY   0x8000U // PCLKCON.HRRDY
+#define P33C_HOST_CLOCK_READ_CYCLES 2U    // Simulated cost of one status register access [instruction cycles]
+
+volatile uint16_t CLKDIV = 0x3001U; // Clock divider register (reset value)
+
+uint32_t p33c_HostClock_PllLockNs = 0;  // Lock delay of the system PLL in [ns]
+uint32_t p33c_HostClock_ApllLockNs = 0; // Lock delay of the auxiliary PLL in [ns]
+volatile struct P33C_HOST_CLOCK_LOCK_s p33c_HostClockLock; // Lock events of the current reset
+
+/* Returns the time base of the host timer in [ns] */
+static uint64_t p33c_HostClock_Now(void)
+{
+    return(p33c_HostTimer_GetTimeNs(P33C_HOST_CLOCK_READ_CYCLES));
+}
+
+/* @@p33c_HostClock_Reset
+ * ********************************************************************************
+ * Summary:
+ *     Resets the oscillator model (called by p33c_HostSfr_Reset())
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     (none)
+ *
+ * ********************************************************************************/
+
+void p33c_HostClock_Reset(void)
+{
+    p33c_HostClockLock.pll_start_ns = 0;
+    p33c_HostClockLock.pll_lock_ns = 0;
+    p33c_HostClockLock.apll_start_ns = 0;
+    p33c_HostClockLock.apll_lock_ns = 0;
+}
+
+/* @@p33c_HostClock_Sync
+ * ********************************************************************************
+ * Summary:
+ *     Updates the simulated oscillator status bits
+ *
+ * Parameters:
+ *     volatile uint16_t* sfr: Register to be accessed by the caller
+ *
+ * Returns:
+ *     Address of the register to be accessed
+ *
+ * Description:
+ *     This function is called by the bit-field access macros OSCCONbits, 
+ *     ACLKCON1bits and PCLKCONbits. It completes a pending clock switch and
+ *     sets the lock status bits of the enabled PLLs after their lock delays.
+ *
+ * ********************************************************************************/
+
+volatile uint16_t* p33c_HostClock_Sync(volatile uint16_t* sfr)
+{
+    uint64_t now = p33c_HostClock_Now();
+    uint16_t osccon = OSCCON;
+    uint16_t nosc;
+
+    if ((osccon & P33C_HOST_OSCCON_OSWEN) && 
+        ((now - p33c_HostClockLock.pll_start_ns) >= p33c_HostClock_PllLockNs))
+    {
+        nosc = (osccon >> P33C_HOST_OSCCON_NOSC) & 0x7U;
+        osccon &= ~(P33C_HOST_OSCCON_OSWEN | P33C_HOST_OSCCON_LOCK | (0x7U << P33C_HOST_OSCCON_COSC));
+        osccon |= (nosc << P33C_HOST_OSCCON_COSC);
+        if ((nosc == 0b001) || (nosc == 0b011)) // FRCPLL or PRIPLL
+            osccon |= P33C_HOST_OSCCON_LOCK;
+        OSCCON = osccon;
+        p33c_HostClockLock.pll_lock_ns = p33c_HostClockLock.pll_start_ns + p33c_HostClock_PllLockNs;
+    }
+
+    if (!(ACLKCON1 & P33C_HOST_ACLKCON1_APLLEN))
+    {
+        ACLKCON1 &= ~P33C_HOST_ACLKCON1_APLLCK;
+        p33c_HostClockLock.apll_start_ns = 0;
+    }
+    else if (!(ACLKCON1 & P33C_HOST_ACLKCON1_APLLCK))
+    {
+        if (p33c_HostClockLock.apll_start_ns == 0)
+            p33c_HostClockLock.apll_start_ns = now;
+
+        if ((now - p33c_HostClockLock.apll_start_ns) >= p33c_HostClock_ApllLockNs)
+        {
+            ACLKCON1 |= P33C_HOST_ACLKCON1_APLLCK;
+            PCLKCON |= P33C_HOST_PCLKCON_HRRDY; // AFPLLO available
+            p33c_HostClockLock.apll_lock_ns = now;
+        }
+        else
+        {
+            PCLKCON &= ~P33C_HOST_PCLKCON_HRRDY;
+        }
+    }
+
+    return(sfr);
+}
+
+/* @@p33c_HostClock_WriteOSCCONH
+ * ********************************************************************************
+ * Summary:
+ *     Writes the high byte of OSCCON (__builtin_write_OSCCONH)
+ *
+ * Parameters:
+ *     uint8_t value: New oscillator selection (NOSC)
+ *
+ * Returns:
+ *     (none)
+ *
+ * ********************************************************************************/
+
+void p33c_HostClock_WriteOSCCONH(uint8_t value)
+{
+    OSCCON = (OSCCON & 0x00FFU) | ((uint16_t)value << 8);
+}
+
+/* @@p33c_HostClock_WriteOSCCONL
+ * ********************************************************************************
+ * Summary:
+ *     Writes the low byte of OSCCON (__builtin_write_OSCCONL)
+ *
+ * Parameters:
+ *     uint8_t value: Low byte of OSCCON (OSWEN = 1 requests a clock switch)
+ *
+ * Returns:
+ *     (none)
+ *
+ * ********************************************************************************/
+
+void p33c_HostClock_WriteOSCCONL(uint8_t value)
+{
+    if (value & P33C_HOST_OSCCON_OSWEN)
+        p33c_HostClockLock.pll_start_ns = p33c_HostClock_Now();
+    OSCCON = (OSCCON & 0xFF00U) | value;
+    p33c_HostClock_Sync(&OSCCON);
+}
+
+// ________________________
+// end of file
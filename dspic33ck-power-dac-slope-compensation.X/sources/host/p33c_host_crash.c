@@ -0,0 +1,215 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_crash.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the crash forensics record and the trap-to-safe-state latency
+ *
+ * Description:
+ * This source file calls CRASH_Trap() on the simulated register file for every 
+ * combination of running PWM generators and verifies that
+ *
+ *   - exactly the running generators are reported as active and have their override 
+ *     bits set to the safe state, all other bits and generators remain unchanged
+ *   - the time from the trap entry to the safe state of all generators measured by the 
+ *     host cycle model does not exceed CRASH_SAFE_CYCLES_MAX instruction cycles
+ *   - the trap counter is continued, the stack words and register sets are captured
+ *     and the record is valid for the firmware and the host decoder
+ *   - CRASH_Initialize() keeps a valid record and clears a corrupted record
+ *   - the stack error trap (CRASH_StackError()) applies the safe state and leaves a 
+ *     partial record, which is completed and counted by CRASH_Initialize()
+ *
+ * The latency is the sum of the modelled CRASH_CYCLES_* steps of crash.c executed on
+ * the path, not a measurement on the device.
+ *
+ * This file is only compiled in host builds.
+ *
+ * See Also:
+ *	crash.c, p33c_host_crashdec.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <string.h>
+
+#include "config/demo.h"
+#include "crash.h"
+#include "../mcc_generated_files/traps.h"
+#include "p33c_host_crashdec.h"
+
+#define P33C_HOST_CRASH_PGCON_ON    0x8000U // PGxCONL.ON
+
+/* Loads a distinct register set into every PWM generator, runs the generators of the given mask */
+static void p33c_HostCrash_Load(uint16_t mask)
+{
+    P33C_PWM_GENERATOR_t* pg;
+    uint16_t i;
+
+    for (i = 0; i < P33C_PG_COUNT; i++)
+    {
+        pg = p33c_PwmGenerator_GetHandle(i + 1);
+        pg->PGxCONL.value = ((mask & (1U << i)) ? P33C_HOST_CRASH_PGCON_ON : 0) | 0x0008U | i;
+        pg->PGxIOCONL.value = (uint16_t)(0x00A5U ^ (i << 2) ^ ((mask << 8) & 0xC000U) ^ ((mask * 0x0101U) & 0x3F00U));
+        pg->PGxPER.value = 8000U + 8U * i;
+        pg->PGxDC.value = 4000U + 8U * i;
+        pg->PGxTRIGA.value = 100U + i;
+    }
+}
+
+/* @@p33c_Host_VerifyCrash
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the safe state, the latency and the content of the crash record
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure
+ *     1 = success
+ * 
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyCrash(void)
+{
+    struct P33C_PWM_GENERATOR_s saved[P33C_PG_COUNT];
+    struct P33C_PWM_GENERATOR_s before[P33C_PG_COUNT];
+    P33C_PWM_GENERATOR_t* pg;
+    uint16_t stack[16];
+    uint16_t mask, i, count_ok = 1, safe_ok = 1, capture_ok = 1, valid_ok = 1, ok, retval = 1;
+    uint16_t max_cycles = 0, max_mask = 0;
+    uint8_t image[sizeof(struct CRASH_RECORD_s) + 6];
+
+    printf("crash record\n");
+
+    for (i = 0; i < P33C_PG_COUNT; i++)
+        memcpy(&saved[i], p33c_PwmGenerator_GetHandle(i + 1), sizeof(saved[i]));
+    for (i = 0; i < 16; i++)
+        stack[i] = (uint16_t)(0x1000U + i);
+
+    // All combinations of running PWM generators
+    memset(&crash_record, 0, sizeof(crash_record));
+    for (mask = 0; mask < (1U << P33C_PG_COUNT); mask++)
+    {
+        p33c_HostCrash_Load(mask);
+        for (i = 0; i < P33C_PG_COUNT; i++)
+            memcpy(&before[i], p33c_PwmGenerator_GetHandle(i + 1), sizeof(before[i]));
+
+        CRASH_Trap(TRAPS_ADDRESS_ERR, &stack[12]);
+
+        if ((crash_record.count != mask + 1) || (crash_record.code != TRAPS_ADDRESS_ERR))
+            count_ok = 0;
+        if (crash_record.active != mask)
+            safe_ok = 0;
+        for (i = 0; i < P33C_PG_COUNT; i++)
+        {
+            pg = p33c_PwmGenerator_GetHandle(i + 1);
+            if (mask & (1U << i))
+                ok = (pg->PGxIOCONL.value == ((before[i].PGxIOCONL.value & ~CRASH_IOCONL_OVR_MASK) | CRASH_IOCONL_OVR_SAFE));
+            else
+                ok = (pg->PGxIOCONL.value == before[i].PGxIOCONL.value);
+            ok &= (crash_record.ioconl[i] == before[i].PGxIOCONL.value);
+            safe_ok &= ok;
+            capture_ok &= (memcmp(&crash_record.pg[i], pg, sizeof(crash_record.pg[i])) == 0);
+        }
+        for (i = 0; i < CRASH_STACK_DEPTH; i++)
+            capture_ok &= (crash_record.stack[i] == stack[11 - i]);
+        for (i = 0; i < P33C_DAC_COUNT; i++)
+            capture_ok &= (memcmp(&crash_record.dac[i], p33c_DacInstance_GetHandle(i + 1), sizeof(crash_record.dac[i])) == 0);
+        valid_ok &= CRASH_Validate(&crash_record);
+        valid_ok &= p33c_HostCrash_Check((const uint8_t*)&crash_record, sizeof(crash_record));
+
+        if (crash_record.safe_cycles > max_cycles)
+        {
+            max_cycles = crash_record.safe_cycles;
+            max_mask = mask;
+        }
+    }
+
+    ok = (max_cycles <= CRASH_SAFE_CYCLES_MAX);
+    printf("  %u generator combinations, worst case safe state latency %u cycles (%.2f us, limit %u cycles, active 0x%02X), %s\n"
+           "  (latency is the sum of the modelled CRASH_CYCLES_* steps, not a device measurement)\n",
+                (unsigned)(1U << P33C_PG_COUNT), (unsigned)max_cycles, (double)max_cycles * 1.0e6 / CPU_CLOCK,
+                (unsigned)CRASH_SAFE_CYCLES_MAX, (unsigned)max_mask, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+    printf("  safe override state of running generators only, %s\n", (safe_ok) ? "ok" : "FAILED");
+    printf("  trap counter and code, %s\n", (count_ok) ? "ok" : "FAILED");
+    printf("  stack, PWM generator and DAC snapshot, %s\n", (capture_ok) ? "ok" : "FAILED");
+    printf("  record valid (firmware and decoder), %s\n", (valid_ok) ? "ok" : "FAILED");
+    retval &= (safe_ok & count_ok & capture_ok & valid_ok);
+
+    // Decoder: record at an unaligned position of a memory image
+    memset(image, 0x5A, sizeof(image));
+    memcpy(&image[6], &crash_record, sizeof(crash_record));
+    ok = (p33c_HostCrash_Find(image, sizeof(image)) == (const struct CRASH_RECORD_s*)&image[6]);
+    image[6 + offsetof(struct CRASH_RECORD_s, code)] ^= 0x01;
+    ok &= (p33c_HostCrash_Find(image, sizeof(image)) == NULL);
+    printf("  decoder finds record in memory image and rejects corrupted record, %s\n", (ok) ? "ok" : "FAILED");
+    retval &= ok;
+    p33c_HostCrash_Print(stdout, &crash_record, "    ");
+
+    // Startup: a valid record is kept, a corrupted record is cleared
+    memcpy(image, &crash_record, sizeof(crash_record));
+    CRASH_Initialize();
+    ok = (memcmp(image, &crash_record, sizeof(crash_record)) == 0);
+    crash_record.stack[0] ^= 0x8000U;
+    CRASH_Initialize();
+    ok &= (crash_record.magic == 0) && (crash_record.count == 0) && (!CRASH_Validate(&crash_record));
+    printf("  startup keeps valid record and clears corrupted record, %s\n", (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Stack error trap: safe state and trap code only, the record is completed at startup
+    ok = 1;
+    for (mask = 0x0001U; mask <= 0x0003U; mask += 0x0002U)
+    {
+        p33c_HostCrash_Load(mask);
+        memcpy(&before[0], p33c_PwmGenerator_GetHandle(1), sizeof(before[0]));
+        CRASH_StackError(TRAPS_STACK_ERR);
+        pg = p33c_PwmGenerator_GetHandle(1);
+        ok &= (crash_record.magic == CRASH_RECORD_MAGIC_STACK) && (!CRASH_Validate(&crash_record)) &&
+              (crash_record.active == mask) && (crash_record.ioconl[0] == before[0].PGxIOCONL.value) &&
+              (pg->PGxIOCONL.value == ((before[0].PGxIOCONL.value & ~CRASH_IOCONL_OVR_MASK) | CRASH_IOCONL_OVR_SAFE)) &&
+              (crash_record.safe_cycles <= CRASH_SAFE_CYCLES_MAX);
+        CRASH_Initialize();
+        ok &= (crash_record.count == ((mask == 0x0001U) ? 1 : 2)) && (crash_record.code == TRAPS_STACK_ERR) && 
+              (crash_record.sp == 0) && (crash_record.active == mask);
+        for (i = 0; i < CRASH_STACK_DEPTH; i++)
+            ok &= (crash_record.stack[i] == 0);
+        ok &= CRASH_Validate(&crash_record) && p33c_HostCrash_Check((const uint8_t*)&crash_record, sizeof(crash_record));
+    }
+    printf("  stack error trap: safe state and trap code, record completed and counted at startup, %s\n", (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Restore the simulated register file
+    for (i = 0; i < P33C_PG_COUNT; i++)
+        memcpy(p33c_PwmGenerator_GetHandle(i + 1), &saved[i], sizeof(saved[i]));
+    memset(&crash_record, 0, sizeof(crash_record));
+
+    return(retval);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,226 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_crashdec.c
+ * ************************************************************************************************
+ * Summary:
+ * Host-side decoder of the crash forensics record
+ *
+ * Description:
+ * This source file verifies and prints the crash record written by the trap handlers
+ * (see crash.c). It is used by the host application and by the command line tool 
+ * p33c_crash. The checksum is verified with the CRC-16/CCITT-FALSE implementation of 
+ * the telemetry decoder.
+ *
+ * See Also:
+ *	p33c_host_crashdec.h, p33c_host_tlm.c, crash.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <string.h>
+
+#include "config/demo.h"
+#include "../mcc_generated_files/traps.h"
+#include "p33c_host_crashdec.h"
+#include "p33c_host_tlm.h"
+
+/* @@p33c_HostCrash_Check
+ * ********************************************************************************
+ * Summary:
+ *     Checks if a memory image contains a valid crash record at its first byte
+ *
+ * Parameters:
+ *     const uint8_t* data: Pointer to the first byte of the record
+ *     size_t length: Number of bytes available
+ *
+ * Returns:
+ *     0 = no valid record
+ *     1 = valid record
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostCrash_Check(const uint8_t* data, size_t length)
+{
+    struct CRASH_RECORD_s record;
+
+    if ((data == NULL) || (length < sizeof(record)))
+        return(0);
+
+    memcpy(&record, data, sizeof(record));
+    return((record.magic == CRASH_RECORD_MAGIC) && (record.version == CRASH_RECORD_VERSION) &&
+           (record.size == sizeof(record)) && 
+           (record.crc == p33c_HostTlm_Crc16(data, offsetof(struct CRASH_RECORD_s, crc))));
+}
+
+/* @@p33c_HostCrash_Find
+ * ********************************************************************************
+ * Summary:
+ *     Locates the first valid crash record in a memory image
+ *
+ * Parameters:
+ *     const uint8_t* data: Pointer to the memory image
+ *     size_t length: Size of the memory image in [byte]
+ *
+ * Returns:
+ *     Pointer to the record within the memory image (NULL = no valid record)
+ *
+ * Description:
+ *     The record is searched at all word-aligned offsets, so the memory image 
+ *     may be an export of the complete data memory. The returned pointer may 
+ *     be unaligned for the host and has to be copied before its fields are read.
+ *
+ * ********************************************************************************/
+
+const struct CRASH_RECORD_s* p33c_HostCrash_Find(const uint8_t* data, size_t length)
+{
+    size_t ofs;
+
+    if (data == NULL)
+        return(NULL);
+
+    for (ofs = 0; (ofs + sizeof(struct CRASH_RECORD_s)) <= length; ofs += 2)
+    {
+        if ((data[ofs] == (CRASH_RECORD_MAGIC & 0xFF)) && (data[ofs + 1] == (CRASH_RECORD_MAGIC >> 8)) &&
+            (p33c_HostCrash_Check(&data[ofs], length - ofs)))
+            return((const struct CRASH_RECORD_s*)&data[ofs]);
+    }
+
+    return(NULL);
+}
+
+/* @@p33c_HostCrash_TrapName
+ * ********************************************************************************
+ * Summary:
+ *     Returns the name of a trap error code
+ *
+ * Parameters:
+ *     uint16_t code: Trap error code (TRAPS_ERROR_CODE)
+ *
+ * Returns:
+ *     Name of the trap
+ *
+ * ********************************************************************************/
+
+const char* p33c_HostCrash_TrapName(uint16_t code)
+{
+    switch (code)
+    {
+        case TRAPS_OSC_FAIL:    return("oscillator fail");
+        case TRAPS_STACK_ERR:   return("stack error");
+        case TRAPS_ADDRESS_ERR: return("address error");
+        case TRAPS_MATH_ERR:    return("math error");
+        case TRAPS_HARD_ERR:    return("generic hard trap");
+        case TRAPS_NVM_ERR:     return("NVM address error");
+        case TRAPS_DMT_ERR:     return("deadman timer");
+        case TRAPS_DAE_ERR:     return("DMA address error");
+        case TRAPS_DOOVR_ERR:   return("DO stack overflow");
+        case TRAPS_APLL_ERR:    return("auxiliary PLL loss of lock");
+        default:                return("unknown");
+    }
+}
+
+/* @@p33c_HostCrash_Print
+ * ********************************************************************************
+ * Summary:
+ *     Prints a crash record
+ *
+ * Parameters:
+ *     FILE* file: Output file
+ *     const struct CRASH_RECORD_s* record: Pointer to the record
+ *     const char* indent: Prefix of every line
+ *
+ * Returns:
+ *     0 = the record is invalid, only its header has been printed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostCrash_Print(FILE* file, const struct CRASH_RECORD_s* record, const char* indent)
+{
+    struct CRASH_RECORD_s r;
+    const struct P33C_PWM_GENERATOR_s* pg;
+    const struct P33C_DAC_INSTANCE_s* dac;
+    uint16_t i;
+
+    if ((file == NULL) || (record == NULL))
+        return(0);
+    if (indent == NULL)
+        indent = "";
+
+    memcpy(&r, record, sizeof(r));
+    if (!p33c_HostCrash_Check((const uint8_t*)&r, sizeof(r)))
+    {
+        fprintf(file, "%sno valid crash record (magic 0x%04X, version %u, size %u)\n", 
+                    indent, (unsigned)r.magic, (unsigned)r.version, (unsigned)r.size);
+        return(0);
+    }
+
+    fprintf(file, "%strap #%u: %s (code %u), INTCON1 0x%04X, INTCON3 0x%04X, INTCON4 0x%04X\n", 
+                indent, (unsigned)r.count, p33c_HostCrash_TrapName(r.code), (unsigned)r.code,
+                (unsigned)r.intcon1, (unsigned)r.intcon3, (unsigned)r.intcon4);
+    fprintf(file, "%sW15 0x%04X, SPLIM 0x%04X, stack", indent, (unsigned)r.sp, (unsigned)r.splim);
+    for (i = 0; i < CRASH_STACK_DEPTH; i++)
+        fprintf(file, " %04X", (unsigned)r.stack[i]);
+    fprintf(file, "\n");
+    fprintf(file, "%ssafe state after %u cycles (%.2f us), PCLKCON 0x%04X, generators running:", 
+                indent, (unsigned)r.safe_cycles, (double)r.safe_cycles * 1.0e6 / CPU_CLOCK, (unsigned)r.pclkcon);
+    for (i = 0; i < P33C_PG_COUNT; i++)
+    {
+        if (r.active & (1U << i))
+            fprintf(file, " PG%u", (unsigned)(i + 1));
+    }
+    fprintf(file, "%s\n", (r.active) ? "" : " none");
+
+    for (i = 0; i < P33C_PG_COUNT; i++)
+    {
+        pg = &r.pg[i];
+        if ((!(r.active & (1U << i))) && (pg->PGxCONL.value == 0))
+            continue; // generator not configured
+        fprintf(file, "%s  PG%u: CONL 0x%04X CONH 0x%04X STAT 0x%04X IOCONL 0x%04X->0x%04X IOCONH 0x%04X "
+                "PER %u DC %u PHASE %u TRIGA %u TRIGB %u TRIGC %u\n",
+                indent, (unsigned)(i + 1), (unsigned)pg->PGxCONL.value, (unsigned)pg->PGxCONH.value, 
+                (unsigned)pg->PGxSTAT.value, (unsigned)r.ioconl[i], (unsigned)pg->PGxIOCONL.value, 
+                (unsigned)pg->PGxIOCONH.value, (unsigned)pg->PGxPER.value, (unsigned)pg->PGxDC.value, 
+                (unsigned)pg->PGxPHASE.value, (unsigned)pg->PGxTRIGA.value, (unsigned)pg->PGxTRIGB.value, 
+                (unsigned)pg->PGxTRIGC.value);
+    }
+
+    for (i = 0; i < P33C_DAC_COUNT; i++)
+    {
+        dac = &r.dac[i];
+        if (dac->DACxCONL.value == 0)
+            continue; // DAC instance not configured
+        fprintf(file, "%s  DAC%u: CONL 0x%04X DATH %u DATL %u SLPCONL 0x%04X SLPCONH 0x%04X SLPDAT %u\n",
+                indent, (unsigned)(i + 1), (unsigned)dac->DACxCONL.value, (unsigned)dac->DACxDATH.value,
+                (unsigned)dac->DACxDATL.value, (unsigned)dac->SLPxCONL.value, (unsigned)dac->SLPxCONH.value,
+                (unsigned)dac->SLPxDAT.value);
+    }
+
+    return(1);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,63 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_crashdec.h
+ * ************************************************************************************************
+ * Summary:
+ * Host-side decoder of the crash forensics record (header file)
+ *
+ * Description:
+ * The decoder locates the crash record (see crash.h) in a memory image, e.g. a binary 
+ * export of the persistent RAM read by the debugger, verifies identifier, layout version,
+ * size and checksum and prints the trap context and the register sets of all PWM 
+ * generators and DAC instances in human readable form. The record is stored in the 
+ * little-endian byte order of the target, which equals the byte order of the host.
+ *
+ * See Also:
+ *	p33c_host_crashdec.c, crash.h, tools/p33c_crash.c
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_CRASHDEC_H
+#define	P33C_HOST_CRASHDEC_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+
+#include "crash.h"
+
+/* *********************************************************************************
+ * FUNCTION PROTOTYPES
+ * ********************************************************************************/
+
+extern uint16_t p33c_HostCrash_Check(const uint8_t* data, size_t length);
+extern const struct CRASH_RECORD_s* p33c_HostCrash_Find(const uint8_t* data, size_t length);
+extern const char* p33c_HostCrash_TrapName(uint16_t code);
+extern uint16_t p33c_HostCrash_Print(FILE* file, const struct CRASH_RECORD_s* record, const char* indent);
+
+
+#endif	/* P33C_HOST_CRASHDEC_H */
+// END OF FILE
@@ -0,0 +1,176 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_ctrl.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the PWM-triggered control loop interrupt service routine
+ *
+ * Description:
+ * This source file configures the ADC input of the control loop and executes the control
+ * loop interrupt service routine of pwm.c once per simulated switching cycle. The feedback
+ * sample of each cycle is derived from the DAC level of the previous cycle by a proportional
+ * plant model. The following properties are verified:
+ *
+ *   - the ADC conversion is triggered by ADC Trigger 1 of the leading PWM generator
+ *   - a disabled control loop acquires samples without writing PWM or DAC registers
+ *   - the enabled control loop settles the feedback at the reference and writes the 
+ *     DAC level, the duty cycle limit and the PWM update request in every cycle
+ *   - the DAC level is limited to the valid output range
+ *   - the slope compensation ramp amplitude handed over by the adaptive slope 
+ *     controller (pwm_ctrl.ramp) raises the DAC level within the same limit
+ *   - the trigger to update latency is within the switching cycle of the trigger
+ *
+ * The execution time of the routine is measured with Timer1 on the target device; it 
+ * is zero in this simulation. This file is only compiled in host builds.
+ *
+ * See Also:
+ *	pwm.c, adc.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+
+#include "config/demo.h"
+#include "pwm.h"
+#include "dac.h"
+#include "adc.h"
+
+#define P33C_HOST_CTRL_CYCLES       2000U   // Number of simulated switching cycles
+#define P33C_HOST_CTRL_PLANT_GAIN   3U      // Plant gain = P33C_HOST_CTRL_PLANT_GAIN / 4 [ADC ticks per DAC tick]
+#define P33C_HOST_CTRL_RAMP         100U    // Slope compensation ramp amplitude in [DAC ticks]
+
+extern void _ADCAN0Interrupt(void);
+
+/* Executes the control loop interrupt of one switching cycle with the feedback of the given DAC level */
+static void p33c_Host_CtrlCycle(uint16_t dac_level)
+{
+    ADCBUF0 = (uint16_t)(((uint32_t)dac_level * P33C_HOST_CTRL_PLANT_GAIN) >> 2);
+    _ADCAN0IF = 1;
+    PWM_CONTROL_PG->PGxSTAT.bits.UPDREQ = 0; // the PWM generator clears the update request at the start of cycle
+    _ADCAN0Interrupt();
+    return;
+}
+
+/* @@p33c_Host_VerifyControlLoop
+ * ********************************************************************************
+ * Summary:
+ *     Verifies ADC trigger routing, register updates and latency of the control loop
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyControlLoop(void)
+{
+    uint32_t i, updates;
+    uint16_t retval=1, ok, dac_level;
+
+    printf("control loop interrupt\n");
+
+    p33c_HostSfr_Reset();
+    PWM_Initialize();
+    DAC_Initialize();
+    ADC_Initialize();
+    ADCON5Lbits.C0RDY = 1; // the simulated ADC core is ready immediately
+    ok = ADC_Enable();
+    ok &= ((ADTRIG0Lbits.TRGSRC0 == ADC_TRGSRC_PWM_TRIG1(PWM_GENERATOR)) && (my_pg1->PGxEVTL.bits.ADTR1EN2) &&
+           (ADIELbits.IE0) && (_ADCAN0IE) && (ADCORE0Hbits.ADCS == ADC_CORE_CLOCK_DIV) && 
+           (ADCORE0Lbits.SAMC == ADC_SAMPLE_TIME));
+    retval &= ok;
+    printf("  AN0 triggered by PWM%u ADC Trigger 1 at %u ticks, core clock divider %u, %s\n", 
+                (unsigned)PWM_GENERATOR, (unsigned)CONTROL_TRIGGER_RAW, (unsigned)ADCORE0Hbits.ADCS, 
+                (ok) ? "ok" : "FAILED");
+
+    // Disabled: samples are acquired, registers are not written
+    my_dac->DACxDATH.value = DACOUT_VALUE_HIGH_2;
+    for (i = 0; i < 10; i++)
+        p33c_Host_CtrlCycle(DACOUT_VALUE_HIGH_1);
+    ok = ((pwm_ctrl.count == 10) && (pwm_ctrl.sample == ADCBUF0) && (!_ADCAN0IF) &&
+          (my_dac->DACxDATH.value == DACOUT_VALUE_HIGH_2) && (!my_pg1->PGxSTAT.bits.UPDREQ));
+    retval &= ok;
+    printf("  disabled: %u samples acquired, no register written, %s\n", (unsigned)pwm_ctrl.count, (ok) ? "ok" : "FAILED");
+
+    // Enabled: the loop settles the feedback at the reference
+    pwm_ctrl.enable = true;
+    pwm_ctrl.duty = (PWM_DUTY_CYCLE >> 1);
+    updates = 0;
+    for (i = 0; i < P33C_HOST_CTRL_CYCLES; i++)
+    {
+        p33c_Host_CtrlCycle(my_dac->DACxDATH.value);
+        updates += ((my_pg1->PGxSTAT.bits.UPDREQ) && (my_pg1->PGxDC.value == pwm_ctrl.duty));
+    }
+    dac_level = my_dac->DACxDATH.value;
+    ok = ((updates == P33C_HOST_CTRL_CYCLES) && 
+          (DEMO_ABS((int16_t)pwm_ctrl.sample - (int16_t)CONTROL_REFERENCE) <= (int16_t)P33C_HOST_CTRL_PLANT_GAIN));
+    retval &= ok;
+    printf("  enabled: feedback %u (reference %u), DAC level %u, %lu of %lu cycles updated, %s\n", 
+                (unsigned)pwm_ctrl.sample, (unsigned)CONTROL_REFERENCE, (unsigned)dac_level, 
+                (unsigned long)updates, (unsigned long)P33C_HOST_CTRL_CYCLES, (ok) ? "ok" : "FAILED");
+
+    // Reference beyond the output range: the DAC level is limited
+    pwm_ctrl.reference = (uint16_t)(ADC_FULL_SCALE - 1);
+    for (i = 0; i < P33C_HOST_CTRL_CYCLES; i++)
+        p33c_Host_CtrlCycle(my_dac->DACxDATH.value);
+    ok = (my_dac->DACxDATH.value == CONTROL_DAC_MAX);
+    pwm_ctrl.reference = 0;
+    for (i = 0; i < P33C_HOST_CTRL_CYCLES; i++)
+        p33c_Host_CtrlCycle(my_dac->DACxDATH.value);
+    ok &= (my_dac->DACxDATH.value == CONTROL_DAC_MIN);
+    retval &= ok;
+    printf("  limits: DAC level %u ... %u, %s\n", (unsigned)CONTROL_DAC_MIN, (unsigned)CONTROL_DAC_MAX, (ok) ? "ok" : "FAILED");
+
+    // Slope compensation ramp amplitude added to the integrated DAC level
+    pwm_ctrl.ramp = P33C_HOST_CTRL_RAMP;
+    p33c_Host_CtrlCycle(my_dac->DACxDATH.value);
+    ok = (my_dac->DACxDATH.value == (uint16_t)((pwm_ctrl.integrator >> CONTROL_KI_SHIFT) + P33C_HOST_CTRL_RAMP));
+    pwm_ctrl.reference = (uint16_t)(ADC_FULL_SCALE - 1);
+    for (i = 0; i < P33C_HOST_CTRL_CYCLES; i++)
+        p33c_Host_CtrlCycle(my_dac->DACxDATH.value);
+    ok &= (my_dac->DACxDATH.value == CONTROL_DAC_MAX);
+    pwm_ctrl.ramp = 0;
+    pwm_ctrl.reference = CONTROL_REFERENCE;
+    retval &= ok;
+    printf("  slope compensation: ramp amplitude of %u ticks added to the DAC level, %s\n", 
+                (unsigned)P33C_HOST_CTRL_RAMP, (ok) ? "ok" : "FAILED");
+
+    ok = ((pwm_ctrl.deadline_miss == 0) && (pwm_ctrl.latency_max == CONTROL_LATENCY));
+    retval &= ok;
+    printf("  latency: trigger to update %.1f ns (conversion %.1f ns, execution time 0), deadline %.1f ns, %u misses, %s\n",
+                ((double)pwm_ctrl.latency_max * 1.0e9) / (double)PWM_CLOCK, 
+                ((double)CONTROL_ADC_LATENCY_RAW * 1.0e9) / (double)PWM_CLOCK,
+                ((double)CONTROL_DEADLINE * 1.0e9) / (double)PWM_CLOCK, 
+                (unsigned)pwm_ctrl.deadline_miss, (ok) ? "ok" : "FAILED");
+
+    return(retval);
+}
+
+// ________________________
+// end of file
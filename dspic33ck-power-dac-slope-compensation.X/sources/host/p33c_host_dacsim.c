@@ -0,0 +1,353 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_dacsim.c
+ * ************************************************************************************************
+ * Summary:
+ * Host-side behavioural model of the DAC slope generator
+ *
+ * Description:
+ * This source file models the slope generator of one DAC instance at DAC clock
+ * resolution. The DAC clock period is derived from the settings in demo.h
+ * (DAC_CLOCK_DIVIDER / DAC_CLOCK_FREQUENCY). The following behaviour is modelled:
+ *
+ *   - a slope start signal matching SLPSTRT loads the slope accumulator with 
+ *     DACxDATH (DACxDATL when PSE = 1) and starts the ramp
+ *   - while ramping, SLPxDAT (4 fractional bits) is subtracted (added when PSE = 1)
+ *     once per DAC clock until DACxDATL (DACxDATH when PSE = 1) is reached, where 
+ *     the output is held
+ *   - a slope stop signal matching SLPSTOPA or SLPSTOPB ends the ramp and returns 
+ *     the output to its start level
+ *   - every step change of the output (start and stop) starts a transition phase 
+ *     of TMODTIME DAC clocks, during which the output moves linearly towards the 
+ *     new level, and a leading-edge blanking period of TMCB DAC clocks. The 
+ *     output is flagged as steady SSTIME DAC clocks after the step.
+ *   - with SLOPEN = 0 the output stays at DACxDATH
+ *
+ * Hysteretic mode (HME) and triangle wave mode (TWME) are not supported. The 
+ * transition phase is a behavioural approximation and does not represent the 
+ * analog settling of the DAC output stage.
+ *
+ * See Also:
+ *	p33c_host_dacsim.h, p33c_host_pwmsim.c, demo.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+
+#include "config/demo.h"
+#include "p33c_host_dacsim.h"
+
+/* @@p33c_HostDacSim_Load
+ * ********************************************************************************
+ * Summary:
+ *     Loads DAC module and DAC instance register images into the slope generator model
+ *
+ * Parameters:
+ *     struct P33C_HOST_DACSIM_s* sim:
+ *          Pointer to the model object
+ *     const struct P33C_DAC_MODULE_s* dacModuleConfig:
+ *          Pointer to the DAC module register image
+ *     const struct P33C_DAC_INSTANCE_s* dacConfig:
+ *          Pointer to the DAC instance register image
+ *
+ * Returns:
+ *     0 = failure, the configuration is not supported by the model
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostDacSim_Load(struct P33C_HOST_DACSIM_s* sim, 
+                const struct P33C_DAC_MODULE_s* dacModuleConfig, 
+                const struct P33C_DAC_INSTANCE_s* dacConfig)
+{
+    if ((sim == NULL) || (dacModuleConfig == NULL) || (dacConfig == NULL))
+        return(0);
+
+    if ((dacConfig->SLPxCONH.bits.HME) || (dacConfig->SLPxCONH.bits.TWME))
+        return(0);
+
+    sim->clock    = (uint64_t)((1LL * PWM_CLOCK * DAC_CLOCK_DIVIDER) / DAC_CLOCK_FREQUENCY);
+    sim->high     = ((uint32_t)dacConfig->DACxDATH.bits.DACDAT << 4);
+    sim->low      = ((uint32_t)dacConfig->DACxDATL.bits.DACLOW << 4);
+    sim->slope    = dacConfig->SLPxDAT.value;
+    sim->tmodtime = dacModuleConfig->DacModuleCtrl2L.bits.TMODTIME;
+    sim->sstime   = dacModuleConfig->DacModuleCtrl2H.bits.SSTIME;
+    sim->tmcb     = dacConfig->DACxCONH.bits.TMCB;
+    sim->start    = dacConfig->SLPxCONL.bits.SLPSTRT;
+    sim->stop_a   = dacConfig->SLPxCONL.bits.SLPSTOPA;
+    sim->stop_b   = dacConfig->SLPxCONL.bits.SLPSTOPB;
+    sim->slopen   = (bool)dacConfig->SLPxCONH.bits.SLOPEN;
+    sim->positive = (bool)dacConfig->SLPxCONH.bits.PSE;
+
+    if (sim->clock == 0)
+        return(0);
+
+    return(1);
+}
+
+/* @@p33c_HostDacSim_GetSignals
+ * ********************************************************************************
+ * Summary:
+ *     Converts PWM trigger events into slope start/stop signal events
+ *
+ * Parameters:
+ *     struct P33C_HOST_PWMSIM_s* pwm:
+ *          Pointer to a loaded PWM timebase simulator object
+ *     uint16_t pgInstance:
+ *          Instance of the simulated PWM generator (e.g. 1 = PG1)
+ *     uint32_t cycles:
+ *          Number of PWM cycles to simulate
+ *     struct P33C_HOST_DACSIM_SIGNAL_s* signals:
+ *          Array receiving the signal events
+ *     uint32_t max_count:
+ *          Number of elements of the signal array
+ *
+ * Returns:
+ *     uint32_t: number of signal events written
+ *
+ * Description:
+ *     PGxTRIGB events are routed to the slope start signal 'PWMx Trigger 1'
+ *     and PGxTRIGC events to the slope stop signal 'PWMx Trigger 2' with 
+ *     selection code x = pgInstance, as configured in pwm.c and dac.c.
+ *
+ * ********************************************************************************/
+
+uint32_t p33c_HostDacSim_GetSignals(struct P33C_HOST_PWMSIM_s* pwm, uint16_t pgInstance, 
+                uint32_t cycles, struct P33C_HOST_DACSIM_SIGNAL_s* signals, uint32_t max_count)
+{
+    struct P33C_HOST_PWMSIM_CYCLE_s cycle;
+    uint32_t c, count=0;
+
+    if ((pwm == NULL) || (signals == NULL))
+        return(0);
+
+    for (c = 0; c < cycles; c++)
+    {
+        if ((count + 2) > max_count)
+            break;
+
+        p33c_HostPwmSim_NextCycle(pwm, &cycle);
+
+        if (cycle.event[PWMSIM_EVT_TRIGB] != P33C_HOST_PWMSIM_NO_EDGE)
+        {
+            signals[count].time  = cycle.event[PWMSIM_EVT_TRIGB];
+            signals[count].start = (uint8_t)pgInstance;
+            signals[count].stop  = 0;
+            count++;
+        }
+        if (cycle.event[PWMSIM_EVT_TRIGC] != P33C_HOST_PWMSIM_NO_EDGE)
+        {
+            signals[count].time  = cycle.event[PWMSIM_EVT_TRIGC];
+            signals[count].start = 0;
+            signals[count].stop  = (uint8_t)pgInstance;
+            count++;
+        }
+    }
+
+    return(count);
+}
+
+/* @@p33c_HostDacSim_Run
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the sampled DAC output waveform
+ *
+ * Parameters:
+ *     const struct P33C_HOST_DACSIM_s* sim:
+ *          Pointer to a loaded model object
+ *     const struct P33C_HOST_DACSIM_SIGNAL_s* signals:
+ *          Time-ordered slope start/stop signal events
+ *     uint32_t signal_count:
+ *          Number of signal events
+ *     uint64_t t_end:
+ *          End of the simulation in [PWM clock ticks]
+ *     struct P33C_HOST_DACSIM_SAMPLE_s* wave:
+ *          Array receiving one sample per DAC clock
+ *     uint32_t max_count:
+ *          Number of elements of the waveform array
+ *
+ * Returns:
+ *     uint32_t: number of samples written
+ *
+ * Description:
+ *     The DAC output starts at its idle level at time 0. Signal events take 
+ *     effect at the first DAC clock edge at or after their timestamp.
+ *
+ * ********************************************************************************/
+
+uint32_t p33c_HostDacSim_Run(const struct P33C_HOST_DACSIM_s* sim, 
+                const struct P33C_HOST_DACSIM_SIGNAL_s* signals, uint32_t signal_count, 
+                uint64_t t_end, struct P33C_HOST_DACSIM_SAMPLE_s* wave, uint32_t max_count)
+{
+    uint64_t t;
+    uint32_t count=0, next=0, acc, idle, target, from=0;
+    uint32_t since_step=UINT32_MAX;
+    int32_t out;
+    bool ramp=false, limit=false, do_start, do_stop;
+    uint8_t flags;
+
+    if ((sim == NULL) || (wave == NULL) || ((signals == NULL) && (signal_count > 0)))
+        return(0);
+
+    idle   = (sim->positive) ? sim->low : sim->high;
+    target = (sim->positive) ? sim->high : sim->low;
+    acc    = idle;
+
+    for (t = 0; (t <= t_end) && (count < max_count); t += sim->clock)
+    {
+        // Process all signal events up to this DAC clock edge
+        do_start = false;
+        do_stop  = false;
+        while ((next < signal_count) && (signals[next].time <= t))
+        {
+            if ((signals[next].start != 0) && (signals[next].start == sim->start))
+                do_start = true;
+            if ((signals[next].stop != 0) && 
+                ((signals[next].stop == sim->stop_a) || (signals[next].stop == sim->stop_b)))
+                do_stop = true;
+            next++;
+        }
+
+        if (sim->slopen)
+        {
+            if (do_stop && ramp)
+            {
+                // Ramp ends: output returns to the start level
+                from = acc;
+                acc = idle;
+                ramp = false;
+                limit = false;
+                since_step = 0;
+            }
+            if (do_start)
+            {
+                // Ramp starts from the start level
+                if (acc != idle) { from = acc; since_step = 0; }
+                acc = idle;
+                ramp = true;
+                limit = false;
+            }
+            else if (ramp && !limit)
+            {
+                // Advance the slope accumulator by one DAC clock
+                if (sim->positive)
+                {
+                    acc += sim->slope;
+                    if (acc >= target) { acc = target; limit = true; }
+                }
+                else
+                {
+                    if ((acc <= target) || ((acc - target) <= sim->slope)) { acc = target; limit = true; }
+                    else { acc -= sim->slope; }
+                }
+            }
+        }
+
+        // Output including transition phase after step changes
+        flags = 0;
+        out = (int32_t)acc;
+        if (since_step < UINT32_MAX)
+        {
+            if (since_step < sim->tmodtime)
+            {
+                out = (int32_t)from + ((((int32_t)acc - (int32_t)from) * (int32_t)since_step) / (int32_t)sim->tmodtime);
+                flags |= DACSIM_FLAG_TRANSITION;
+            }
+            if (since_step < sim->tmcb)
+                flags |= DACSIM_FLAG_BLANKING;
+            if (since_step >= sim->sstime)
+                flags |= DACSIM_FLAG_STEADY;
+            since_step++;
+        }
+        else
+        {
+            flags |= DACSIM_FLAG_STEADY;
+        }
+        if (ramp) flags |= DACSIM_FLAG_RAMP;
+        if (limit) flags |= DACSIM_FLAG_LIMIT;
+
+        wave[count].time  = t;
+        wave[count].value = (uint16_t)out;
+        wave[count].flags = flags;
+        count++;
+    }
+
+    return(count);
+}
+
+/* @@p33c_HostDacSim_WriteCsv
+ * ********************************************************************************
+ * Summary:
+ *     Writes a sampled DAC output waveform into a CSV file
+ *
+ * Parameters:
+ *     const char* filename:
+ *          Name of the output file
+ *     const struct P33C_HOST_DACSIM_SAMPLE_s* wave:
+ *          Waveform samples
+ *     uint32_t count:
+ *          Number of samples
+ *
+ * Returns:
+ *     0 = failure, the file could not be written
+ *     1 = success
+ *
+ * Description:
+ *     Each line holds the sample time in [ns], the DAC output voltage in [V],
+ *     the DAC output value in [DAC ticks] with 4 fractional bits and the 
+ *     sample flags.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostDacSim_WriteCsv(const char* filename, 
+                const struct P33C_HOST_DACSIM_SAMPLE_s* wave, uint32_t count)
+{
+    FILE* file;
+    uint32_t i;
+
+    if ((filename == NULL) || (wave == NULL))
+        return(0);
+
+    file = fopen(filename, "w");
+    if (file == NULL)
+        return(0);
+
+    fprintf(file, "time_ns,voltage_v,value_q4,flags\n");
+    for (i = 0; i < count; i++)
+    {
+        fprintf(file, "%.3f,%.6f,%u,%u\n",
+                ((double)wave[i].time * 1.0e9) / (double)PWM_CLOCK,
+                ((double)wave[i].value / 16.0) * ((double)DAC_REFERENCE_MV / 1000.0) / (double)DAC_FULL_SCALE,
+                (unsigned)wave[i].value, (unsigned)wave[i].flags);
+    }
+
+    fclose(file);
+
+    return(1);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,109 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_dacsim.h
+ * ************************************************************************************************
+ * Summary:
+ * Host-side behavioural model of the DAC slope generator (header file)
+ *
+ * Description:
+ * The DAC slope generator model takes DAC module and DAC instance register images of 
+ * type P33C_DAC_MODULE_s and P33C_DAC_INSTANCE_s and a list of slope start/stop signal
+ * events (e.g. derived from the PGxTRIGB/PGxTRIGC events of the PWM timebase simulator)
+ * and produces the sampled DAC output waveform. Timestamps are given in [PWM clock ticks]
+ * of PWM_CLOCK declared in demo.h, DAC output values in DAC ticks with 4 fractional bits
+ * (same format as the slope accumulator).
+ *
+ * See Also:
+ *	p33c_host_dacsim.c, p33c_host_pwmsim.h, p33c_dac.h
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_DAC_SIMULATOR_H
+#define	P33C_HOST_DAC_SIMULATOR_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "common/p33c_dac.h"
+#include "p33c_host_pwmsim.h"
+
+#define P33C_HOST_DACSIM_WAVE_SIZE  4096U   // Default waveform buffer size in [samples]
+
+/* Waveform sample flags */
+#define DACSIM_FLAG_RAMP        0x01U   // Slope generator is ramping
+#define DACSIM_FLAG_LIMIT       0x02U   // Ramp has reached DACxDATL (or DACxDATH with PSE = 1)
+#define DACSIM_FLAG_TRANSITION  0x04U   // DAC output is in transition mode (TMODTIME)
+#define DACSIM_FLAG_STEADY      0x08U   // DAC output has reached steady state (SSTIME)
+#define DACSIM_FLAG_BLANKING    0x10U   // Comparator leading-edge blanking is active (TMCB)
+
+/* Slope start/stop signal event */
+struct P33C_HOST_DACSIM_SIGNAL_s {
+    uint64_t time;      // Timestamp in [PWM clock ticks]
+    uint8_t start;      // Slope start signal selection code (SLPSTRT) or 0 = none
+    uint8_t stop;       // Slope stop signal selection code (SLPSTOPA/SLPSTOPB) or 0 = none
+};
+
+/* Sampled DAC output */
+struct P33C_HOST_DACSIM_SAMPLE_s {
+    uint64_t time;      // Timestamp in [PWM clock ticks]
+    uint16_t value;     // DAC output value in [DAC ticks] with 4 fractional bits
+    uint8_t flags;      // Sample flags (DACSIM_FLAG_xxx)
+};
+
+/* DAC slope generator model object */
+struct P33C_HOST_DACSIM_s {
+    uint64_t clock;     // DAC clock period in [PWM clock ticks]
+    uint32_t high;      // DACxDATH with 4 fractional bits
+    uint32_t low;       // DACxDATL with 4 fractional bits
+    uint32_t slope;     // SLPxDAT
+    uint16_t tmodtime;  // Transition mode duration in [DAC clocks]
+    uint16_t sstime;    // Time until steady state in [DAC clocks]
+    uint16_t tmcb;      // Leading-edge blanking period in [DAC clocks]
+    uint8_t start;      // SLPSTRT
+    uint8_t stop_a;     // SLPSTOPA
+    uint8_t stop_b;     // SLPSTOPB
+    bool slopen;        // SLOPEN
+    bool positive;      // PSE
+};
+
+/* *********************************************************************************
+ * FUNCTION PROTOTYPES
+ * ********************************************************************************/
+
+extern uint16_t p33c_HostDacSim_Load(struct P33C_HOST_DACSIM_s* sim, 
+                    const struct P33C_DAC_MODULE_s* dacModuleConfig, 
+                    const struct P33C_DAC_INSTANCE_s* dacConfig);
+extern uint32_t p33c_HostDacSim_GetSignals(struct P33C_HOST_PWMSIM_s* pwm, uint16_t pgInstance, 
+                    uint32_t cycles, struct P33C_HOST_DACSIM_SIGNAL_s* signals, uint32_t max_count);
+extern uint32_t p33c_HostDacSim_Run(const struct P33C_HOST_DACSIM_s* sim, 
+                    const struct P33C_HOST_DACSIM_SIGNAL_s* signals, uint32_t signal_count, 
+                    uint64_t t_end, struct P33C_HOST_DACSIM_SAMPLE_s* wave, uint32_t max_count);
+extern uint16_t p33c_HostDacSim_WriteCsv(const char* filename, 
+                    const struct P33C_HOST_DACSIM_SAMPLE_s* wave, uint32_t count);
+
+
+#endif	/* P33C_HOST_DAC_SIMULATOR_H */
+// END OF FILE
@@ -0,0 +1,268 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_enable.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the non-blocking PWM generator enable requests
+ *
+ * Description:
+ * This source file verifies p33c_PwmGenerator_EnableStart() and 
+ * p33c_PwmGenerator_EnablePoll() on the simulated register file:
+ *
+ *   - four PWM generators in High-Resolution mode are enabled at the same time and 
+ *     remain pending with overridden outputs owned by the I/O module until 
+ *     PCLKCON.HRRDY is set, then all requests complete within one poll of each
+ *     request and every completion callback is called exactly once
+ *   - requests of generators in standard resolution mode complete immediately
+ *   - a clock error (PCLKCON.HRERR) terminates a pending request
+ *   - the timeout is measured with SCCP1: requests with different timeouts expire
+ *     in the order of their timeouts and not before the given time has passed; the 
+ *     blocking p33c_PwmGenerator_Enable() returns after P33C_PWM_ENABLE_TIMEOUT_US
+ *   - the timeout does not expire early when the system clock switches from the FRC
+ *     oscillator to the PLL while the request is pending
+ *   - the enable timeout timer (SCCP1) is started by the driver if it is stopped
+ *
+ * SCCP1 and the oscillator model run on simulated time (p33c_HostTimer_SetSimulated()),
+ * which advances by a modelled cost of every timer and status register read, so the 
+ * completion order and the expiry times do not depend on the load of the host. The
+ * measured timeouts include the simulated execution time of the poll loop. This file
+ * is only compiled in host builds.
+ *
+ * See Also:
+ *	p33c_pwm.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <string.h>
+
+#include "config/demo.h"
+#include "pwm.h"
+
+#define P33C_HOST_ENABLE_COUNT  4U      // Number of PWM generators enabled at the same time
+#define P33C_HOST_ENABLE_PLL_LOCK_NS 100000UL // Lock delay of the system PLL in the clock switch case in [ns]
+
+static uint16_t p33c_HostEnableCalls[P33C_HOST_ENABLE_COUNT]; // Completion callbacks per request
+static uint16_t p33c_HostEnableOrder[P33C_HOST_ENABLE_COUNT]; // Request index in order of completion
+static uint16_t p33c_HostEnableDone; // Number of completed requests
+static struct P33C_PWM_ENABLE_s p33c_HostEnableRequest[P33C_HOST_ENABLE_COUNT];
+
+/* Completion callback: counts the calls of every request and records the completion order */
+static void p33c_HostEnable_Callback(struct P33C_PWM_ENABLE_s* request)
+{
+    uint16_t i = (uint16_t)(request - p33c_HostEnableRequest);
+
+    if (i >= P33C_HOST_ENABLE_COUNT)
+        return;
+    p33c_HostEnableCalls[i]++;
+    if (p33c_HostEnableDone < P33C_HOST_ENABLE_COUNT)
+        p33c_HostEnableOrder[p33c_HostEnableDone] = i;
+    p33c_HostEnableDone++;
+}
+
+/* Resets the registers and configures PG1 ... PG4 */
+static void p33c_HostEnable_Setup(uint16_t hres)
+{
+    uint16_t i;
+
+    p33c_HostSfr_Reset();
+    memset(p33c_HostEnableCalls, 0, sizeof(p33c_HostEnableCalls));
+    memset(p33c_HostEnableOrder, 0, sizeof(p33c_HostEnableOrder));
+    memset(p33c_HostEnableRequest, 0, sizeof(p33c_HostEnableRequest));
+    p33c_HostEnableDone = 0;
+
+    for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+    {
+        p33c_PwmGenerator_ConfigWriteRef(i + 1, &pgConfigClear);
+        p33c_PwmGenerator_GetHandle(i + 1)->PGxCONL.bits.HREN = hres;
+    }
+}
+
+/* Returns the simulated time in [ns] */
+static uint64_t p33c_HostEnable_Now(void)
+{
+    return(p33c_HostTimer_GetTimeNs(0));
+}
+
+/* Checks the output state of a PWM generator: 1 = pins owned by the generator */
+static uint16_t p33c_HostEnable_Pins(uint16_t pgInstance, uint16_t owned)
+{
+    volatile struct P33C_PWM_GENERATOR_s* pg = p33c_PwmGenerator_GetHandle(pgInstance);
+
+    return((pg->PGxCONL.bits.ON) && (pg->PGxIOCONL.bits.OVRENH) && (pg->PGxIOCONL.bits.OVRENL) &&
+           (pg->PGxIOCONH.bits.PENH == owned) && (pg->PGxIOCONH.bits.PENL == owned));
+}
+
+/* @@p33c_Host_VerifyPwmEnable
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the non-blocking PWM generator enable requests
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure
+ *     1 = success
+ * 
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyPwmEnable(void)
+{
+    static uint16_t sfr[P33C_HOST_SFR_SIZE >> 1];
+    static const uint16_t timeout_us[P33C_HOST_ENABLE_COUNT] = { 400, 100, 300, 200 };
+    struct P33C_PWM_ENABLE_s* rq = p33c_HostEnableRequest;
+    uint16_t i, k, pending, ok, retval = 1;
+    uint64_t t0, expired[P33C_HOST_ENABLE_COUNT];
+
+    printf("PWM generator enable requests\n");
+
+    memcpy(sfr, (const void*)p33c_HostSfrFile, sizeof(sfr));
+    p33c_HostTimer_SetSimulated(true);
+
+    // Parallel enable: all requests pending until the high resolution PWM clock is ready
+    p33c_HostEnable_Setup(1);
+    ok = 1;
+    for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+        ok &= p33c_PwmGenerator_EnableStart(&rq[i], p33c_PwmGenerator_GetHandle(i + 1), 
+                    P33C_PWM_ENABLE_TIMEOUT_US, &p33c_HostEnable_Callback);
+    for (k = 0; k < 3; k++)
+        for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+            ok &= (p33c_PwmGenerator_EnablePoll(&rq[i]) == P33C_PWM_ENABLE_PENDING) && 
+                  p33c_HostEnable_Pins(i + 1, 0);
+    ok &= (p33c_HostEnableDone == 0);
+    PCLKCONbits.HRRDY = 1;
+    for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+        ok &= (p33c_PwmGenerator_EnablePoll(&rq[i]) == P33C_PWM_ENABLE_READY) && 
+              p33c_HostEnable_Pins(i + 1, 1);
+    for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+        ok &= (p33c_PwmGenerator_EnablePoll(&rq[i]) == P33C_PWM_ENABLE_READY) && (p33c_HostEnableCalls[i] == 1);
+    printf("  %u generators in parallel, completed on HRRDY, one callback each, %s\n", 
+                (unsigned)P33C_HOST_ENABLE_COUNT, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Standard resolution mode: completed by the start function
+    p33c_HostEnable_Setup(0);
+    ok = p33c_PwmGenerator_EnableStart(&rq[0], p33c_PwmGenerator_GetHandle(1), 0, &p33c_HostEnable_Callback);
+    ok &= (rq[0].state == P33C_PWM_ENABLE_READY) && (p33c_HostEnableCalls[0] == 1) && p33c_HostEnable_Pins(1, 1);
+    ok &= (!p33c_PwmGenerator_EnableStart(NULL, p33c_PwmGenerator_GetHandle(1), 0, NULL)) &&
+          (!p33c_PwmGenerator_EnableStart(&rq[1], NULL, 0, NULL)) && 
+          (p33c_PwmGenerator_EnablePoll(NULL) == P33C_PWM_ENABLE_IDLE);
+    printf("  standard resolution mode completed immediately, %s\n", (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Clock error: request terminated, outputs remain owned by the I/O module
+    p33c_HostEnable_Setup(1);
+    ok = p33c_PwmGenerator_EnableStart(&rq[0], p33c_PwmGenerator_GetHandle(1), 
+                P33C_PWM_ENABLE_TIMEOUT_US, &p33c_HostEnable_Callback);
+    ok &= (p33c_PwmGenerator_EnablePoll(&rq[0]) == P33C_PWM_ENABLE_PENDING);
+    PCLKCONbits.HRERR = 1;
+    PCLKCONbits.HRRDY = 1;
+    ok &= (p33c_PwmGenerator_EnablePoll(&rq[0]) == P33C_PWM_ENABLE_ERROR) && 
+          (p33c_HostEnableCalls[0] == 1) && p33c_HostEnable_Pins(1, 0);
+    printf("  clock error terminates the request, %s\n", (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Timeouts in simulated time: expired in the order of the timeouts, not before the given time
+    p33c_HostEnable_Setup(1);
+    ok = 1;
+    t0 = p33c_HostEnable_Now();
+    for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+        ok &= p33c_PwmGenerator_EnableStart(&rq[i], p33c_PwmGenerator_GetHandle(i + 1), 
+                    timeout_us[i], &p33c_HostEnable_Callback);
+    do {
+        pending = 0;
+        for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+        {
+            if (rq[i].state == P33C_PWM_ENABLE_PENDING)
+            {
+                if (p33c_PwmGenerator_EnablePoll(&rq[i]) == P33C_PWM_ENABLE_PENDING)
+                    pending++;
+                else
+                    expired[i] = p33c_HostEnable_Now() - t0;
+            }
+        }
+    } while (pending > 0);
+    ok &= (p33c_HostEnableDone == P33C_HOST_ENABLE_COUNT) && 
+          (p33c_HostEnableOrder[0] == 1) && (p33c_HostEnableOrder[1] == 3) && 
+          (p33c_HostEnableOrder[2] == 2) && (p33c_HostEnableOrder[3] == 0);
+    for (i = 0; i < P33C_HOST_ENABLE_COUNT; i++)
+    {
+        ok &= (rq[i].state == P33C_PWM_ENABLE_TIMEOUT) && p33c_HostEnable_Pins(i + 1, 0) &&
+              (rq[i].elapsed_ns >= (uint32_t)timeout_us[i] * 1000UL) && 
+              (expired[i] >= (uint64_t)timeout_us[i] * 1000ULL);
+        printf("  timeout %u us: expired after %.1f us\n", (unsigned)timeout_us[i], (double)expired[i] / 1000.0);
+    }
+    printf("  timeouts in simulated time, %s\n", (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Blocking enable: returns after the timeout
+    p33c_HostEnable_Setup(1);
+    t0 = p33c_HostEnable_Now();
+    ok = (p33c_PwmGenerator_Enable(p33c_PwmGenerator_GetHandle(1)) == 0);
+    t0 = p33c_HostEnable_Now() - t0;
+    ok &= (t0 >= (uint64_t)P33C_PWM_ENABLE_TIMEOUT_US * 1000ULL) && p33c_HostEnable_Pins(1, 0);
+    printf("  blocking enable without HRRDY returns after %.1f us (timeout %u us), %s\n", 
+                (double)t0 / 1000.0, (unsigned)P33C_PWM_ENABLE_TIMEOUT_US, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Clock switch from the FRC oscillator to the PLL while the request is pending
+    p33c_HostEnable_Setup(1);
+    OSCCON = 0x0000; // FRC oscillator
+    p33c_HostClock_PllLockNs = P33C_HOST_ENABLE_PLL_LOCK_NS;
+    t0 = p33c_HostEnable_Now();
+    __builtin_write_OSCCONH(0x01); // FRCPLL
+    __builtin_write_OSCCONL(0x01);
+    ok = (p33c_PwmGenerator_Enable(p33c_PwmGenerator_GetHandle(1)) == 0);
+    t0 = p33c_HostEnable_Now() - t0;
+    p33c_HostClock_PllLockNs = 0;
+    ok &= (t0 >= (uint64_t)P33C_PWM_ENABLE_TIMEOUT_US * 1000ULL) && (OSCCONbits.COSC == 0b001) && 
+          p33c_HostEnable_Pins(1, 0);
+    printf("  clock switch after %lu us: blocking enable returns after %.1f us (timeout %u us), %s\n", 
+                P33C_HOST_ENABLE_PLL_LOCK_NS / 1000UL, (double)t0 / 1000.0, 
+                (unsigned)P33C_PWM_ENABLE_TIMEOUT_US, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Stopped timer: started by the driver, the timeout still expires
+    p33c_HostEnable_Setup(1);
+    CCP1CON1L = 0x0000;
+    t0 = p33c_HostEnable_Now();
+    ok = (p33c_PwmGenerator_Enable(p33c_PwmGenerator_GetHandle(1)) == 0) && (CCP1CON1Lbits.CCPON);
+    t0 = p33c_HostEnable_Now() - t0;
+    ok &= (t0 >= (uint64_t)P33C_PWM_ENABLE_TIMEOUT_US * 1000ULL) && p33c_HostEnable_Pins(1, 0);
+    printf("  stopped timer started by the driver, timeout after %.1f us, %s\n", 
+                (double)t0 / 1000.0, (ok) ? "ok" : "FAILED");
+    retval &= ok;
+
+    // Restore the simulated register file and the time base
+    p33c_HostTimer_SetSimulated(false);
+    memcpy((void*)p33c_HostSfrFile, sfr, sizeof(sfr));
+
+    return(retval);
+}
+
+// ________________________
+// end of file
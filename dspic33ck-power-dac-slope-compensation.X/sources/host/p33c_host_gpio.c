@@ -0,0 +1,348 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_gpio.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the generated pin descriptors and the GPIO pin accessors
+ *
+ * Description:
+ * This source file includes the generated pin descriptor headers through hal.h together
+ * with the pinmap headers they have been generated from. Every device pin listed by the
+ * X-macro of the DP PIM descriptor header and every board signal used by the firmware is
+ * compared against the macros of the pinmap headers: port and bit against the latch
+ * register bit of <NAME>_Write(), RPn, analog input, ADC core and ANx input against
+ * <NAME>_RP, <NAME>_IS_ANALOG_INPUT, <NAME>_ADCCORE and <NAME>_ADC_AN_INPUT. Macros not
+ * declared for a pin are stringized unexpanded and count as zero.
+ *
+ * The pin accessors of p33c_gpio.h and the table-driven pin initialization are
+ * verified on the simulated port registers.
+ *
+ * The port register values folded from a pin list at compile time are compared with the
+ * register values obtained by applying the individual pin macros (p33c_Gpio_InitAsOutput(),
+ * p33c_Gpio_InitAsInput(), ...) of every list entry one after another to the same default
+ * values. This is done for the board pin list of gpio.h and a test list covering all modes
+ * and pin options, starting from several default value patterns. The port table written
+ * by GPIO_Initialize() is also compared with the MCC startup sequence it replaces: 
+ * PIN_MANAGER_Initialize() (called by SYSTEM_Initialize()) followed by the individual
+ * pin macros of the board pin list.
+ *
+ * This file is only compiled in host builds.
+ *
+ * See Also:
+ *	p33c_gpio.h, p33c_gpio.c, p33c_pingen.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "config/hal.h"
+#include "gpio.h"
+#include "../mcc_generated_files/pin_manager.h"
+
+// Reference: pinmap headers the pin descriptors have been generated from (DP PIM first,
+// as the DP DevBoard header only declares <NAME>_RP of signals whose DP PIM pin is remappable)
+#if defined (__MA330048_dsPIC33CK_DPPIM__)
+    #include "config/ma330048_r30_pinmap.h"
+    #define P33C_HOST_GPIO_PIN_LIST(pin) MA330048_R30_PIN_LIST(pin)
+#elif defined (__MA330049_dsPIC33CH_DPPIM__)
+    #include "config/ma330049_r10_pinmap.h"
+    #define P33C_HOST_GPIO_PIN_LIST(pin) MA330049_R10_PIN_LIST(pin)
+    #define P33C_HOST_GPIO_IS_ANALOG    IsAnalogInput()
+#endif
+#if defined (__DM330029_R20__)
+    #include "config/dm330029_r20_pinmap.h"
+#endif
+
+#ifndef P33C_HOST_GPIO_IS_ANALOG
+    #define P33C_HOST_GPIO_IS_ANALOG    IS_ANALOG_INPUT
+#endif
+
+#define P33C_HOST_GPIO_STR_(x)          #x
+#define P33C_HOST_GPIO_STR(x)           P33C_HOST_GPIO_STR_(x)
+#define P33C_HOST_GPIO_PASTE_(a, b)     a##_##b
+#define P33C_HOST_GPIO_PASTE(a, b)      P33C_HOST_GPIO_PASTE_(a, b)
+
+/* Pin descriptor and the expanded pinmap macros of one signal */
+struct P33C_HOST_GPIO_REF_s {
+    const char* name;               // Signal name
+    struct P33C_GPIO_PIN_s pin;     // Generated pin descriptor
+    const char* write;              // Expansion of <NAME>_Write()
+    const char* rp;                 // Expansion of <NAME>_RP
+    const char* analog;             // Expansion of <NAME>_IS_ANALOG_INPUT
+    const char* adc_core;           // Expansion of <NAME>_ADCCORE
+    const char* adc_input;          // Expansion of <NAME>_ADC_AN_INPUT
+};
+
+#define P33C_HOST_GPIO_REF(name) { #name, p33c_Gpio_Descriptor(name), \
+            P33C_HOST_GPIO_STR(name##_Write()), \
+            P33C_HOST_GPIO_STR(P33C_HOST_GPIO_PASTE(name, RP)), \
+            P33C_HOST_GPIO_STR(P33C_HOST_GPIO_PASTE(name, P33C_HOST_GPIO_IS_ANALOG)), \
+            P33C_HOST_GPIO_STR(P33C_HOST_GPIO_PASTE(name, ADCCORE)), \
+            P33C_HOST_GPIO_STR(P33C_HOST_GPIO_PASTE(name, ADC_AN_INPUT)) },
+
+// All device pins of the DP PIM descriptor header
+static const struct P33C_HOST_GPIO_REF_s p33c_HostGpioPins[] = {
+    P33C_HOST_GPIO_PIN_LIST(P33C_HOST_GPIO_REF)
+};
+
+// Board signals used by the firmware (aliases resolved through the DP DevBoard header)
+static const struct P33C_HOST_GPIO_REF_s p33c_HostGpioSignals[] = {
+    P33C_HOST_GPIO_REF(DBGPIN)
+    P33C_HOST_GPIO_REF(DBGLED)
+#if defined (__DM330029_R20__)
+    P33C_HOST_GPIO_REF(SW)
+    P33C_HOST_GPIO_REF(TP03)
+    P33C_HOST_GPIO_REF(TP05)
+    P33C_HOST_GPIO_REF(DACOUT)
+#endif
+};
+
+/* Converts a stringized macro into its value, unexpanded macro names count as zero */
+static int p33c_Host_GpioValue(const char* s)
+{
+    if (strcmp(s, "true") == 0)
+        return(1);
+    if (!isdigit((unsigned char)s[0]))
+        return(0);
+    return((int)strtol(s, NULL, 0));
+}
+
+/* Compares the descriptor of one signal with the pinmap macros */
+static uint16_t p33c_Host_GpioCompareRef(const struct P33C_HOST_GPIO_REF_s* ref)
+{
+    char write[32];
+    int analog = p33c_Host_GpioValue(ref->analog);
+
+    snprintf(write, sizeof(write), "LAT%cbits.LAT%c%u", 'A' + ref->pin.port, 'A' + ref->pin.port,
+                (unsigned)ref->pin.bit);
+
+    if ((strcmp(write, ref->write) == 0) && (ref->pin.rp == p33c_Host_GpioValue(ref->rp)) &&
+        (ref->pin.analog == analog) &&
+        (ref->pin.adc_core == ((analog) ? p33c_Host_GpioValue(ref->adc_core) : 0)) &&
+        (ref->pin.adc_input == ((analog) ? p33c_Host_GpioValue(ref->adc_input) : 0)))
+        return(1);
+
+    printf("  %s: R%c%u RP%u AN%u (core %u, analog %u) does not match %s RP %s AN %s (core %s, analog %s)\n",
+                ref->name, 'A' + ref->pin.port, (unsigned)ref->pin.bit, (unsigned)ref->pin.rp,
+                (unsigned)ref->pin.adc_input, (unsigned)ref->pin.adc_core, (unsigned)ref->pin.analog,
+                ref->write, ref->rp, ref->adc_input, ref->adc_core, ref->analog);
+    return(0);
+}
+
+// Test pin list covering all configuration modes and pin options
+#define P33C_HOST_GPIO_TEST_PINS(entry, reg, port) \
+    entry(reg, port, DBGPIN, P33C_GPIO_MODE_OUTPUT_HIGH | P33C_GPIO_OPEN_DRAIN) \
+    entry(reg, port, DBGLED, P33C_GPIO_MODE_OUTPUT_LOW) \
+    entry(reg, port, ECP03,  P33C_GPIO_MODE_ANALOG) \
+    entry(reg, port, ECP05,  P33C_GPIO_MODE_INPUT | P33C_GPIO_PULL_UP) \
+    entry(reg, port, ECP24,  P33C_GPIO_MODE_INPUT | P33C_GPIO_PULL_DOWN)
+
+// Applies the individual pin macros of one list entry to the simulated port registers
+#define P33C_HOST_GPIO_APPLY(reg, p, name, cfg) { \
+            volatile P33C_GPIO_INSTANCE_t* gpio = p33c_GpioInstance_GetHandle( \
+                ((struct P33C_GPIO_PIN_s)p33c_Gpio_Descriptor(name)).port); \
+            if ((cfg) & P33C_GPIO_OPEN_DRAIN) gpio->ODCx |= p33c_Gpio_GetMask(name); \
+            if ((cfg) & P33C_GPIO_PULL_UP) gpio->CNPUx |= p33c_Gpio_GetMask(name); \
+            if ((cfg) & P33C_GPIO_PULL_DOWN) gpio->CNPDx |= p33c_Gpio_GetMask(name); \
+            switch ((cfg) & P33C_GPIO_MODE_MASK) { \
+                case P33C_GPIO_MODE_OUTPUT_LOW: p33c_Gpio_InitAsOutput(name); break; \
+                case P33C_GPIO_MODE_OUTPUT_HIGH: p33c_Gpio_InitAsOutput(name); p33c_Gpio_Set(name); break; \
+                case P33C_GPIO_MODE_INPUT: p33c_Gpio_InitAsInput(name); break; \
+                default: p33c_Gpio_InitAnalog(name); break; \
+            } }
+
+// Folded port configuration of port 'p' from the default value pattern 'seed'
+#define P33C_HOST_GPIO_FOLD(list, p, seed) (struct P33C_GPIO_PORT_CONFIG_s)p33c_GpioPort_Config(list, (p), \
+            p33c_Host_GpioPattern(seed, p, 0), p33c_Host_GpioPattern(seed, p, 1), \
+            p33c_Host_GpioPattern(seed, p, 2), p33c_Host_GpioPattern(seed, p, 3), \
+            p33c_Host_GpioPattern(seed, p, 4), p33c_Host_GpioPattern(seed, p, 5))
+
+/* Default value of one port register (0 = LATx, 1 = ODCx, ... 5 = TRISx) */
+static uint16_t p33c_Host_GpioPattern(uint16_t seed, uint16_t port, uint16_t reg)
+{
+    return((uint16_t)(seed ^ (0x0111U * ((port * 6U) + reg))));
+}
+
+/* Loads the register default values of ports A to D */
+static void p33c_Host_GpioLoad(uint16_t seed)
+{
+    volatile P33C_GPIO_INSTANCE_t* gpio;
+    uint16_t p;
+
+    for (p = P33C_GPIO_PORT_A; p <= P33C_GPIO_PORT_D; p++)
+    {
+        gpio = p33c_GpioInstance_GetHandle(p);
+        gpio->LATx = p33c_Host_GpioPattern(seed, p, 0);
+        gpio->ODCx = p33c_Host_GpioPattern(seed, p, 1);
+        gpio->CNPUx = p33c_Host_GpioPattern(seed, p, 2);
+        gpio->CNPDx = p33c_Host_GpioPattern(seed, p, 3);
+        gpio->ANSELx = p33c_Host_GpioPattern(seed, p, 4);
+        gpio->TRISx = p33c_Host_GpioPattern(seed, p, 5);
+    }
+}
+
+/* Returns the number of port registers differing from a port configuration */
+static uint16_t p33c_Host_GpioCompare(const struct P33C_GPIO_PORT_CONFIG_s* config)
+{
+    volatile P33C_GPIO_INSTANCE_t* gpio = p33c_GpioInstance_GetHandle(config->port);
+
+    return((gpio->LATx != config->LATx) + (gpio->ODCx != config->ODCx) +
+           (gpio->CNPUx != config->CNPUx) + (gpio->CNPDx != config->CNPDx) +
+           (gpio->ANSELx != config->ANSELx) + (gpio->TRISx != config->TRISx));
+}
+
+/* @@p33c_Host_VerifyGpio
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the generated pin descriptors and the GPIO pin accessors
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyGpio(void)
+{
+    static const struct P33C_GPIO_PIN_CONFIG_s pin_config[] = {
+        { .pin = p33c_Gpio_Descriptor(DBGPIN), .mode = P33C_GPIO_MODE_OUTPUT_HIGH },
+        { .pin = p33c_Gpio_Descriptor(DBGLED), .mode = P33C_GPIO_MODE_OUTPUT_LOW },
+        { .pin = p33c_Gpio_Descriptor(ECP03),  .mode = P33C_GPIO_MODE_ANALOG },
+        { .pin = p33c_Gpio_Descriptor(ECP05),  .mode = P33C_GPIO_MODE_INPUT },
+        { .pin = p33c_Gpio_Descriptor(ECP24),  .mode = P33C_GPIO_MODE_ANALOG }   // digital only: rejected
+    };
+    static const struct P33C_GPIO_PIN_CONFIG_s test_pins[] = {
+        p33c_GpioPin_Config(P33C_HOST_GPIO_TEST_PINS)
+    };
+    static const uint16_t seed[] = { 0x0000, 0xFFFF, 0x5A5A, 0xC3C3 };
+    volatile P33C_GPIO_INSTANCE_t* gpio_d;
+    uint16_t retval=1, ok, mismatches = 0;
+    uint16_t i, p, pins = 0, compared = 0;
+
+    printf("pin descriptors\n");
+
+    // Generated descriptors against the pinmap macros
+    for (i = 0; i < (sizeof(p33c_HostGpioPins) / sizeof(p33c_HostGpioPins[0])); i++, pins++)
+        mismatches += (1 - p33c_Host_GpioCompareRef(&p33c_HostGpioPins[i]));
+    for (i = 0; i < (sizeof(p33c_HostGpioSignals) / sizeof(p33c_HostGpioSignals[0])); i++, pins++)
+        mismatches += (1 - p33c_Host_GpioCompareRef(&p33c_HostGpioSignals[i]));
+    ok = ((mismatches == 0) && (pins > 2));
+    retval &= ok;
+    printf("  %u pins and board signals compared with the pinmap headers, %u mismatches, %s\n",
+                (unsigned)pins, (unsigned)mismatches, (ok) ? "ok" : "FAILED");
+
+    // Single bit accessors on the simulated latch registers
+    p33c_HostSfr_Reset();
+    gpio_d = p33c_GpioInstance_GetHandle(P33C_GPIO_PORT_D);
+    p33c_Gpio_InitAsOutput(DBGPIN);
+    p33c_Gpio_Set(DBGPIN);
+    ok = ((LATD == p33c_Gpio_GetMask(DBGPIN)) && (TRISD == 0) && (gpio_d->LATx == LATD));
+    p33c_Gpio_Toggle(DBGLED);
+    p33c_Gpio_Clear(DBGPIN);
+    ok &= (LATD == p33c_Gpio_GetMask(DBGLED));
+    p33c_Gpio_Write(DBGPIN, 1);
+    p33c_Gpio_Write(DBGLED, 0);
+    ok &= (LATD == p33c_Gpio_GetMask(DBGPIN));
+    PORTD = p33c_Gpio_GetMask(DBGLED);
+    ok &= ((p33c_Gpio_Read(DBGLED) == 1) && (p33c_Gpio_Read(DBGPIN) == 0));
+    p33c_Gpio_InitAnalog(ECP03);
+    ok &= ((ANSELA == p33c_Gpio_GetMask(ECP03)) && (TRISA == ANSELA) && (LATA == ANSELA));
+    ok &= ((p33c_Gpio_GetRP(ECP05) == ECP05_RP) && (p33c_Gpio_IsAnalog(ECP05) == 1) &&
+           (p33c_Gpio_GetAdcInput(ECP05) == ECP05_ADC_AN_INPUT) && (p33c_Gpio_GetAdcCore(ECP05) == ECP05_ADCCORE));
+    retval &= ok;
+    printf("  accessors: set, clear, toggle, write, read and analog initialization, %s\n", (ok) ? "ok" : "FAILED");
+
+    // Table-driven pin initialization
+    p33c_HostSfr_Reset();
+    ok = (p33c_GpioPins_Initialize(pin_config, (sizeof(pin_config) / sizeof(pin_config[0]))) == 0);
+    ok &= ((LATD == p33c_Gpio_GetMask(DBGPIN)) && (TRISD == 0));
+    ok &= ((ANSELA == p33c_Gpio_GetMask(ECP03)) && (TRISA == ANSELA) && (LATA == ANSELA));
+    ok &= ((ANSELB == 0) && (TRISB == p33c_Gpio_GetMask(ECP05)) && (LATB == TRISB));
+    ok &= ((ANSELC == 0) && (TRISC == 0) && (LATC == 0));
+    ok &= (p33c_GpioPins_Initialize(pin_config, 4) == 1);
+    retval &= ok;
+    printf("  pin table: %u entries, invalid entry rejected, %s\n",
+                (unsigned)(sizeof(pin_config) / sizeof(pin_config[0])), (ok) ? "ok" : "FAILED");
+
+    // Folded port register values against the individual pin macros and the pin table
+    mismatches = 0;
+    for (i = 0; i < (sizeof(seed) / sizeof(seed[0])); i++)
+    {
+        p33c_Host_GpioLoad(seed[i]);
+        GPIO_BOARD_PINS(P33C_HOST_GPIO_APPLY, 0, 0)
+        for (p = P33C_GPIO_PORT_A; p <= P33C_GPIO_PORT_D; p++, compared += 6)
+            mismatches += p33c_Host_GpioCompare(&P33C_HOST_GPIO_FOLD(GPIO_BOARD_PINS, p, seed[i]));
+
+        p33c_Host_GpioLoad(seed[i]);
+        P33C_HOST_GPIO_TEST_PINS(P33C_HOST_GPIO_APPLY, 0, 0)
+        for (p = P33C_GPIO_PORT_A; p <= P33C_GPIO_PORT_D; p++, compared += 6)
+            mismatches += p33c_Host_GpioCompare(&P33C_HOST_GPIO_FOLD(P33C_HOST_GPIO_TEST_PINS, p, seed[i]));
+
+        p33c_Host_GpioLoad(seed[i]);
+        mismatches += (1 - p33c_GpioPins_Initialize(test_pins, (sizeof(test_pins) / sizeof(test_pins[0]))));
+        for (p = P33C_GPIO_PORT_A; p <= P33C_GPIO_PORT_D; p++, compared += 6)
+            mismatches += p33c_Host_GpioCompare(&P33C_HOST_GPIO_FOLD(P33C_HOST_GPIO_TEST_PINS, p, seed[i]));
+    }
+    ok = (mismatches == 0);
+    retval &= ok;
+    printf("  folded port registers: %u values compared with the individual pin macros, %u mismatches, %s\n",
+                (unsigned)compared, (unsigned)mismatches, (ok) ? "ok" : "FAILED");
+
+    // Port configuration of the firmware: one write per register, board pins already configured
+    p33c_Host_GpioLoad(0xFFFF);
+    ok = (GPIO_Initialize() == 1);
+    for (p = 0; p < GPIO_PORT_COUNT; p++)
+        ok &= ((gpio_port_config[p].port == p) && (p33c_Host_GpioCompare(&gpio_port_config[p]) == 0));
+    GPIO_BOARD_PINS(P33C_HOST_GPIO_APPLY, 0, 0)
+    for (p = 0; p < GPIO_PORT_COUNT; p++)
+        ok &= (p33c_Host_GpioCompare(&gpio_port_config[p]) == 0);
+    ok &= (p33c_GpioPorts_Initialize(&(struct P33C_GPIO_PORT_CONFIG_s){ .port = 5 }, 1) == 0);
+    retval &= ok;
+    printf("  port table: %u ports, board pins unchanged by the individual pin macros, %s\n",
+                (unsigned)GPIO_PORT_COUNT, (ok) ? "ok" : "FAILED");
+
+    // MCC startup sequence: pin manager defaults followed by the individual pin macros
+    p33c_Host_GpioLoad(0xFFFF);
+    PIN_MANAGER_Initialize();
+    GPIO_BOARD_PINS(P33C_HOST_GPIO_APPLY, 0, 0)
+    ok = 1;
+    for (p = 0; p < GPIO_PORT_COUNT; p++)
+        ok &= (p33c_Host_GpioCompare(&gpio_port_config[p]) == 0);
+    retval &= ok;
+    printf("  PIN_MANAGER_Initialize() and pin macros: same port registers as the port table, %s\n", 
+                (ok) ? "ok" : "FAILED");
+
+    return(retval);
+}
+
+// ________________________
+// end of file
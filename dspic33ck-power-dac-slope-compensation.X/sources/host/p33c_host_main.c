@@ -0,0 +1,507 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_main.c
+ * ************************************************************************************************
+ * Summary:
+ * Host executable running the PWM and DAC user configuration on the simulated register file
+ *
+ * Description:
+ * This host application executes PWM_Initialize() and DAC_Initialize() against the
+ * simulated register file declared in sources/host/xc.h and prints the resulting
+ * register images of the PWM module, the user PWM generator, the DAC module and the
+ * user DAC instance. An optional command line argument specifies how many times the
+ * configuration sequence is repeated to measure the execution time per scenario.
+ * Finally, a runtime duty cycle and trigger update is applied through the delta
+ * register writer to report the number of PWM generator registers being written,
+ * followed by the quantization errors of all register values derived in demo.h
+ * and the verification of the runtime slope calculator and the adaptive slope 
+ * controller. The PWM timebase simulator is used to report the output edges and 
+ * trigger events of the user PWM generator configuration, which are fed into the DAC
+ * slope generator model to measure the resulting ramp of the user DAC configuration.
+ * The closed-loop buck simulator sweeps the duty ratio of a peak current mode buck
+ * converter driven by these register images to verify that the configured slope 
+ * compensation prevents sub-harmonic oscillation. A parameter sweep maps the stable
+ * operating region across PWM frequency, duty ratio, slew rate, slope delays and load 
+ * on all processor cores and optionally writes the map as CSV (*.csv) or binary file.
+ * Finally, the timing properties of the task scheduler are verified on the simulated
+ * Timer1, the generated pin descriptors are compared with the pinmap headers, the
+ * PWM generator synchronization routes and their propagation delays are checked and the
+ * phase alignment of interleaved multi-phase configurations is verified. The trap handler
+ * safe state, its latency and the crash record are checked, followed by the selection of
+ * the cold boot and warm restart path with the PLLs locking in the background and the 
+ * non-blocking PWM generator enable requests.
+ *
+ *   usage: p33c_host [iterations] [voltage profile file] [DAC waveform output file] [sweep output file]
+ *
+ * See Also:
+ *	xc.h (host), p33c_host_sfr.c, p33c_host_slope.c, p33c_host_slope_ctrl.c, p33c_host_pwmsim.c, p33c_host_dacsim.c, p33c_host_buck.c, p33c_host_sweep.c, p33c_host_sched.c, p33c_host_gpio.c, p33c_host_sync.c, p33c_host_phase.c, p33c_host_crash.c, p33c_host_boot.c, p33c_host_enable.c, pwm.c, dac.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "config/demo.h"
+#include "pwm.h"
+#include "dac.h"
+#include "common/p33c_profile.h"
+#include "p33c_host_pwmsim.h"
+#include "p33c_host_dacsim.h"
+#include "p33c_host_buck.h"
+#include "p33c_host_sweep.h"
+
+extern uint16_t p33c_Host_VerifySlope(void);
+extern uint16_t p33c_Host_VerifySlopeController(const char* filename);
+extern uint16_t p33c_Host_VerifyScheduler(void);
+extern uint16_t p33c_Host_VerifyControlLoop(void);
+extern uint16_t p33c_Host_VerifyProfiler(void);
+extern uint16_t p33c_Host_VerifyTelemetry(void);
+extern uint16_t p33c_Host_VerifyGpio(void);
+extern uint16_t p33c_Host_VerifySync(void);
+extern uint16_t p33c_Host_VerifyPhaseManager(void);
+extern uint16_t p33c_Host_VerifyCrash(void);
+extern uint16_t p33c_Host_VerifyBoot(void);
+extern uint16_t p33c_Host_VerifyPwmEnable(void);
+
+static void p33c_Host_PrintRegisters(const char* label, volatile uint16_t* sfr, uint16_t count)
+{
+    uint16_t i;
+
+    printf("%s\n", label);
+    for (i = 0; i < count; i++)
+        printf("  [+0x%02X] 0x%04X\n", (unsigned)(i << 1), (unsigned)sfr[i]);
+
+    return;
+}
+
+static void p33c_Host_PrintQuantization(const char* label, long long value, long long qerr_ppm)
+{
+    printf("  %-20s %6lld (%+lld ppm)\n", label, value, qerr_ppm);
+    return;
+}
+
+static void p33c_Host_RunPwmSim(const struct P33C_PWM_GENERATOR_s* pgConfig)
+{
+    static const char* label[P33C_HOST_PWMSIM_EVENT_COUNT] = {
+        "SOC", "PWMxH on", "PWMxH off", "PWMxL on", "PWMxL off", "TRIGA", "TRIGB", "TRIGC" };
+    struct P33C_HOST_PWMSIM_s sim;
+    struct P33C_HOST_PWMSIM_CYCLE_s cycle;
+    struct timespec t_start, t_stop;
+    double t_elapsed;
+    uint64_t checksum=0;
+    uint32_t i, cycles=10000000;
+
+    printf("PWM timebase simulation\n");
+    if (!p33c_HostPwmSim_Load(&sim, pgConfig))
+    {
+        printf("  configuration not supported\n");
+        return;
+    }
+
+    p33c_HostPwmSim_NextCycle(&sim, &cycle);
+    for (i = 0; i < P33C_HOST_PWMSIM_EVENT_COUNT; i++)
+    {
+        if (cycle.event[i] == P33C_HOST_PWMSIM_NO_EDGE)
+            printf("  %-10s        -\n", label[i]);
+        else
+            printf("  %-10s %8.3f ns\n", label[i], ((double)cycle.event[i] * 1.0e9) / (double)PWM_CLOCK);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    for (i = 0; i < cycles; i++)
+    {
+        p33c_HostPwmSim_NextCycle(&sim, &cycle);
+        checksum += cycle.event[PWMSIM_EVT_PWMH_OFF];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    t_elapsed = (double)(t_stop.tv_sec - t_start.tv_sec) +
+                (double)(t_stop.tv_nsec - t_start.tv_nsec) * 1.0e-9;
+
+    printf("  %lu PWM cycles in %.6f s (%.1f Mcycles/s, checksum 0x%016llX)\n", (unsigned long)cycles, 
+                t_elapsed, (t_elapsed > 0.0) ? ((double)cycles / t_elapsed * 1.0e-6) : 0.0, 
+                (unsigned long long)checksum);
+
+    return;
+}
+
+static uint16_t p33c_Host_RunDacSim(const struct P33C_PWM_GENERATOR_s* pgConfig, const char* filename)
+{
+    static struct P33C_HOST_DACSIM_SIGNAL_s signals[16];
+    static struct P33C_HOST_DACSIM_SAMPLE_s wave[P33C_HOST_DACSIM_WAVE_SIZE];
+    struct P33C_HOST_PWMSIM_s pwm;
+    struct P33C_HOST_DACSIM_s sim;
+    struct P33C_DAC_MODULE_s dac_module;
+    struct P33C_DAC_INSTANCE_s dac_instance;
+    uint32_t i, signal_count, count, first=UINT32_MAX, last=0;
+    double slew, slew_set, v_start, v_stop, t_ramp;
+    uint16_t retval=1;
+
+    printf("DAC slope generator simulation\n");
+    p33c_DacModule_ConfigReadRef(&dac_module);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &dac_instance);
+    if ((!p33c_HostPwmSim_Load(&pwm, pgConfig)) || 
+        (!p33c_HostDacSim_Load(&sim, &dac_module, &dac_instance)))
+    {
+        printf("  configuration not supported\n");
+        return(0);
+    }
+
+    // Simulate two PWM cycles at DAC clock resolution
+    signal_count = p33c_HostDacSim_GetSignals(&pwm, PWM_GENERATOR, 2, signals, 16);
+    count = p33c_HostDacSim_Run(&sim, signals, signal_count, 
+                (2 * (uint64_t)pwm.period) - 1, wave, P33C_HOST_DACSIM_WAVE_SIZE);
+
+    // Measure the steady-state part of the first ramp
+    for (i = 0; i < count; i++)
+    {
+        if (!(wave[i].flags & DACSIM_FLAG_RAMP))
+        {
+            if (first != UINT32_MAX) break;
+            continue;
+        }
+        if ((first == UINT32_MAX) && (wave[i].flags & DACSIM_FLAG_STEADY) && 
+            !(wave[i].flags & DACSIM_FLAG_TRANSITION))
+            first = i;
+        if ((first != UINT32_MAX) && !(wave[i].flags & DACSIM_FLAG_LIMIT))
+            last = i;
+    }
+
+    if ((first == UINT32_MAX) || (last <= first))
+    {
+        printf("  no ramp detected\n");
+        return(0);
+    }
+
+    v_start  = ((double)wave[first].value / 16.0) * (double)DAC_REFERENCE_MV / (double)DAC_FULL_SCALE;
+    v_stop   = ((double)wave[last].value / 16.0) * (double)DAC_REFERENCE_MV / (double)DAC_FULL_SCALE;
+    t_ramp   = ((double)(wave[last].time - wave[first].time) * 1.0e6) / (double)PWM_CLOCK;
+    slew     = (v_start - v_stop) / t_ramp;
+    slew_set = (double)SLOPE_SLEW_RATE_1_MV_US;
+
+    printf("  %lu signal events, %lu samples\n", (unsigned long)signal_count, (unsigned long)count);
+    printf("  ramp %.1f mV -> %.1f mV in %.3f us\n", v_start, v_stop, t_ramp);
+    printf("  slew rate %.2f mV/us (set %.2f mV/us, %+.2f %%)\n", 
+                slew, slew_set, ((slew - slew_set) * 100.0) / slew_set);
+
+    if (filename != NULL)
+    {
+        retval &= p33c_HostDacSim_WriteCsv(filename, wave, count);
+        printf("  waveform %s %s\n", filename, (retval) ? "written" : "could not be written");
+    }
+
+    return(retval);
+}
+
+static uint16_t p33c_Host_RunBuckSweep(const struct P33C_PWM_GENERATOR_s* pgConfig)
+{
+    static const uint16_t slope[3] = { 0, SLP_SLEW_RATE_1, SLP_SLEW_RATE_2 };
+    struct P33C_HOST_BUCK_PLANT_s plant = {
+        .vin = 0.0, .vout = 12000.0, .inductance = (double)POWER_STAGE_INDUCTANCE_NH,
+        .sense_gain = (double)CURRENT_SENSE_GAIN_MV_A, .capacitance = 0.0, .load = 0.0 };
+    struct P33C_PWM_GENERATOR_s pg;
+    struct P33C_DAC_MODULE_s dac_module;
+    struct P33C_DAC_INSTANCE_s dac_instance;
+    struct P33C_HOST_BUCK_s buck;
+    struct P33C_HOST_BUCK_RESULT_s result;
+    struct timespec t_start, t_stop;
+    double t_elapsed, d, m1, m2, ma, alpha;
+    uint32_t cycles=1000000, mismatches=0, unstable=0;
+    uint16_t i, k;
+
+    // Peak current mode: PGxDC sets the maximum duty cycle, comparator stops the ramp
+    pg = *pgConfig;
+    pg.PGxDC.value = SLP_TRIG_STOP;
+    p33c_DacModule_ConfigReadRef(&dac_module);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &dac_instance);
+    dac_instance.SLPxCONL.bits.SLPSTOPB = DAC_INSTANCE;
+
+    printf("peak current mode buck simulation (Vout = %.1f V, L = %.1f uH)\n", 
+                plant.vout * 1.0e-3, plant.inductance * 1.0e-3);
+    printf("  duty   ");
+    for (k = 0; k < 3; k++)
+        printf("  SLPDAT %-3u        ", (unsigned)slope[k]);
+    printf("\n");
+
+    for (i = 3; i <= 17; i++)
+    {
+        d = (double)i * 0.05;
+        plant.vin = plant.vout / d;
+        printf("  %5.2f  ", d);
+
+        for (k = 0; k < 3; k++)
+        {
+            dac_instance.SLPxDAT.value = slope[k];
+            if ((!p33c_HostBuck_Load(&buck, &plant, &pg, &dac_module, &dac_instance)) || 
+                (!p33c_HostBuck_Run(&buck, 20000, 1000, &result)))
+            {
+                printf("  configuration not supported\n");
+                return(0);
+            }
+
+            // Analytic criterion: (m2 - ma) / (m1 + ma) < 1
+            m1 = plant.sense_gain * (plant.vin - plant.vout) / plant.inductance;
+            m2 = plant.sense_gain * plant.vout / plant.inductance;
+            ma = buck.v_slope / buck.tick;
+            alpha = (m2 - ma) / (m1 + ma);
+            if ((fabs(alpha - 1.0) > 0.05) && ((alpha < 1.0) != result.stable))
+                mismatches++;
+            if ((slope[k] == SLP_SLEW_RATE_1) && (!result.stable))
+                unstable++;
+
+            printf("  %-6s %9.2e A ", (result.stable) ? "stable" : "SUB-H", result.deviation);
+        }
+        printf("\n");
+    }
+
+    // Measure the simulation throughput with the user slope configuration
+    dac_instance.SLPxDAT.value = SLP_SLEW_RATE_1;
+    plant.vin = plant.vout / 0.7;
+    p33c_HostBuck_Load(&buck, &plant, &pg, &dac_module, &dac_instance);
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    p33c_HostBuck_Run(&buck, 0, cycles, &result);
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    t_elapsed = (double)(t_stop.tv_sec - t_start.tv_sec) +
+                (double)(t_stop.tv_nsec - t_start.tv_nsec) * 1.0e-9;
+
+    printf("  %lu PWM cycles in %.6f s (%.1f Mcycles/s, peak %.3f A)\n", (unsigned long)cycles, 
+                t_elapsed, (t_elapsed > 0.0) ? ((double)cycles / t_elapsed * 1.0e-6) : 0.0, result.i_peak);
+    printf("  %lu deviations from analytic criterion, %lu unstable operating points with SLPDAT %u\n", 
+                (unsigned long)mismatches, (unsigned long)unstable, (unsigned)SLP_SLEW_RATE_1);
+
+    return((uint16_t)((mismatches == 0) && (unstable == 0)));
+}
+
+static uint16_t p33c_Host_RunSweep(const struct P33C_PWM_GENERATOR_s* pgConfig, const char* filename)
+{
+    static const uint32_t frequency[] = { 100000, 200000, 300000, 400000, 500000 };
+    static const uint32_t duty[] = { 150, 200, 250, 300, 350, 400, 450, 500, 550, 600, 650, 700, 750, 800, 850 };
+    static const uint32_t slew_rate[] = { 50, 100, 150, 200, 250, 300, 350, 400 };
+    static const uint32_t start_delay[] = { 50, 100 };
+    static const uint32_t stop_delay[] = { 900 };
+    static const uint32_t load[] = { 1000, 2000, 4000 };
+    struct P33C_HOST_SWEEP_s sweep = {
+        .frequency   = { frequency, sizeof(frequency) / sizeof(frequency[0]) },
+        .duty        = { duty, sizeof(duty) / sizeof(duty[0]) },
+        .slew_rate   = { slew_rate, sizeof(slew_rate) / sizeof(slew_rate[0]) },
+        .start_delay = { start_delay, sizeof(start_delay) / sizeof(start_delay[0]) },
+        .stop_delay  = { stop_delay, sizeof(stop_delay) / sizeof(stop_delay[0]) },
+        .load        = { load, sizeof(load) / sizeof(load[0]) },
+        .vout = 12000, .settle = 5000, .cycles = 500, .threads = 0, .steals = 0 };
+    struct P33C_HOST_SWEEP_POINT_s *result, *reference;
+    struct timespec t_start, t_stop;
+    double t_single, t_multi, speedup;
+    uint32_t i, count, status[4]={0,0,0,0};
+    uint16_t retval=1, speedup_ok=1;
+    long cores;
+
+    sweep.pg = *pgConfig;
+    p33c_DacModule_ConfigReadRef(&sweep.dac_module);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &sweep.dac_instance);
+
+    count = p33c_HostSweep_GetCount(&sweep);
+    result = calloc(count, sizeof(struct P33C_HOST_SWEEP_POINT_s));
+    reference = calloc(count, sizeof(struct P33C_HOST_SWEEP_POINT_s));
+    if ((result == NULL) || (reference == NULL))
+    {
+        free(result);
+        free(reference);
+        return(0);
+    }
+
+    printf("stability map sweep (%lu grid points)\n", (unsigned long)count);
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    retval &= p33c_HostSweep_Run(&sweep, 1, reference);
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    t_single = (double)(t_stop.tv_sec - t_start.tv_sec) + (double)(t_stop.tv_nsec - t_start.tv_nsec) * 1.0e-9;
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    retval &= p33c_HostSweep_Run(&sweep, 0, result);
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    t_multi = (double)(t_stop.tv_sec - t_start.tv_sec) + (double)(t_stop.tv_nsec - t_start.tv_nsec) * 1.0e-9;
+
+    // Multithreaded results must match the single-threaded run
+    if (memcmp(result, reference, count * sizeof(struct P33C_HOST_SWEEP_POINT_s)) != 0)
+        retval = 0;
+
+    for (i = 0; i < count; i++)
+        if (result[i].status < 4) status[result[i].status]++;
+
+    printf("  %lu stable, %lu sub-harmonic, %lu out of range, %lu not simulated (error)\n", 
+                (unsigned long)status[SWEEP_STATUS_STABLE], (unsigned long)status[SWEEP_STATUS_SUBHARMONIC], 
+                (unsigned long)status[SWEEP_STATUS_RANGE], (unsigned long)status[SWEEP_STATUS_ERROR]);
+    printf("  1 thread %.3f s, %lu threads %.3f s (speedup %.2f, %lu steals), results %s\n", 
+                t_single, (unsigned long)sweep.threads, t_multi, (t_multi > 0.0) ? (t_single / t_multi) : 0.0, 
+                (unsigned long)sweep.steals, (retval) ? "identical" : "differ");
+    if (status[SWEEP_STATUS_ERROR] > 0)
+        retval = 0; // grid points without simulation result
+
+    // A speedup is only expected when the worker threads can run on more than one core
+    cores = sysconf(_SC_NPROCESSORS_ONLN);
+    speedup = (t_multi > 0.0) ? (t_single / t_multi) : 0.0;
+    if ((cores > 1) && (sweep.threads > 1))
+    {
+        speedup_ok = (speedup > 1.0);
+        printf("  speedup %.2f with %lu threads on %ld cores, %s\n", speedup, (unsigned long)sweep.threads, 
+                    cores, (speedup_ok) ? "ok" : "FAILED");
+    }
+    else
+    {
+        printf("  speedup %.2f with %lu thread(s) on %ld core(s), not checked\n", speedup, 
+                    (unsigned long)sweep.threads, (cores > 0) ? cores : 1L);
+    }
+    retval &= speedup_ok;
+
+    if (filename != NULL)
+    {
+        i = (uint32_t)strlen(filename);
+        if ((i > 4) && (strcmp(&filename[i - 4], ".csv") == 0))
+            retval &= p33c_HostSweep_WriteCsv(filename, result, count);
+        else
+            retval &= p33c_HostSweep_WriteBinary(filename, result, count);
+        printf("  stability map %s %s\n", filename, (retval) ? "written" : "could not be written");
+    }
+
+    free(result);
+    free(reference);
+
+    return(retval);
+}
+
+int main(int argc, char* argv[])
+{
+    uint16_t retval=1;
+    unsigned long i, iterations=1;
+    struct timespec t_start, t_stop;
+    double t_elapsed;
+    struct P33C_PWM_GENERATOR_s pg_shadow, pg_update, pg_init;
+    uint16_t pg_writes, delta_ok;
+
+    if (argc > 1)
+        iterations = strtoul(argv[1], NULL, 0);
+    if (iterations == 0)
+        iterations = 1;
+
+    // Record all instrumented regions executed by the host application
+    p33c_Profile_Initialize();
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    for (i = 0; i < iterations; i++)
+    {
+        p33c_HostSfr_Reset();
+        retval = 1;
+        retval &= PWM_Initialize();
+        retval &= DAC_Initialize();
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    t_elapsed = (double)(t_stop.tv_sec - t_start.tv_sec) +
+                (double)(t_stop.tv_nsec - t_start.tv_nsec) * 1.0e-9;
+
+    p33c_Host_PrintRegisters("PWM module", (volatile uint16_t*)p33c_PwmModule_GetHandle(),
+                sizeof(struct P33C_PWM_MODULE_s) / sizeof(uint16_t));
+    p33c_Host_PrintRegisters("PWM generator", (volatile uint16_t*)my_pg1,
+                sizeof(struct P33C_PWM_GENERATOR_s) / sizeof(uint16_t));
+    p33c_Host_PrintRegisters("DAC module", (volatile uint16_t*)p33c_DacModule_GetHandle(),
+                sizeof(struct P33C_DAC_MODULE_s) / sizeof(uint16_t));
+    p33c_Host_PrintRegisters("DAC instance", (volatile uint16_t*)my_dac,
+                sizeof(struct P33C_DAC_INSTANCE_s) / sizeof(uint16_t));
+
+    // Apply a runtime timing update through the delta writer
+    p33c_PwmGenerator_ConfigReadRef(PWM_GENERATOR, &pg_shadow);
+    pg_init = pg_shadow;
+    pg_update = pg_shadow;
+    pg_update.PGxDC.value    = (PWM_DUTY_CYCLE + (PWM_DUTY_CYCLE >> 2));
+    pg_update.PGxTRIGB.value = (SLP_TRIG_START + (SLP_TRIG_START >> 2));
+    pg_update.PGxTRIGC.value = (SLP_TRIG_STOP - (SLP_TRIG_STOP >> 3));
+    pg_writes = p33c_PwmGenerator_ConfigWriteDelta(PWM_GENERATOR, &pg_update, &pg_shadow);
+
+    printf("delta update: %u of %u PWM generator registers written\n", (unsigned)pg_writes, 
+                (unsigned)(sizeof(struct P33C_PWM_GENERATOR_s) / sizeof(uint16_t)));
+    // The writer requests the update itself and never latches status bits in the shadow copy
+    delta_ok  = ((pg_writes == 3) && (my_pg1->PGxSTAT.bits.UPDREQ) && (!pg_shadow.PGxSTAT.bits.UPDREQ));
+    my_pg1->PGxSTAT.bits.UPDREQ = 0; // the PWM generator clears the update request at the start of cycle
+    pg_update.PGxDC.value = PWM_DUTY_CYCLE;
+    delta_ok &= ((p33c_PwmGenerator_ConfigWriteDelta(PWM_GENERATOR, &pg_update, &pg_shadow) == 1) &&
+                 (my_pg1->PGxSTAT.bits.UPDREQ) && (my_pg1->PGxDC.value == PWM_DUTY_CYCLE));
+    my_pg1->PGxSTAT.bits.UPDREQ = 0;
+    pg_update.PGxDC.value = (PWM_DUTY_CYCLE + (PWM_DUTY_CYCLE >> 2));
+    delta_ok &= ((p33c_PwmGenerator_ConfigWriteDelta(PWM_GENERATOR, &pg_update, &pg_shadow) == 1) &&
+                 (my_pg1->PGxSTAT.bits.UPDREQ));
+    my_pg1->PGxSTAT.bits.UPDREQ = 0;
+    printf("  UPDREQ set after timing writes, PGxSTAT/PGxCAP not shadowed, %s\n", (delta_ok) ? "ok" : "FAILED");
+    retval &= delta_ok;
+    // Simulate the PWM timebase of the user PWM generator configuration
+    p33c_Host_RunPwmSim(&pg_shadow);
+    // Simulate the resulting DAC slope of the user DAC configuration
+    retval &= p33c_Host_RunDacSim(&pg_shadow, (argc > 3) ? argv[3] : NULL);
+    // Close the peak current loop around the initial user configuration
+    retval &= p33c_Host_RunBuckSweep(&pg_init);
+    // Map the stable operating region on all processor cores
+    retval &= p33c_Host_RunSweep(&pg_init, (argc > 4) ? argv[4] : NULL);
+
+    printf("derived register values (quantization error)\n");
+    p33c_Host_PrintQuantization("PWM_PERIOD", PWM_PERIOD_RAW, PWM_PERIOD_QERR_PPM);
+    p33c_Host_PrintQuantization("PWM_DUTY_CYCLE", PWM_DUTY_CYCLE_RAW, PWM_DUTY_CYCLE_QERR_PPM);
+    p33c_Host_PrintQuantization("PWM_DEAD_TIME_RE", PWM_DEAD_TIME_RE_RAW, PWM_DEAD_TIME_RE_QERR_PPM);
+    p33c_Host_PrintQuantization("PWM_DEAD_TIME_FE", PWM_DEAD_TIME_FE_RAW, PWM_DEAD_TIME_FE_QERR_PPM);
+    p33c_Host_PrintQuantization("DAC_TMODTIME", DAC_TMODTIME_RAW, DAC_TMODTIME_QERR_PPM);
+    p33c_Host_PrintQuantization("DAC_SSTIME", DAC_SSTIME_RAW, DAC_SSTIME_QERR_PPM);
+    p33c_Host_PrintQuantization("DAC_TMCB", DAC_TMCB_RAW, DAC_TMCB_QERR_PPM);
+    p33c_Host_PrintQuantization("SLP_TRIG_START", SLP_TRIG_START_RAW, SLP_TRIG_START_QERR_PPM);
+    p33c_Host_PrintQuantization("SLP_TRIG_STOP", SLP_TRIG_STOP_RAW, SLP_TRIG_STOP_QERR_PPM);
+    p33c_Host_PrintQuantization("SLP_SLEW_RATE_1", SLP_SLEW_RATE_1_RAW, SLP_SLEW_RATE_1_QERR_PPM);
+    p33c_Host_PrintQuantization("SLP_SLEW_RATE_2", SLP_SLEW_RATE_2_RAW, SLP_SLEW_RATE_2_QERR_PPM);
+    p33c_Host_PrintQuantization("DACOUT_VALUE_HIGH_1", DACOUT_VALUE_HIGH_1_RAW, DACOUT_VALUE_HIGH_1_QERR_PPM);
+    p33c_Host_PrintQuantization("DACOUT_VALUE_HIGH_2", DACOUT_VALUE_HIGH_2_RAW, DACOUT_VALUE_HIGH_2_QERR_PPM);
+
+    retval &= p33c_Host_VerifySlope();
+    retval &= p33c_Host_VerifySlopeController((argc > 2) ? argv[2] : NULL);
+    retval &= p33c_Host_VerifyScheduler();
+    retval &= p33c_Host_VerifyControlLoop();
+    retval &= p33c_Host_VerifyProfiler();
+    retval &= p33c_Host_VerifyTelemetry();
+    retval &= p33c_Host_VerifyGpio();
+    retval &= p33c_Host_VerifySync();
+    retval &= p33c_Host_VerifyPhaseManager();
+    retval &= p33c_Host_VerifyCrash();
+    retval &= p33c_Host_VerifyBoot();
+    retval &= p33c_Host_VerifyPwmEnable();
+
+    printf("return value: %u\n", (unsigned)retval);
+    printf("%lu configuration runs in %.6f s (%.1f runs/s)\n",
+                iterations, t_elapsed, (t_elapsed > 0.0) ? ((double)iterations / t_elapsed) : 0.0);
+
+    return((retval) ? 0 : 1); // process exit code: 0 = all verifications passed
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,341 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_phase.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the multi-phase PWM and slope compensation manager
+ *
+ * Description:
+ * This source file configures interleaved converters with 2, 3 and 4 phases on PWM 
+ * generators of group 1 (PG1-PG4) and group 2 (PG5-PG8), using the user PWM generator 
+ * and DAC instance configuration of pwm.c and dac.c as templates. The following 
+ * properties are verified on the simulated registers:
+ *
+ *   - period, slope triggers and sync trigger output (PGxTRIGA) of every phase
+ *   - sync routing of every phase to the previous phase (SOCS, PGTRGSEL, MSTEN)
+ *   - slope start/stop signals of every DAC instance routed to the PWM generator of its phase
+ *   - phase alignment: the register image of every phase is loaded into the PWM timebase 
+ *     simulator, the start of cycle of every phase is derived from the PGxTRIGA event of
+ *     the previous phase and the propagation delay of the sync route decoded from the 
+ *     registers of the phase, and the PWMxH rising edges and slope start triggers are 
+ *     compared with the ideal phase shift of k * PER / N
+ *   - enabling all phases and updating duty cycle and DAC levels of all phases at once
+ *   - phase current balancing of phases with different current sense gains
+ *   - rejection of invalid phase assignments and of assignments across both groups
+ *
+ * The device provides three DAC instances, so the fourth phase of 4-phase configurations 
+ * is operated without slope compensation. This file is only compiled in host builds.
+ *
+ * See Also:
+ *	phase.c, p33c_host_pwmsim.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include "config/demo.h"
+#include "pwm.h"
+#include "dac.h"
+#include "phase.h"
+#include "p33c_host_pwmsim.h"
+
+#define P33C_HOST_PHASE_CYCLES      4U      // Number of simulated PWM cycles per phase
+#define P33C_HOST_PHASE_UPDATES     400U    // Number of phase manager updates of the balancing test
+
+/* Phase assignment under test */
+struct P33C_HOST_PHASE_TEST_s {
+    const char* name;                               // Description
+    uint16_t count;                                 // Number of phases
+    struct PHASE_CONFIG_s config[PHASE_COUNT_MAX];  // Phase assignment
+};
+
+static const struct P33C_HOST_PHASE_TEST_s p33c_HostPhaseTests[] = {
+    { "group 1", 2, { { 1, 1 }, { 2, 2 } } },
+    { "group 2", 2, { { 5, 1 }, { 6, 2 } } },
+    { "group 1", 3, { { 2, 1 }, { 3, 2 }, { 4, 3 } } },
+    { "group 2", 3, { { 5, 1 }, { 6, 2 }, { 7, 3 } } },
+    { "group 1", 4, { { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 0 } } },
+    { "group 2", 4, { { 5, 1 }, { 6, 2 }, { 7, 3 }, { 8, 0 } } }
+};
+
+/* Phase assignments across both PWM groups, rejected by PHASE_Initialize() */
+static const struct P33C_HOST_PHASE_TEST_s p33c_HostPhaseCrossGroup[] = {
+    { "group 1/2", 2, { { 1, 1 }, { 5, 2 } } },
+    { "group 1/2", 3, { { 4, 1 }, { 8, 2 }, { 1, 3 } } },
+    { "group 1/2", 4, { { 1, 1 }, { 5, 2 }, { 2, 3 }, { 6, 0 } } }
+};
+
+// Current sense gain deviation of each phase in [1/1024] used by the balancing plant model
+static const int16_t p33c_HostPhaseGainError[PHASE_COUNT_MAX] = { 41, -33, 17, -52 };
+
+/* Verifies the sync routing of phase #i to phase #i-1 */
+static uint16_t p33c_Host_PhaseRouting(const struct PHASE_MANAGER_s* mgr, uint16_t i)
+{
+    const struct PHASE_s* mother = &mgr->phase[i - 1];
+    const struct PHASE_s* child = &mgr->phase[i];
+
+    if ((!mother->pg->PGxCONH.bits.MSTEN) || (mother->pg->PGxEVTL.bits.PGTRGSEL != PHASE_TRIGGER_OUTPUT) ||
+        (!child->pg->PGxCONH.bits.TRGMOD))
+        return(0);
+
+    if (((mother->pg_instance - 1) >> 2) == ((child->pg_instance - 1) >> 2))
+        return(child->pg->PGxCONH.bits.SOCS == (((mother->pg_instance - 1) & 0x03) + 1));
+    else
+        return((child->pg->PGxCONH.bits.SOCS == 0b1111) && (child->pg->PGxSPCIL.bits.PSS == 0b00001));
+}
+
+/* Returns the maximum deviation of the PWMxH rising edges and slope start triggers from the ideal phase shift */
+static double p33c_Host_PhaseAlignment(const struct PHASE_MANAGER_s* mgr)
+{
+    struct P33C_HOST_PWMSIM_s sim[PHASE_COUNT_MAX];
+    struct P33C_HOST_PWMSIM_CYCLE_s cycle[PHASE_COUNT_MAX];
+    struct P33C_PWM_GENERATOR_s img;
+    uint64_t start = 0, delay;
+    uint16_t mother, input;
+    double ideal, error, error_max = 0.0;
+    uint16_t i, c;
+
+    // Start of cycle of each phase is the PGxTRIGA event of the previous phase plus the sync propagation delay
+    for (i = 0; i < mgr->count; i++)
+    {
+        p33c_PwmGenerator_ConfigReadRef(mgr->phase[i].pg_instance, &img);
+        delay = p33c_HostPwmSim_GetSyncDelay(&img, mgr->phase[i].pg_instance, &mother, &input);
+        img.PGxCONH.bits.SOCS = 0b0000; // the simulator only supports self-triggered generators,
+        img.PGxCONH.bits.TRGMOD = 0;    // the start of cycle is set below
+        if (!p33c_HostPwmSim_Load(&sim[i], &img))
+            return(HUGE_VAL);
+        if (i > 0)
+        {
+            if ((sim[i - 1].offset[PWMSIM_EVT_TRIGA] == P33C_HOST_PWMSIM_NO_EDGE) || 
+                (delay == P33C_HOST_PWMSIM_NO_EDGE) || (input != PWMSIM_SYNC_TRIGGER) ||
+                (mother != mgr->phase[i - 1].pg_instance))
+                return(HUGE_VAL);
+            start += sim[i - 1].offset[PWMSIM_EVT_TRIGA] + delay;
+        }
+        sim[i].start = start;
+    }
+
+    for (c = 0; c < P33C_HOST_PHASE_CYCLES; c++)
+    {
+        for (i = 0; i < mgr->count; i++)
+            p33c_HostPwmSim_NextCycle(&sim[i], &cycle[i]);
+
+        for (i = 1; i < mgr->count; i++)
+        {
+            ideal = ((double)i * sim[0].period) / mgr->count;
+            error = fabs((double)(cycle[i].event[PWMSIM_EVT_PWMH_ON] - cycle[0].event[PWMSIM_EVT_PWMH_ON]) - ideal);
+            if (error > error_max) error_max = error;
+            error = fabs((double)(cycle[i].event[PWMSIM_EVT_TRIGB] - cycle[0].event[PWMSIM_EVT_TRIGB]) - ideal);
+            if (error > error_max) error_max = error;
+        }
+    }
+
+    return(error_max);
+}
+
+/* Runs one phase assignment, returns 1 when all checks passed */
+static uint16_t p33c_Host_PhaseRun(const struct P33C_HOST_PHASE_TEST_s* test,
+                    const struct P33C_PWM_GENERATOR_s* pgTemplate,
+                    const struct P33C_DAC_INSTANCE_s* dacTemplate)
+{
+    struct PHASE_MANAGER_s mgr = { .balance = NULL };
+    struct PHASE_s* ph;
+    uint16_t ok, i, k, n, trig_a, imbalance_start = 0, imbalance = 0;
+    int32_t mean, current[PHASE_COUNT_MAX];
+    double error;
+    char pgs[32];
+
+    p33c_HostSfr_Reset();
+    PCLKCONbits.HRRDY = 1; // the simulated high resolution PWM clock is ready immediately
+
+    ok = PHASE_Initialize(&mgr, test->config, test->count, pgTemplate, dacTemplate);
+
+    // Register configuration of all phases
+    for (i = 0, n = 0; (ok) && (i < test->count); i++)
+    {
+        ph = &mgr.phase[i];
+        trig_a = (i + 1 < test->count) ? (uint16_t)(mgr.phase[i + 1].shift - ph->shift - 
+                    (mgr.phase[i + 1].sync.delay * P33C_PWM_HRES_COUNTS)) : (uint16_t)(mgr.period - ph->shift);
+        ok &= ((ph->pg->PGxPER.value == pgTemplate->PGxPER.value) && (ph->pg->PGxDC.value == pgTemplate->PGxDC.value) &&
+               (ph->pg->PGxTRIGA.value == trig_a) && (ph->pg->PGxTRIGB.value == pgTemplate->PGxTRIGB.value) &&
+               (ph->pg->PGxTRIGC.value == pgTemplate->PGxTRIGC.value) && (!ph->pg->PGxCONL.bits.ON));
+        if (i > 0)
+            ok &= p33c_Host_PhaseRouting(&mgr, i);
+        if (ph->dac != NULL)
+            ok &= ((ph->dac->SLPxCONL.bits.SLPSTRT == PHASE_SLPSTRT(ph->pg_instance)) &&
+                   (ph->dac->SLPxCONL.bits.SLPSTOPA == PHASE_SLPSTOPA(ph->pg_instance)) &&
+                   (ph->dac->SLPxDAT.value == dacTemplate->SLPxDAT.value) && (ph->dac->SLPxCONH.bits.SLOPEN));
+        n += snprintf(&pgs[n], sizeof(pgs) - n, "%sPG%u", (i) ? " " : "", (unsigned)ph->pg_instance);
+    }
+
+    // Phase alignment in the PWM timebase simulator
+    error = (ok) ? p33c_Host_PhaseAlignment(&mgr) : HUGE_VAL;
+    ok &= (error <= 0.5);
+
+    // Enable all phases
+    ok &= PHASE_Enable(&mgr);
+    for (i = 0; (ok) && (i < test->count); i++)
+    {
+        ph = &mgr.phase[i];
+        ok &= ((ph->pg->PGxCONL.bits.ON) && (ph->pg->PGxIOCONH.bits.PENH) && (!ph->pg->PGxIOCONL.bits.OVRENH) &&
+               ((ph->dac == NULL) || (ph->dac->DACxCONL.bits.DACEN)));
+    }
+    ok &= (DACCTRL1Lbits.DACON == 1);
+
+    // Phase current balancing: the phase current is proportional to the DAC level with different gains
+    mgr.balance = &PHASE_BalanceCurrents;
+    for (n = 0; n < P33C_HOST_PHASE_UPDATES; n++)
+    {
+        for (i = 0, mean = 0; i < test->count; i++)
+        {
+            ph = &mgr.phase[i];
+            ph->pg->PGxSTAT.bits.UPDREQ = 0; // the PWM generator clears the update request at the start of cycle
+            current[i] = ((int32_t)((ph->dac != NULL) ? ph->dac->DACxDATH.value : 0) * 
+                            (1024 + p33c_HostPhaseGainError[i])) >> 10;
+            ph->current = (uint16_t)current[i];
+        }
+        for (i = 0, k = 0, imbalance = 0; i < test->count; i++)
+        {
+            if (mgr.phase[i].dac != NULL) { mean += current[i]; k++; }
+        }
+        mean /= k;
+        for (i = 0; i < test->count; i++)
+        {
+            if ((mgr.phase[i].dac != NULL) && ((uint16_t)labs(current[i] - mean) > imbalance))
+                imbalance = (uint16_t)labs(current[i] - mean);
+        }
+        if (n == 1)
+            imbalance_start = imbalance;
+        ok &= PHASE_Update(&mgr, (PWM_DUTY_CYCLE >> 1), DACOUT_VALUE_HIGH_1);
+    }
+    ok &= (imbalance <= 2);
+    for (i = 0; i < test->count; i++)
+    {
+        ph = &mgr.phase[i];
+        ok &= ((ph->pg->PGxDC.value == (PWM_DUTY_CYCLE >> 1)) && (ph->pg->PGxSTAT.bits.UPDREQ));
+    }
+
+    ok &= PHASE_Disable(&mgr);
+    for (i = 0; i < test->count; i++)
+        ok &= (!mgr.phase[i].pg->PGxCONL.bits.ON);
+
+    printf("  %u phases %-15s (%-9s): shift %5u ticks, alignment error %.1f ticks, imbalance %2u -> %u ADC ticks, %s\n",
+                (unsigned)test->count, pgs, test->name, (unsigned)mgr.phase[1].shift, error,
+                (unsigned)imbalance_start, (unsigned)imbalance, (ok) ? "ok" : "FAILED");
+
+    return(ok);
+}
+
+/* @@p33c_Host_VerifyPhaseManager
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the multi-phase PWM and slope compensation manager
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyPhaseManager(void)
+{
+    static const struct PHASE_CONFIG_s too_many[] = { {1, 1}, {2, 2}, {3, 3}, {4, 0}, {5, 0} };
+    static const struct PHASE_CONFIG_s same_pg[] = { {1, 1}, {1, 2} };
+    static const struct PHASE_CONFIG_s same_dac[] = { {1, 1}, {2, 1} };
+    static const struct PHASE_CONFIG_s no_dac[] = { {1, 1}, {2, 4} };
+    static const struct PHASE_CONFIG_s no_pg[] = { {1, 1}, {9, 2} };
+    static const struct PHASE_CONFIG_s controlled[] = { {PWM_GENERATOR, DAC_INSTANCE}, {PWM_GENERATOR + 1, DAC_INSTANCE + 1} };
+    struct PWM_CONTROL_s ctrl;
+    uint16_t dc, level;
+    struct P33C_PWM_GENERATOR_s pg_template;
+    struct P33C_DAC_INSTANCE_s dac_template;
+    struct PHASE_MANAGER_s mgr;
+    uint16_t retval=1, ok, i;
+
+    printf("phase manager\n");
+
+    // Templates: user PWM generator and DAC instance configuration
+    p33c_HostSfr_Reset();
+    PWM_Initialize();
+    DAC_Initialize();
+    p33c_PwmGenerator_ConfigReadRef(PWM_GENERATOR, &pg_template);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &dac_template);
+
+    for (i = 0; i < (sizeof(p33c_HostPhaseTests) / sizeof(p33c_HostPhaseTests[0])); i++)
+        retval &= p33c_Host_PhaseRun(&p33c_HostPhaseTests[i], &pg_template, &dac_template);
+
+    // Invalid phase assignments
+    ok = ((PHASE_Initialize(&mgr, too_many, 5, &pg_template, &dac_template) == 0) &&
+          (PHASE_Initialize(&mgr, same_pg, 2, &pg_template, &dac_template) == 0) &&
+          (PHASE_Initialize(&mgr, same_dac, 2, &pg_template, &dac_template) == 0) &&
+          (PHASE_Initialize(&mgr, no_dac, 2, &pg_template, &dac_template) == 0) &&
+          (PHASE_Initialize(&mgr, no_pg, 2, &pg_template, &dac_template) == 0));
+    retval &= ok;
+    printf("  invalid assignments (5 phases, shared PG, shared DAC, DAC4, PG9) rejected, %s\n", (ok) ? "ok" : "FAILED");
+
+    // Phases of both PWM groups: the PCI Sync route carries the PWM output, not the PGxTRIGA event
+    ok = 1;
+    for (i = 0; i < (sizeof(p33c_HostPhaseCrossGroup) / sizeof(p33c_HostPhaseCrossGroup[0])); i++)
+    {
+        p33c_HostSfr_Reset();
+        ok &= (PHASE_Initialize(&mgr, p33c_HostPhaseCrossGroup[i].config, p33c_HostPhaseCrossGroup[i].count, 
+                    &pg_template, &dac_template) == 0) &&
+              (p33c_PwmGenerator_GetHandle(p33c_HostPhaseCrossGroup[i].config[0].pg)->PGxPER.value == 0) &&
+              (p33c_PwmGenerator_GetHandle(p33c_HostPhaseCrossGroup[i].config[1].pg)->PGxCONH.value == 0);
+    }
+    retval &= ok;
+    printf("  assignments across PWM groups (2, 3 and 4 phases) rejected, registers unchanged, %s\n", 
+                (ok) ? "ok" : "FAILED");
+
+    // Enabled control loop: the registers of the controlled phase are left to _ADCAN0Interrupt()
+    memcpy(&ctrl, &pwm_ctrl, sizeof(ctrl));
+    p33c_HostSfr_Reset();
+    ok = PHASE_Initialize(&mgr, controlled, 2, &pg_template, &dac_template);
+    mgr.balance = NULL;
+    dc = PWM_CONTROL_PG->PGxDC.value;
+    level = PWM_CONTROL_DAC->DACxDATH.value;
+    pwm_ctrl.enable = true;
+    ok &= PHASE_Update(&mgr, (PWM_DUTY_CYCLE >> 1), DACOUT_VALUE_HIGH_2);
+    ok &= (pwm_ctrl.duty == (PWM_DUTY_CYCLE >> 1)) && (PWM_CONTROL_PG->PGxDC.value == dc) && 
+          (PWM_CONTROL_DAC->DACxDATH.value == level) && (!PWM_CONTROL_PG->PGxSTAT.bits.UPDREQ) &&
+          (mgr.phase[1].pg->PGxDC.value == (PWM_DUTY_CYCLE >> 1)) && (mgr.phase[1].pg->PGxSTAT.bits.UPDREQ) &&
+          (mgr.phase[1].dac->DACxDATH.value == DACOUT_VALUE_HIGH_2);
+    memcpy(&pwm_ctrl, &ctrl, sizeof(ctrl));
+    retval &= ok;
+    printf("  enabled control loop owns PGxDC/DACxDATH of PG%u, duty passed as limit, %s\n", 
+                (unsigned)PWM_GENERATOR, (ok) ? "ok" : "FAILED");
+
+    return(retval);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,170 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_profile.c
+ * ************************************************************************************************
+ * Summary:
+ * Host report and verification of the cycle-count profiler
+ *
+ * Description:
+ * In host builds the profiler timer reads the monotonic clock of the host (see xc.h), so
+ * the instrumented regions of the PWM and DAC drivers, DAC_Initialize() and the scheduler 
+ * main loop report host execution times in units of 10 ns. This source file executes the 
+ * by-value and by-reference register set writes of the drivers, prints the region table
+ * and verifies the recording of minimum, maximum, mean, log2 histogram, overhead 
+ * compensation and overflow handling with synthetic execution times.
+ *
+ * This file is only compiled in host builds.
+ *
+ * See Also:
+ *	p33c_profile.c, p33c_host_timer.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+
+#include "config/demo.h"
+#include "common/p33c_pwm.h"
+#include "common/p33c_dac.h"
+#include "common/p33c_profile.h"
+
+#define P33C_HOST_PROFILE_WRITES    10000U  // Number of profiled register set writes per driver function
+
+static const char* p33c_HostProfileName[P33C_PROFILE_REGION_COUNT] = {
+    "PwmGenerator_ConfigWrite", "PwmGenerator_ConfigWriteRef", 
+    "DacInstance_ConfigWrite", "DacInstance_ConfigWriteRef",
+    "DAC_Initialize", "main loop (tick)", "telemetry push"
+};
+
+/* Prints the statistics and non-empty histogram bins of all recorded regions */
+static void p33c_Host_PrintProfile(void)
+{
+    const struct P33C_PROFILE_REGION_s* region;
+    uint16_t i, j;
+
+    p33c_Profile_Update();
+    for (i = 0; i < P33C_PROFILE_REGION_COUNT; i++)
+    {
+        region = &p33c_profile.region[i];
+        if (region->count == 0)
+            continue;
+        printf("  %-28s %8lu passes, min %5u, mean %5u, max %5u cycles, log2 bins", p33c_HostProfileName[i],
+                    (unsigned long)region->count, (unsigned)region->min, (unsigned)region->mean, (unsigned)region->max);
+        for (j = 0; j < P33C_PROFILE_HISTOGRAM_SIZE; j++)
+        {
+            if (region->histogram[j] > 0)
+                printf(" %u:%u", (unsigned)j, (unsigned)region->histogram[j]);
+        }
+        printf("\n");
+    }
+    return;
+}
+
+/* @@p33c_Host_VerifyProfiler
+ * ********************************************************************************
+ * Summary:
+ *     Reports the profiled regions and verifies the recording of execution times
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * Description:
+ *     p33c_Profile_Initialize() has to be called at program start to record 
+ *     the initialization runs and the scheduler verification of the host 
+ *     application.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyProfiler(void)
+{
+    static const uint16_t cycles[6] = { 0, 1, 2, 3, 1000, 65535 };
+    struct P33C_PWM_GENERATOR_s pg;
+    struct P33C_DAC_INSTANCE_s dac;
+    struct P33C_PROFILE_REGION_s* region;
+    uint32_t i, sum;
+    uint16_t retval=1, ok;
+
+    printf("cycle-count profiler (%u ns per cycle, overhead %u cycles)\n", 
+                (unsigned)P33C_PROFILE_TICK_NS, (unsigned)p33c_profile.overhead);
+
+    // Profile by-value and by-reference register set writes
+    p33c_PwmGenerator_ConfigReadRef(PWM_GENERATOR, &pg);
+    p33c_DacInstance_ConfigReadRef(DAC_INSTANCE, &dac);
+    for (i = 0; i < P33C_HOST_PROFILE_WRITES; i++)
+    {
+        p33c_PwmGenerator_ConfigWrite(PWM_GENERATOR, pg);
+        p33c_PwmGenerator_ConfigWriteRef(PWM_GENERATOR, &pg);
+        p33c_DacInstance_ConfigWrite(DAC_INSTANCE, dac);
+        p33c_DacInstance_ConfigWriteRef(DAC_INSTANCE, &dac);
+    }
+    p33c_Host_PrintProfile();
+
+    // Synthetic execution times: statistics and histogram bins
+    p33c_Profile_Initialize();
+    p33c_profile.overhead = 0;
+    region = &p33c_profile.region[0];
+    sum = 0;
+    for (i = 0; i < 6; i++)
+    {
+        p33c_Profile_Record(0, cycles[i]);
+        sum += cycles[i];
+    }
+    p33c_Profile_Update();
+    ok = ((region->count == 6) && (region->min == 0) && (region->max == 65535) && (region->mean == (sum / 6)));
+    ok &= ((region->histogram[0] == 2) && (region->histogram[1] == 2) && 
+           (region->histogram[9] == 1) && (region->histogram[15] == 1));
+    retval &= ok;
+    printf("  statistics: min %u, mean %u, max %u, bins 0:%u 1:%u 9:%u 15:%u, %s\n", (unsigned)region->min, 
+                (unsigned)region->mean, (unsigned)region->max, (unsigned)region->histogram[0], 
+                (unsigned)region->histogram[1], (unsigned)region->histogram[9], (unsigned)region->histogram[15],
+                (ok) ? "ok" : "FAILED");
+
+    // Overhead compensation and overflow of the sum
+    p33c_Profile_Initialize();
+    p33c_profile.overhead = 5;
+    p33c_Profile_Record(1, 3);
+    p33c_Profile_Record(1, 25);
+    region = &p33c_profile.region[1];
+    ok = ((region->min == 0) && (region->max == 20));
+    p33c_profile.overhead = 0;
+    region->count = 0x10000UL;
+    region->sum = 0xFFFF0000UL; // mean 65535
+    p33c_Profile_Record(1, 65535);
+    p33c_Profile_Record(1, 65535);
+    p33c_Profile_Update();
+    ok &= ((region->count < 0x10000UL) && (region->mean >= 65533));
+    retval &= ok;
+    printf("  overhead compensation and sum overflow: mean %u cycles after %lu passes, %s\n",
+                (unsigned)region->mean, (unsigned long)region->count, (ok) ? "ok" : "FAILED");
+
+    return(retval);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,343 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_pwmsim.c
+ * ************************************************************************************************
+ * Summary:
+ * Host-side PWM generator timebase simulator
+ *
+ * Description:
+ * This source file decodes PWM generator register images and calculates the resulting
+ * output edges and trigger events. The timing model follows the relationships used by
+ * demo.h to derive the register values:
+ *
+ *   - one PWM cycle lasts PGxPER counts
+ *   - in High Resolution mode (HREN = 1) one count equals one PWM_CLOCK tick, 
+ *     otherwise one count equals (PWM_CLOCK / AUX_CLOCK) ticks
+ *   - Independent Edge mode (MODSEL = 0b000): PWMxH turns on at PGxPHASE and
+ *     turns off at PGxDC
+ *   - Complementary output mode (PMOD = 0b00): PWMxH turn-on is delayed by PGxDTH, 
+ *     PWMxL turns on PGxDTL after PWMxH has turned off and turns off at the end
+ *     of the PWM cycle
+ *   - trigger events occur when the PWM counter matches PGxTRIGA/B/C
+ *
+ * Only self-triggered generators (SOCS = 0b0000, TRGMOD = 0) in Independent Edge mode
+ * with complementary outputs are supported. Output overrides, polarity settings, 
+ * PCI functions and the ON bit are not evaluated: the simulator describes the signals 
+ * generated by the PWM timebase.
+ *
+ * See Also:
+ *	p33c_host_pwmsim.h, demo.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+#include "p33c_host_pwmsim.h"
+
+#define P33C_HOST_PWMSIM_STD_RES    ((uint64_t)(PWM_CLOCK / AUX_CLOCK)) // PWM clock ticks per count in standard resolution mode
+
+// Sync propagation delays in [PWM generator clock cycles]: unmeasured estimates, identical to 
+// P33C_PWM_SYNC_DELAY_DIRECT/PCI, so the simulated delay compensation cannot reveal a wrong estimate
+#define P33C_HOST_PWMSIM_SYNC_SOCS  1U  // Start-of-cycle trigger register
+#define P33C_HOST_PWMSIM_SYNC_PCI   5U  // PWMPCI multiplexer, 2-stage input synchronizer, edge detector and SOC register
+
+/* @@p33c_HostPwmSim_Load
+ * ********************************************************************************
+ * Summary:
+ *     Loads a PWM generator register image into the timebase simulator
+ *
+ * Parameters:
+ *     struct P33C_HOST_PWMSIM_s* sim:
+ *          Pointer to the simulator object
+ *     const struct P33C_PWM_GENERATOR_s* pgConfig:
+ *          Pointer to the PWM generator register image
+ *
+ * Returns:
+ *     0 = failure, the configuration is not supported by the simulator
+ *     1 = success, the simulator has been reset to cycle #0
+ *
+ * Description:
+ *     This function decodes the timing registers of the register image and 
+ *     calculates the offsets of all edges and trigger events from the start 
+ *     of a PWM cycle. Pulses completely absorbed by the dead time as well as 
+ *     compare values outside of the PWM period produce no edge 
+ *     (P33C_HOST_PWMSIM_NO_EDGE).
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostPwmSim_Load(struct P33C_HOST_PWMSIM_s* sim, 
+                const struct P33C_PWM_GENERATOR_s* pgConfig)
+{
+    uint64_t res, per, phase, dc, dth, dtl;
+    uint64_t h_on, h_off, l_on, l_off;
+    uint16_t i;
+
+    if ((sim == NULL) || (pgConfig == NULL))
+        return(0);
+
+    // Check for supported operating modes
+    if ((pgConfig->PGxCONL.bits.MODSEL != 0b000) ||   // Independent Edge mode
+        (pgConfig->PGxCONH.bits.SOCS != 0b0000) ||    // Self-triggered
+        (pgConfig->PGxCONH.bits.TRGMOD != 0) ||       // Single trigger mode
+        (pgConfig->PGxIOCONH.bits.PMOD != 0b00))      // Complementary outputs
+        return(0);
+
+    // Resolution of one register count in [PWM clock ticks]
+    res = (pgConfig->PGxCONL.bits.HREN) ? 1 : P33C_HOST_PWMSIM_STD_RES;
+
+    per   = (uint64_t)pgConfig->PGxPER.value * res;
+    phase = (uint64_t)pgConfig->PGxPHASE.value * res;
+    dc    = (uint64_t)pgConfig->PGxDC.value * res;
+    dth   = (uint64_t)pgConfig->PGxDTH.value * res;
+    dtl   = (uint64_t)pgConfig->PGxDTL.value * res;
+
+    if (per == 0)
+        return(0);
+
+    // Duty cycle and phase are limited to the PWM period
+    if (dc > per) dc = per;
+    if (phase > dc) phase = dc;
+
+    // PWMxH: active from PHASE + DTH until DC
+    h_on  = phase + dth;
+    h_off = dc;
+    if (h_on >= h_off)
+    {
+        h_on  = P33C_HOST_PWMSIM_NO_EDGE;
+        h_off = P33C_HOST_PWMSIM_NO_EDGE;
+    }
+    else if (h_off >= per)
+    {
+        h_off = P33C_HOST_PWMSIM_NO_EDGE;   // 100% duty cycle: PWMxH stays on
+    }
+
+    // PWMxL: active from DC + DTL until the end of the cycle (next PHASE)
+    l_on  = dc + dtl;
+    l_off = per + phase;
+    if (l_on >= l_off)
+    {
+        l_on  = P33C_HOST_PWMSIM_NO_EDGE;
+        l_off = P33C_HOST_PWMSIM_NO_EDGE;
+    }
+
+    sim->period = per;
+    sim->offset[PWMSIM_EVT_SOC]      = 0;
+    sim->offset[PWMSIM_EVT_PWMH_ON]  = h_on;
+    sim->offset[PWMSIM_EVT_PWMH_OFF] = h_off;
+    sim->offset[PWMSIM_EVT_PWML_ON]  = l_on;
+    sim->offset[PWMSIM_EVT_PWML_OFF] = l_off;
+    sim->offset[PWMSIM_EVT_TRIGA]    = (uint64_t)pgConfig->PGxTRIGA.value * res;
+    sim->offset[PWMSIM_EVT_TRIGB]    = (uint64_t)pgConfig->PGxTRIGB.value * res;
+    sim->offset[PWMSIM_EVT_TRIGC]    = (uint64_t)pgConfig->PGxTRIGC.value * res;
+
+    // Compare events outside of the PWM period never occur
+    for (i = PWMSIM_EVT_TRIGA; i <= PWMSIM_EVT_TRIGC; i++)
+    {
+        if (sim->offset[i] >= per)
+            sim->offset[i] = P33C_HOST_PWMSIM_NO_EDGE;
+    }
+
+    sim->start = 0;
+    sim->cycle = 0;
+
+    return(1);
+}
+
+/* @@p33c_HostPwmSim_NextCycle
+ * ********************************************************************************
+ * Summary:
+ *     Calculates all edges and trigger events of the next PWM cycle
+ *
+ * Parameters:
+ *     struct P33C_HOST_PWMSIM_s* sim:
+ *          Pointer to the simulator object
+ *     struct P33C_HOST_PWMSIM_CYCLE_s* result:
+ *          Pointer to the cycle record receiving the absolute timestamps
+ *
+ * Returns:
+ *     0 = failure, invalid parameters
+ *     1 = success
+ *
+ * Description:
+ *     Timestamps are absolute times in [PWM clock ticks] since the start of 
+ *     cycle #0. The PWMxL turn-off edge of a cycle coincides with the start 
+ *     of the following cycle (plus phase).
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostPwmSim_NextCycle(struct P33C_HOST_PWMSIM_s* sim, 
+                struct P33C_HOST_PWMSIM_CYCLE_s* result)
+{
+    uint16_t i;
+
+    if ((sim == NULL) || (result == NULL))
+        return(0);
+
+    result->cycle = sim->cycle;
+    for (i = 0; i < P33C_HOST_PWMSIM_EVENT_COUNT; i++)
+    {
+        result->event[i] = (sim->offset[i] == P33C_HOST_PWMSIM_NO_EDGE) ? 
+                            P33C_HOST_PWMSIM_NO_EDGE : (sim->start + sim->offset[i]);
+    }
+
+    sim->start += sim->period;
+    sim->cycle++;
+
+    return(1);
+}
+
+/* @@p33c_HostPwmSim_GetEvents
+ * ********************************************************************************
+ * Summary:
+ *     Writes the time-ordered event list of a number of PWM cycles
+ *
+ * Parameters:
+ *     struct P33C_HOST_PWMSIM_s* sim:
+ *          Pointer to the simulator object
+ *     uint32_t cycles:
+ *          Number of PWM cycles to simulate
+ *     uint64_t* timestamps:
+ *          Array receiving the event timestamps in [PWM clock ticks]
+ *     uint8_t* events:
+ *          Array receiving the event identifiers (P33C_HOST_PWMSIM_EVENT_e)
+ *     uint32_t max_count:
+ *          Number of elements of both arrays
+ *
+ * Returns:
+ *     uint32_t: number of events written
+ *
+ * Description:
+ *     Events of each cycle are sorted by their timestamp. As all events of a 
+ *     cycle except the PWMxL turn-off edge lie within the cycle, the resulting 
+ *     list is ordered across cycles as well, apart from the PWMxL turn-off edge
+ *     coinciding with the next start of cycle. Simulation stops when the 
+ *     arrays are full.
+ *
+ * ********************************************************************************/
+
+uint32_t p33c_HostPwmSim_GetEvents(struct P33C_HOST_PWMSIM_s* sim, uint32_t cycles,
+                uint64_t* timestamps, uint8_t* events, uint32_t max_count)
+{
+    struct P33C_HOST_PWMSIM_CYCLE_s cycle;
+    uint8_t order[P33C_HOST_PWMSIM_EVENT_COUNT];
+    uint8_t i, j, n=0, tmp;
+    uint32_t c, count=0;
+
+    if ((sim == NULL) || (timestamps == NULL) || (events == NULL))
+        return(0);
+
+    // Sort event types by their offset once (insertion sort of 8 elements)
+    for (i = 0; i < P33C_HOST_PWMSIM_EVENT_COUNT; i++)
+    {
+        if (sim->offset[i] == P33C_HOST_PWMSIM_NO_EDGE)
+            continue;
+        order[n] = i;
+        for (j = n; (j > 0) && (sim->offset[order[j-1]] > sim->offset[order[j]]); j--)
+        {
+            tmp = order[j]; order[j] = order[j-1]; order[j-1] = tmp;
+        }
+        n++;
+    }
+
+    for (c = 0; c < cycles; c++)
+    {
+        if ((count + n) > max_count)
+            break;
+
+        p33c_HostPwmSim_NextCycle(sim, &cycle);
+        for (i = 0; i < n; i++)
+        {
+            timestamps[count] = cycle.event[order[i]];
+            events[count] = order[i];
+            count++;
+        }
+    }
+
+    return(count);
+}
+
+/* @@p33c_HostPwmSim_GetSyncDelay
+ * ********************************************************************************
+ * Summary:
+ *     Decodes the sync trigger input of a PWM generator register image
+ *
+ * Parameters:
+ *     const struct P33C_PWM_GENERATOR_s* pgConfig:
+ *          Pointer to the register image of the child PWM generator
+ *     uint16_t pgInstance:
+ *          Instance of the child PWM generator (1=PG1, 2=PG2, etc)
+ *     uint16_t* mother:
+ *          Pointer receiving the instance of the mother PWM generator
+ *     uint16_t* input:
+ *          Pointer receiving the signal of the mother PWM generator starting 
+ *          the cycle (P33C_HOST_PWMSIM_SYNC_INPUT_e)
+ *
+ * Returns:
+ *     uint64_t: propagation delay from the signal of the mother PWM generator
+ *               to the start of cycle in [PWM clock ticks]
+ *               (P33C_HOST_PWMSIM_NO_EDGE = no valid sync trigger input)
+ *
+ * Description:
+ *     A start-of-cycle selection of 1 to 4 selects the trigger output (PGTRGSEL)
+ *     of a PWM generator of the own group. A start-of-cycle selection of 0b1111
+ *     selects the PCI Sync function, which is decoded as sync input when its 
+ *     source is the PWMPCI multiplexer, it is not synchronized to EOC and it 
+ *     accepts rising edges. PWMPCI selects the PWM output of the mother PWM 
+ *     generator, so the cycle is started by the PWMxH rising edge of the mother
+ *     PWM generator and its trigger output has no effect. All other settings, 
+ *     including self-triggered generators, have no sync input.
+ *
+ * ********************************************************************************/
+
+uint64_t p33c_HostPwmSim_GetSyncDelay(const struct P33C_PWM_GENERATOR_s* pgConfig, 
+                uint16_t pgInstance, uint16_t* mother, uint16_t* input)
+{
+    uint16_t socs;
+
+    if ((pgConfig == NULL) || (mother == NULL) || (input == NULL) || (pgInstance == 0) || (pgInstance > 8))
+        return(P33C_HOST_PWMSIM_NO_EDGE);
+
+    socs = pgConfig->PGxCONH.bits.SOCS;
+
+    if ((socs >= 1) && (socs <= 4))
+    {
+        *mother = socs + (((pgInstance - 1) >> 2) << 2);
+        *input = PWMSIM_SYNC_TRIGGER;
+        return((uint64_t)P33C_HOST_PWMSIM_SYNC_SOCS * P33C_HOST_PWMSIM_STD_RES);
+    }
+    else if ((socs == 0b1111) && (pgConfig->PGxSPCIL.bits.PSS == 0b00001) && 
+             (pgConfig->PGxSPCIL.bits.PSYNC == 0) && (pgConfig->PGxSPCIH.bits.ACP == 0b001))
+    {
+        *mother = pgConfig->PGxLEBH.bits.PWMPCI + 1;
+        *input = PWMSIM_SYNC_PWMH;
+        return((uint64_t)P33C_HOST_PWMSIM_SYNC_PCI * P33C_HOST_PWMSIM_STD_RES);
+    }
+
+    return(P33C_HOST_PWMSIM_NO_EDGE);
+}
+
+// ________________________
+// end of file
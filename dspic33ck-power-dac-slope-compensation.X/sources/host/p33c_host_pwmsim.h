@@ -0,0 +1,109 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_pwmsim.h
+ * ************************************************************************************************
+ * Summary:
+ * Host-side PWM generator timebase simulator (header file)
+ *
+ * Description:
+ * The PWM timebase simulator decodes a PWM generator register image of type 
+ * P33C_PWM_GENERATOR_s and calculates the PWMxH/PWMxL edge timestamps and the 
+ * PGxTRIGA/B/C trigger events of consecutive PWM cycles. All timestamps are given 
+ * in [PWM clock ticks] of PWM_CLOCK declared in demo.h (e.g. 250 ps at 4 GHz).
+ *
+ * Edges are calculated once per configuration when the register image is loaded. 
+ * Advancing to the next PWM cycle only adds the cycle start time to the precomputed 
+ * edge offsets, which allows simulating millions of switching cycles per second.
+ *
+ * The sync trigger input of a triggered PWM generator is decoded separately from 
+ * the timebase: the start of cycle of a child PWM generator is the trigger event
+ * of its mother PWM generator plus the propagation delay of the sync route.
+ *
+ * See Also:
+ *	p33c_host_pwmsim.c, p33c_pwm.h
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_PWM_SIMULATOR_H
+#define	P33C_HOST_PWM_SIMULATOR_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "common/p33c_pwm.h"
+
+#define P33C_HOST_PWMSIM_NO_EDGE    UINT64_MAX  // Timestamp of an edge not occurring within a PWM cycle
+
+/* PWM timebase simulator event identifiers */
+typedef enum {
+    PWMSIM_EVT_SOC      = 0,    // Start of cycle
+    PWMSIM_EVT_PWMH_ON  = 1,    // PWMxH rising edge
+    PWMSIM_EVT_PWMH_OFF = 2,    // PWMxH falling edge
+    PWMSIM_EVT_PWML_ON  = 3,    // PWMxL rising edge
+    PWMSIM_EVT_PWML_OFF = 4,    // PWMxL falling edge
+    PWMSIM_EVT_TRIGA    = 5,    // PGxTRIGA compare event
+    PWMSIM_EVT_TRIGB    = 6,    // PGxTRIGB compare event
+    PWMSIM_EVT_TRIGC    = 7     // PGxTRIGC compare event
+} P33C_HOST_PWMSIM_EVENT_e;
+
+#define P33C_HOST_PWMSIM_EVENT_COUNT   8U  // Number of event types per PWM cycle
+
+/* Signal of the mother PWM generator starting the cycle of a synchronized PWM generator */
+typedef enum {
+    PWMSIM_SYNC_TRIGGER = 0,    // Trigger output selected by PGTRGSEL (direct route, SOCS = 1 ... 4)
+    PWMSIM_SYNC_PWMH    = 1     // PWMxH output selected by PWMPCI (PCI Sync route, SOCS = 0b1111)
+} P33C_HOST_PWMSIM_SYNC_INPUT_e;
+
+/* Edges and trigger events of one PWM cycle */
+struct P33C_HOST_PWMSIM_CYCLE_s {
+    uint64_t cycle;     // Index of the PWM cycle
+    uint64_t event[P33C_HOST_PWMSIM_EVENT_COUNT]; // Timestamps in [PWM clock ticks] (P33C_HOST_PWMSIM_NO_EDGE = none)
+};
+
+/* PWM timebase simulator object */
+struct P33C_HOST_PWMSIM_s {
+    uint64_t period;    // PWM period in [PWM clock ticks]
+    uint64_t offset[P33C_HOST_PWMSIM_EVENT_COUNT]; // Event offsets from the start of cycle in [PWM clock ticks]
+    uint64_t start;     // Start time of the next PWM cycle in [PWM clock ticks]
+    uint64_t cycle;     // Index of the next PWM cycle
+};
+
+/* *********************************************************************************
+ * FUNCTION PROTOTYPES
+ * ********************************************************************************/
+
+extern uint16_t p33c_HostPwmSim_Load(struct P33C_HOST_PWMSIM_s* sim, 
+                    const struct P33C_PWM_GENERATOR_s* pgConfig);
+extern uint16_t p33c_HostPwmSim_NextCycle(struct P33C_HOST_PWMSIM_s* sim, 
+                    struct P33C_HOST_PWMSIM_CYCLE_s* result);
+extern uint32_t p33c_HostPwmSim_GetEvents(struct P33C_HOST_PWMSIM_s* sim, uint32_t cycles,
+                    uint64_t* timestamps, uint8_t* events, uint32_t max_count);
+extern uint64_t p33c_HostPwmSim_GetSyncDelay(const struct P33C_PWM_GENERATOR_s* pgConfig, 
+                    uint16_t pgInstance, uint16_t* mother, uint16_t* input);
+
+
+#endif	/* P33C_HOST_PWM_SIMULATOR_H */
+// END OF FILE
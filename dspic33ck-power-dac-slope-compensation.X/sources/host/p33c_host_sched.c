@@ -0,0 +1,220 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_sched.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the timing properties of the cooperative task scheduler
+ *
+ * Description:
+ * This source file runs the task scheduler declared in sched.h on the simulated Timer1 
+ * initialized by TMR1_Initialize(). Each test task consumes a defined number of 
+ * simulated instruction cycles. The following properties are verified:
+ *
+ *   - every task is called exactly once per period, starting at its tick offset
+ *   - tasks are released at a constant position within their tick (zero jitter)
+ *   - measured execution times match the simulated execution times
+ *   - the tick busy time reports the remaining headroom
+ *   - a task exceeding the tick period is reported as overrun, the elapsed ticks 
+ *     are reported as missed and the calls dropped as skipped
+ *   - execution times are measured correctly when Timer1 has rolled over and its
+ *     interrupt has not been serviced yet (interrupt latency)
+ *
+ * This file is only compiled in host builds.
+ *
+ * See Also:
+ *	sched.c, p33c_host_timer.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+
+#include "sched.h"
+#include "../mcc_generated_files/tmr1.h"
+
+#define P33C_HOST_SCHED_TICKS       10000U  // Number of simulated ticks (1 s)
+#define P33C_HOST_SCHED_OVERLOAD    25000U  // Execution time of the overloaded 10 ms task in [instruction cycles]
+
+/* Test task state */
+struct P33C_HOST_SCHED_TASK_s {
+    uint32_t cycles;        // Simulated execution time in [instruction cycles]
+    uint32_t calls;         // Number of calls
+    uint16_t last_tick;     // Tick of the most recent call
+    uint16_t period_err;    // Number of calls not separated by the task period
+    uint16_t release_min;   // Earliest position within the tick at task entry in [Timer1 counts]
+    uint16_t release_max;   // Latest position within the tick at task entry in [Timer1 counts]
+};
+
+static struct P33C_HOST_SCHED_TASK_s p33c_HostSchedTask[3];
+static const uint16_t p33c_HostSchedPeriod[3] = { SCHED_RATE_100US, SCHED_RATE_1MS, SCHED_RATE_10MS };
+
+static void p33c_Host_SchedTask(uint16_t id)
+{
+    struct P33C_HOST_SCHED_TASK_s* task = &p33c_HostSchedTask[id];
+    uint16_t tmr = TMR1;
+
+    if ((task->calls > 0) && ((uint16_t)(sched.tick - task->last_tick) != p33c_HostSchedPeriod[id]))
+        task->period_err++;
+    if (tmr < task->release_min) task->release_min = tmr;
+    if (tmr > task->release_max) task->release_max = tmr;
+    task->last_tick = sched.tick;
+    task->calls++;
+
+    p33c_HostTimer_Advance(task->cycles);
+    return;
+}
+
+static void p33c_Host_SchedTask100us(void) { p33c_Host_SchedTask(0); }
+static void p33c_Host_SchedTask1ms(void) { p33c_Host_SchedTask(1); }
+static void p33c_Host_SchedTask10ms(void) { p33c_Host_SchedTask(2); }
+
+#define P33C_HOST_SCHED_LATENCY     100U    // Cycles after the Timer1 period match with the interrupt pending
+
+extern void _T1Interrupt(void);
+
+/* Latency test task 1: ends after the Timer1 period match with the interrupt still pending */
+static void p33c_Host_SchedLatencyHold(void)
+{
+    _T1IE = 0;
+    p33c_HostTimer_Advance(((uint32_t)PR1 - (uint32_t)TMR1) + 1UL + P33C_HOST_SCHED_LATENCY);
+    return;
+}
+
+/* Latency test task 2: starts with the interrupt pending, which is then serviced */
+static void p33c_Host_SchedLatencyService(void)
+{
+    _T1IE = 1;
+    _T1Interrupt();
+    p33c_HostTimer_Advance(p33c_HostSchedTask[0].cycles);
+    return;
+}
+
+static void p33c_Host_SchedSetup(struct SCHED_TASK_s* tasks, const uint32_t* cycles)
+{
+    uint16_t i;
+
+    tasks[0] = (struct SCHED_TASK_s){ .function = &p33c_Host_SchedTask100us, .period = SCHED_RATE_100US, .offset = 0 };
+    tasks[1] = (struct SCHED_TASK_s){ .function = &p33c_Host_SchedTask1ms, .period = SCHED_RATE_1MS, .offset = 1 };
+    tasks[2] = (struct SCHED_TASK_s){ .function = &p33c_Host_SchedTask10ms, .period = SCHED_RATE_10MS, .offset = 5 };
+
+    for (i = 0; i < 3; i++)
+    {
+        p33c_HostSchedTask[i] = (struct P33C_HOST_SCHED_TASK_s){ .cycles = cycles[i], .calls = 0, 
+                    .last_tick = 0, .period_err = 0, .release_min = 0xFFFF, .release_max = 0 };
+    }
+
+    p33c_HostSfr_Reset();
+    TMR1_Initialize();
+    SCHED_Initialize(tasks, 3);
+    SCHED_Start();
+
+    return;
+}
+
+/* @@p33c_Host_VerifyScheduler
+ * ********************************************************************************
+ * Summary:
+ *     Verifies call rates, release jitter and execution time accounting
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyScheduler(void)
+{
+    static const uint32_t cycles_nominal[3] = { 1500, 2000, 4000 };
+    static const uint32_t cycles_overload[3] = { 1500, 2000, P33C_HOST_SCHED_OVERLOAD };
+    struct SCHED_TASK_s tasks[3];
+    uint32_t i, expected, tick_cycles, lost;
+    uint16_t retval=1, ok;
+
+    printf("task scheduler\n");
+
+    // Nominal load: all tasks complete within their tick
+    p33c_Host_SchedSetup(tasks, cycles_nominal);
+    tick_cycles = (uint32_t)PR1 + 1UL;
+    for (i = 0; i < P33C_HOST_SCHED_TICKS; i++)
+        SCHED_Execute();
+
+    for (i = 0; i < 3; i++)
+    {
+        expected = (P33C_HOST_SCHED_TICKS - tasks[i].offset + tasks[i].period - 1) / tasks[i].period;
+        ok = ((p33c_HostSchedTask[i].calls == expected) && (tasks[i].calls == (uint16_t)expected) &&
+              (p33c_HostSchedTask[i].period_err == 0) && (tasks[i].exec_max == cycles_nominal[i]) &&
+              (p33c_HostSchedTask[i].release_min == p33c_HostSchedTask[i].release_max) && 
+              (tasks[i].overruns == 0) && (tasks[i].skipped == 0));
+        retval &= ok;
+        printf("  %5u us task: %6lu calls (expected %lu), exec %5u cycles, release jitter %u cycles, %s\n",
+                (unsigned)(tasks[i].period * SCHED_TICK_PERIOD_US), (unsigned long)p33c_HostSchedTask[i].calls,
+                (unsigned long)expected, (unsigned)tasks[i].exec_max, 
+                (unsigned)(p33c_HostSchedTask[i].release_max - p33c_HostSchedTask[i].release_min),
+                (ok) ? "ok" : "FAILED");
+    }
+    ok = ((sched.overruns == 0) && (sched.missed == 0) && 
+          (sched.busy_max == (cycles_nominal[0] + cycles_nominal[2])));
+    retval &= ok;
+    printf("  nominal load: busy max %u of %lu cycles (%.1f %% headroom), %u overruns, %u missed ticks, %s\n",
+                (unsigned)sched.busy_max, (unsigned long)tick_cycles, 
+                100.0 * (double)(tick_cycles - sched.busy_max) / (double)tick_cycles,
+                (unsigned)sched.overruns, (unsigned)sched.missed, (ok) ? "ok" : "FAILED");
+
+    // Overload: the 10 ms task exceeds the tick period
+    p33c_Host_SchedSetup(tasks, cycles_overload);
+    for (i = 0; i < P33C_HOST_SCHED_TICKS; i++)
+        SCHED_Execute();
+
+    // Ticks elapsed during one overloaded tick; the most recent one is processed late, all others are missed
+    lost = ((cycles_overload[0] + P33C_HOST_SCHED_OVERLOAD) / tick_cycles) - 1;
+    ok = ((tasks[2].overruns == tasks[2].calls) && (sched.overruns == tasks[2].calls) &&
+          (sched.missed == (tasks[2].calls * lost)) && (tasks[0].skipped == sched.missed) &&
+          (tasks[2].exec_max == P33C_HOST_SCHED_OVERLOAD) && (tasks[0].overruns == 0));
+    retval &= ok;
+    printf("  overload: 10 ms task exec %u cycles, %u overruns in %u calls, %u missed ticks, %u skipped 100 us calls, %s\n",
+                (unsigned)tasks[2].exec_max, (unsigned)tasks[2].overruns, (unsigned)tasks[2].calls,
+                (unsigned)sched.missed, (unsigned)tasks[0].skipped, (ok) ? "ok" : "FAILED");
+
+    // Interrupt latency: Timer1 rolls over while its interrupt is held off
+    p33c_Host_SchedSetup(tasks, cycles_nominal);
+    tasks[0] = (struct SCHED_TASK_s){ .function = &p33c_Host_SchedLatencyHold, .period = SCHED_RATE_100US, .offset = 0 };
+    tasks[1] = (struct SCHED_TASK_s){ .function = &p33c_Host_SchedLatencyService, .period = SCHED_RATE_100US, .offset = 0 };
+    SCHED_Initialize(tasks, 2);
+    SCHED_Start();
+    SCHED_Execute();
+    ok = ((tasks[0].exec_time == (tick_cycles + P33C_HOST_SCHED_LATENCY)) && 
+          (tasks[1].exec_time == cycles_nominal[0]) && (sched.tick == 2));
+    retval &= ok;
+    printf("  interrupt latency: exec %u and %u cycles across a pending Timer1 rollover, %s\n",
+                (unsigned)tasks[0].exec_time, (unsigned)tasks[1].exec_time, (ok) ? "ok" : "FAILED");
+
+    return(retval);
+}
+
+// ________________________
+// end of file
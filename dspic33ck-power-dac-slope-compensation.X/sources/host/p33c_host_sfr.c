@@ -0,0 +1,94 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_sfr.c
+ * ************************************************************************************************
+ * Summary:
+ * Simulated Special Function Register file of the host build
+ *
+ * Description:
+ * This source file provides the memory behind all SFR names declared in the host
+ * device header sources/host/xc.h. It is only compiled in host builds.
+ *
+ * See Also:
+ *	xc.h (host)
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+/* @@p33c_HostSfrFile
+ * ********************************************************************************
+ * Summary:
+ *   Simulated SFR address space
+ *
+ * Description:
+ *   Word array covering the SFR address space of the device. Every SFR name
+ *   declared in the host device header resolves to one element of this array.
+ *
+ * *******************************************************************************/
+
+volatile uint16_t p33c_HostSfrFile[P33C_HOST_SFR_SIZE >> 1];
+
+uint32_t p33c_HostSfrWrites = 0; // PWM and DAC register writes of the boot paths (BOOT_HOST_WRITES(), boot.h)
+
+#define P33C_HOST_SFR_OSCCON_PLL    0x1120U // OSCCON: COSC = NOSC = FRCPLL, LOCK = 1
+
+/* @@p33c_HostSfr_Reset
+ * ********************************************************************************
+ * Summary:
+ *     Clears all simulated Special Function Registers
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     (none)
+ *
+ * Description:
+ *     This function resets the simulated register file to all zeros, which
+ *     represents the state of the peripheral registers after a device RESET,
+ *     and resets the PLL lock timing of the oscillator model. Only OSCCON is
+ *     preset to the completed clock switch to the FRC PLL performed by main(), 
+ *     so the profiler timer (SCCP1) counts PLL instruction cycles. Scenarios 
+ *     simulating the boot sequence clear OSCCON to start from the FRC oscillator.
+ *     Host applications call this function before running a new configuration
+ *     scenario.
+ *
+ * ********************************************************************************/
+
+void p33c_HostSfr_Reset(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < (P33C_HOST_SFR_SIZE >> 1); i++)
+        p33c_HostSfrFile[i] = 0x0000;
+    OSCCON = P33C_HOST_SFR_OSCCON_PLL;
+    p33c_HostClock_Reset(); // oscillator model of p33c_host_clock.c
+
+    return;
+}
+
+// ________________________
+// end of file
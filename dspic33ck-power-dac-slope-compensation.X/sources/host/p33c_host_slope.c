@@ -0,0 +1,168 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_slope.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the runtime slope calculator against a double-precision oracle
+ *
+ * Description:
+ * This source file sweeps the entire 16-bit input range of the fixed-point conversion
+ * functions declared in slope.h and compares every result with a reference value
+ * calculated in double-precision floating point using the same Q16.16 gain. The 
+ * maximum deviation of the fixed-point results from the ideal physical values derived
+ * from the demo.h settings is reported as well. It is only compiled in host builds.
+ *
+ * See Also:
+ *	slope.c, demo.h, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "slope.h"
+
+/* @@p33c_Host_SlopeOracle
+ * ********************************************************************************
+ * Summary:
+ *     Double-precision reference of SLOPE_Scale()
+ *
+ * Parameters:
+ *     uint16_t input:  unsigned Q15 input value
+ *     uint32_t gain:   unsigned Q16.16 gain
+ *     double limit:    maximum output value
+ *
+ * Returns:
+ *     double: expected output value
+ *
+ * ********************************************************************************/
+
+static double p33c_Host_SlopeOracle(uint16_t input, uint32_t gain, double limit)
+{
+    double value;
+
+    if (input & 0x8000)
+        return(0.0);
+
+    value = floor(((double)input / 32768.0) * ((double)gain / 65536.0) + 0.5);
+
+    return((value > limit) ? limit : value);
+}
+
+/* @@p33c_Host_SlopeSweep
+ * ********************************************************************************
+ * Summary:
+ *     Compares one conversion function with its oracle across all input values
+ *
+ * Parameters:
+ *     const char* label:  name of the conversion printed in the report
+ *     uint16_t (*convert)(uint16_t): fixed-point conversion function
+ *     uint32_t gain:      Q16.16 gain used by the conversion function
+ *     double ideal_gain:  exact gain in [output ticks] per full scale input
+ *     double limit:       maximum output value
+ *
+ * Returns:
+ *     uint32_t: number of mismatches
+ *
+ * ********************************************************************************/
+
+static uint32_t p33c_Host_SlopeSweep(const char* label, uint16_t (*convert)(uint16_t), 
+                    uint32_t gain, double ideal_gain, double limit)
+{
+    uint32_t i, mismatches=0;
+    uint16_t result;
+    double ideal, error, max_error=0.0;
+    struct timespec t_start, t_stop;
+    double t_elapsed;
+    volatile uint16_t sink=0;
+
+    for (i = 0; i <= 0xFFFF; i++)
+    {
+        result = convert((uint16_t)i);
+        if ((double)result != p33c_Host_SlopeOracle((uint16_t)i, gain, limit))
+            mismatches++;
+
+        // Compare against ideal physical value where it is within the output range
+        ideal = (i & 0x8000) ? 0.0 : (((double)i / 32768.0) * ideal_gain);
+        if (ideal <= limit)
+        {
+            error = fabs((double)result - ideal);
+            if (error > max_error)
+                max_error = error;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    for (i = 0; i <= 0xFFFF; i++)
+        sink += convert((uint16_t)i);
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    t_elapsed = (double)(t_stop.tv_sec - t_start.tv_sec) +
+                (double)(t_stop.tv_nsec - t_start.tv_nsec) * 1.0e-9;
+
+    printf("  %-18s gain 0x%08lX: %lu mismatches in 65536 inputs, max. error %.4f ticks, %.1f ns/call\n",
+                label, (unsigned long)gain, (unsigned long)mismatches, max_error, 
+                (t_elapsed * 1.0e9) / 65536.0);
+
+    return(mismatches);
+}
+
+/* @@p33c_Host_VerifySlope
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the runtime slope calculator functions
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one result differs from the oracle
+ *     1 = success, all results are bit-exact
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifySlope(void)
+{
+    uint32_t mismatches=0;
+    double slew_gain, voltage_gain;
+
+    // Exact gains derived from the demo.h settings (see slope.h)
+    slew_gain = (16.0 * ((double)SLOPE_SLEW_RATE_FS_MV_US / 1000.0) * (double)DAC_FULL_SCALE * 
+                (double)DAC_CLOCK_DIVIDER) / (((double)DAC_REFERENCE_MV / 1000.0) * 
+                ((double)DAC_CLOCK_FREQUENCY / 1.0e6));
+    voltage_gain = ((double)SLOPE_VOLTAGE_FS_MV * (double)DAC_FULL_SCALE) / (double)DAC_REFERENCE_MV;
+
+    printf("slope calculator\n");
+    mismatches += p33c_Host_SlopeSweep("SLOPE_GetSlopeData", &SLOPE_GetSlopeData,
+                SLOPE_SLEW_RATE_GAIN, slew_gain, 65535.0);
+    mismatches += p33c_Host_SlopeSweep("SLOPE_GetDacData", &SLOPE_GetDacData,
+                SLOPE_VOLTAGE_GAIN, voltage_gain, (double)(DAC_FULL_SCALE - 1));
+
+    return(mismatches == 0);
+}
+
+// ________________________
+// end of file
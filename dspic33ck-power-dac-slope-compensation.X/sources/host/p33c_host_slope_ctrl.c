@@ -0,0 +1,306 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_slope_ctrl.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the adaptive slope controller against the analytic optimum
+ *
+ * Description:
+ * This source file feeds input and output voltage profiles into the adaptive slope 
+ * controller declared in slope_ctrl.h and compares the selected slope rate with the 
+ * analytic optimum m2/2 calculated in double-precision floating point. The ramp start
+ * level is verified by the compensated peak current reference at the expected turn-off
+ * time, which has to match the reference of the controller within 0.5 DAC ticks plus 
+ * the ramp of one PWM tick of on-time quantization. The deviation of the level from 
+ * the level of the exact slope rate is dominated by the SLPxDAT rounding error 
+ * accumulated across the ramp (several DAC ticks); it is reported and checked against
+ * this bound. The settings are applied to the simulated DAC registers through the 
+ * timing update transaction and read back for every sample. Built-in profiles cover 
+ * a soft-start, an input voltage transient and an output voltage droop. Additional 
+ * profiles can be loaded from a text file with one sample per line in the format
+ *
+ *   <Vin [mV]>,<Vout [mV]>
+ *
+ * With the control loop enabled, the ramp start level is handed over to the control 
+ * loop (pwm_ctrl.ramp) instead of being written to DACxDATH.
+ *
+ * This file is only compiled in host builds.
+ *
+ * See Also:
+ *	slope_ctrl.c, demo.h, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <math.h>
+
+#include "slope_ctrl.h"
+
+#define P33C_HOST_PROFILE_SIZE  64U // Maximum number of samples of a profile
+
+/* Voltage profile sample */
+struct P33C_HOST_PROFILE_SAMPLE_s {
+    uint32_t vin_mv;    // Input voltage in [mV]
+    uint32_t vout_mv;   // Output voltage in [mV]
+};
+
+/* Verification result accumulated across all samples */
+struct P33C_HOST_SLOPECTRL_RESULT_s {
+    uint32_t samples;       // Number of samples processed
+    uint32_t failures;      // Number of samples outside of the tolerance
+    double max_slope_error; // Maximum slope rate deviation in [SLPxDAT ticks]
+    double max_peak_error;  // Maximum deviation of the compensated peak current reference at turn-off in [DAC ticks]
+    double max_level_error; // Maximum ramp start level deviation from the level of the exact slope rate in [DAC ticks]
+};
+
+/* @@p33c_Host_ToQ15
+ * ********************************************************************************
+ * Summary:
+ *     Converts a voltage into an unsigned Q15 feedback value
+ *
+ * Parameters:
+ *     uint32_t mv:    voltage in [mV]
+ *     uint32_t fs_mv: voltage represented by full scale in [mV]
+ *
+ * Returns:
+ *     uint16_t: Q15 feedback value (saturated to 0x7FFF)
+ *
+ * ********************************************************************************/
+
+static uint16_t p33c_Host_ToQ15(uint32_t mv, uint32_t fs_mv)
+{
+    uint32_t value;
+
+    value = (uint32_t)((((uint64_t)mv << 15) + (fs_mv >> 1)) / fs_mv);
+
+    return((value > 0x7FFF) ? 0x7FFF : (uint16_t)value);
+}
+
+/* @@p33c_Host_SlopeCtrlSample
+ * ********************************************************************************
+ * Summary:
+ *     Runs one controller update and compares the result with the analytic optimum
+ *
+ * Parameters:
+ *     struct SLOPECTRL_s* ctrl:     adaptive slope controller object
+ *     struct P33C_HOST_PROFILE_SAMPLE_s* sample: input and output voltage sample
+ *     struct P33C_HOST_SLOPECTRL_RESULT_s* result: accumulated verification result
+ *
+ * Returns:
+ *     (none)
+ *
+ * ********************************************************************************/
+
+static void p33c_Host_SlopeCtrlSample(struct SLOPECTRL_s* ctrl, 
+                const struct P33C_HOST_PROFILE_SAMPLE_s* sample,
+                struct P33C_HOST_SLOPECTRL_RESULT_s* result)
+{
+    uint16_t vin, vout;
+    double vout_v, slope_opt, level_opt, level_q, ton, ramp, tol_slope, tol_peak, tol_level;
+    double slope_err, peak_err, level_err;
+
+    vin  = p33c_Host_ToQ15(sample->vin_mv, VIN_FEEDBACK_FS_MV);
+    vout = p33c_Host_ToQ15(sample->vout_mv, VOUT_FEEDBACK_FS_MV);
+
+    if (!SLOPECTRL_Update(ctrl, vin, vout))
+        result->failures++;
+
+    // Analytic optimum slope m2/2 in [SLPxDAT ticks] based on the sampled output voltage
+    vout_v = ((double)vout / 32768.0) * ((double)VOUT_FEEDBACK_FS_MV / 1000.0);
+    slope_opt = 0.5 * (vout_v / ((double)POWER_STAGE_INDUCTANCE_NH / 1000.0))   // [A/us]
+                * ((double)CURRENT_SENSE_GAIN_MV_A / 1000.0)                    // [V/us]
+                * 16.0 * ((double)DAC_FULL_SCALE / ((double)DAC_REFERENCE_MV / 1000.0))
+                * ((double)DAC_CLOCK_DIVIDER / ((double)DAC_CLOCK_FREQUENCY / 1.0e6));
+
+    // Analytic ramp start level for the analytic slope rate
+    ton = (vin == 0) ? (double)PWM_PERIOD : 
+          ((double)vout * (double)VOUT_FEEDBACK_FS_MV) / ((double)vin * (double)VIN_FEEDBACK_FS_MV) * (double)PWM_PERIOD;
+    if (ton > (double)PWM_PERIOD) ton = (double)PWM_PERIOD;
+    ramp = ton - (double)SLP_TRIG_START;
+    if (ramp < 0.0) ramp = 0.0;
+    if (ramp > (double)(SLP_TRIG_STOP - SLP_TRIG_START)) ramp = (double)(SLP_TRIG_STOP - SLP_TRIG_START);
+    level_opt = (double)ctrl->reference + (slope_opt * ramp) / (double)SLOPECTRL_RAMP_DIVIDER;
+    if (level_opt > (double)(DAC_FULL_SCALE - 1)) level_opt = (double)(DAC_FULL_SCALE - 1);
+
+    // Ramp start level compensating the applied slope rate: the peak current reference at 
+    // the expected turn-off time equals the reference of the controller
+    level_q = (double)ctrl->reference + ((double)ctrl->slope * ramp) / (double)SLOPECTRL_RAMP_DIVIDER;
+    if (level_q > (double)(DAC_FULL_SCALE - 1)) level_q = (double)(DAC_FULL_SCALE - 1);
+
+    // Tolerances: output rounding plus the effect of the Q16.16 gain and on-time quantization;
+    // the level of the exact slope rate additionally carries the slope tolerance across the ramp
+    tol_slope = 0.5 + ((double)SLOPECTRL_SLEW_GAIN / 65536.0) / 32768.0 + 1.0e-6;
+    tol_peak  = 0.5 + (double)ctrl->slope / (double)SLOPECTRL_RAMP_DIVIDER + 1.0e-6;
+    tol_level = 0.5 + ((slope_opt + tol_slope) + (tol_slope * ramp)) / (double)SLOPECTRL_RAMP_DIVIDER + 1.0e-6;
+
+    slope_err = fabs((double)ctrl->slope - slope_opt);
+    peak_err  = fabs((double)ctrl->dac_high - level_q);
+    level_err = fabs((double)ctrl->dac_high - level_opt);
+
+    if ((slope_err > tol_slope) || (peak_err > tol_peak) || (level_err > tol_level) ||
+        (my_dac->SLPxDAT.value != ctrl->slope) || (my_dac->DACxDATH.value != ctrl->dac_high) ||
+        (pwm_ctrl.ramp != ctrl->ramp))
+        result->failures++;
+
+    if (slope_err > result->max_slope_error) result->max_slope_error = slope_err;
+    if (peak_err > result->max_peak_error) result->max_peak_error = peak_err;
+    if (level_err > result->max_level_error) result->max_level_error = level_err;
+    result->samples++;
+
+    return;
+}
+
+/* @@p33c_Host_SlopeCtrlProfile
+ * ********************************************************************************
+ * Summary:
+ *     Feeds one voltage profile into the adaptive slope controller
+ *
+ * Parameters:
+ *     const char* label: name of the profile printed in the report
+ *     const struct P33C_HOST_PROFILE_SAMPLE_s* profile: profile samples
+ *     uint16_t count:    number of samples
+ *
+ * Returns:
+ *     uint32_t: number of failed samples
+ *
+ * ********************************************************************************/
+
+static uint32_t p33c_Host_SlopeCtrlProfile(const char* label, 
+                const struct P33C_HOST_PROFILE_SAMPLE_s* profile, uint16_t count)
+{
+    struct SLOPECTRL_s ctrl;
+    struct P33C_HOST_SLOPECTRL_RESULT_s result = { 0, 0, 0.0, 0.0, 0.0 };
+    uint16_t i;
+
+    SLOPECTRL_Initialize(&ctrl);
+
+    for (i = 0; i < count; i++)
+        p33c_Host_SlopeCtrlSample(&ctrl, &profile[i], &result);
+
+    printf("  %-16s %3lu samples, %lu failures, max. slope error %.4f ticks, max. peak error %.4f ticks, "
+                "max. level deviation %.4f ticks\n",
+                label, (unsigned long)result.samples, (unsigned long)result.failures, 
+                result.max_slope_error, result.max_peak_error, result.max_level_error);
+
+    return(result.failures);
+}
+
+/* @@p33c_Host_VerifySlopeController
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the adaptive slope controller with built-in and recorded profiles
+ *
+ * Parameters:
+ *     const char* filename: optional profile file (NULL = built-in profiles only)
+ *
+ * Returns:
+ *     0 = failure, at least one sample is outside of the tolerance
+ *     1 = success, all samples are within the tolerance
+ *
+ * Description:
+ *     PWM_Initialize() and DAC_Initialize() have to be called before this 
+ *     function to set up the simulated PWM generator and DAC instance.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifySlopeController(const char* filename)
+{
+    struct P33C_HOST_PROFILE_SAMPLE_s profile[P33C_HOST_PROFILE_SIZE];
+    struct SLOPECTRL_s ctrl;
+    uint32_t failures=0;
+    uint16_t i, count, ok, dac_level;
+    unsigned long vin_mv, vout_mv;
+    FILE* file;
+
+    printf("adaptive slope controller\n");
+
+    // Soft-start: Vout ramps from 0 to 12 V at Vin = 48 V
+    for (i = 0; i <= 24; i++)
+    {
+        profile[i].vin_mv  = 48000;
+        profile[i].vout_mv = (uint32_t)i * 500;
+    }
+    failures += p33c_Host_SlopeCtrlProfile("soft-start", profile, 25);
+
+    // Line transient: Vin steps between 36 V and 60 V at Vout = 12 V
+    for (i = 0; i < 32; i++)
+    {
+        profile[i].vin_mv  = (i < 8) ? 36000 : (i < 16) ? (36000 + (i - 7) * 3000) : (i < 24) ? 60000 : 36000;
+        profile[i].vout_mv = 12000;
+    }
+    failures += p33c_Host_SlopeCtrlProfile("line transient", profile, 32);
+
+    // Output voltage droop and recovery after a load step at Vin = 48 V
+    for (i = 0; i < 32; i++)
+    {
+        profile[i].vin_mv  = 48000;
+        profile[i].vout_mv = (i < 4) ? 12000 : (i < 8) ? (12000 - (i - 3) * 150) : 
+                             (11250 + (i - 7) * 30 > 12000) ? 12000 : (11250 + (i - 7) * 30);
+    }
+    failures += p33c_Host_SlopeCtrlProfile("load step", profile, 32);
+
+    // Recorded profile
+    if (filename != NULL)
+    {
+        file = fopen(filename, "r");
+        if (file == NULL)
+        {
+            printf("  cannot open profile file '%s'\n", filename);
+            return(0);
+        }
+
+        count = 0;
+        while ((count < P33C_HOST_PROFILE_SIZE) && (fscanf(file, "%lu,%lu", &vin_mv, &vout_mv) == 2))
+        {
+            profile[count].vin_mv  = (uint32_t)vin_mv;
+            profile[count].vout_mv = (uint32_t)vout_mv;
+            count++;
+        }
+        fclose(file);
+
+        failures += p33c_Host_SlopeCtrlProfile(filename, profile, count);
+    }
+
+    // Control loop enabled: the ramp start level is handed over instead of written to DACxDATH
+    ok = (SLOPECTRL_Calculate(NULL, 0, 0) == 0) && (SLOPECTRL_Update(NULL, 0, 0) == 0);
+    ok &= SLOPECTRL_Initialize(&ctrl);
+    ok &= SLOPECTRL_Update(&ctrl, SLOPECTRL_VIN_NOMINAL, SLOPECTRL_VOUT_NOMINAL);
+    pwm_ctrl.enable = true;
+    dac_level = my_dac->DACxDATH.value;
+    ok &= SLOPECTRL_Update(&ctrl, SLOPECTRL_VIN_NOMINAL, (SLOPECTRL_VOUT_NOMINAL >> 1));
+    pwm_ctrl.enable = false;
+    ok &= ((my_dac->DACxDATH.value == dac_level) && (my_dac->SLPxDAT.value == ctrl.slope) && 
+           (pwm_ctrl.ramp == ctrl.ramp) && (ctrl.ramp > 0) && (ctrl.dac_high == (ctrl.reference + ctrl.ramp)));
+    pwm_ctrl.ramp = 0;
+    failures += (!ok);
+    printf("  control loop enabled: ramp amplitude %u ticks handed over, DACxDATH unchanged, %s\n",
+                (unsigned)ctrl.ramp, (ok) ? "ok" : "FAILED");
+
+    return(failures == 0);
+}
+
+// ________________________
+// end of file
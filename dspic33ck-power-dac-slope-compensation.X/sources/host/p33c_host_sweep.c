@@ -0,0 +1,495 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_sweep.c
+ * ************************************************************************************************
+ * Summary:
+ * Host-side multithreaded parameter sweep of the closed-loop buck simulator
+ *
+ * Description:
+ * This source file evaluates the grid points of a parameter sweep on all available 
+ * processor cores. The grid points are numbered with the PWM frequency as the slowest 
+ * and the load current as the fastest changing axis. Each worker thread owns a queue 
+ * holding a contiguous range of grid point indices, initially an equal share of the 
+ * grid. The owner takes indices from the head of its queue while idle workers steal 
+ * the upper half of the remaining range of another queue. Both ends of a range are 
+ * packed into one 64-bit word, which is updated with atomic compare-and-swap operations.
+ *
+ * Register values of each grid point are derived with the parametric conversion macros
+ * of demo.h, so the sweep covers the values the firmware would program for the same
+ * settings. The DACxDATH level is chosen so that the peak current at the comparator trip 
+ * point equals the load current plus half the inductor current ripple. Results are 
+ * stored in grid point order and can be written as CSV file or as binary file.
+ *
+ * The binary file starts with the 8-character identifier "P33CSWP1", followed by the 
+ * number of records and the record size as 32-bit unsigned integers and the records 
+ * of type P33C_HOST_SWEEP_POINT_s in the byte order of the host.
+ *
+ * See Also:
+ *	p33c_host_sweep.h, p33c_host_buck.c, demo.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "config/demo.h"
+#include "p33c_host_sweep.h"
+
+/* Work queue of one worker thread (one cache line each) */
+struct P33C_HOST_SWEEP_QUEUE_s {
+    uint64_t range;         // Index range: head (upper 32 bits) to tail (lower 32 bits, exclusive)
+    uint8_t pad[56];        // Padding to avoid false sharing between queues
+} __attribute__((aligned(64)));
+
+/* Worker thread context */
+struct P33C_HOST_SWEEP_WORKER_s {
+    struct P33C_HOST_SWEEP_s* sweep;        // Parameter sweep object
+    struct P33C_HOST_SWEEP_POINT_s* result; // Result array
+    struct P33C_HOST_SWEEP_QUEUE_s* queue;  // Work queues of all workers
+    uint32_t threads;       // Number of worker threads
+    uint32_t id;            // Index of this worker
+    uint32_t seed;          // Random number generator state for victim selection
+    uint32_t steals;        // Number of successful steals
+};
+
+#define P33C_HOST_SWEEP_RANGE(head, tail)   ((((uint64_t)(head)) << 32) | (uint64_t)(tail))
+
+/* @@p33c_HostSweep_GetCount
+ * ********************************************************************************
+ * Summary:
+ *     Returns the number of grid points of a parameter sweep
+ *
+ * Parameters:
+ *     const struct P33C_HOST_SWEEP_s* sweep:
+ *          Pointer to the parameter sweep object
+ *
+ * Returns:
+ *     uint32_t: number of grid points (0 = invalid sweep definition)
+ *
+ * ********************************************************************************/
+
+uint32_t p33c_HostSweep_GetCount(const struct P33C_HOST_SWEEP_s* sweep)
+{
+    uint64_t count;
+
+    if (sweep == NULL)
+        return(0);
+
+    count = (uint64_t)sweep->frequency.count * sweep->duty.count * sweep->slew_rate.count;
+    count *= (uint64_t)sweep->start_delay.count * sweep->stop_delay.count * sweep->load.count;
+
+    if (count > UINT32_MAX)
+        return(0);
+
+    return((uint32_t)count);
+}
+
+/* @@p33c_HostSweep_Evaluate
+ * ********************************************************************************
+ * Summary:
+ *     Derives the register values of one grid point and simulates the current loop
+ *
+ * Parameters:
+ *     const struct P33C_HOST_SWEEP_s* sweep:
+ *          Pointer to the parameter sweep object
+ *     uint32_t index:
+ *          Grid point index
+ *     struct P33C_HOST_SWEEP_POINT_s* point:
+ *          Pointer to the grid point result
+ *
+ * Returns:
+ *     0 = failure, the simulation could not be executed
+ *     1 = success
+ *
+ * Description:
+ *     Grid points whose derived register values violate the range checks of 
+ *     demo.h are reported with status SWEEP_STATUS_RANGE and are not simulated.
+ *     Grid points which could not be simulated are reported with status 
+ *     SWEEP_STATUS_ERROR.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostSweep_Evaluate(const struct P33C_HOST_SWEEP_s* sweep, uint32_t index, 
+                struct P33C_HOST_SWEEP_POINT_s* point)
+{
+    struct P33C_PWM_GENERATOR_s pg;
+    struct P33C_DAC_INSTANCE_s dac;
+    struct P33C_HOST_BUCK_PLANT_s plant;
+    struct P33C_HOST_BUCK_s buck;
+    struct P33C_HOST_BUCK_RESULT_s result;
+    long long f, per, trig_b, trig_c, slpdat, dath, drop;
+    long long vin, ton_ns, tstart_ns, ripple, v_trip;
+    uint32_t i;
+
+    if ((sweep == NULL) || (point == NULL))
+        return(0);
+
+    // Decode grid point index
+    memset(point, 0, sizeof(struct P33C_HOST_SWEEP_POINT_s));
+    point->index = index;
+    i = index;
+    point->load        = (uint16_t)sweep->load.value[i % sweep->load.count];               i /= sweep->load.count;
+    point->stop_delay  = (uint16_t)sweep->stop_delay.value[i % sweep->stop_delay.count];   i /= sweep->stop_delay.count;
+    point->start_delay = (uint16_t)sweep->start_delay.value[i % sweep->start_delay.count]; i /= sweep->start_delay.count;
+    point->slew_rate   = (uint16_t)sweep->slew_rate.value[i % sweep->slew_rate.count];     i /= sweep->slew_rate.count;
+    point->duty        = (uint16_t)sweep->duty.value[i % sweep->duty.count];               i /= sweep->duty.count;
+    point->frequency   = sweep->frequency.value[i % sweep->frequency.count];
+
+    // Derive register values like demo.h
+    f      = point->frequency;
+    per    = DEMO_PWM_PERIOD(f);
+    trig_b = DEMO_PWM_RATIO(f, point->start_delay);
+    trig_c = DEMO_PWM_RATIO(f, point->stop_delay);
+    slpdat = DEMO_SLP_SLEW_RATE(point->slew_rate);
+
+    // Operating point: peak current at the comparator trip point
+    vin       = ((1000LL * sweep->vout) / ((point->duty > 0) ? point->duty : 1));
+    ton_ns    = ((1000000LL * point->duty) / f);
+    tstart_ns = ((1000000LL * point->start_delay) / f);
+    ripple    = ((vin - sweep->vout) * ton_ns) / POWER_STAGE_INDUCTANCE_NH;
+    v_trip    = (((1LL * point->load) + (ripple / 2)) * CURRENT_SENSE_GAIN_MV_A) / 1000LL;
+    if (ton_ns > tstart_ns)
+        v_trip += ((1LL * point->slew_rate * (ton_ns - tstart_ns)) / 1000LL);
+    dath   = DEMO_DACOUT_VALUE(v_trip);
+    drop   = DEMO_SLP_RAMP_DROP(slpdat, (trig_c - trig_b));
+
+    point->pgxper   = (uint16_t)per;
+    point->slpxdat  = (uint16_t)slpdat;
+    point->dacxdath = (uint16_t)dath;
+
+    // Range checks of demo.h
+    if ((per < 0x0010) || (per > 0xFFFF) || (trig_b >= trig_c) || (trig_c > per) ||
+        (slpdat < 1) || (slpdat > 0xFFFF) || (point->duty == 0) || (point->duty >= 1000) ||
+        (dath > DACOUT_VALUE_MAX_RAW) || ((dath - drop) < DACOUT_VALUE_MIN_RAW))
+    {
+        point->status = SWEEP_STATUS_RANGE;
+        return(1);
+    }
+
+    // Apply register values to the images of the user configuration
+    pg  = sweep->pg;
+    dac = sweep->dac_instance;
+    pg.PGxPER.value   = (uint16_t)per;
+    pg.PGxDC.value    = (uint16_t)trig_c;   // Maximum duty cycle
+    pg.PGxTRIGB.value = (uint16_t)trig_b;
+    pg.PGxTRIGC.value = (uint16_t)trig_c;
+    dac.SLPxDAT.value  = (uint16_t)slpdat;
+    dac.DACxDATH.value = (uint16_t)dath;
+    dac.SLPxCONL.bits.SLPSTOPB = DAC_INSTANCE;
+
+    plant.vin         = (double)vin;
+    plant.vout        = (double)sweep->vout;
+    plant.inductance  = (double)POWER_STAGE_INDUCTANCE_NH;
+    plant.sense_gain  = (double)CURRENT_SENSE_GAIN_MV_A;
+    plant.capacitance = 0.0;
+    plant.load        = 0.0;
+
+    point->status = SWEEP_STATUS_ERROR;
+    if (!p33c_HostBuck_Load(&buck, &plant, &pg, &sweep->dac_module, &dac))
+        return(0);
+    if (!p33c_HostBuck_Run(&buck, sweep->settle, sweep->cycles, &result))
+        return(0);
+
+    point->status    = (result.stable) ? SWEEP_STATUS_STABLE : SWEEP_STATUS_SUBHARMONIC;
+    point->duty_sim  = (uint16_t)((result.duty * 1000.0) + 0.5);
+    point->deviation = (float)result.deviation;
+    point->i_peak    = (float)result.i_peak;
+
+    return(1);
+}
+
+/* @@p33c_HostSweep_Take
+ * ********************************************************************************
+ * Summary:
+ *     Takes the next grid point index from the head of a work queue
+ *
+ * ********************************************************************************/
+
+static bool p33c_HostSweep_Take(struct P33C_HOST_SWEEP_QUEUE_s* queue, uint32_t* index)
+{
+    uint64_t range, head, tail;
+
+    range = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE);
+    do {
+        head = (range >> 32);
+        tail = (range & 0xFFFFFFFFULL);
+        if (head >= tail)
+            return(false);
+    } while (!__atomic_compare_exchange_n(&queue->range, &range, P33C_HOST_SWEEP_RANGE(head + 1, tail), 
+                true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    *index = (uint32_t)head;
+    return(true);
+}
+
+/* @@p33c_HostSweep_Steal
+ * ********************************************************************************
+ * Summary:
+ *     Moves the upper half of the remaining range of a victim queue into an empty queue
+ *
+ * ********************************************************************************/
+
+static bool p33c_HostSweep_Steal(struct P33C_HOST_SWEEP_QUEUE_s* victim, struct P33C_HOST_SWEEP_QUEUE_s* own)
+{
+    uint64_t range, head, tail, split;
+
+    range = __atomic_load_n(&victim->range, __ATOMIC_ACQUIRE);
+    do {
+        head = (range >> 32);
+        tail = (range & 0xFFFFFFFFULL);
+        if (head >= tail)
+            return(false);
+        split = tail - ((tail - head + 1) >> 1);
+    } while (!__atomic_compare_exchange_n(&victim->range, &range, P33C_HOST_SWEEP_RANGE(head, split), 
+                true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    __atomic_store_n(&own->range, P33C_HOST_SWEEP_RANGE(split, tail), __ATOMIC_RELEASE);
+    return(true);
+}
+
+/* @@p33c_HostSweep_Worker
+ * ********************************************************************************
+ * Summary:
+ *     Worker thread processing its own queue and stealing from other queues
+ *
+ * Description:
+ *     A worker terminates when its own queue is empty and a full pass over all 
+ *     other queues did not find any work. As no new work is created during a 
+ *     run, all grid points have been taken when the last worker terminates.
+ *
+ * ********************************************************************************/
+
+static void* p33c_HostSweep_Worker(void* arg)
+{
+    struct P33C_HOST_SWEEP_WORKER_s* worker = (struct P33C_HOST_SWEEP_WORKER_s*)arg;
+    struct P33C_HOST_SWEEP_QUEUE_s* own = &worker->queue[worker->id];
+    uint32_t index, n, victim;
+    bool found;
+
+    while (1)
+    {
+        while (p33c_HostSweep_Take(own, &index))
+            p33c_HostSweep_Evaluate(worker->sweep, index, &worker->result[index]);
+
+        // Own queue is empty: select a random start victim and scan all queues once
+        worker->seed ^= (worker->seed << 13);
+        worker->seed ^= (worker->seed >> 17);
+        worker->seed ^= (worker->seed << 5);
+
+        found = false;
+        for (n = 0; (n < worker->threads) && (!found); n++)
+        {
+            victim = (worker->seed + n) % worker->threads;
+            if (victim == worker->id)
+                continue;
+            found = p33c_HostSweep_Steal(&worker->queue[victim], own);
+        }
+
+        if (!found)
+            break;
+        worker->steals++;
+    }
+
+    return(NULL);
+}
+
+/* @@p33c_HostSweep_Run
+ * ********************************************************************************
+ * Summary:
+ *     Evaluates all grid points of a parameter sweep
+ *
+ * Parameters:
+ *     struct P33C_HOST_SWEEP_s* sweep:
+ *          Pointer to the parameter sweep object
+ *     uint32_t threads:
+ *          Number of worker threads (0 = number of online processor cores)
+ *     struct P33C_HOST_SWEEP_POINT_s* result:
+ *          Result array with p33c_HostSweep_GetCount() elements
+ *
+ * Returns:
+ *     0 = failure, worker threads could not be created
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostSweep_Run(struct P33C_HOST_SWEEP_s* sweep, uint32_t threads, 
+                struct P33C_HOST_SWEEP_POINT_s* result)
+{
+    static struct P33C_HOST_SWEEP_QUEUE_s queue[P33C_HOST_SWEEP_MAX_THREADS];
+    struct P33C_HOST_SWEEP_WORKER_s worker[P33C_HOST_SWEEP_MAX_THREADS];
+    pthread_t thread[P33C_HOST_SWEEP_MAX_THREADS];
+    uint32_t i, count, created=0;
+    uint16_t retval=1;
+    long cores;
+
+    count = p33c_HostSweep_GetCount(sweep);
+    if ((count == 0) || (result == NULL))
+        return(0);
+
+    if (threads == 0)
+    {
+        cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cores > 0) ? (uint32_t)cores : 1;
+    }
+    if (threads > P33C_HOST_SWEEP_MAX_THREADS) threads = P33C_HOST_SWEEP_MAX_THREADS;
+    if (threads > count) threads = count;
+
+    // Distribute the grid points equally across all work queues
+    for (i = 0; i < threads; i++)
+    {
+        queue[i].range = P33C_HOST_SWEEP_RANGE(
+                            ((uint64_t)count * i) / threads, ((uint64_t)count * (i + 1)) / threads);
+        worker[i].sweep   = sweep;
+        worker[i].result  = result;
+        worker[i].queue   = queue;
+        worker[i].threads = threads;
+        worker[i].id      = i;
+        worker[i].seed    = 0x9E3779B9U * (i + 1);
+        worker[i].steals  = 0;
+    }
+
+    for (i = 1; i < threads; i++)
+    {
+        if (pthread_create(&thread[i], NULL, p33c_HostSweep_Worker, &worker[i]) != 0)
+            break;
+        created++;
+    }
+    if (created < (threads - 1))
+        retval = 0; // remaining queues are processed by stealing
+
+    p33c_HostSweep_Worker(&worker[0]);
+
+    sweep->threads = created + 1;
+    sweep->steals = worker[0].steals;
+    for (i = 1; i <= created; i++)
+    {
+        pthread_join(thread[i], NULL);
+        sweep->steals += worker[i].steals;
+    }
+
+    return(retval);
+}
+
+/* @@p33c_HostSweep_WriteCsv
+ * ********************************************************************************
+ * Summary:
+ *     Writes the results of a parameter sweep into a CSV file
+ *
+ * Parameters:
+ *     const char* filename:
+ *          Name of the output file
+ *     const struct P33C_HOST_SWEEP_POINT_s* result:
+ *          Result array
+ *     uint32_t count:
+ *          Number of grid points
+ *
+ * Returns:
+ *     0 = failure, the file could not be written
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostSweep_WriteCsv(const char* filename, 
+                const struct P33C_HOST_SWEEP_POINT_s* result, uint32_t count)
+{
+    FILE* file;
+    uint32_t i;
+
+    if ((filename == NULL) || (result == NULL))
+        return(0);
+
+    file = fopen(filename, "w");
+    if (file == NULL)
+        return(0);
+
+    fprintf(file, "index,frequency_hz,duty_permil,slew_mv_us,start_permil,stop_permil,load_ma,"
+                  "status,pgxper,slpxdat,dacxdath,duty_sim_permil,deviation_a,i_peak_a\n");
+    for (i = 0; i < count; i++)
+    {
+        fprintf(file, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%.3e,%.4f\n",
+                (unsigned)result[i].index, (unsigned)result[i].frequency, (unsigned)result[i].duty,
+                (unsigned)result[i].slew_rate, (unsigned)result[i].start_delay, 
+                (unsigned)result[i].stop_delay, (unsigned)result[i].load, (unsigned)result[i].status,
+                (unsigned)result[i].pgxper, (unsigned)result[i].slpxdat, (unsigned)result[i].dacxdath,
+                (unsigned)result[i].duty_sim, (double)result[i].deviation, (double)result[i].i_peak);
+    }
+
+    fclose(file);
+
+    return(1);
+}
+
+/* @@p33c_HostSweep_WriteBinary
+ * ********************************************************************************
+ * Summary:
+ *     Writes the results of a parameter sweep into a binary file
+ *
+ * Parameters:
+ *     const char* filename:
+ *          Name of the output file
+ *     const struct P33C_HOST_SWEEP_POINT_s* result:
+ *          Result array
+ *     uint32_t count:
+ *          Number of grid points
+ *
+ * Returns:
+ *     0 = failure, the file could not be written
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostSweep_WriteBinary(const char* filename, 
+                const struct P33C_HOST_SWEEP_POINT_s* result, uint32_t count)
+{
+    FILE* file;
+    uint32_t header[2];
+    uint16_t retval=1;
+
+    if ((filename == NULL) || (result == NULL))
+        return(0);
+
+    file = fopen(filename, "wb");
+    if (file == NULL)
+        return(0);
+
+    header[0] = count;
+    header[1] = (uint32_t)sizeof(struct P33C_HOST_SWEEP_POINT_s);
+
+    if ((fwrite("P33CSWP1", 1, 8, file) != 8) ||
+        (fwrite(header, sizeof(uint32_t), 2, file) != 2) ||
+        (fwrite(result, sizeof(struct P33C_HOST_SWEEP_POINT_s), count, file) != count))
+        retval = 0;
+
+    if (fclose(file) != 0)
+        retval = 0;
+
+    return(retval);
+}
+
+// ________________________
+// end of file
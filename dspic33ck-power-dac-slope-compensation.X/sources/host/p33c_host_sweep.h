@@ -0,0 +1,120 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_sweep.h
+ * ************************************************************************************************
+ * Summary:
+ * Host-side multithreaded parameter sweep of the closed-loop buck simulator (header file)
+ *
+ * Description:
+ * The parameter sweep evaluates the stability of the peak current loop across a grid of
+ * PWM frequency, duty ratio, slope slew rate, slope start/stop delay and load current 
+ * settings. For each grid point, the register values are derived with the conversion 
+ * macros of demo.h, applied to register images of the user configuration and simulated
+ * by the closed-loop buck simulator. Grid points are distributed across worker threads
+ * with per-thread work queues; idle workers steal work from other queues.
+ *
+ * See Also:
+ *	p33c_host_sweep.c, p33c_host_buck.h, demo.h
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_SWEEP_H
+#define	P33C_HOST_SWEEP_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "p33c_host_buck.h"
+
+#define P33C_HOST_SWEEP_MAX_THREADS   256U  // Maximum number of worker threads
+
+/* Grid point status */
+typedef enum {
+    SWEEP_STATUS_STABLE     = 0,    // Current loop is stable
+    SWEEP_STATUS_SUBHARMONIC = 1,   // Sub-harmonic oscillation detected
+    SWEEP_STATUS_RANGE      = 2,    // Derived register values out of range, not simulated
+    SWEEP_STATUS_ERROR      = 3     // Simulation could not be executed, no result
+} P33C_HOST_SWEEP_STATUS_e;
+
+/* Grid axis */
+struct P33C_HOST_SWEEP_AXIS_s {
+    const uint32_t* value;  // Pointer to the axis values
+    uint32_t count;         // Number of axis values
+};
+
+/* Result of one grid point (record of the binary output file) */
+struct P33C_HOST_SWEEP_POINT_s {
+    uint32_t index;         // Grid point index
+    uint32_t frequency;     // PWM frequency in [Hz]
+    uint16_t duty;          // Duty ratio of the operating point in [0.1%]
+    uint16_t slew_rate;     // Slope slew rate in [mV/us]
+    uint16_t start_delay;   // Slope start delay in [0.1%] of the PWM period
+    uint16_t stop_delay;    // Slope stop delay in [0.1%] of the PWM period
+    uint16_t load;          // Load current in [mA]
+    uint16_t status;        // Grid point status (P33C_HOST_SWEEP_STATUS_e)
+    uint16_t pgxper;        // Derived PGxPER value
+    uint16_t slpxdat;       // Derived SLPxDAT value
+    uint16_t dacxdath;      // Derived DACxDATH value
+    uint16_t duty_sim;      // Simulated duty ratio in [0.1%]
+    float deviation;        // Cycle-to-cycle deviation of the valley current in [A]
+    float i_peak;           // Average inductor peak current in [A]
+};
+
+/* Parameter sweep object */
+struct P33C_HOST_SWEEP_s {
+    struct P33C_HOST_SWEEP_AXIS_s frequency;    // PWM frequencies in [Hz]
+    struct P33C_HOST_SWEEP_AXIS_s duty;         // Duty ratios in [0.1%]
+    struct P33C_HOST_SWEEP_AXIS_s slew_rate;    // Slope slew rates in [mV/us]
+    struct P33C_HOST_SWEEP_AXIS_s start_delay;  // Slope start delays in [0.1%] of the PWM period
+    struct P33C_HOST_SWEEP_AXIS_s stop_delay;   // Slope stop delays in [0.1%] of the PWM period
+    struct P33C_HOST_SWEEP_AXIS_s load;         // Load currents in [mA]
+    struct P33C_PWM_GENERATOR_s pg;             // PWM generator register image of the user configuration
+    struct P33C_DAC_MODULE_s dac_module;        // DAC module register image of the user configuration
+    struct P33C_DAC_INSTANCE_s dac_instance;    // DAC instance register image of the user configuration
+    uint32_t vout;          // Output voltage in [mV]
+    uint32_t settle;        // Number of PWM cycles simulated before the evaluation starts
+    uint32_t cycles;        // Number of PWM cycles evaluated per grid point
+    uint32_t threads;       // Number of worker threads of the last run
+    uint32_t steals;        // Number of successful steals of the last run
+};
+
+/* *********************************************************************************
+ * FUNCTION PROTOTYPES
+ * ********************************************************************************/
+
+extern uint32_t p33c_HostSweep_GetCount(const struct P33C_HOST_SWEEP_s* sweep);
+extern uint16_t p33c_HostSweep_Evaluate(const struct P33C_HOST_SWEEP_s* sweep, uint32_t index, 
+                    struct P33C_HOST_SWEEP_POINT_s* point);
+extern uint16_t p33c_HostSweep_Run(struct P33C_HOST_SWEEP_s* sweep, uint32_t threads, 
+                    struct P33C_HOST_SWEEP_POINT_s* result);
+extern uint16_t p33c_HostSweep_WriteCsv(const char* filename, 
+                    const struct P33C_HOST_SWEEP_POINT_s* result, uint32_t count);
+extern uint16_t p33c_HostSweep_WriteBinary(const char* filename, 
+                    const struct P33C_HOST_SWEEP_POINT_s* result, uint32_t count);
+
+
+#endif	/* P33C_HOST_SWEEP_H */
+// END OF FILE
@@ -0,0 +1,345 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_sync.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the PWM generator synchronization routes and their propagation delays
+ *
+ * Description:
+ * This source file verifies p33c_PwmGenerator_GetSyncRoute() and 
+ * p33c_PwmGenerator_SyncGeneratorsRoute() for every mother/child pair of PWM generators 
+ * and every trigger output on devices with 4 and 8 PWM generators:
+ *
+ *   - pairs of the same group use the direct route (SOCS), pairs of different groups 
+ *     the PCI Sync route, pairs including the same or unavailable generators are rejected
+ *   - the route descriptor returned by SyncGeneratorsRoute() matches the routing written to
+ *     the registers, which is decoded by the sync input model of the PWM timebase simulator
+ *   - direct route: the start of cycle of the child is derived from the simulated trigger
+ *     event of the mother and the modelled propagation delay and compared with the trigger 
+ *     compare value, before and after subtracting the delay of the route descriptor from 
+ *     the trigger compare value
+ *   - PCI Sync route: PWMPCI feeds the PWM output of the mother to the PCI logic of the 
+ *     child, so the start of cycle of the child follows the PWMxH rising edge of the
+ *     mother for every trigger output and does not move with the trigger compare value
+ *
+ * The propagation delays of both routes are unmeasured estimates shared by the driver 
+ * (P33C_PWM_SYNC_DELAY_DIRECT/PCI) and the simulator, so the compensated alignment 
+ * error only verifies the compensation arithmetic, not the delay values.
+ *
+ * The simulated register file provides 8 PWM generators. Routes of 4-generator devices 
+ * are applied to PG1-PG4 of the simulated register file. This file is only compiled in 
+ * host builds.
+ *
+ * See Also:
+ *	p33c_pwm.c, p33c_host_pwmsim.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <string.h>
+
+#include "config/demo.h"
+#include "pwm.h"
+#include "p33c_host_pwmsim.h"
+
+#define P33C_HOST_SYNC_TICKS    ((uint64_t)(PWM_CLOCK / AUX_CLOCK)) // PWM clock ticks per PWM generator clock cycle
+
+/* Event of the PWM timebase simulator of each trigger output (PGTRGSEL) */
+static const uint8_t p33c_HostSyncEvent[4] = { 
+    PWMSIM_EVT_SOC, PWMSIM_EVT_TRIGA, PWMSIM_EVT_TRIGB, PWMSIM_EVT_TRIGC 
+};
+
+/* Results of one device */
+struct P33C_HOST_SYNC_RESULT_s {
+    uint16_t direct;        // Number of pairs using the direct route
+    uint16_t pci;           // Number of pairs using the PCI Sync route
+    uint16_t pci_output;    // Number of PCI Sync pairs and trigger outputs started by the mother PWMxH edge
+    uint16_t rejected;      // Number of pairs rejected
+    uint16_t mismatch;      // Number of failed checks
+    uint64_t error_raw;     // Maximum alignment error without delay compensation in [PWM clock ticks]
+    uint64_t error_comp;    // Maximum alignment error with delay compensation in [PWM clock ticks]
+};
+
+/* Returns the child start of cycle relative to the mother start of cycle, or P33C_HOST_PWMSIM_NO_EDGE */
+static uint64_t p33c_Host_SyncStart(uint16_t mother, uint16_t child, uint16_t trigger, uint16_t* input)
+{
+    struct P33C_HOST_PWMSIM_s sim;
+    struct P33C_PWM_GENERATOR_s img;
+    uint64_t delay, event;
+    uint16_t source;
+
+    // Sync input of the child as decoded from its registers
+    p33c_PwmGenerator_ConfigReadRef(child, &img);
+    delay = p33c_HostPwmSim_GetSyncDelay(&img, child, &source, input);
+    if ((delay == P33C_HOST_PWMSIM_NO_EDGE) || (source != mother))
+        return(P33C_HOST_PWMSIM_NO_EDGE);
+
+    // Trigger event of the mother; the EOC trigger coincides with the start of the next cycle.
+    // The PCI Sync input is the PWMxH output of the mother, independent of its trigger output.
+    p33c_PwmGenerator_ConfigReadRef(mother, &img);
+    if (img.PGxEVTL.bits.PGTRGSEL != trigger)
+        return(P33C_HOST_PWMSIM_NO_EDGE);
+    img.PGxCONH.bits.SOCS = 0b0000;
+    img.PGxCONH.bits.TRGMOD = 0;
+    if (!p33c_HostPwmSim_Load(&sim, &img))
+        return(P33C_HOST_PWMSIM_NO_EDGE);
+    if (*input == PWMSIM_SYNC_PWMH)
+        event = sim.offset[PWMSIM_EVT_PWMH_ON];
+    else
+        event = (trigger == 0) ? sim.period : sim.offset[p33c_HostSyncEvent[trigger]];
+    if (event == P33C_HOST_PWMSIM_NO_EDGE)
+        return(P33C_HOST_PWMSIM_NO_EDGE);
+
+    return(event + delay);
+}
+
+/* Verifies one mother/child pair and trigger output */
+static void p33c_Host_SyncPair(uint16_t pgCount, uint16_t mother, uint16_t child, uint16_t trigger,
+                    const struct P33C_PWM_GENERATOR_s* pgTemplate, struct P33C_HOST_SYNC_RESULT_s* result)
+{
+    struct P33C_PWM_SYNC_ROUTE_s route, applied;
+    struct P33C_PWM_GENERATOR_s pgConfig;
+    volatile struct P33C_PWM_GENERATOR_s* pg;
+    struct P33C_HOST_PWMSIM_s sim;
+    uint64_t target, start, error;
+    uint16_t valid, expected, ok, input;
+
+    valid = ((mother != child) && (mother <= pgCount) && (child <= pgCount));
+    expected = (((mother - 1) >> 2) == ((child - 1) >> 2)) ? P33C_PWM_SYNC_DIRECT : P33C_PWM_SYNC_PCI;
+
+    ok = p33c_PwmGenerator_GetSyncRoute(pgCount, mother, trigger, child, &route);
+    if (!valid)
+    {
+        if ((ok) || (route.route != P33C_PWM_SYNC_NONE))
+            result->mismatch++;
+        else if (trigger == 0)
+            result->rejected++;
+        return;
+    }
+    if ((!ok) || (route.route != expected) || (route.mother != mother) || (route.child != child) ||
+        (route.delay != ((expected == P33C_PWM_SYNC_DIRECT) ? P33C_PWM_SYNC_DELAY_DIRECT : P33C_PWM_SYNC_DELAY_PCI)))
+    {
+        result->mismatch++;
+        return;
+    }
+    if (trigger == 0)
+    {
+        if (expected == P33C_PWM_SYNC_DIRECT) result->direct++;
+        else result->pci++;
+    }
+
+    // Apply the route to two generators configured with the user template
+    p33c_HostSfr_Reset();
+    pgConfig = *pgTemplate;
+    pgConfig.PGxCONL.bits.ON = 0;
+    pgConfig.PGxTRIGA.value = (pgConfig.PGxPER.value >> 2); // trigger events at 1/4, 1/2 and 3/4 of the period
+    pgConfig.PGxTRIGB.value = (pgConfig.PGxPER.value >> 1);
+    pgConfig.PGxTRIGC.value = (pgConfig.PGxPER.value >> 2) * 3;
+    p33c_PwmGenerator_ConfigWriteRef(mother, &pgConfig);
+    p33c_PwmGenerator_ConfigWriteRef(child, &pgConfig);
+
+    ok = p33c_PwmGenerator_SyncGeneratorsRoute(p33c_PwmGenerator_GetHandle(mother), trigger,
+                    p33c_PwmGenerator_GetHandle(child), false, &applied);
+    if ((!ok) || (memcmp(&route, &applied, sizeof(route)) != 0))
+    {
+        result->mismatch++;
+        return;
+    }
+
+    // Requested phase shift: trigger compare value (EOC: one period)
+    if (trigger == 1) target = pgConfig.PGxTRIGA.value;
+    else if (trigger == 2) target = pgConfig.PGxTRIGB.value;
+    else if (trigger == 3) target = pgConfig.PGxTRIGC.value;
+    else target = pgConfig.PGxPER.value;
+    target *= (pgConfig.PGxCONL.bits.HREN) ? 1U : P33C_HOST_SYNC_TICKS;
+
+    start = p33c_Host_SyncStart(mother, child, trigger, &input);
+    if ((start == P33C_HOST_PWMSIM_NO_EDGE) || 
+        (input != ((expected == P33C_PWM_SYNC_DIRECT) ? PWMSIM_SYNC_TRIGGER : PWMSIM_SYNC_PWMH)))
+    {
+        result->mismatch++;
+        return;
+    }
+
+    if (input == PWMSIM_SYNC_PWMH)
+    {
+        // PCI Sync: started by the PWMxH rising edge of the mother, advancing the trigger has no effect
+        p33c_PwmGenerator_ConfigReadRef(mother, &pgConfig);
+        pgConfig.PGxCONH.bits.SOCS = 0b0000;
+        pgConfig.PGxCONH.bits.TRGMOD = 0;
+        if (!p33c_HostPwmSim_Load(&sim, &pgConfig))
+        {
+            result->mismatch++;
+            return;
+        }
+        target = sim.offset[PWMSIM_EVT_PWMH_ON] + (route.delay * P33C_HOST_SYNC_TICKS);
+        pg = p33c_PwmGenerator_GetHandle(mother);
+        pg->PGxTRIGA.value -= route.delay;
+        pg->PGxTRIGB.value -= route.delay;
+        pg->PGxTRIGC.value -= route.delay;
+        if ((start == target) && (p33c_Host_SyncStart(mother, child, trigger, &input) == target))
+            result->pci_output++;
+        else
+            result->mismatch++;
+        return;
+    }
+
+    error = (start > target) ? (start - target) : (target - start);
+    if (error != (route.delay * P33C_HOST_SYNC_TICKS)) // model delay differs from the expected delay
+        result->mismatch++;
+    if (error > result->error_raw)
+        result->error_raw = error;
+    if (trigger == 0)
+        return; // the EOC trigger cannot be advanced
+
+    // Compensate the propagation delay by advancing the trigger compare value
+    pg = p33c_PwmGenerator_GetHandle(mother);
+    if (trigger == 1) pg->PGxTRIGA.value -= route.delay * ((pg->PGxCONL.bits.HREN) ? P33C_PWM_HRES_COUNTS : 1U);
+    if (trigger == 2) pg->PGxTRIGB.value -= route.delay * ((pg->PGxCONL.bits.HREN) ? P33C_PWM_HRES_COUNTS : 1U);
+    if (trigger == 3) pg->PGxTRIGC.value -= route.delay * ((pg->PGxCONL.bits.HREN) ? P33C_PWM_HRES_COUNTS : 1U);
+
+    start = p33c_Host_SyncStart(mother, child, trigger, &input);
+    error = (start > target) ? (start - target) : (target - start);
+    if (error > result->error_comp)
+        result->error_comp = error;
+}
+
+/* @@p33c_Host_SyncWrapper
+ * ********************************************************************************
+ * Summary:
+ *     Compares the registers written by p33c_PwmGenerator_SyncGenerators() with 
+ *     those written by p33c_PwmGenerator_SyncGeneratorsRoute()
+ *
+ * Parameters:
+ *     uint16_t mother: instance of the mother PWM generator
+ *     uint16_t child: instance of the child PWM generator
+ *     uint16_t trigger: trigger output of the mother PWM generator
+ *     struct P33C_PWM_GENERATOR_s* pgTemplate: generator template
+ *
+ * Returns:
+ *     0 = the registers or the return values differ
+ *     1 = both functions succeeded and wrote identical registers
+ *
+ * ********************************************************************************/
+
+static uint16_t p33c_Host_SyncWrapper(uint16_t mother, uint16_t child, uint16_t trigger,
+                    const struct P33C_PWM_GENERATOR_s* pgTemplate)
+{
+    struct P33C_PWM_GENERATOR_s img[2][2];
+    struct P33C_PWM_SYNC_ROUTE_s route;
+    uint16_t ok[2], i;
+
+    for (i = 0; i < 2; i++)
+    {
+        p33c_HostSfr_Reset();
+        p33c_PwmGenerator_ConfigWriteRef(mother, pgTemplate);
+        p33c_PwmGenerator_ConfigWriteRef(child, pgTemplate);
+        if (i == 0)
+            ok[i] = p33c_PwmGenerator_SyncGenerators(p33c_PwmGenerator_GetHandle(mother), trigger,
+                            p33c_PwmGenerator_GetHandle(child), false);
+        else
+            ok[i] = p33c_PwmGenerator_SyncGeneratorsRoute(p33c_PwmGenerator_GetHandle(mother), trigger,
+                            p33c_PwmGenerator_GetHandle(child), false, &route);
+        p33c_PwmGenerator_ConfigReadRef(mother, &img[i][0]);
+        p33c_PwmGenerator_ConfigReadRef(child, &img[i][1]);
+    }
+
+    return((ok[0] == 1) && (ok[1] == 1) && (memcmp(img[0], img[1], sizeof(img[0])) == 0));
+}
+
+/* @@p33c_Host_VerifySync
+ * ********************************************************************************
+ * Summary:
+ *     Verifies the PWM generator synchronization routes of all generator pairs
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifySync(void)
+{
+    static const uint16_t devices[] = { 4, 8 };
+    struct P33C_PWM_GENERATOR_s pg_template;
+    struct P33C_HOST_SYNC_RESULT_s result;
+    struct P33C_PWM_SYNC_ROUTE_s route;
+    uint16_t retval=1, ok, d, m, c, t;
+
+    printf("PWM generator synchronization\n");
+
+    // Template: user PWM generator configuration
+    p33c_HostSfr_Reset();
+    PWM_Initialize();
+    p33c_PwmGenerator_ConfigReadRef(PWM_GENERATOR, &pg_template);
+
+    for (d = 0; d < (sizeof(devices) / sizeof(devices[0])); d++)
+    {
+        memset(&result, 0, sizeof(result));
+        for (m = 1; m <= 8; m++)
+            for (c = 1; c <= 8; c++)
+                for (t = 0; t < 4; t++)
+                    p33c_Host_SyncPair(devices[d], m, c, t, &pg_template, &result);
+
+        ok = ((result.mismatch == 0) && (result.error_comp == 0) &&
+              (result.direct == ((devices[d] > 4) ? 24 : 12)) && (result.pci == ((devices[d] > 4) ? 32 : 0)) &&
+              (result.pci_output == (result.pci * 4)));
+        retval &= ok;
+        printf("  %u generators: %2u direct (%u PWM clock), %2u PCI sync (%u PWM clocks, started by mother PWMxH), "
+               "%2u pairs rejected, direct alignment error %llu ticks, compensated %llu ticks, %s\n", 
+                (unsigned)devices[d], (unsigned)result.direct, (unsigned)P33C_PWM_SYNC_DELAY_DIRECT,
+                (unsigned)result.pci, (unsigned)P33C_PWM_SYNC_DELAY_PCI, (unsigned)result.rejected,
+                (unsigned long long)result.error_raw, (unsigned long long)result.error_comp, (ok) ? "ok" : "FAILED");
+    }
+    printf("  propagation delays are unmeasured estimates shared by driver and simulator: the compensated\n"
+           "  error verifies the compensation arithmetic only\n");
+
+    // Invalid trigger output and invalid pairs leave the registers unchanged
+    p33c_HostSfr_Reset();
+    ok = ((p33c_PwmGenerator_GetSyncRoute(P33C_PG_COUNT, 1, 4, 2, &route) == 0) && 
+          (p33c_PwmGenerator_SyncGenerators(p33c_PwmGenerator_GetHandle(1), 4, p33c_PwmGenerator_GetHandle(2), false) == 0) &&
+          (p33c_PwmGenerator_SyncGeneratorsRoute(p33c_PwmGenerator_GetHandle(3), 1, p33c_PwmGenerator_GetHandle(3), false, &route) == 0) &&
+          (route.route == P33C_PWM_SYNC_NONE) && (p33c_PwmGenerator_GetHandle(1)->PGxCONH.value == 0) &&
+          (p33c_PwmGenerator_GetHandle(2)->PGxCONH.value == 0) && (p33c_PwmGenerator_GetHandle(3)->PGxCONH.value == 0) &&
+          (p33c_PwmGenerator_GetHandle(1)->PGxEVTL.value == 0));
+    retval &= ok;
+    printf("  invalid trigger output and self-synchronization rejected, registers unchanged, %s\n", (ok) ? "ok" : "FAILED");
+
+    // SyncGenerators() without route descriptor writes the same registers as SyncGeneratorsRoute()
+    ok = p33c_Host_SyncWrapper(1, 2, 1, &pg_template);
+    if (P33C_PG_COUNT > 4)
+        ok &= p33c_Host_SyncWrapper(2, 6, 1, &pg_template);
+    retval &= ok;
+    printf("  SyncGenerators() configures the same registers as SyncGeneratorsRoute(), %s\n", (ok) ? "ok" : "FAILED");
+
+    return(retval);
+}
+
+// ________________________
+// end of file
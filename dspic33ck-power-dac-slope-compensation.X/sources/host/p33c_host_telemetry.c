@@ -0,0 +1,527 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_telemetry.c
+ * ************************************************************************************************
+ * Summary:
+ * Host verification of the lock-free telemetry stream and its frame decoder
+ *
+ * Description:
+ * This source file executes the control loop interrupt service routine of pwm.c together 
+ * with the 1 ms telemetry task and a simple model of DMA channel 0, which copies 
+ * each started transfer from the ring buffer into a byte stream and completes it before
+ * the next task call. The received byte stream is decoded by the frame decoder of 
+ * p33c_host_tlm.c and the following properties are verified:
+ *
+ *   - UART1, the remappable TX pin and DMA channel 0 are configured as specified
+ *   - with a consumer keeping up, every frame is received in sequence without drops
+ *     and carries the PWM or DAC register values of its control loop execution
+ *   - frames passed through a pseudo-terminal in random-sized pieces are decoded 
+ *     unchanged; a corrupted frame is rejected and the decoder resynchronizes
+ *   - the decoder throughput exceeds the line rate and the CSV and columnar exports
+ *     contain every decoded frame
+ *   - the control loop interrupt does not write frames; with a stalled DMA transfer, 
+ *     the producer never blocks, drops frames once the buffer is full and the number 
+ *     of dropped frames matches the frames lost by the decoder
+ *
+ * The execution time of the frame push is reported from the profiler region 
+ * P33C_PROFILE_TELEMETRY_PUSH. This file is only compiled in host builds.
+ *
+ * See Also:
+ *	telemetry.c, telemetry.h, pwm.c, p33c_host_tlm.c, p33c_host_main.c
+ * ***********************************************************************************************/
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600 // posix_openpt(), grantpt(), unlockpt(), ptsname()
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "config/hal.h"
+#include "pwm.h"
+#include "dac.h"
+#include "adc.h"
+#include "telemetry.h"
+#include "common/p33c_profile.h"
+#include "p33c_host_tlm.h"
+
+#define P33C_HOST_TLM_FRAMES        400U    // Number of frames of the continuous stream scenario
+#define P33C_HOST_TLM_STALL         100U    // Number of frames pushed while the consumer is stalled
+#define P33C_HOST_TLM_TASK_CYCLES   ((uint16_t)DEMO_DIV(PWM_FREQUENCY, 1000)) // Switching cycles per 1 ms task call
+#define P33C_HOST_TLM_STREAM_SIZE   ((P33C_HOST_TLM_FRAMES + P33C_HOST_TLM_STALL) * TELEMETRY_FRAME_SIZE)
+#define P33C_HOST_TLM_CORRUPT       100U    // Frame corrupted in the pseudo-terminal loopback
+#define P33C_HOST_TLM_REPEAT        3000U   // Number of stream copies decoded by the throughput measurement
+
+extern void _ADCAN0Interrupt(void);
+
+static uint8_t p33c_HostTlmStream[P33C_HOST_TLM_STREAM_SIZE]; // Bytes received by the UART
+static uint32_t p33c_HostTlmLength; // Number of bytes received
+static uint16_t p33c_HostTlmDmaError; // Number of transfers with an unexpected source address or length
+static uint16_t p33c_HostTlmExpectedDc[P33C_HOST_TLM_FRAMES]; // PGxDC after control loop execution n
+static uint16_t p33c_HostTlmExpectedDac[P33C_HOST_TLM_FRAMES]; // DACxDATH after control loop execution n
+
+/* Frame handler state */
+struct P33C_HOST_TLM_CHECK_s {
+    uint32_t frames;        // Number of frames received
+    uint32_t errors;        // Number of frames with unexpected content
+    uint64_t sum;           // Sum of all timestamps
+};
+
+/* Pseudo-terminal writer */
+struct P33C_HOST_TLM_WRITER_s {
+    int fd;                 // Master side of the pseudo-terminal
+    const uint8_t* data;    // Bytes to be written
+    size_t length;          // Number of bytes
+};
+
+/* Executes the control loop interrupt of one switching cycle */
+static void p33c_Host_TlmCycle(void)
+{
+    ADCBUF0 = CONTROL_REFERENCE;
+    _ADCAN0IF = 1;
+    _ADCAN0Interrupt();
+    return;
+}
+
+/* Completes an active DMA channel 0 transfer by copying its bytes into the received stream */
+static void p33c_Host_TlmDma(void)
+{
+    const uint8_t* source;
+    uint16_t count;
+
+    if ((!DMACH0bits.CHEN) || (DMAINT0bits.DONEIF))
+        return;
+
+    // The channel transfers from the oldest frame in the buffer
+    source = (const uint8_t*)&telemetry.buffer[telemetry.tail & TELEMETRY_BUFFER_MASK];
+    count = DMACNT0;
+    if ((DMASRC0 != (uint16_t)(uintptr_t)source) || (count == 0) || 
+        ((count % TELEMETRY_FRAME_SIZE) != 0) || 
+        ((source + count) > (const uint8_t*)&telemetry.buffer[TELEMETRY_BUFFER_SIZE]) ||
+        ((p33c_HostTlmLength + count) > P33C_HOST_TLM_STREAM_SIZE))
+    {
+        p33c_HostTlmDmaError++;
+        count = 0;
+    }
+
+    memcpy(&p33c_HostTlmStream[p33c_HostTlmLength], source, count);
+    p33c_HostTlmLength += count;
+    U1TXREG = (count > 0) ? source[count - 1] : 0;
+    
+    DMACNT0 = 0;
+    DMACH0bits.CHEN = 0; // One-shot mode: the channel is disabled after the last transfer
+    DMAINT0bits.DONEIF = 1;
+    return;
+}
+
+/* Executes the telemetry task followed by the DMA transfer it started */
+static void p33c_Host_TlmTask(void)
+{
+    TELEMETRY_Record();
+    TELEMETRY_Transmit();
+    p33c_Host_TlmDma();
+    return;
+}
+
+/* Checks a frame of the continuous stream against the registers of its control loop execution */
+static void p33c_Host_TlmCheckRegisters(const struct P33C_HOST_TLM_FRAME_s* frame, void* context)
+{
+    struct P33C_HOST_TLM_CHECK_s* check = (struct P33C_HOST_TLM_CHECK_s*)context;
+    uint16_t n = frame->sequence;
+    bool ok;
+
+    ok = ((n == check->frames) && (n < P33C_HOST_TLM_FRAMES) && 
+          (frame->timestamp == ((uint32_t)(n + 1) * TELEMETRY_DECIMATION)));
+    if ((ok) && (frame->type == TELEMETRY_TYPE_PWM))
+        ok = ((n & 1) == 0) &&
+             (p33c_HostTlm_Word(frame, 0) == my_pg1->PGxCONL.value) &&
+             (p33c_HostTlm_Word(frame, 2) == PWM_PERIOD) &&
+             (p33c_HostTlm_Word(frame, 3) == p33c_HostTlmExpectedDc[n]) &&
+             (p33c_HostTlm_Word(frame, 6) == my_pg1->PGxTRIGB.value) &&
+             (p33c_HostTlm_Word(frame, 7) == my_pg1->PGxTRIGC.value);
+    else if (ok)
+        ok = ((n & 1) == 1) &&
+             (p33c_HostTlm_Word(frame, 0) == my_dac->DACxCONL.value) &&
+             (p33c_HostTlm_Word(frame, 1) == p33c_HostTlmExpectedDac[n]) &&
+             (p33c_HostTlm_Word(frame, 5) == my_dac->SLPxDAT.value) &&
+             (p33c_HostTlm_Word(frame, 6) == CONTROL_REFERENCE) &&
+             (p33c_HostTlm_Word(frame, 7) == (TELEMETRY_STATUS_HRRDY | TELEMETRY_STATUS_CONTROL));
+
+    check->errors += (!ok);
+    check->frames++;
+    return;
+}
+
+/* Checks that a frame is an unchanged copy of the transmitted frame with the same sequence number */
+static void p33c_Host_TlmCheckCopy(const struct P33C_HOST_TLM_FRAME_s* frame, void* context)
+{
+    struct P33C_HOST_TLM_CHECK_s* check = (struct P33C_HOST_TLM_CHECK_s*)context;
+
+    check->errors += ((frame->sequence >= P33C_HOST_TLM_FRAMES) || 
+        (memcmp(frame->data, &p33c_HostTlmStream[frame->sequence * TELEMETRY_FRAME_SIZE], TELEMETRY_FRAME_SIZE) != 0));
+    check->frames++;
+    return;
+}
+
+/* Sums the timestamps of all frames */
+static void p33c_Host_TlmSum(const struct P33C_HOST_TLM_FRAME_s* frame, void* context)
+{
+    struct P33C_HOST_TLM_CHECK_s* check = (struct P33C_HOST_TLM_CHECK_s*)context;
+
+    check->sum += frame->timestamp;
+    check->frames++;
+    return;
+}
+
+/* Adds a frame to a columnar export */
+static void p33c_Host_TlmColumns(const struct P33C_HOST_TLM_FRAME_s* frame, void* context)
+{
+    p33c_HostTlm_ColumnsAppend((struct P33C_HOST_TLM_COLUMNS_s*)context, frame);
+    return;
+}
+
+/* Adds a frame to a CSV export */
+static void p33c_Host_TlmCsv(const struct P33C_HOST_TLM_FRAME_s* frame, void* context)
+{
+    p33c_HostTlm_WriteCsv((FILE*)context, frame);
+    return;
+}
+
+/* Writes bytes to the master side of a pseudo-terminal in pieces of 1 to 61 bytes */
+static void* p33c_Host_TlmWriter(void* context)
+{
+    struct P33C_HOST_TLM_WRITER_s* writer = (struct P33C_HOST_TLM_WRITER_s*)context;
+    uint32_t seed = 12345;
+    size_t i = 0, piece;
+    ssize_t n;
+
+    while (i < writer->length)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        piece = 1 + ((seed >> 16) % 61);
+        if (piece > (writer->length - i))
+            piece = (writer->length - i);
+        n = write(writer->fd, &writer->data[i], piece);
+        if (n <= 0)
+            break;
+        i += (size_t)n;
+    }
+
+    return(NULL);
+}
+
+/* Reads a columnar export and returns the number of frames and the sum of all timestamps */
+static uint16_t p33c_Host_TlmReadColumns(FILE* file, uint64_t* rows, uint32_t* chunks, uint64_t* sum)
+{
+    char magic[8], name[16];
+    uint32_t count, width[P33C_HOST_TLM_COLUMNS], n, i, j;
+    uint32_t* timestamp;
+    uint16_t ok;
+
+    *rows = 0; *chunks = 0; *sum = 0;
+    ok = ((fread(magic, 1, 8, file) == 8) && (memcmp(magic, "P33CTLC1", 8) == 0) &&
+          (fread(&count, sizeof(uint32_t), 1, file) == 1) && (count == P33C_HOST_TLM_COLUMNS));
+    for (i = 0; (ok) && (i < P33C_HOST_TLM_COLUMNS); i++)
+        ok = ((fread(name, 1, sizeof(name), file) == sizeof(name)) && (fread(&width[i], sizeof(uint32_t), 1, file) == 1));
+    if (!ok)
+        return(0);
+
+    timestamp = (uint32_t*)malloc(P33C_HOST_TLM_CHUNK_ROWS * sizeof(uint32_t));
+    while ((ok) && (fread(&n, sizeof(uint32_t), 1, file) == 1))
+    {
+        ok = ((n > 0) && (n <= P33C_HOST_TLM_CHUNK_ROWS));
+        for (i = 0; (ok) && (i < P33C_HOST_TLM_COLUMNS); i++)
+        {
+            if (i == 1) // timestamp column
+            {
+                ok = (fread(timestamp, sizeof(uint32_t), n, file) == n);
+                for (j = 0; (ok) && (j < n); j++)
+                    *sum += timestamp[j];
+            }
+            else
+                ok = (fseek(file, (long)(n * width[i]), SEEK_CUR) == 0);
+        }
+        *rows += n;
+        (*chunks)++;
+    }
+    free(timestamp);
+
+    return(ok);
+}
+
+/* @@p33c_Host_VerifyTelemetry
+ * ********************************************************************************
+ * Summary:
+ *     Verifies configuration, ordering, decoding and overflow accounting of the 
+ *     telemetry stream
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     0 = failure, at least one check failed
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_Host_VerifyTelemetry(void)
+{
+    struct P33C_HOST_TLM_DECODER_s decoder;
+    struct P33C_HOST_TLM_CHECK_s check;
+    struct P33C_HOST_TLM_WRITER_s writer;
+    struct P33C_HOST_TLM_COLUMNS_s* columns;
+    struct P33C_PROFILE_REGION_s* region;
+    struct timespec t_start, t_stop;
+    pthread_t thread;
+    uint8_t* buffer;
+    FILE* file;
+    char line[256];
+    double seconds;
+    uint64_t rows = 0, sum;
+    uint32_t i, chunks = 0, lines, pushes;
+    uint16_t retval=1, ok, dropped, head;
+    int master, slave;
+
+    printf("telemetry stream (%u frames of %u bytes, 1 frame per %u control cycles)\n",
+                (unsigned)TELEMETRY_BUFFER_SIZE, (unsigned)sizeof(struct TELEMETRY_FRAME_s), 
+                (unsigned)TELEMETRY_DECIMATION);
+
+    p33c_HostSfr_Reset();
+    PWM_Initialize();
+    PCLKCONbits.HRRDY = 1; // the simulated high resolution PWM clock is ready immediately
+    DAC_Initialize();
+    ADC_Initialize();
+    ADCON5Lbits.C0RDY = 1; // the simulated ADC core is ready immediately
+    ADC_Enable();
+    ok = TELEMETRY_Initialize();
+    ok &= TELEMETRY_Enable();
+    ok &= ((U1MODEbits.UARTEN) && (U1MODEbits.UTXEN) && (U1MODEbits.BRGH) && (U1BRG == TELEMETRY_BRG) &&
+           (((volatile uint8_t*)&RPOR0)[p33c_Gpio_GetRP(ECP05) - 32] == 0b000001) && (DMACONbits.DMAEN) &&
+           (DMACH0bits.SIZE) && (DMACH0bits.SAMODE == 0b01) && (DMACH0bits.DAMODE == 0b00) && 
+           (DMAINT0bits.CHSEL == TELEMETRY_DMA_TRIGGER) && (DMADST0 == (uint16_t)(uintptr_t)&U1TXREG));
+    ok &= ((sizeof(struct TELEMETRY_FRAME_s) == TELEMETRY_FRAME_SIZE) && 
+           (offsetof(struct TELEMETRY_FRAME_s, crc) == TELEMETRY_CRC_SIZE) &&
+           (p33c_HostTlm_Crc16((const uint8_t*)"123456789", 9) == 0x29B1));
+    retval &= ok;
+    printf("  UART1 %lu baud (BRG %u) on RP%u, DMA channel 0 trigger 0x%02X, %s\n",
+                (unsigned long)DEMO_DIV(CPU_CLOCK, 4LL * (U1BRG + 1)), (unsigned)U1BRG, (unsigned)p33c_Gpio_GetRP(ECP05),
+                (unsigned)DMAINT0bits.CHSEL, (ok) ? "ok" : "FAILED");
+
+    // Continuous stream: the 1 ms task keeps up with the frame rate
+    p33c_HostTlmLength = 0;
+    p33c_HostTlmDmaError = 0;
+    memset(&p33c_profile.region[P33C_PROFILE_TELEMETRY_PUSH], 0, sizeof(struct P33C_PROFILE_REGION_s));
+    p33c_profile.region[P33C_PROFILE_TELEMETRY_PUSH].min = 0xFFFF;
+    pwm_ctrl.enable = true;
+    pwm_ctrl.duty = (PWM_DUTY_CYCLE >> 1);
+    pwm_ctrl.count = 0;
+    for (i = 0; i < (P33C_HOST_TLM_FRAMES * TELEMETRY_DECIMATION); i++)
+    {
+        p33c_Host_TlmCycle();
+        if (((i + 1) % TELEMETRY_DECIMATION) == 0) // pwm_ctrl.count wraps around during this scenario
+        {
+            p33c_HostTlmExpectedDac[((i + 1) / TELEMETRY_DECIMATION) - 1] = my_dac->DACxDATH.value;
+            p33c_HostTlmExpectedDc[((i + 1) / TELEMETRY_DECIMATION) - 1] = my_pg1->PGxDC.value;
+        }
+        if (((i + 1) % P33C_HOST_TLM_TASK_CYCLES) == 0)
+            p33c_Host_TlmTask();
+    }
+    while (telemetry.head != telemetry.tail)
+        p33c_Host_TlmTask();
+
+    memset(&check, 0, sizeof(check));
+    p33c_HostTlm_Reset(&decoder);
+    p33c_HostTlm_Decode(&decoder, p33c_HostTlmStream, p33c_HostTlmLength, &p33c_Host_TlmCheckRegisters, &check);
+    ok = ((decoder.frames == P33C_HOST_TLM_FRAMES) && (telemetry.sent == P33C_HOST_TLM_FRAMES) && 
+          (check.errors == 0) && (decoder.crc_errors == 0) && (decoder.skipped == 0) && (decoder.lost == 0) &&
+          (telemetry.dropped == 0) && (p33c_HostTlmDmaError == 0));
+    retval &= ok;
+    printf("  continuous: %lu frames decoded, %lu field errors, %lu checksum errors, %u dropped, buffer high water %u, %s\n",
+                (unsigned long)decoder.frames, (unsigned long)check.errors, (unsigned long)decoder.crc_errors,
+                (unsigned)telemetry.dropped, (unsigned)telemetry.high_water, (ok) ? "ok" : "FAILED");
+
+    // Pseudo-terminal loopback: random-sized pieces, one corrupted frame
+    ok = 0;
+    buffer = (uint8_t*)malloc(p33c_HostTlmLength);
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((buffer != NULL) && (master >= 0) && (grantpt(master) == 0) && (unlockpt(master) == 0) &&
+        ((slave = open(ptsname(master), O_RDWR | O_NOCTTY)) >= 0))
+    {
+        memcpy(buffer, p33c_HostTlmStream, p33c_HostTlmLength);
+        buffer[(P33C_HOST_TLM_CORRUPT * TELEMETRY_FRAME_SIZE) + offsetof(struct TELEMETRY_FRAME_s, payload)] ^= 0x40;
+
+        memset(&check, 0, sizeof(check));
+        p33c_HostTlm_Reset(&decoder);
+        writer.fd = master;
+        writer.data = buffer;
+        writer.length = p33c_HostTlmLength;
+        ok = p33c_HostTlm_SetRaw(slave, 0);
+        ok &= (pthread_create(&thread, NULL, &p33c_Host_TlmWriter, &writer) == 0);
+        if (ok)
+        {
+            ok &= p33c_HostTlm_DecodeFd(&decoder, slave, p33c_HostTlmLength, NULL, &p33c_Host_TlmCheckCopy, &check);
+            pthread_join(thread, NULL);
+        }
+        close(slave);
+        ok &= ((decoder.bytes == p33c_HostTlmLength) && (decoder.frames == (P33C_HOST_TLM_FRAMES - 1)) && 
+               (check.errors == 0) && (decoder.crc_errors >= 1) && (decoder.lost == 1));
+    }
+    if (master >= 0)
+        close(master);
+    free(buffer);
+    retval &= ok;
+    printf("  pty loopback: %llu bytes, %llu frames decoded, %llu rejected, %llu bytes skipped, %llu lost, %s\n",
+                (unsigned long long)decoder.bytes, (unsigned long long)decoder.frames, 
+                (unsigned long long)decoder.crc_errors, (unsigned long long)decoder.skipped, 
+                (unsigned long long)decoder.lost, (ok) ? "ok" : "FAILED");
+
+    // Decoder throughput and exports of a long capture
+    ok = 0;
+    buffer = (uint8_t*)malloc((size_t)p33c_HostTlmLength * P33C_HOST_TLM_REPEAT);
+    if (buffer != NULL)
+    {
+        for (i = 0; i < P33C_HOST_TLM_REPEAT; i++)
+            memcpy(&buffer[i * p33c_HostTlmLength], p33c_HostTlmStream, p33c_HostTlmLength);
+
+        memset(&check, 0, sizeof(check));
+        p33c_HostTlm_Reset(&decoder);
+        clock_gettime(CLOCK_MONOTONIC, &t_start);
+        p33c_HostTlm_Decode(&decoder, buffer, (size_t)p33c_HostTlmLength * P33C_HOST_TLM_REPEAT, &p33c_Host_TlmSum, &check);
+        clock_gettime(CLOCK_MONOTONIC, &t_stop);
+        seconds = (double)(t_stop.tv_sec - t_start.tv_sec) + (1.0e-9 * (double)(t_stop.tv_nsec - t_start.tv_nsec));
+        if (seconds <= 0.0) seconds = 1.0e-9;
+        ok = ((decoder.frames == ((uint64_t)P33C_HOST_TLM_FRAMES * P33C_HOST_TLM_REPEAT)) && (decoder.crc_errors == 0) &&
+              (((double)decoder.bytes / seconds) > ((double)TELEMETRY_BAUDRATE / 10.0)));
+        retval &= ok;
+        printf("  decoder: %llu frames in %.3f s, %.1f MB/s (%.0fx line rate), %s\n",
+                    (unsigned long long)decoder.frames, seconds, ((double)decoder.bytes / seconds) * 1.0e-6, 
+                    ((double)decoder.bytes / seconds) / ((double)TELEMETRY_BAUDRATE / 10.0), (ok) ? "ok" : "FAILED");
+
+        // Columnar export of the long capture
+        ok = 0;
+        file = tmpfile();
+        if ((file != NULL) && ((columns = p33c_HostTlm_ColumnsOpen(file)) != NULL))
+        {
+            p33c_HostTlm_Reset(&decoder);
+            p33c_HostTlm_Decode(&decoder, buffer, (size_t)p33c_HostTlmLength * P33C_HOST_TLM_REPEAT, &p33c_Host_TlmColumns, columns);
+            ok = p33c_HostTlm_ColumnsClose(columns);
+            rewind(file);
+            ok &= p33c_Host_TlmReadColumns(file, &rows, &chunks, &sum);
+            ok &= ((rows == decoder.frames) && (sum == check.sum) && 
+                   (chunks == ((decoder.frames + P33C_HOST_TLM_CHUNK_ROWS - 1) / P33C_HOST_TLM_CHUNK_ROWS)));
+        }
+        if (file != NULL)
+            fclose(file);
+        retval &= ok;
+        printf("  columnar export: %llu frames in %u chunks of up to %u frames, %s\n",
+                    (unsigned long long)rows, (unsigned)chunks, (unsigned)P33C_HOST_TLM_CHUNK_ROWS, (ok) ? "ok" : "FAILED");
+    }
+    free(buffer);
+
+    // CSV export of the continuous stream
+    ok = 0;
+    lines = 0;
+    file = tmpfile();
+    if (file != NULL)
+    {
+        p33c_HostTlm_Reset(&decoder);
+        ok = p33c_HostTlm_WriteCsvHeader(file);
+        p33c_HostTlm_Decode(&decoder, p33c_HostTlmStream, p33c_HostTlmLength, &p33c_Host_TlmCsv, file);
+        rewind(file);
+        while (fgets(line, sizeof(line), file) != NULL)
+        {
+            if ((lines == 2) && (strncmp(line, "1,400,2,,,,,,,,,", 16) != 0)) // second frame: DAC snapshot
+                ok = 0;
+            lines++;
+        }
+        fclose(file);
+        ok &= (lines == (P33C_HOST_TLM_FRAMES + 1));
+    }
+    retval &= ok;
+    printf("  CSV export: %u lines, %s\n", (unsigned)lines, (ok) ? "ok" : "FAILED");
+
+    // The control loop interrupt does not write frames
+    p33c_HostTlmLength = 0;
+    head = telemetry.head;
+    for (i = 0; i < (P33C_HOST_TLM_STALL * TELEMETRY_DECIMATION); i++)
+        p33c_Host_TlmCycle();
+    ok = (telemetry.head == head);
+    
+    // Stalled consumer: the DMA transfer is never completed, the producer drops frames once the buffer is full
+    for (i = 0; i < (P33C_HOST_TLM_STALL * TELEMETRY_DECIMATION); i++)
+    {
+        p33c_Host_TlmCycle();
+        if (((i + 1) % TELEMETRY_DECIMATION) == 0)
+        {
+            TELEMETRY_Record();
+            TELEMETRY_Transmit();
+        }
+    }
+    dropped = telemetry.dropped;
+    ok &= ((uint16_t)(telemetry.head - telemetry.tail) == TELEMETRY_BUFFER_SIZE) &&
+          (dropped == (P33C_HOST_TLM_STALL - TELEMETRY_BUFFER_SIZE));
+    while (telemetry.head != telemetry.tail)
+        p33c_Host_TlmTask();
+    
+    // Resume: the next frame carries the sequence number following all dropped frames
+    for (i = 0; i < TELEMETRY_DECIMATION; i++)
+        p33c_Host_TlmCycle();
+    p33c_Host_TlmTask();
+    p33c_Host_TlmTask();
+
+    p33c_HostTlm_Reset(&decoder);
+    p33c_HostTlm_Decode(&decoder, p33c_HostTlmStream, p33c_HostTlmLength, NULL, NULL);
+    ok &= ((decoder.frames == (TELEMETRY_BUFFER_SIZE + 1)) && (decoder.lost == dropped) && 
+           (decoder.sequence == telemetry.sequence) && (telemetry.high_water == TELEMETRY_BUFFER_SIZE) &&
+           (decoder.crc_errors == 0) && (p33c_HostTlmDmaError == 0));
+    retval &= ok;
+    printf("  stalled consumer: %u pushed, %llu decoded, %u dropped, %llu lost, %s\n",
+                (unsigned)(P33C_HOST_TLM_STALL + 1), (unsigned long long)decoder.frames, (unsigned)dropped, 
+                (unsigned long long)decoder.lost, (ok) ? "ok" : "FAILED");
+
+    // Push cost: one reserve/fill/commit pass of the task per frame, dropped frames included
+    p33c_Profile_Update();
+    region = &p33c_profile.region[P33C_PROFILE_TELEMETRY_PUSH];
+    pushes = (P33C_HOST_TLM_FRAMES + P33C_HOST_TLM_STALL + 1);
+    ok = (region->count == pushes);
+    retval &= ok;
+    printf("  push cost: %lu passes, min %u, mean %u, max %u cycles (host clock), %s\n",
+                (unsigned long)region->count, (unsigned)region->min, (unsigned)region->mean, 
+                (unsigned)region->max, (ok) ? "ok" : "FAILED");
+
+    telemetry.enable = false;
+    pwm_ctrl.enable = false;
+
+    return(retval);
+}
+
+// ________________________
+// end of file
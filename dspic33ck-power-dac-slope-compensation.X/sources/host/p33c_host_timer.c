@@ -0,0 +1,283 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_timer.c
+ * ************************************************************************************************
+ * Summary:
+ * Simulated Timer1 of the host build
+ *
+ * Description:
+ * This source file advances the simulated Timer1 registers declared in the host device 
+ * header sources/host/xc.h. Host code consumes simulated CPU time by calling 
+ * p33c_HostTimer_Advance() with the number of instruction cycles to be simulated; 
+ * Idle() advances the timer to its next period match. On every period match TMR1 
+ * is reset, T1IF is set and, if T1IE is set, the Timer1 interrupt service routine 
+ * _T1Interrupt() is called, if it is linked into the host application.
+ *
+ * Only the internal instruction clock with a 1:1 prescaler is supported.
+ *
+ * p33c_HostTimer_ReadClock() provides the free-running profiler timer (SCCP1) of
+ * the host build from the monotonic clock of the host. Like SCCP1 clocked by FCY,
+ * it counts instruction cycles of the current oscillator: 10 ns per count while a 
+ * PLL is the system clock (OSCCON.COSC) and 250 ns per count while the FRC 
+ * oscillator is.
+ *
+ * p33c_HostTimer_SetSimulated() moves SCCP1 and the oscillator model (p33c_host_clock.c)
+ * from the monotonic clock of the host to simulated time, which only advances by the
+ * instruction cycles consumed with p33c_HostTimer_Advance() and by a modelled cost of
+ * every read of SCCP1 and of the oscillator status registers. Polling loops then make 
+ * progress independent of the load of the host, so timeouts, lock delays and their
+ * ordering are reproducible.
+ *
+ * See Also:
+ *	xc.h (host), sched.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <time.h>
+
+extern void _T1Interrupt(void) __attribute__((weak));
+
+#define P33C_HOST_TIMER_TICK_NS_FRC 250U // Instruction cycle of the FRC oscillator in [ns] (FCY = 4 MHz)
+#define P33C_HOST_TIMER_TICK_NS_PLL 10U  // Instruction cycle of the system PLL in [ns] (FCY = 100 MHz)
+#define P33C_HOST_TIMER_READ_CYCLES 8U   // Simulated cost of one SCCP1 read in a polling loop [instruction cycles]
+
+static uint64_t p33c_HostTimer_Cycles = 0; // Total number of simulated instruction cycles
+static uint64_t p33c_HostTimer_ClockNs = 0; // Host clock of the most recent SCCP1 read in [ns]
+static uint64_t p33c_HostTimer_ClockRem = 0; // Host time not yet counted by SCCP1 in [ns]
+static uint16_t p33c_HostTimer_Clock = 0; // SCCP1 counter
+static bool p33c_HostTimer_Simulated = false; // SCCP1 and oscillator model run on simulated time
+static uint64_t p33c_HostTimer_TimeNs = 0; // Simulated time in [ns]
+
+/* Returns the instruction cycle of the current oscillator in [ns] (does not complete a clock switch) */
+static uint16_t p33c_HostTimer_TickNs(void)
+{
+    uint16_t cosc = (OSCCON >> 12) & 0x7U;
+
+    return(((cosc == 0b001) || (cosc == 0b011)) ? P33C_HOST_TIMER_TICK_NS_PLL : P33C_HOST_TIMER_TICK_NS_FRC);
+}
+
+/* @@p33c_HostTimer_Advance
+ * ********************************************************************************
+ * Summary:
+ *     Advances the simulated Timer1 by a number of instruction cycles
+ *
+ * Parameters:
+ *     uint32_t cycles:
+ *          Number of instruction cycles to be simulated
+ *
+ * Returns:
+ *     (none)
+ *
+ * Description:
+ *     The interrupt service routine is called at the simulated time of the
+ *     period match, i.e. it preempts the code consuming the cycles.
+ *
+ * ********************************************************************************/
+
+void p33c_HostTimer_Advance(uint32_t cycles)
+{
+    uint32_t remaining;
+
+    p33c_HostTimer_Cycles += cycles;
+    if (p33c_HostTimer_Simulated)
+        p33c_HostTimer_TimeNs += (uint64_t)cycles * p33c_HostTimer_TickNs();
+
+    if (!T1CONbits.TON)
+        return;
+
+    while (cycles > 0)
+    {
+        // Number of cycles until TMR1 matches PR1 and is reset
+        remaining = ((uint32_t)PR1 - (uint32_t)TMR1) + 1UL;
+        if (cycles < remaining)
+        {
+            TMR1 = (uint16_t)(TMR1 + cycles);
+            break;
+        }
+
+        cycles -= remaining;
+        TMR1 = 0;
+        _T1IF = 1;
+        if ((_T1IE) && (_T1Interrupt != NULL))
+            _T1Interrupt();
+    }
+
+    return;
+}
+
+/* @@p33c_HostTimer_Idle
+ * ********************************************************************************
+ * Summary:
+ *     Simulates Idle mode until the next Timer1 period match
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     (none)
+ *
+ * ********************************************************************************/
+
+void p33c_HostTimer_Idle(void)
+{
+    if (!T1CONbits.TON)
+        return;
+
+    p33c_HostTimer_Advance(((uint32_t)PR1 - (uint32_t)TMR1) + 1UL);
+
+    return;
+}
+
+/* @@p33c_HostTimer_GetCycles
+ * ********************************************************************************
+ * Summary:
+ *     Returns the total number of simulated instruction cycles
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     uint64_t: number of instruction cycles simulated since program start
+ *
+ * ********************************************************************************/
+
+uint64_t p33c_HostTimer_GetCycles(void)
+{
+    return(p33c_HostTimer_Cycles);
+}
+
+/* @@p33c_HostTimer_SetSimulated
+ * ********************************************************************************
+ * Summary:
+ *     Selects the time base of SCCP1 and of the oscillator model
+ *
+ * Parameters:
+ *     bool enable:
+ *          true = simulated time, false = monotonic clock of the host
+ *
+ * Returns:
+ *     (none)
+ *
+ * Description:
+ *     SCCP1 continues counting from its current value. Lock delays of the 
+ *     oscillator model which are pending while the time base is changed are
+ *     undefined, so it should be changed before p33c_HostSfr_Reset().
+ *
+ * ********************************************************************************/
+
+void p33c_HostTimer_SetSimulated(bool enable)
+{
+    p33c_HostTimer_Simulated = enable;
+    p33c_HostTimer_ClockNs = p33c_HostTimer_GetTimeNs(0);
+    p33c_HostTimer_ClockRem = 0;
+}
+
+/* @@p33c_HostTimer_GetTimeNs
+ * ********************************************************************************
+ * Summary:
+ *     Returns the time base of SCCP1 and of the oscillator model
+ *
+ * Parameters:
+ *     uint32_t cycles:
+ *          Simulated cost of the access in instruction cycles
+ *
+ * Returns:
+ *     uint64_t: simulated time or monotonic clock of the host in [ns]
+ *
+ * Description:
+ *     With simulated time the access consumes the given number of instruction
+ *     cycles (p33c_HostTimer_Advance()) before the time is returned. The cost 
+ *     is ignored while the monotonic clock of the host is used.
+ *
+ * ********************************************************************************/
+
+uint64_t p33c_HostTimer_GetTimeNs(uint32_t cycles)
+{
+    struct timespec t;
+
+    if (p33c_HostTimer_Simulated)
+    {
+        p33c_HostTimer_Advance(cycles);
+        return(p33c_HostTimer_TimeNs);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return(((uint64_t)t.tv_sec * 1000000000ULL) + (uint64_t)t.tv_nsec);
+}
+
+/* @@p33c_HostTimer_ReadClock
+ * ********************************************************************************
+ * Summary:
+ *     Returns the time base of the host as free-running 16-bit timer value
+ *
+ * Parameters:
+ *     (none)
+ *
+ * Returns:
+ *     uint16_t: time base in instruction cycles of the current oscillator
+ *
+ * Description:
+ *     The time since the previous read is counted with the instruction 
+ *     cycle of the current oscillator. When the clock switch to a PLL has 
+ *     completed since the previous read, the time up to the lock of the PLL 
+ *     (p33c_HostClockLock) is counted with the instruction cycle of the FRC.
+ *
+ * ********************************************************************************/
+
+static void p33c_HostTimer_Count(uint64_t until_ns, uint16_t tick_ns)
+{
+    p33c_HostTimer_ClockRem += (until_ns - p33c_HostTimer_ClockNs);
+    p33c_HostTimer_ClockNs = until_ns;
+    p33c_HostTimer_Clock = (uint16_t)(p33c_HostTimer_Clock + (p33c_HostTimer_ClockRem / tick_ns));
+    p33c_HostTimer_ClockRem %= tick_ns;
+}
+
+uint16_t p33c_HostTimer_ReadClock(void)
+{
+    uint64_t now, lock_ns;
+    uint16_t cosc;
+
+    cosc = OSCCONbits.COSC; // completes a pending clock switch
+    lock_ns = p33c_HostClockLock.pll_lock_ns;
+
+    now = p33c_HostTimer_GetTimeNs(P33C_HOST_TIMER_READ_CYCLES);
+
+    if ((cosc != 0b001) && (cosc != 0b011))
+    {
+        p33c_HostTimer_Count(now, P33C_HOST_TIMER_TICK_NS_FRC);
+    }
+    else
+    {
+        if ((lock_ns > p33c_HostTimer_ClockNs) && (lock_ns <= now))
+            p33c_HostTimer_Count(lock_ns, P33C_HOST_TIMER_TICK_NS_FRC);
+        p33c_HostTimer_Count(now, P33C_HOST_TIMER_TICK_NS_PLL);
+    }
+
+    return(p33c_HostTimer_Clock);
+}
+
+// ________________________
+// end of file
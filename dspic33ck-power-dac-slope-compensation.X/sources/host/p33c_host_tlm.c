@@ -0,0 +1,553 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_tlm.c
+ * ************************************************************************************************
+ * Summary:
+ * Host-side decoder, recorder and exporter of the telemetry frame stream
+ *
+ * Description:
+ * This source file decodes the telemetry frame stream transmitted by telemetry.c. Frames
+ * are located by the sync word 0x5AA5 followed by a known payload type and the payload 
+ * length; candidates with a checksum mismatch are rejected and the search continues one
+ * byte after the rejected sync word, so the decoder resynchronizes after corrupted or
+ * lost bytes. Valid frames are passed to a frame handler as a view into the input buffer 
+ * without copying. Gaps in the sequence numbers of valid frames are counted as lost 
+ * frames; they are caused by frames dropped by the firmware or rejected by the decoder.
+ *
+ * Streams can be read from files, pipes or serial ports (e.g. a USB-UART adapter or a 
+ * pseudo-terminal) and optionally recorded into a capture file, which can be decoded 
+ * again later.
+ *
+ * The columnar export file starts with the 8-character identifier "P33CTLC1" and the 
+ * number of columns as 32-bit unsigned integer, followed by one descriptor per column 
+ * consisting of the zero-padded column name (16 characters) and the size of one value
+ * in [byte] as 32-bit unsigned integer. The descriptors are followed by chunks of up 
+ * to P33C_HOST_TLM_CHUNK_ROWS frames. Every chunk starts with the number of frames as 
+ * 32-bit unsigned integer, followed by the values of all frames of the first column, 
+ * then of the second column and so on. All values are stored in the byte order of the 
+ * host. Payload words of the snapshot type not carried by a frame are zero.
+ *
+ * See Also:
+ *	p33c_host_tlm.h, telemetry.h, tools/p33c_tlm.c
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "p33c_host_tlm.h"
+
+// Column names of the columnar export
+static const char* p33c_HostTlmColumnName[P33C_HOST_TLM_COLUMNS] = {
+    "sequence", "timestamp", "type",
+    "PGxCONL", "PGxSTAT", "PGxPER", "PGxDC", "PGxPHASE", "PGxTRIGA", "PGxTRIGB", "PGxTRIGC",
+    "DACxCONL", "DACxDATH", "DACxDATL", "SLPxCONL", "SLPxCONH", "SLPxDAT", "sample", "status"
+};
+
+// CRC-16/CCITT-FALSE remainders of all byte values (polynomial 0x1021)
+static uint16_t p33c_HostTlmCrcTable[256];
+static bool p33c_HostTlmCrcReady = false;
+
+/* Returns the 16-bit little endian value at the given address */
+static inline uint16_t p33c_HostTlm_Get16(const uint8_t* p)
+{
+    return((uint16_t)(p[0] | ((uint16_t)p[1] << 8)));
+}
+
+/* Builds the CRC remainder table */
+static void p33c_HostTlm_CrcInit(void)
+{
+    uint16_t i, j, crc;
+
+    for (i = 0; i < 256; i++)
+    {
+        crc = (uint16_t)(i << 8);
+        for (j = 0; j < 8; j++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        p33c_HostTlmCrcTable[i] = crc;
+    }
+    p33c_HostTlmCrcReady = true;
+
+    return;
+}
+
+/* @@p33c_HostTlm_Crc16
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the CRC-16/CCITT-FALSE checksum of a byte array
+ *
+ * Parameters:
+ *     const uint8_t* data: Pointer to the first byte
+ *     size_t length: Number of bytes
+ *
+ * Returns:
+ *     Checksum (initial value 0xFFFF, no final XOR)
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_Crc16(const uint8_t* data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    size_t i;
+
+    if (!p33c_HostTlmCrcReady)
+        p33c_HostTlm_CrcInit();
+
+    for (i = 0; i < length; i++)
+        crc = (uint16_t)((crc << 8) ^ p33c_HostTlmCrcTable[(crc >> 8) ^ data[i]]);
+
+    return(crc);
+}
+
+/* @@p33c_HostTlm_Reset
+ * ********************************************************************************
+ * Summary:
+ *     Resets the state and statistics of a telemetry decoder
+ *
+ * Parameters:
+ *     struct P33C_HOST_TLM_DECODER_s* decoder: Decoder object
+ *
+ * Returns:
+ *     (none)
+ *
+ * ********************************************************************************/
+
+void p33c_HostTlm_Reset(struct P33C_HOST_TLM_DECODER_s* decoder)
+{
+    memset(decoder, 0, sizeof(struct P33C_HOST_TLM_DECODER_s));
+    if (!p33c_HostTlmCrcReady)
+        p33c_HostTlm_CrcInit();
+
+    return;
+}
+
+/* @@p33c_HostTlm_Decode
+ * ********************************************************************************
+ * Summary:
+ *     Decodes all complete telemetry frames of a byte buffer
+ *
+ * Parameters:
+ *     struct P33C_HOST_TLM_DECODER_s* decoder: Decoder object
+ *     const uint8_t* data: Pointer to the received bytes
+ *     size_t length: Number of received bytes
+ *     P33C_HOST_TLM_HANDLER_t handler: Function called for every valid frame (optional)
+ *     void* context: Context pointer passed to the frame handler
+ *
+ * Returns:
+ *     Number of bytes consumed
+ *
+ * Description:
+ *     The function returns as soon as fewer bytes than one frame are left. These 
+ *     bytes are not consumed; streaming callers keep them and pass them again 
+ *     together with the next bytes received. The frame views passed to the 
+ *     handler are only valid during the handler call.
+ *
+ * ********************************************************************************/
+
+size_t p33c_HostTlm_Decode(struct P33C_HOST_TLM_DECODER_s* decoder, const uint8_t* data, size_t length,
+                P33C_HOST_TLM_HANDLER_t handler, void* context)
+{
+    struct P33C_HOST_TLM_FRAME_s frame;
+    const uint8_t* p;
+    const uint8_t* next;
+    size_t i = 0, skip;
+
+    while ((length - i) >= TELEMETRY_FRAME_SIZE)
+    {
+        p = &data[i];
+
+        // Search for the next sync word followed by a valid type and length
+        if ((p[0] != (uint8_t)TELEMETRY_SYNC) || (p[1] != (uint8_t)(TELEMETRY_SYNC >> 8)) ||
+            ((p[2] != TELEMETRY_TYPE_PWM) && (p[2] != TELEMETRY_TYPE_DAC)) || 
+            (p[3] != TELEMETRY_PAYLOAD_SIZE))
+        {
+            next = memchr(&p[1], (uint8_t)TELEMETRY_SYNC, length - i - 1);
+            skip = (next != NULL) ? (size_t)(next - p) : (length - i);
+            decoder->skipped += skip;
+            i += skip;
+            continue;
+        }
+
+        // Reject the candidate on a checksum mismatch
+        if (p33c_HostTlm_Crc16(p, TELEMETRY_CRC_SIZE) != p33c_HostTlm_Get16(&p[TELEMETRY_CRC_SIZE]))
+        {
+            decoder->crc_errors++;
+            decoder->skipped++;
+            i++;
+            continue;
+        }
+
+        frame.data = p;
+        frame.type = p[offsetof(struct TELEMETRY_FRAME_s, type)];
+        frame.timestamp = (uint32_t)p33c_HostTlm_Get16(&p[offsetof(struct TELEMETRY_FRAME_s, timestamp)]) |
+                          ((uint32_t)p33c_HostTlm_Get16(&p[offsetof(struct TELEMETRY_FRAME_s, timestamp) + 2]) << 16);
+        frame.sequence = p33c_HostTlm_Get16(&p[offsetof(struct TELEMETRY_FRAME_s, sequence)]);
+
+        if (decoder->synced)
+            decoder->lost += (uint16_t)(frame.sequence - decoder->sequence);
+        decoder->sequence = (uint16_t)(frame.sequence + 1);
+        decoder->synced = true;
+        decoder->frames++;
+
+        if (handler != NULL)
+            handler(&frame, context);
+
+        i += TELEMETRY_FRAME_SIZE;
+    }
+
+    decoder->bytes += i;
+
+    return(i);
+}
+
+/* @@p33c_HostTlm_DecodeFd
+ * ********************************************************************************
+ * Summary:
+ *     Reads and decodes a telemetry stream from a file descriptor
+ *
+ * Parameters:
+ *     struct P33C_HOST_TLM_DECODER_s* decoder: Decoder object
+ *     int fd: File descriptor of a file, pipe, serial port or pseudo-terminal
+ *     uint64_t limit: Number of bytes to read (0 = until end of file)
+ *     FILE* capture: File receiving a copy of all bytes read (optional)
+ *     P33C_HOST_TLM_HANDLER_t handler: Function called for every valid frame (optional)
+ *     void* context: Context pointer passed to the frame handler
+ *
+ * Returns:
+ *     0 = failure, a read or write error occurred
+ *     1 = success
+ *
+ * Description:
+ *     Reading stops at the end of the file, when the byte limit has been reached, 
+ *     when the read call is interrupted by a signal or when the other side of a
+ *     pseudo-terminal has been closed. Incomplete frames at the end of the stream 
+ *     are counted as skipped bytes.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_DecodeFd(struct P33C_HOST_TLM_DECODER_s* decoder, int fd, uint64_t limit, 
+                FILE* capture, P33C_HOST_TLM_HANDLER_t handler, void* context)
+{
+    uint8_t* buffer;
+    size_t fill = 0, used, request;
+    uint64_t total = 0;
+    ssize_t n;
+    uint16_t retval=1;
+
+    buffer = (uint8_t*)malloc(P33C_HOST_TLM_READ_SIZE);
+    if (buffer == NULL)
+        return(0);
+
+    while ((limit == 0) || (total < limit))
+    {
+        request = (P33C_HOST_TLM_READ_SIZE - fill);
+        if ((limit != 0) && (request > (limit - total)))
+            request = (size_t)(limit - total);
+
+        n = read(fd, &buffer[fill], request);
+        if (n < 0)
+        {
+            if ((errno != EINTR) && (errno != EIO)) // EIO: pseudo-terminal closed
+                retval = 0;
+            break;
+        }
+        if (n == 0)
+            break;
+
+        if ((capture != NULL) && (fwrite(&buffer[fill], 1, (size_t)n, capture) != (size_t)n))
+            retval = 0;
+
+        total += (uint64_t)n;
+        fill += (size_t)n;
+        used = p33c_HostTlm_Decode(decoder, buffer, fill, handler, context);
+        memmove(buffer, &buffer[used], fill - used);
+        fill -= used;
+    }
+
+    decoder->skipped += fill;
+    decoder->bytes += fill;
+    free(buffer);
+
+    return(retval);
+}
+
+/* @@p33c_HostTlm_SetRaw
+ * ********************************************************************************
+ * Summary:
+ *     Configures a serial port or pseudo-terminal for binary reception
+ *
+ * Parameters:
+ *     int fd: File descriptor of the terminal device
+ *     uint32_t baudrate: Baud rate (0 = leave unchanged)
+ *
+ * Returns:
+ *     0 = failure, the device is no terminal or the baud rate is not supported
+ *     1 = success
+ *
+ * Description:
+ *     Input and output processing, echo and flow control are disabled, so all 
+ *     bytes are passed unchanged. Reads return as soon as one byte is available.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_SetRaw(int fd, uint32_t baudrate)
+{
+    static const struct { uint32_t baudrate; speed_t speed; } table[] = {
+        { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 },
+        { 115200, B115200 }, { 230400, B230400 }, { 460800, B460800 }, { 500000, B500000 },
+        { 921600, B921600 }, { 1000000, B1000000 }, { 2000000, B2000000 }, { 3000000, B3000000 }
+    };
+    struct termios tio;
+    uint16_t i;
+
+    if (tcgetattr(fd, &tio) != 0)
+        return(0);
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= (CLOCAL | CREAD);
+    tio.c_cflag &= ~CRTSCTS;
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+
+    if (baudrate != 0)
+    {
+        for (i = 0; i < (sizeof(table) / sizeof(table[0])); i++)
+            if (table[i].baudrate == baudrate)
+                break;
+        if (i == (sizeof(table) / sizeof(table[0])))
+            return(0);
+        cfsetispeed(&tio, table[i].speed);
+        cfsetospeed(&tio, table[i].speed);
+    }
+
+    if (tcsetattr(fd, TCSANOW, &tio) != 0)
+        return(0);
+
+    return(1);
+}
+
+/* @@p33c_HostTlm_WriteCsvHeader
+ * ********************************************************************************
+ * Summary:
+ *     Writes the column header line of the CSV export
+ *
+ * Parameters:
+ *     FILE* file: Output file
+ *
+ * Returns:
+ *     0 = failure, the file could not be written
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_WriteCsvHeader(FILE* file)
+{
+    uint16_t i;
+    int n = 0;
+
+    for (i = 0; i < P33C_HOST_TLM_COLUMNS; i++)
+        n |= fprintf(file, (i == 0) ? "%s" : ",%s", p33c_HostTlmColumnName[i]);
+    n |= fprintf(file, "\n");
+
+    return((uint16_t)(n >= 0));
+}
+
+/* @@p33c_HostTlm_WriteCsv
+ * ********************************************************************************
+ * Summary:
+ *     Writes one frame as line of the CSV export
+ *
+ * Parameters:
+ *     FILE* file: Output file
+ *     const struct P33C_HOST_TLM_FRAME_s* frame: Decoded frame
+ *
+ * Returns:
+ *     0 = failure, the file could not be written
+ *     1 = success
+ *
+ * Description:
+ *     The fields of the snapshot type not carried by the frame are left empty.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_WriteCsv(FILE* file, const struct P33C_HOST_TLM_FRAME_s* frame)
+{
+    char line[256];
+    char* p = line;
+    uint16_t i;
+
+    p += sprintf(p, "%u,%lu,%u", (unsigned)frame->sequence, (unsigned long)frame->timestamp, (unsigned)frame->type);
+    if (frame->type == TELEMETRY_TYPE_DAC)
+        p += sprintf(p, ",,,,,,,,");
+    for (i = 0; i < (TELEMETRY_PAYLOAD_SIZE >> 1); i++)
+        p += sprintf(p, ",%u", (unsigned)p33c_HostTlm_Word(frame, i));
+    if (frame->type == TELEMETRY_TYPE_PWM)
+        p += sprintf(p, ",,,,,,,,");
+    *p++ = '\n';
+
+    return((uint16_t)(fwrite(line, 1, (size_t)(p - line), file) == (size_t)(p - line)));
+}
+
+/* Writes the frames collected in the current chunk of a columnar export */
+static uint16_t p33c_HostTlm_ColumnsFlush(struct P33C_HOST_TLM_COLUMNS_s* columns)
+{
+    uint32_t rows = columns->rows;
+    uint16_t i, retval=1;
+
+    if (rows == 0)
+        return(1);
+
+    if ((fwrite(&rows, sizeof(uint32_t), 1, columns->file) != 1) ||
+        (fwrite(columns->sequence, sizeof(uint16_t), rows, columns->file) != rows) ||
+        (fwrite(columns->timestamp, sizeof(uint32_t), rows, columns->file) != rows) ||
+        (fwrite(columns->type, sizeof(uint8_t), rows, columns->file) != rows))
+        retval = 0;
+    for (i = 0; i < (2 * (TELEMETRY_PAYLOAD_SIZE >> 1)); i++)
+        if (fwrite(columns->word[i], sizeof(uint16_t), rows, columns->file) != rows)
+            retval = 0;
+
+    columns->total += rows;
+    columns->chunks++;
+    columns->rows = 0;
+
+    return(retval);
+}
+
+/* @@p33c_HostTlm_ColumnsOpen
+ * ********************************************************************************
+ * Summary:
+ *     Starts a columnar export
+ *
+ * Parameters:
+ *     FILE* file: Output file opened in binary mode
+ *
+ * Returns:
+ *     Columnar export object or NULL when the file header could not be written
+ *
+ * ********************************************************************************/
+
+struct P33C_HOST_TLM_COLUMNS_s* p33c_HostTlm_ColumnsOpen(FILE* file)
+{
+    struct P33C_HOST_TLM_COLUMNS_s* columns;
+    char name[16];
+    uint32_t value;
+    uint16_t i, ok;
+
+    columns = (struct P33C_HOST_TLM_COLUMNS_s*)calloc(1, sizeof(struct P33C_HOST_TLM_COLUMNS_s));
+    if (columns == NULL)
+        return(NULL);
+    columns->file = file;
+
+    value = P33C_HOST_TLM_COLUMNS;
+    ok = ((fwrite("P33CTLC1", 1, 8, file) == 8) && (fwrite(&value, sizeof(uint32_t), 1, file) == 1));
+    for (i = 0; i < P33C_HOST_TLM_COLUMNS; i++)
+    {
+        memset(name, 0, sizeof(name));
+        strncpy(name, p33c_HostTlmColumnName[i], sizeof(name) - 1);
+        value = (i == 1) ? sizeof(uint32_t) : (i == 2) ? sizeof(uint8_t) : sizeof(uint16_t);
+        ok &= ((fwrite(name, 1, sizeof(name), file) == sizeof(name)) && (fwrite(&value, sizeof(uint32_t), 1, file) == 1));
+    }
+
+    if (!ok)
+    {
+        free(columns);
+        return(NULL);
+    }
+
+    return(columns);
+}
+
+/* @@p33c_HostTlm_ColumnsAppend
+ * ********************************************************************************
+ * Summary:
+ *     Adds one frame to a columnar export
+ *
+ * Parameters:
+ *     struct P33C_HOST_TLM_COLUMNS_s* columns: Columnar export object
+ *     const struct P33C_HOST_TLM_FRAME_s* frame: Decoded frame
+ *
+ * Returns:
+ *     0 = failure, a completed chunk could not be written
+ *     1 = success
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_ColumnsAppend(struct P33C_HOST_TLM_COLUMNS_s* columns, 
+                const struct P33C_HOST_TLM_FRAME_s* frame)
+{
+    uint32_t row = columns->rows;
+    uint16_t i, first;
+
+    columns->sequence[row] = frame->sequence;
+    columns->timestamp[row] = frame->timestamp;
+    columns->type[row] = frame->type;
+
+    first = (frame->type == TELEMETRY_TYPE_DAC) ? (TELEMETRY_PAYLOAD_SIZE >> 1) : 0;
+    for (i = 0; i < (TELEMETRY_PAYLOAD_SIZE >> 1); i++)
+    {
+        columns->word[first + i][row] = p33c_HostTlm_Word(frame, i);
+        columns->word[(TELEMETRY_PAYLOAD_SIZE >> 1) - first + i][row] = 0;
+    }
+
+    if (++columns->rows < P33C_HOST_TLM_CHUNK_ROWS)
+        return(1);
+
+    return(p33c_HostTlm_ColumnsFlush(columns));
+}
+
+/* @@p33c_HostTlm_ColumnsClose
+ * ********************************************************************************
+ * Summary:
+ *     Writes the last chunk and releases a columnar export object
+ *
+ * Parameters:
+ *     struct P33C_HOST_TLM_COLUMNS_s* columns: Columnar export object
+ *
+ * Returns:
+ *     0 = failure, the last chunk could not be written
+ *     1 = success
+ *
+ * Description:
+ *     The output file is not closed.
+ *
+ * ********************************************************************************/
+
+uint16_t p33c_HostTlm_ColumnsClose(struct P33C_HOST_TLM_COLUMNS_s* columns)
+{
+    uint16_t retval;
+
+    retval = p33c_HostTlm_ColumnsFlush(columns);
+    free(columns);
+
+    return(retval);
+}
+
+// ________________________
+// end of file
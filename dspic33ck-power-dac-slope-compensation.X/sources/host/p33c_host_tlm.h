@@ -0,0 +1,120 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_host_tlm.h
+ * ************************************************************************************************
+ * Summary:
+ * Host-side decoder, recorder and exporter of the telemetry frame stream (header file)
+ *
+ * Description:
+ * The decoder locates telemetry frames (see telemetry.h) in a byte stream by their sync 
+ * word, payload type and length, verifies their checksum and tracks their sequence numbers.
+ * Frames are parsed in place: the frame view passed to the frame handler points into the 
+ * input buffer, so captured files can be decoded directly from a memory mapping. Decoded
+ * frames can be exported as CSV file or as columnar file, in which the frame fields are
+ * stored column by column in chunks of up to P33C_HOST_TLM_CHUNK_ROWS frames.
+ *
+ * See Also:
+ *	p33c_host_tlm.c, telemetry.h, tools/p33c_tlm.c
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_TLM_H
+#define	P33C_HOST_TLM_H
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+
+#include "telemetry.h"
+
+#define P33C_HOST_TLM_CHUNK_ROWS    65536U  // Maximum number of frames per columnar chunk
+#define P33C_HOST_TLM_COLUMNS       19U     // Number of columns: sequence, timestamp, type and 16 payload words
+#define P33C_HOST_TLM_READ_SIZE     65536U  // Size of the stream read buffer in [byte]
+
+/* Decoded frame (view into the input buffer) */
+struct P33C_HOST_TLM_FRAME_s {
+    const uint8_t* data;    // Pointer to the first byte of the frame in the input buffer
+    uint32_t timestamp;     // Control loop executions since the stream has been enabled
+    uint16_t sequence;      // Frame sequence number
+    uint8_t type;           // Payload type (TELEMETRY_TYPE_xxx)
+};
+
+/* Frame handler called for every valid frame */
+typedef void (*P33C_HOST_TLM_HANDLER_t)(const struct P33C_HOST_TLM_FRAME_s* frame, void* context);
+
+/* Decoder state and statistics */
+struct P33C_HOST_TLM_DECODER_s {
+    uint64_t bytes;         // Number of bytes processed
+    uint64_t frames;        // Number of valid frames
+    uint64_t skipped;       // Number of bytes discarded while searching for the next frame
+    uint64_t crc_errors;    // Number of frame candidates with a checksum mismatch
+    uint64_t lost;          // Number of frames missing in the sequence (dropped or corrupted)
+    uint16_t sequence;      // Expected sequence number of the next frame
+    bool synced;            // At least one valid frame has been received
+};
+
+/* Columnar export */
+struct P33C_HOST_TLM_COLUMNS_s {
+    FILE* file;             // Output file
+    uint32_t rows;          // Number of frames in the current chunk
+    uint32_t chunks;        // Number of chunks written
+    uint64_t total;         // Number of frames written
+    uint16_t sequence[P33C_HOST_TLM_CHUNK_ROWS];
+    uint32_t timestamp[P33C_HOST_TLM_CHUNK_ROWS];
+    uint8_t type[P33C_HOST_TLM_CHUNK_ROWS];
+    uint16_t word[2 * (TELEMETRY_PAYLOAD_SIZE >> 1)][P33C_HOST_TLM_CHUNK_ROWS]; // PWM words followed by DAC words
+};
+
+/* Returns payload word n (0 ... 7) of a decoded frame */
+static inline uint16_t p33c_HostTlm_Word(const struct P33C_HOST_TLM_FRAME_s* frame, uint16_t n)
+{
+    const uint8_t* p = &frame->data[offsetof(struct TELEMETRY_FRAME_s, payload) + (n << 1)];
+    return((uint16_t)(p[0] | ((uint16_t)p[1] << 8)));
+}
+
+/* *********************************************************************************
+ * FUNCTION PROTOTYPES
+ * ********************************************************************************/
+
+extern uint16_t p33c_HostTlm_Crc16(const uint8_t* data, size_t length);
+extern void p33c_HostTlm_Reset(struct P33C_HOST_TLM_DECODER_s* decoder);
+extern size_t p33c_HostTlm_Decode(struct P33C_HOST_TLM_DECODER_s* decoder, const uint8_t* data, size_t length,
+                    P33C_HOST_TLM_HANDLER_t handler, void* context);
+extern uint16_t p33c_HostTlm_DecodeFd(struct P33C_HOST_TLM_DECODER_s* decoder, int fd, uint64_t limit, 
+                    FILE* capture, P33C_HOST_TLM_HANDLER_t handler, void* context);
+extern uint16_t p33c_HostTlm_SetRaw(int fd, uint32_t baudrate);
+
+extern uint16_t p33c_HostTlm_WriteCsvHeader(FILE* file);
+extern uint16_t p33c_HostTlm_WriteCsv(FILE* file, const struct P33C_HOST_TLM_FRAME_s* frame);
+
+extern struct P33C_HOST_TLM_COLUMNS_s* p33c_HostTlm_ColumnsOpen(FILE* file);
+extern uint16_t p33c_HostTlm_ColumnsAppend(struct P33C_HOST_TLM_COLUMNS_s* columns, 
+                    const struct P33C_HOST_TLM_FRAME_s* frame);
+extern uint16_t p33c_HostTlm_ColumnsClose(struct P33C_HOST_TLM_COLUMNS_s* columns);
+
+
+#endif	/* P33C_HOST_TLM_H */
+// END OF FILE
@@ -0,0 +1,127 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_crash.c
+ * ************************************************************************************************
+ * Summary:
+ * Linux command line tool decoding the crash forensics record
+ *
+ * Description:
+ * This tool searches a binary memory image for the crash record written by the trap 
+ * handlers (see crash.c) and prints the trap context, the PWM safe state latency and the
+ * register sets of all PWM generators and DAC instances captured at the time of the trap.
+ * The memory image is usually a binary export of the data memory read by the debugger 
+ * after a reset, since the record is placed in persistent RAM. The exit code is 0 when
+ * a valid record has been found and 1 otherwise.
+ *
+ * Usage:
+ *
+ *   p33c_crash <image.bin|->
+ *
+ * Build:
+ *
+ *   gcc -std=gnu99 -O2 -Wall -D__MA330048_dsPIC33CK_DPPIM__ -D__DM330029_R20__ \
+ *       -Isources/host -Isources sources/host/tools/p33c_crash.c sources/host/p33c_host_crashdec.c \
+ *       sources/host/p33c_host_tlm.c -o p33c_crash
+ *
+ * See Also:
+ *	p33c_host_crashdec.h, p33c_host_crashdec.c, crash.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "p33c_host_crashdec.h"
+
+/* Reads the complete memory image into a buffer */
+static uint8_t* p33c_Crash_Load(FILE* file, size_t* length)
+{
+    uint8_t* data = NULL;
+    uint8_t* ptr;
+    size_t size = 0, n;
+
+    *length = 0;
+    do {
+        ptr = realloc(data, size + 65536);
+        if (ptr == NULL)
+        {
+            free(data);
+            return(NULL);
+        }
+        data = ptr;
+        n = fread(&data[size], 1, 65536, file);
+        size += n;
+    } while (n > 0);
+
+    *length = size;
+    return(data);
+}
+
+int main(int argc, char** argv)
+{
+    FILE* file;
+    uint8_t* data;
+    size_t length;
+    const struct CRASH_RECORD_s* record;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <image.bin|->\n", argv[0]);
+        return(2);
+    }
+
+    file = (strcmp(argv[1], "-") == 0) ? stdin : fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        perror(argv[1]);
+        return(2);
+    }
+    data = p33c_Crash_Load(file, &length);
+    if (file != stdin)
+        fclose(file);
+    if (data == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[1]);
+        return(2);
+    }
+
+    record = p33c_HostCrash_Find(data, length);
+    if (record == NULL)
+    {
+        printf("%s: no valid crash record in %lu bytes\n", argv[1], (unsigned long)length);
+        free(data);
+        return(1);
+    }
+
+    printf("%s: crash record at offset 0x%04lX\n", argv[1], (unsigned long)((const uint8_t*)record - data));
+    p33c_HostCrash_Print(stdout, record, "  ");
+    free(data);
+    return(0);
+}
+
+// ________________________
+// end of file
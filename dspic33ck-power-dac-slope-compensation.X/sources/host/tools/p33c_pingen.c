@@ -0,0 +1,480 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_pingen.c
+ * ************************************************************************************************
+ * Summary:
+ * Linux command line tool generating compact pin descriptor headers from pinmap headers
+ *
+ * Description:
+ * This tool reads a board pinmap header (e.g. ma330048_r30_pinmap.h), which declares about
+ * 15 register bit, inline assembly and interrupt macros per device pin, and writes a compact
+ * pin descriptor header (e.g. ma330048_r30_pins.h) declaring one object-like macro per pin:
+ *
+ *   #define DBGPIN_PIN  D, 12, 76, 0, 0, 0  // port, bit, RPn, analog, ADC core, ANx input
+ *   #define TP05_PIN    ECP05_PIN           // board signal routed to another descriptor
+ *
+ * Port and bit are taken from the latch register bit of <NAME>_Write(), the remaining fields
+ * from <NAME>_RP, <NAME>_IS_ANALOG_INPUT (or <NAME>_IsAnalogInput()), <NAME>_ADCCORE and
+ * <NAME>_ADC_AN_INPUT. Pins whose <NAME>_Write() refers to another signal become aliases.
+ * Plain constants (PINSTATE_xxx, LED_ON, RPO_xxx, version strings, ...) and device
+ * conditionals (e.g. #if defined (__P33SMPS_CH_MSTR__)) are copied, while the register bit
+ * macros and all conditionals inside pin declarations are dropped. Every branch also gets
+ * an X-macro <BOARD>_PIN_LIST(pin) calling pin(NAME) for each device pin (aliases are not
+ * listed), which allows iterating over all pins at compile time.
+ *
+ * The descriptors are used with the pin accessors of p33c_gpio.h. The generated headers are
+ * checked into the project; rerun the tool whenever a pinmap header changes.
+ *
+ * Usage:
+ *
+ *   p33c_pingen <pinmap.h> <pins.h>
+ *
+ * Build:
+ *
+ *   gcc -std=gnu99 -O2 -Wall sources/host/tools/p33c_pingen.c -o p33c_pingen
+ *   ./p33c_pingen sources/config/ma330048_r30_pinmap.h sources/config/ma330048_r30_pins.h
+ *
+ * See Also:
+ *	p33c_gpio.h, hal.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define PINGEN_LINE_SIZE    512U    // Maximum length of a source line
+#define PINGEN_NAME_SIZE    48U     // Maximum length of a signal name
+#define PINGEN_PINS_MAX     256U    // Maximum number of pins per branch
+#define PINGEN_DEPTH_MAX    16U     // Maximum nesting depth of conditionals
+
+/* Pin collected from one pin declaration block */
+struct PINGEN_PIN_s {
+    char name[PINGEN_NAME_SIZE];    // Signal name
+    char alias[PINGEN_NAME_SIZE];   // Name of the referenced signal (alias pins only)
+    char comment[PINGEN_NAME_SIZE]; // Device pin comment (e.g. 'Device Pin #21 is RD12')
+    char port;                      // Port letter (direct pins only)
+    int bit;                        // Bit position (direct pins only)
+    int rp;                         // Number of Remappable Pin (0 = not remappable)
+    int analog;                     // 1 = analog input
+    int adc_core;                   // ADC core index
+    int adc_input;                  // ANx input number
+    bool valid;                     // Block declared <NAME>_Write()
+};
+
+/* Generator state */
+struct PINGEN_s {
+    FILE* out;
+    char prefix[PINGEN_NAME_SIZE];  // Board prefix of the X-macro (e.g. MA330048_R30)
+    struct PINGEN_PIN_s pin;        // Pin of the current pin declaration block
+    bool in_block;                  // A pin declaration block is open
+    bool keep[PINGEN_DEPTH_MAX];    // Conditional copied into the output
+    bool guarded[PINGEN_DEPTH_MAX]; // Conditional is the #ifndef guard of a constant
+    unsigned depth;                 // Nesting depth of conditionals
+    unsigned guard_depth;           // Depth of the header guard (0 = not yet found)
+    char list[PINGEN_PINS_MAX][PINGEN_NAME_SIZE]; // Pins of the current branch
+    unsigned list_count;
+    unsigned top_count;             // Pins declared outside of copied conditionals
+    unsigned lists;                 // Number of X-macros written
+    int section;                    // Kind of the last output line (0 = none, 1 = constant, 2 = pin)
+    unsigned pins, aliases, constants;
+};
+
+/* Copies the identifier at src into dst and returns the number of characters read */
+static size_t p33c_Pingen_Identifier(const char* src, char* dst, size_t size)
+{
+    size_t n = 0;
+
+    while ((isalnum((unsigned char)src[n]) || (src[n] == '_')) && (n < (size - 1)))
+    {
+        dst[n] = src[n];
+        n++;
+    }
+    dst[n] = '\0';
+    return(n);
+}
+
+/* Returns a pointer to the first non-blank character */
+static const char* p33c_Pingen_Skip(const char* s)
+{
+    while ((*s == ' ') || (*s == '\t'))
+        s++;
+    return(s);
+}
+
+/* Parses a decimal number or a boolean literal */
+static int p33c_Pingen_Number(const char* s)
+{
+    s = p33c_Pingen_Skip(s);
+    if (strncmp(s, "true", 4) == 0)
+        return(1);
+    if (strncmp(s, "false", 5) == 0)
+        return(0);
+    return((int)strtol(s, NULL, 0));
+}
+
+/* Separates groups of constants and pin descriptors by a blank line */
+static void p33c_Pingen_Section(struct PINGEN_s* gen, int section)
+{
+    if ((gen->section != 0) && (gen->section != section))
+        fprintf(gen->out, "\n");
+    gen->section = section;
+    return;
+}
+
+/* Writes the pin of the current block and adds it to the pin list of the branch */
+static void p33c_Pingen_ClosePin(struct PINGEN_s* gen)
+{
+    struct PINGEN_PIN_s* pin = &gen->pin;
+    char name[PINGEN_NAME_SIZE + 8];
+
+    gen->in_block = false;
+    if (!pin->valid)
+        return;
+
+    p33c_Pingen_Section(gen, 2);
+    snprintf(name, sizeof(name), "%s_PIN", pin->name);
+    if (pin->alias[0] != '\0')
+    {
+        fprintf(gen->out, "#define %-20s %s_PIN", name, pin->alias);
+        gen->aliases++;
+    }
+    else
+    {
+        fprintf(gen->out, "#define %-20s %c, %d, %d, %d, %d, %d", name, pin->port, pin->bit,
+                    pin->rp, pin->analog, (pin->analog) ? pin->adc_core : 0,
+                    (pin->analog) ? pin->adc_input : 0);
+        gen->pins++;
+    }
+    fprintf(gen->out, "%s%s\n", (pin->comment[0] != '\0') ? " // " : "", pin->comment);
+
+    // Only device pins are listed, aliases would repeat them under another name
+    if ((pin->alias[0] == '\0') && (gen->list_count < PINGEN_PINS_MAX))
+        strcpy(gen->list[gen->list_count++], pin->name);
+    return;
+}
+
+/* Writes the X-macro of all pins declared in the current branch */
+static void p33c_Pingen_CloseList(struct PINGEN_s* gen)
+{
+    unsigned i;
+
+    p33c_Pingen_Section(gen, 0);
+    fprintf(gen->out, "#define %s_PIN_LIST(pin)", gen->prefix);
+    for (i = 0; i < gen->list_count; i++)
+        fprintf(gen->out, " \\\n    pin(%s)", gen->list[i]);
+    fprintf(gen->out, "\n\n");
+    gen->section = 0;
+    gen->lists++;
+    return;
+}
+
+/* Processes a #define within a pin declaration block */
+static void p33c_Pingen_PinDefine(struct PINGEN_s* gen, const char* name, const char* value)
+{
+    struct PINGEN_PIN_s* pin = &gen->pin;
+    size_t len = strlen(name);
+    const char* suffix;
+    char target[PINGEN_NAME_SIZE];
+
+    // The latch bit macro declares the signal name and either the port bit or the alias
+    if ((len > 6) && (strcmp(&name[len - 6], "_Write") == 0))
+    {
+        memcpy(pin->name, name, len - 6);
+        pin->name[len - 6] = '\0';
+        pin->valid = true;
+
+        // LAT<port>bits.LAT<port><bit>
+        if ((strncmp(value, "LAT", 3) == 0) && (strncmp(&value[4], "bits.LAT", 8) == 0))
+        {
+            pin->port = value[3];
+            pin->bit = atoi(&value[13]);
+        }
+        // <OTHER>_Write()
+        else if (p33c_Pingen_Identifier(value, target, sizeof(target)) > 6)
+        {
+            target[strlen(target) - 6] = '\0';
+            strcpy(pin->alias, target);
+        }
+        else
+            pin->valid = false;
+        return;
+    }
+
+    if ((!pin->valid) || (strncmp(name, pin->name, strlen(pin->name)) != 0) ||
+        (name[strlen(pin->name)] != '_'))
+        return;
+
+    suffix = &name[strlen(pin->name) + 1];
+    if (strcmp(suffix, "RP") == 0)
+        pin->rp = p33c_Pingen_Number(value);
+    else if ((strcmp(suffix, "IS_ANALOG_INPUT") == 0) || (strcmp(suffix, "IsAnalogInput") == 0))
+        pin->analog = (p33c_Pingen_Number(value) != 0);
+    else if (strcmp(suffix, "ADCCORE") == 0)
+        pin->adc_core = p33c_Pingen_Number(value);
+    else if (strcmp(suffix, "ADC_AN_INPUT") == 0)
+        pin->adc_input = p33c_Pingen_Number(value);
+    return;
+}
+
+/* Processes one source line */
+static void p33c_Pingen_Line(struct PINGEN_s* gen, const char* line, const char* next)
+{
+    const char* s = p33c_Pingen_Skip(line);
+    char name[PINGEN_NAME_SIZE], guard[PINGEN_NAME_SIZE], value[PINGEN_LINE_SIZE];
+    const char* comment;
+    size_t n;
+    bool keep;
+
+    // Blank lines and top-level comments terminate pin declaration blocks
+    if ((*s == '\0') || (*s == '\n') || (*s == '\r'))
+    {
+        if (gen->in_block)
+            p33c_Pingen_ClosePin(gen);
+        return;
+    }
+
+    if (strncmp(s, "//", 2) == 0)
+    {
+        if (gen->in_block)
+            p33c_Pingen_ClosePin(gen);
+        s = p33c_Pingen_Skip(&s[2]);
+        if (strncmp(s, "Device Pin #", 12) == 0)
+        {
+            memset(&gen->pin, 0, sizeof(gen->pin));
+            n = strcspn(s, "=\r\n");
+            while ((n > 0) && (s[n - 1] == ' '))
+                n--;
+            if (n >= PINGEN_NAME_SIZE)
+                n = PINGEN_NAME_SIZE - 1;
+            memcpy(gen->pin.comment, s, n);
+            gen->in_block = true;
+        }
+        return;
+    }
+
+    if (*s != '#')
+        return;
+    s = p33c_Pingen_Skip(&s[1]);
+
+    // Conditionals: only device conditionals outside of pin blocks are copied
+    if ((strncmp(s, "if", 2) == 0) && (gen->depth < PINGEN_DEPTH_MAX))
+    {
+        keep = !gen->in_block;
+        gen->guarded[gen->depth] = false;
+        if (strncmp(s, "ifndef", 6) == 0)
+        {
+            p33c_Pingen_Identifier(p33c_Pingen_Skip(&s[6]), guard, sizeof(guard));
+            if (gen->guard_depth == 0)
+            {
+                gen->guard_depth = gen->depth + 1; // header guard
+                keep = false;
+            }
+            else if ((next != NULL) && (strstr(next, "#define") != NULL) && (strstr(next, guard) != NULL))
+            {
+                gen->guarded[gen->depth] = true; // guard of a constant
+                keep = false;
+            }
+        }
+        if ((keep) && (gen->list_count > 0))
+            gen->top_count = gen->list_count;
+        gen->keep[gen->depth++] = keep;
+        if (keep)
+        {
+            p33c_Pingen_Section(gen, 0);
+            fputs(line, gen->out);
+            fprintf(gen->out, "\n");
+        }
+        return;
+    }
+
+    if ((strncmp(s, "el", 2) == 0) || (strncmp(s, "endif", 5) == 0))
+    {
+        if (gen->depth == 0)
+            return;
+        if (gen->keep[gen->depth - 1])
+        {
+            if (gen->in_block)
+                p33c_Pingen_ClosePin(gen);
+            p33c_Pingen_CloseList(gen);
+            gen->list_count = gen->top_count; // the next branch starts with the top-level pins
+            fputs(line, gen->out);
+            fprintf(gen->out, "\n");
+        }
+        if (strncmp(s, "endif", 5) == 0)
+            gen->depth--;
+        return;
+    }
+
+    if (strncmp(s, "define", 6) != 0)
+        return;
+
+    s = p33c_Pingen_Skip(&s[6]);
+    n = p33c_Pingen_Identifier(s, name, sizeof(name));
+    if (n == 0)
+        return;
+    s = &s[n];
+    if (strncmp(s, "()", 2) == 0)
+        s = &s[2];
+    s = p33c_Pingen_Skip(s);
+
+    // Strip line end and trailing comment of the value
+    strncpy(value, s, sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+    value[strcspn(value, "\r\n")] = '\0';
+    comment = strstr(s, "//");
+
+    if (gen->in_block)
+    {
+        p33c_Pingen_PinDefine(gen, name, value);
+        return;
+    }
+
+    // Header guard and empty defines are not copied
+    if ((gen->depth == gen->guard_depth) && (gen->depth > 0) && (value[0] == '\0'))
+        return;
+
+    if (strstr(value, "//") != NULL)
+        *strstr(value, "//") = '\0';
+    n = strlen(value);
+    while ((n > 0) && isspace((unsigned char)value[n - 1]))
+        value[--n] = '\0';
+    if (n == 0)
+        return;
+
+    // Plain constant
+    p33c_Pingen_Section(gen, 1);
+    if ((gen->depth > 0) && (gen->guarded[gen->depth - 1]))
+        fprintf(gen->out, "#ifndef %s\n    #define %s %s\n#endif\n", name, name, value);
+    else
+    {
+        fprintf(gen->out, "#define %-16s %s", name, value);
+        if (comment != NULL)
+        {
+            n = strcspn(comment, "\r\n");
+            while ((n > 0) && isspace((unsigned char)comment[n - 1]))
+                n--;
+            fprintf(gen->out, " %.*s", (int)n, comment);
+        }
+        fprintf(gen->out, "\n");
+    }
+    gen->constants++;
+    return;
+}
+
+static void p33c_Pingen_Usage(void)
+{
+    fprintf(stderr, "usage: p33c_pingen <pinmap.h> <pins.h>\n");
+    return;
+}
+
+int main(int argc, char* argv[])
+{
+    static struct PINGEN_s gen;
+    char line[PINGEN_LINE_SIZE], next[PINGEN_LINE_SIZE];
+    const char *base, *source;
+    FILE* in;
+    bool more;
+    size_t i;
+
+    if (argc != 3)
+    {
+        p33c_Pingen_Usage();
+        return(1);
+    }
+
+    in = fopen(argv[1], "r");
+    if (in == NULL)
+    {
+        perror(argv[1]);
+        return(1);
+    }
+    gen.out = fopen(argv[2], "w");
+    if (gen.out == NULL)
+    {
+        perror(argv[2]);
+        fclose(in);
+        return(1);
+    }
+
+    // Board prefix from the output file name (e.g. ma330048_r30_pins.h => MA330048_R30)
+    base = strrchr(argv[2], '/');
+    base = (base != NULL) ? &base[1] : argv[2];
+    for (i = 0; (base[i] != '\0') && (base[i] != '.') && (i < (PINGEN_NAME_SIZE - 1)); i++)
+        gen.prefix[i] = (char)toupper((unsigned char)base[i]);
+    gen.prefix[i] = '\0';
+    if ((i > 5) && (strcmp(&gen.prefix[i - 5], "_PINS") == 0))
+        gen.prefix[i - 5] = '\0';
+
+    source = strrchr(argv[1], '/');
+    source = (source != NULL) ? &source[1] : argv[1];
+
+    fprintf(gen.out,
+        "/* ***********************************************************************************************\n"
+        " * File:        %s\n"
+        " * Comments:    Hardware abstraction layer device pin descriptors\n"
+        " * Board ID:    %s\n"
+        " *\n"
+        " * Description:\n"
+        " * This file has been generated from %s by p33c_pingen (sources/host/tools).\n"
+        " * Do not edit this file; edit the pinmap header and run the generator again.\n"
+        " *\n"
+        " * Each pin descriptor <NAME>_PIN expands into 'port, bit, RPn, analog, ADC core, ANx input'\n"
+        " * and is used with the pin accessors of p33c_gpio.h (e.g. p33c_Gpio_Set(DBGPIN)).\n"
+        " * %s_PIN_LIST(pin) calls pin(NAME) for each pin declared in this file.\n"
+        " * ***********************************************************************************************/\n"
+        "\n"
+        "// This is a guard condition so that contents of this file are not included\n"
+        "// more than once.\n"
+        "#ifndef __%s_PINS_H__\n"
+        "#define __%s_PINS_H__\n"
+        "\n", base, gen.prefix, source, gen.prefix, gen.prefix, gen.prefix);
+
+    more = (fgets(line, sizeof(line), in) != NULL);
+    while (more)
+    {
+        more = (fgets(next, sizeof(next), in) != NULL);
+        p33c_Pingen_Line(&gen, line, (more) ? next : NULL);
+        if (more)
+            memcpy(line, next, sizeof(line));
+    }
+    if (gen.in_block)
+        p33c_Pingen_ClosePin(&gen);
+    if (gen.lists == 0)
+        p33c_Pingen_CloseList(&gen);
+
+    fprintf(gen.out, "#endif\t/* __%s_PINS_H__ */\n", gen.prefix);
+
+    fclose(in);
+    if (fclose(gen.out) != 0)
+    {
+        perror(argv[2]);
+        return(1);
+    }
+
+    printf("%s: %u pins, %u aliases, %u constants\n", base, gen.pins, gen.aliases, gen.constants);
+    return(0);
+}
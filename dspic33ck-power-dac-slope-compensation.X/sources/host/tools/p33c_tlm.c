@@ -0,0 +1,235 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@p33c_tlm.c
+ * ************************************************************************************************
+ * Summary:
+ * Linux command line tool decoding and recording the telemetry frame stream
+ *
+ * Description:
+ * This tool decodes the telemetry frames transmitted by telemetry.c from a serial port, 
+ * a pseudo-terminal, a pipe or a capture file. Serial ports and pseudo-terminals are 
+ * configured for binary reception at the given baud rate and read until the tool is 
+ * stopped with Ctrl+C. Capture files are decoded in place from a read-only memory 
+ * mapping. The received bytes can be recorded into a capture file; decoded frames can 
+ * be exported as CSV file and as columnar file (see p33c_host_tlm.c). At the end, the 
+ * number of frames, rejected frame candidates, skipped bytes and lost frames as well as
+ * the decoding throughput are reported.
+ *
+ * Usage:
+ *
+ *   p33c_tlm [-b baudrate] [-w capture.bin] [-c frames.csv] [-p frames.col] <device|file|->
+ *
+ * Build:
+ *
+ *   gcc -std=gnu99 -O2 -Wall -D__MA330048_dsPIC33CK_DPPIM__ -D__DM330029_R20__ \
+ *       -Isources/host -Isources sources/host/tools/p33c_tlm.c sources/host/p33c_host_tlm.c \
+ *       -o p33c_tlm
+ *
+ * See Also:
+ *	p33c_host_tlm.h, p33c_host_tlm.c, telemetry.h
+ * ***********************************************************************************************/
+
+// Include standard header files
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "p33c_host_tlm.h"
+
+/* Export targets of the frame handler */
+struct P33C_TLM_OUTPUT_s {
+    FILE* csv;              // CSV export (optional)
+    struct P33C_HOST_TLM_COLUMNS_s* columns; // Columnar export (optional)
+    uint16_t ok;            // Cleared on a write error
+};
+
+/* Writes a decoded frame to all export files */
+static void p33c_Tlm_Output(const struct P33C_HOST_TLM_FRAME_s* frame, void* context)
+{
+    struct P33C_TLM_OUTPUT_s* output = (struct P33C_TLM_OUTPUT_s*)context;
+
+    if (output->csv != NULL)
+        output->ok &= p33c_HostTlm_WriteCsv(output->csv, frame);
+    if (output->columns != NULL)
+        output->ok &= p33c_HostTlm_ColumnsAppend(output->columns, frame);
+    return;
+}
+
+/* Interrupts a blocking read on Ctrl+C */
+static void p33c_Tlm_Stop(int signal)
+{
+    (void)signal;
+    return;
+}
+
+static void p33c_Tlm_Usage(void)
+{
+    fprintf(stderr, "usage: p33c_tlm [-b baudrate] [-w capture.bin] [-c frames.csv] [-p frames.col] <device|file|->\n");
+    return;
+}
+
+int main(int argc, char* argv[])
+{
+    struct P33C_HOST_TLM_DECODER_s decoder;
+    struct P33C_TLM_OUTPUT_s output;
+    struct sigaction action;
+    struct timespec t_start, t_stop;
+    struct stat info;
+    const char* capture_name = NULL;
+    const char* csv_name = NULL;
+    const char* columns_name = NULL;
+    FILE* capture = NULL;
+    FILE* columns_file = NULL;
+    uint32_t baudrate = 1000000;
+    const void* map;
+    double seconds;
+    int opt, fd;
+    uint16_t retval=1;
+
+    while ((opt = getopt(argc, argv, "b:w:c:p:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b': baudrate = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'w': capture_name = optarg; break;
+            case 'c': csv_name = optarg; break;
+            case 'p': columns_name = optarg; break;
+            default: p33c_Tlm_Usage(); return(2);
+        }
+    }
+    if (optind != (argc - 1))
+    {
+        p33c_Tlm_Usage();
+        return(2);
+    }
+
+    // Open input and export files
+    fd = (strcmp(argv[optind], "-") == 0) ? STDIN_FILENO : open(argv[optind], O_RDONLY | O_NOCTTY);
+    if ((fd < 0) || (fstat(fd, &info) != 0))
+    {
+        perror(argv[optind]);
+        return(1);
+    }
+
+    memset(&output, 0, sizeof(output));
+    output.ok = 1;
+    if ((capture_name != NULL) && ((capture = fopen(capture_name, "wb")) == NULL))
+    {
+        perror(capture_name);
+        return(1);
+    }
+    if (csv_name != NULL)
+    {
+        if ((output.csv = fopen(csv_name, "w")) == NULL)
+        {
+            perror(csv_name);
+            return(1);
+        }
+        output.ok &= p33c_HostTlm_WriteCsvHeader(output.csv);
+    }
+    if (columns_name != NULL)
+    {
+        if (((columns_file = fopen(columns_name, "wb")) == NULL) ||
+            ((output.columns = p33c_HostTlm_ColumnsOpen(columns_file)) == NULL))
+        {
+            perror(columns_name);
+            return(1);
+        }
+    }
+
+    // Ctrl+C ends the reception of serial ports, pseudo-terminals and pipes
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = &p33c_Tlm_Stop;
+    sigaction(SIGINT, &action, NULL);
+
+    p33c_HostTlm_Reset(&decoder);
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    if (S_ISREG(info.st_mode) && (info.st_size > 0))
+    {
+        // Capture file: decode in place from a memory mapping
+        map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            perror(argv[optind]);
+            return(1);
+        }
+        madvise((void*)map, (size_t)info.st_size, MADV_SEQUENTIAL);
+        p33c_HostTlm_Decode(&decoder, (const uint8_t*)map, (size_t)info.st_size, &p33c_Tlm_Output, &output);
+        decoder.skipped += ((uint64_t)info.st_size - decoder.bytes);
+        decoder.bytes = (uint64_t)info.st_size;
+        if (capture != NULL)
+            output.ok &= (fwrite(map, 1, (size_t)info.st_size, capture) == (size_t)info.st_size);
+        munmap((void*)map, (size_t)info.st_size);
+    }
+    else
+    {
+        // Serial port, pseudo-terminal or pipe: decode while receiving
+        if (isatty(fd) && (!p33c_HostTlm_SetRaw(fd, baudrate)))
+        {
+            fprintf(stderr, "%s: baud rate %lu not supported\n", argv[optind], (unsigned long)baudrate);
+            return(1);
+        }
+        retval &= p33c_HostTlm_DecodeFd(&decoder, fd, 0, capture, &p33c_Tlm_Output, &output);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t_stop);
+    seconds = (double)(t_stop.tv_sec - t_start.tv_sec) + (1.0e-9 * (double)(t_stop.tv_nsec - t_start.tv_nsec));
+
+    // Close all files
+    if (output.columns != NULL)
+        output.ok &= p33c_HostTlm_ColumnsClose(output.columns);
+    if ((columns_file != NULL) && (fclose(columns_file) != 0))
+        output.ok = 0;
+    if ((output.csv != NULL) && (fclose(output.csv) != 0))
+        output.ok = 0;
+    if ((capture != NULL) && (fclose(capture) != 0))
+        output.ok = 0;
+    if (fd != STDIN_FILENO)
+        close(fd);
+    retval &= output.ok;
+
+    printf("%llu bytes, %llu frames, %llu rejected candidates, %llu bytes skipped, %llu frames lost\n",
+                (unsigned long long)decoder.bytes, (unsigned long long)decoder.frames, 
+                (unsigned long long)decoder.crc_errors, (unsigned long long)decoder.skipped, 
+                (unsigned long long)decoder.lost);
+    if (seconds > 0.0)
+        printf("%.3f s, %.1f MB/s, %.0f frames/s\n", seconds, ((double)decoder.bytes / seconds) * 1.0e-6, 
+                    (double)decoder.frames / seconds);
+    if (!retval)
+        fprintf(stderr, "read or write error\n");
+
+    return((retval) ? 0 : 1);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,1090 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*@@xc.h (host)
+ * ************************************************************************************************
+ * Summary:
+ * Host-side replacement of the XC16 device header for building peripheral drivers on Linux
+ *
+ * Description:
+ * This header file stands in for the compiler-provided <xc.h> when the peripheral drivers
+ * in sources/common and the user configuration files pwm.c/dac.c are compiled with a native
+ * host compiler (e.g. gcc on Linux). It is picked up instead of the device header by adding
+ * the directory sources/host to the include search path of the host build only. The MPLAB X
+ * project never sees this file.
+ *
+ * All Special Function Registers (SFR) declared in this file resolve to words of one
+ * simulated register file (p33c_HostSfrFile[]). Registers are mapped to addresses within
+ * the device SFR address space, where every register block has the same order, size
+ * and instance stride as the SFR set data structures P33C_PWM_MODULE_s,
+ * P33C_PWM_GENERATOR_s, P33C_DAC_MODULE_s and P33C_DAC_INSTANCE_s. Pointers to these
+ * structures obtained through the driver GetHandle() macros therefore address the
+ * simulated registers exactly like they address the real SFRs on the target.
+ *
+ * Please note:
+ * The simulated register file is plain memory. Read-only status bits (e.g. PCLKCON.HRRDY)
+ * are not updated by any hardware model and writes are not masked. Host applications can
+ * preset status bits directly through the register names declared below.
+ *
+ * Example host build:
+ *
+ *   gcc -std=gnu99 -fno-strict-aliasing -D__MA330048_dsPIC33CK_DPPIM__ -D__DM330029_R20__ \
+ *       -Isources/host -Isources \
+ *       sources/host/p33c_host_sfr.c sources/host/p33c_host_main.c \
+ *       sources/common/p33c_pwm.c sources/common/p33c_dac.c \
+ *       sources/pwm.c sources/dac.c -o p33c_host
+ *
+ * See Also:
+ *	p33c_host_sfr.c, p33c_pwm.h, p33c_dac.h
+ * ***********************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef P33C_HOST_DEVICE_HEADER_H
+#define	P33C_HOST_DEVICE_HEADER_H
+
+// Include standard header files
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+// Host build identifier, which can be used to exclude device-specific code sections
+#define __P33C_HOST__   1
+
+// Simulated device
+#define __dsPIC33CK256MP506__   1
+#define __dsPIC33C__            1
+
+/* ********************************************************************************************* *
+ * SIMULATED SPECIAL FUNCTION REGISTER FILE
+ * ********************************************************************************************* */
+
+#define P33C_HOST_SFR_SIZE      0x1000U  // Size of the simulated SFR address space in [byte]
+
+extern volatile uint16_t p33c_HostSfrFile[P33C_HOST_SFR_SIZE >> 1]; // simulated SFR address space
+extern void p33c_HostSfr_Reset(void); // clears all simulated registers
+extern uint32_t p33c_HostSfrWrites; // PWM and DAC register writes of the boot paths (BOOT_HOST_WRITES(), boot.h)
+
+// Macro declaration mapping a device SFR address onto the simulated register file
+#define P33C_HOST_SFR(addr)     (p33c_HostSfrFile[(addr) >> 1])
+
+// Macro declaration overlaying an SFR bit-field data structure onto a simulated register
+#define P33C_HOST_SFRBITS(sfr, tag) (*(volatile struct tag*)&(sfr))
+
+/* ********************************************************************************************* *
+ * INTRINSIC FUNCTIONS
+ * ********************************************************************************************* */
+
+#define Nop()   do { __asm__ volatile ("nop"); } while(0)
+#define ClrWdt() do { } while(0)
+#define __builtin_enable_interrupts()   do { } while(0) // interrupts are not simulated
+#define __builtin_disable_interrupts()  do { } while(0)
+
+// Idle mode: the simulated Timer1 advances to its next period match (see p33c_host_timer.c)
+extern void p33c_HostTimer_Idle(void);
+extern void p33c_HostTimer_Advance(uint32_t cycles); // consumes simulated instruction cycles
+extern uint64_t p33c_HostTimer_GetCycles(void); // returns the number of simulated instruction cycles
+extern uint16_t p33c_HostTimer_ReadClock(void); // returns the time base of the host in instruction cycles
+extern void p33c_HostTimer_SetSimulated(bool enable); // SCCP1 and oscillator model on simulated time
+extern uint64_t p33c_HostTimer_GetTimeNs(uint32_t cycles); // returns the time base of the host in [ns]
+#define Idle()  p33c_HostTimer_Idle()
+
+/* ********************************************************************************************* *
+ * TIMER1
+ * ********************************************************************************************* */
+
+#define P33C_HOST_TMR1_BASE     0x0100U // start address of the Timer1 registers
+
+#define T1CON       P33C_HOST_SFR(P33C_HOST_TMR1_BASE + 0x00U)
+#define TMR1        P33C_HOST_SFR(P33C_HOST_TMR1_BASE + 0x04U)
+#define PR1         P33C_HOST_SFR(P33C_HOST_TMR1_BASE + 0x08U)
+
+struct tagT1CONBITS {
+    uint16_t :1;
+    uint16_t TCS:1;
+    uint16_t TSYNC:1;
+    uint16_t :1;
+    uint16_t TCKPS:2;
+    uint16_t :1;
+    uint16_t TGATE:1;
+    uint16_t TECS:2;
+    uint16_t PRWIP:1;
+    uint16_t TMWIP:1;
+    uint16_t TMWDIS:1;
+    uint16_t TSIDL:1;
+    uint16_t :1;
+    uint16_t TON:1;
+};
+typedef struct tagT1CONBITS T1CONBITS;
+
+#define T1CONbits   P33C_HOST_SFRBITS(T1CON, tagT1CONBITS)
+
+/* ********************************************************************************************* *
+ * SCCP1 (16-bit timer mode only)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_CCP1_BASE     0x0980U // start address of the SCCP1 registers
+
+#define CCP1CON1L   P33C_HOST_SFR(P33C_HOST_CCP1_BASE + 0x00U)
+#define CCP1PRL     P33C_HOST_SFR(P33C_HOST_CCP1_BASE + 0x14U)
+
+// The free-running timer reads the monotonic clock of the host in units of
+// the instruction cycle (10 ns), so profiled regions report host execution times
+#define CCP1TMRL    (p33c_HostTimer_ReadClock())
+
+struct tagCCP1CON1LBITS {
+    uint16_t MOD:4;
+    uint16_t CCSEL:1;
+    uint16_t T32:1;
+    uint16_t TMRPS:2;
+    uint16_t CLKSEL:3;
+    uint16_t TMRSYNC:1;
+    uint16_t :1;
+    uint16_t CCPSIDL:1;
+    uint16_t :1;
+    uint16_t CCPON:1;
+};
+typedef struct tagCCP1CON1LBITS CCP1CON1LBITS;
+
+#define CCP1CON1Lbits   P33C_HOST_SFRBITS(CCP1CON1L, tagCCP1CON1LBITS)
+
+/* ********************************************************************************************* *
+ * UART1 (transmitter only)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_U1_BASE       0x0238U // start address of the UART1 registers
+
+#define U1MODE      P33C_HOST_SFR(P33C_HOST_U1_BASE + 0x00U)
+#define U1MODEH     P33C_HOST_SFR(P33C_HOST_U1_BASE + 0x02U)
+#define U1STA       P33C_HOST_SFR(P33C_HOST_U1_BASE + 0x04U)
+#define U1STAH      P33C_HOST_SFR(P33C_HOST_U1_BASE + 0x06U)
+#define U1BRG       P33C_HOST_SFR(P33C_HOST_U1_BASE + 0x08U)
+#define U1TXREG     P33C_HOST_SFR(P33C_HOST_U1_BASE + 0x10U)
+
+struct tagU1MODEBITS {
+    uint16_t MOD:4;
+    uint16_t URXEN:1;
+    uint16_t UTXEN:1;
+    uint16_t ABAUD:1;
+    uint16_t BRGH:1;
+    uint16_t SENDB:1;
+    uint16_t WAKE:1;
+    uint16_t :1;
+    uint16_t RXBIMD:1;
+    uint16_t :1;
+    uint16_t USIDL:1;
+    uint16_t :1;
+    uint16_t UARTEN:1;
+};
+typedef struct tagU1MODEBITS U1MODEBITS;
+
+struct tagU1MODEHBITS {
+    uint16_t FLO:2;
+    uint16_t UTXINV:1;
+    uint16_t C0EN:1;
+    uint16_t STSEL:2;
+    uint16_t URXINV:1;
+    uint16_t RUNOVF:1;
+    uint16_t HALFDPLX:1;
+    uint16_t BCLKSEL:2;
+    uint16_t BCLKMOD:1;
+    uint16_t :2;
+    uint16_t ACTIVE:1;
+    uint16_t SLPEN:1;
+};
+typedef struct tagU1MODEHBITS U1MODEHBITS;
+
+struct tagU1STAHBITS {
+    uint16_t URXBF:1;
+    uint16_t URXBE:1;
+    uint16_t :2;
+    uint16_t UTXBF:1;
+    uint16_t UTXBE:1;
+    uint16_t :6;
+    uint16_t UTXISEL:3;
+    uint16_t :1;
+};
+typedef struct tagU1STAHBITS U1STAHBITS;
+
+#define U1MODEbits  P33C_HOST_SFRBITS(U1MODE, tagU1MODEBITS)
+#define U1MODEHbits P33C_HOST_SFRBITS(U1MODEH, tagU1MODEHBITS)
+#define U1STAHbits  P33C_HOST_SFRBITS(U1STAH, tagU1STAHBITS)
+
+/* ********************************************************************************************* *
+ * DMA CONTROLLER (channel 0 only)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_DMA_BASE      0x0A00U // start address of the DMA registers
+
+#define DMACON      P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x00U)
+#define DMABUF      P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x02U)
+#define DMAL        P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x04U)
+#define DMAH        P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x06U)
+#define DMACH0      P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x08U)
+#define DMAINT0     P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x0AU)
+#define DMASRC0     P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x0CU)
+#define DMADST0     P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x0EU)
+#define DMACNT0     P33C_HOST_SFR(P33C_HOST_DMA_BASE + 0x10U)
+
+struct tagDMACONBITS {
+    uint16_t PRSSEL:1;
+    uint16_t :14;
+    uint16_t DMAEN:1;
+};
+typedef struct tagDMACONBITS DMACONBITS;
+
+struct tagDMACH0BITS {
+    uint16_t CHEN:1;
+    uint16_t CHREQ:1;
+    uint16_t RELOAD:1;
+    uint16_t NULLW:1;
+    uint16_t TRMODE:2;
+    uint16_t DAMODE:2;
+    uint16_t SAMODE:2;
+    uint16_t SIZE:1;
+    uint16_t :5;
+};
+typedef struct tagDMACH0BITS DMACH0BITS;
+
+struct tagDMAINT0BITS {
+    uint16_t HALFEN:1;
+    uint16_t OVRUNIF:1;
+    uint16_t HALFIF:1;
+    uint16_t DONEIF:1;
+    uint16_t LOWIF:1;
+    uint16_t HIGHIF:1;
+    uint16_t :1;
+    uint16_t DBUFWF:1;
+    uint16_t CHSEL:7;
+    uint16_t :1;
+};
+typedef struct tagDMAINT0BITS DMAINT0BITS;
+
+#define DMACONbits  P33C_HOST_SFRBITS(DMACON, tagDMACONBITS)
+#define DMACH0bits  P33C_HOST_SFRBITS(DMACH0, tagDMACH0BITS)
+#define DMAINT0bits P33C_HOST_SFRBITS(DMAINT0, tagDMAINT0BITS)
+
+/* ********************************************************************************************* *
+ * PERIPHERAL PIN SELECT (output registers only)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_PPS_BASE      0x0E00U // start address of the PPS registers
+
+#define RPCON       P33C_HOST_SFR(P33C_HOST_PPS_BASE + 0x00U)
+#define RPOR0       P33C_HOST_SFR(P33C_HOST_PPS_BASE + 0x20U) // RP32/RP33, followed by RPOR1 ... RPOR17
+
+#define __builtin_write_RPCON(x)    (RPCON = (x))
+
+/* ********************************************************************************************* *
+ * GPIO PORTS (PORTA ... PORTE)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_GPIO_BASE     0x0400U // start address of the PORTA registers
+#define P33C_HOST_GPIO_STRIDE   0x001CU // address offset between two port register sets (12 SFRs + 2 reserved words)
+
+#define P33C_HOST_GPIO_SFR(n, ofs)   P33C_HOST_SFR(P33C_HOST_GPIO_BASE + ((n) * P33C_HOST_GPIO_STRIDE) + (ofs))
+
+#define ANSELA      P33C_HOST_GPIO_SFR(0U, 0x00U)
+#define TRISA       P33C_HOST_GPIO_SFR(0U, 0x02U)
+#define PORTA       P33C_HOST_GPIO_SFR(0U, 0x04U)
+#define LATA        P33C_HOST_GPIO_SFR(0U, 0x06U)
+#define ODCA        P33C_HOST_GPIO_SFR(0U, 0x08U)
+#define CNPUA       P33C_HOST_GPIO_SFR(0U, 0x0AU)
+#define CNPDA       P33C_HOST_GPIO_SFR(0U, 0x0CU)
+#define CNCONA      P33C_HOST_GPIO_SFR(0U, 0x0EU)
+#define CNEN0A      P33C_HOST_GPIO_SFR(0U, 0x10U)
+#define CNSTATA     P33C_HOST_GPIO_SFR(0U, 0x12U)
+#define CNEN1A      P33C_HOST_GPIO_SFR(0U, 0x14U)
+#define CNFA        P33C_HOST_GPIO_SFR(0U, 0x16U)
+
+#define ANSELB      P33C_HOST_GPIO_SFR(1U, 0x00U)
+#define TRISB       P33C_HOST_GPIO_SFR(1U, 0x02U)
+#define PORTB       P33C_HOST_GPIO_SFR(1U, 0x04U)
+#define LATB        P33C_HOST_GPIO_SFR(1U, 0x06U)
+#define ODCB        P33C_HOST_GPIO_SFR(1U, 0x08U)
+#define CNPUB       P33C_HOST_GPIO_SFR(1U, 0x0AU)
+#define CNPDB       P33C_HOST_GPIO_SFR(1U, 0x0CU)
+#define CNCONB      P33C_HOST_GPIO_SFR(1U, 0x0EU)
+#define CNEN0B      P33C_HOST_GPIO_SFR(1U, 0x10U)
+#define CNSTATB     P33C_HOST_GPIO_SFR(1U, 0x12U)
+#define CNEN1B      P33C_HOST_GPIO_SFR(1U, 0x14U)
+#define CNFB        P33C_HOST_GPIO_SFR(1U, 0x16U)
+
+#define ANSELC      P33C_HOST_GPIO_SFR(2U, 0x00U)
+#define TRISC       P33C_HOST_GPIO_SFR(2U, 0x02U)
+#define PORTC       P33C_HOST_GPIO_SFR(2U, 0x04U)
+#define LATC        P33C_HOST_GPIO_SFR(2U, 0x06U)
+#define ODCC        P33C_HOST_GPIO_SFR(2U, 0x08U)
+#define CNPUC       P33C_HOST_GPIO_SFR(2U, 0x0AU)
+#define CNPDC       P33C_HOST_GPIO_SFR(2U, 0x0CU)
+#define CNCONC      P33C_HOST_GPIO_SFR(2U, 0x0EU)
+#define CNEN0C      P33C_HOST_GPIO_SFR(2U, 0x10U)
+#define CNSTATC     P33C_HOST_GPIO_SFR(2U, 0x12U)
+#define CNEN1C      P33C_HOST_GPIO_SFR(2U, 0x14U)
+#define CNFC        P33C_HOST_GPIO_SFR(2U, 0x16U)
+
+#define ANSELD      P33C_HOST_GPIO_SFR(3U, 0x00U)
+#define TRISD       P33C_HOST_GPIO_SFR(3U, 0x02U)
+#define PORTD       P33C_HOST_GPIO_SFR(3U, 0x04U)
+#define LATD        P33C_HOST_GPIO_SFR(3U, 0x06U)
+#define ODCD        P33C_HOST_GPIO_SFR(3U, 0x08U)
+#define CNPUD       P33C_HOST_GPIO_SFR(3U, 0x0AU)
+#define CNPDD       P33C_HOST_GPIO_SFR(3U, 0x0CU)
+#define CNCOND      P33C_HOST_GPIO_SFR(3U, 0x0EU)
+#define CNEN0D      P33C_HOST_GPIO_SFR(3U, 0x10U)
+#define CNSTATD     P33C_HOST_GPIO_SFR(3U, 0x12U)
+#define CNEN1D      P33C_HOST_GPIO_SFR(3U, 0x14U)
+#define CNFD        P33C_HOST_GPIO_SFR(3U, 0x16U)
+
+#define ANSELE      P33C_HOST_GPIO_SFR(4U, 0x00U)
+#define TRISE       P33C_HOST_GPIO_SFR(4U, 0x02U)
+#define PORTE       P33C_HOST_GPIO_SFR(4U, 0x04U)
+#define LATE        P33C_HOST_GPIO_SFR(4U, 0x06U)
+#define ODCE        P33C_HOST_GPIO_SFR(4U, 0x08U)
+#define CNPUE       P33C_HOST_GPIO_SFR(4U, 0x0AU)
+#define CNPDE       P33C_HOST_GPIO_SFR(4U, 0x0CU)
+#define CNCONE      P33C_HOST_GPIO_SFR(4U, 0x0EU)
+#define CNEN0E      P33C_HOST_GPIO_SFR(4U, 0x10U)
+#define CNSTATE     P33C_HOST_GPIO_SFR(4U, 0x12U)
+#define CNEN1E      P33C_HOST_GPIO_SFR(4U, 0x14U)
+#define CNFE        P33C_HOST_GPIO_SFR(4U, 0x16U)
+
+/* ********************************************************************************************* *
+ * INTERRUPT CONTROLLER (Timer1 and ADCAN0 only)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_IFS0_ADDR     0x0800U // address of the interrupt flag status register 0
+#define P33C_HOST_IEC0_ADDR     0x0820U // address of the interrupt enable control register 0
+#define P33C_HOST_IPC0_ADDR     0x0840U // address of the interrupt priority control register 0
+#define P33C_HOST_IFS5_ADDR     0x080AU // address of the interrupt flag status register 5
+#define P33C_HOST_IEC5_ADDR     0x082AU // address of the interrupt enable control register 5
+#define P33C_HOST_IPC22_ADDR    0x086CU // address of the interrupt priority control register 22
+
+struct tagIFS0BITS {
+    uint16_t INT0IF:1;
+    uint16_t T1IF:1;
+    uint16_t :14;
+};
+typedef struct tagIFS0BITS IFS0BITS;
+
+struct tagIEC0BITS {
+    uint16_t INT0IE:1;
+    uint16_t T1IE:1;
+    uint16_t :14;
+};
+typedef struct tagIEC0BITS IEC0BITS;
+
+struct tagIPC0BITS {
+    uint16_t INT0IP:3;
+    uint16_t :1;
+    uint16_t T1IP:3;
+    uint16_t :9;
+};
+typedef struct tagIPC0BITS IPC0BITS;
+
+#define IFS0        P33C_HOST_SFR(P33C_HOST_IFS0_ADDR)
+#define IEC0        P33C_HOST_SFR(P33C_HOST_IEC0_ADDR)
+#define IPC0        P33C_HOST_SFR(P33C_HOST_IPC0_ADDR)
+
+#define IFS0bits    P33C_HOST_SFRBITS(IFS0, tagIFS0BITS)
+#define IEC0bits    P33C_HOST_SFRBITS(IEC0, tagIEC0BITS)
+#define IPC0bits    P33C_HOST_SFRBITS(IPC0, tagIPC0BITS)
+
+#define _T1IF       IFS0bits.T1IF
+#define _T1IE       IEC0bits.T1IE
+#define _T1IP       IPC0bits.T1IP
+
+struct tagIFS5BITS {
+    uint16_t :14;
+    uint16_t ADCAN0IF:1;
+    uint16_t ADCAN1IF:1;
+};
+typedef struct tagIFS5BITS IFS5BITS;
+
+struct tagIEC5BITS {
+    uint16_t :14;
+    uint16_t ADCAN0IE:1;
+    uint16_t ADCAN1IE:1;
+};
+typedef struct tagIEC5BITS IEC5BITS;
+
+struct tagIPC22BITS {
+    uint16_t :8;
+    uint16_t ADCAN0IP:3;
+    uint16_t :1;
+    uint16_t ADCAN1IP:3;
+    uint16_t :1;
+};
+typedef struct tagIPC22BITS IPC22BITS;
+
+#define IFS5        P33C_HOST_SFR(P33C_HOST_IFS5_ADDR)
+#define IEC5        P33C_HOST_SFR(P33C_HOST_IEC5_ADDR)
+#define IPC22       P33C_HOST_SFR(P33C_HOST_IPC22_ADDR)
+
+#define IFS5bits    P33C_HOST_SFRBITS(IFS5, tagIFS5BITS)
+#define IEC5bits    P33C_HOST_SFRBITS(IEC5, tagIEC5BITS)
+#define IPC22bits   P33C_HOST_SFRBITS(IPC22, tagIPC22BITS)
+
+#define _ADCAN0IF   IFS5bits.ADCAN0IF
+#define _ADCAN0IE   IEC5bits.ADCAN0IE
+#define _ADCAN0IP   IPC22bits.ADCAN0IP
+
+/* ********************************************************************************************* *
+ * OSCILLATOR, PERIPHERAL MODULE DISABLE AND RESET CONTROL
+ * ********************************************************************************************* */
+
+#define P33C_HOST_OSC_BASE      0x0300U // start address of the oscillator and reset registers
+
+#define OSCCON      P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x00U)
+extern volatile uint16_t CLKDIV; // plain variable: the register name is also a bit-field name of ADCON3H and DACCTRL1L
+#define PLLFBD      P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x04U)
+#define PLLDIV      P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x06U)
+#define OSCTUN      P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x08U)
+#define ACLKCON1    P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x0AU)
+#define APLLFBD1    P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x0CU)
+#define APLLDIV1    P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x0EU)
+#define CANCLKCON   P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x10U)
+#define REFOCONL    P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x12U)
+#define REFOCONH    P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x14U)
+#define REFOTRIMH   P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x16U)
+#define PMDCON      P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x18U)
+#define PMD1        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x1AU)
+#define PMD2        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x1CU)
+#define PMD3        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x1EU)
+#define PMD4        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x20U)
+#define PMD6        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x24U)
+#define PMD7        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x26U)
+#define PMD8        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x28U)
+#define RCON        P33C_HOST_SFR(P33C_HOST_OSC_BASE + 0x30U)
+
+struct tagOSCCONBITS {
+    uint16_t OSWEN:1;
+    uint16_t :2;
+    uint16_t CF:1;
+    uint16_t :1;
+    uint16_t LOCK:1;
+    uint16_t :1;
+    uint16_t CLKLOCK:1;
+    uint16_t NOSC:3;
+    uint16_t :1;
+    uint16_t COSC:3;
+    uint16_t :1;
+};
+typedef struct tagOSCCONBITS OSCCONBITS;
+
+struct tagACLKCON1BITS {
+    uint16_t APLLPRE:4;
+    uint16_t :4;
+    uint16_t FRCSEL:1;
+    uint16_t :5;
+    uint16_t APLLCK:1;
+    uint16_t APLLEN:1;
+};
+typedef struct tagACLKCON1BITS ACLKCON1BITS;
+
+struct tagRCONBITS {
+    uint16_t POR:1;
+    uint16_t BOR:1;
+    uint16_t IDLE:1;
+    uint16_t SLEEP:1;
+    uint16_t WDTO:1;
+    uint16_t :1;
+    uint16_t SWR:1;
+    uint16_t EXTR:1;
+    uint16_t VREGS:1;
+    uint16_t CM:1;
+    uint16_t :4;
+    uint16_t IOPUWR:1;
+    uint16_t TRAPR:1;
+};
+typedef struct tagRCONBITS RCONBITS;
+
+// The oscillator model of p33c_host_clock.c updates the switch and lock status bits 
+// before OSCCONbits, ACLKCON1bits and PCLKCONbits are accessed
+struct P33C_HOST_CLOCK_LOCK_s {
+    uint64_t pll_start_ns;  // Host clock of the clock switch request in [ns]
+    uint64_t pll_lock_ns;   // Host clock of the completed clock switch in [ns] (0 = pending)
+    uint64_t apll_start_ns; // Host clock of the auxiliary PLL start in [ns] (0 = disabled)
+    uint64_t apll_lock_ns;  // Host clock of the auxiliary PLL lock in [ns] (0 = not locked)
+};
+extern uint32_t p33c_HostClock_PllLockNs;  // Lock delay of the system PLL in [ns] (0 = instant)
+extern uint32_t p33c_HostClock_ApllLockNs; // Lock delay of the auxiliary PLL in [ns] (0 = instant)
+extern volatile struct P33C_HOST_CLOCK_LOCK_s p33c_HostClockLock;
+extern void p33c_HostClock_Reset(void);
+extern volatile uint16_t* p33c_HostClock_Sync(volatile uint16_t* sfr);
+extern void p33c_HostClock_WriteOSCCONH(uint8_t value);
+extern void p33c_HostClock_WriteOSCCONL(uint8_t value);
+
+#define OSCCONbits      (*(volatile struct tagOSCCONBITS*)p33c_HostClock_Sync(&OSCCON))
+#define ACLKCON1bits    (*(volatile struct tagACLKCON1BITS*)p33c_HostClock_Sync(&ACLKCON1))
+#define RCONbits        P33C_HOST_SFRBITS(RCON, tagRCONBITS)
+
+#define __builtin_write_OSCCONH(x)  p33c_HostClock_WriteOSCCONH(x)
+#define __builtin_write_OSCCONL(x)  p33c_HostClock_WriteOSCCONL(x)
+
+/* ********************************************************************************************* *
+ * CPU CORE, STACK LIMIT AND TRAP FLAG REGISTERS
+ * ********************************************************************************************* */
+
+#define P33C_HOST_SPLIM_ADDR    0x0020U // address of the stack pointer limit register
+#define P33C_HOST_SR_ADDR       0x0042U // address of the CPU status register
+#define P33C_HOST_CORCON_ADDR   0x0044U // address of the CPU core control register
+#define P33C_HOST_INTCON1_ADDR  0x08C0U // address of the interrupt control register 1
+#define P33C_HOST_INTTREG_ADDR  0x08C8U // address of the interrupt vector and priority register
+
+#define __DEVID_BASE    0xFF0000UL  // program memory address of the device ID register
+
+#define SPLIM       P33C_HOST_SFR(P33C_HOST_SPLIM_ADDR)
+#define SR          P33C_HOST_SFR(P33C_HOST_SR_ADDR)
+#define CORCON      P33C_HOST_SFR(P33C_HOST_CORCON_ADDR)
+#define INTCON1     P33C_HOST_SFR(P33C_HOST_INTCON1_ADDR + 0x00U)
+#define INTCON2     P33C_HOST_SFR(P33C_HOST_INTCON1_ADDR + 0x02U)
+#define INTCON3     P33C_HOST_SFR(P33C_HOST_INTCON1_ADDR + 0x04U)
+#define INTCON4     P33C_HOST_SFR(P33C_HOST_INTCON1_ADDR + 0x06U)
+#define INTTREG     P33C_HOST_SFR(P33C_HOST_INTTREG_ADDR)
+#define _VECNUM     (INTTREG & 0x00FFU)
+
+// The CPU interrupt priority level is plain memory, interrupts of the host build are 
+// executed by explicit calls of the interrupt service routines
+struct tagSRBITS {
+    uint16_t C:1;
+    uint16_t Z:1;
+    uint16_t OV:1;
+    uint16_t N:1;
+    uint16_t RA:1;
+    uint16_t IPL:3;
+    uint16_t DC:1;
+    uint16_t DA:1;
+    uint16_t SAB:1;
+    uint16_t OAB:1;
+    uint16_t SB:1;
+    uint16_t SA:1;
+    uint16_t OB:1;
+    uint16_t OA:1;
+};
+typedef struct tagSRBITS SRBITS;
+#define SRbits      P33C_HOST_SFRBITS(SR, tagSRBITS)
+
+/* ********************************************************************************************* *
+ * HIGH-SPEED ADC MODULE (dedicated core 0 and input AN0 only)
+ * ********************************************************************************************* */
+
+#define P33C_HOST_ADC_BASE      0x0B00U // start address of the ADC registers
+
+#define ADCON1L     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x00U)
+#define ADCON1H     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x02U)
+#define ADCON3L     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x08U)
+#define ADCON3H     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x0AU)
+#define ADMOD0L     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x10U)
+#define ADIEL       P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x20U)
+#define ADLVLTRGL   P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x28U)
+#define ADCORE0L    P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x2CU)
+#define ADCORE0H    P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x2EU)
+#define ADCON5L     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x3CU)
+#define ADCON5H     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x3EU)
+#define ADTRIG0L    P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0x80U)
+#define ADCBUF0     P33C_HOST_SFR(P33C_HOST_ADC_BASE + 0xC0U)
+
+struct tagADCON1LBITS {
+    uint16_t :11;
+    uint16_t NRE:1;
+    uint16_t :1;
+    uint16_t ADSIDL:1;
+    uint16_t :1;
+    uint16_t ADON:1;
+};
+typedef struct tagADCON1LBITS ADCON1LBITS;
+
+struct tagADCON1HBITS {
+    uint16_t :5;
+    uint16_t SHRRES:2;
+    uint16_t FORM:1;
+    uint16_t :8;
+};
+typedef struct tagADCON1HBITS ADCON1HBITS;
+
+struct tagADCON3LBITS {
+    uint16_t CNVCHSEL:6;
+    uint16_t SWCTRG:1;
+    uint16_t SWLCTRG:1;
+    uint16_t SHRSAMP:1;
+    uint16_t CNVRTCH:1;
+    uint16_t SUSPRDY:1;
+    uint16_t SUSPCIE:1;
+    uint16_t SUSPEND:1;
+    uint16_t REFSEL:3;
+};
+typedef struct tagADCON3LBITS ADCON3LBITS;
+
+struct tagADCON3HBITS {
+    uint16_t C0EN:1;
+    uint16_t C1EN:1;
+    uint16_t :5;
+    uint16_t SHREN:1;
+    uint16_t CLKDIV:6;
+    uint16_t CLKSEL:2;
+};
+typedef struct tagADCON3HBITS ADCON3HBITS;
+
+struct tagADMOD0LBITS {
+    uint16_t SIGN0:1;
+    uint16_t DIFF0:1;
+    uint16_t :14;
+};
+typedef struct tagADMOD0LBITS ADMOD0LBITS;
+
+struct tagADIELBITS {
+    uint16_t IE0:1;
+    uint16_t :15;
+};
+typedef struct tagADIELBITS ADIELBITS;
+
+struct tagADLVLTRGLBITS {
+    uint16_t LVLEN0:1;
+    uint16_t :15;
+};
+typedef struct tagADLVLTRGLBITS ADLVLTRGLBITS;
+
+struct tagADCORE0LBITS {
+    uint16_t SAMC:10;
+    uint16_t :6;
+};
+typedef struct tagADCORE0LBITS ADCORE0LBITS;
+
+struct tagADCORE0HBITS {
+    uint16_t ADCS:7;
+    uint16_t :1;
+    uint16_t RES:2;
+    uint16_t :2;
+    uint16_t EISEL:3;
+    uint16_t :1;
+};
+typedef struct tagADCORE0HBITS ADCORE0HBITS;
+
+struct tagADCON5LBITS {
+    uint16_t C0PWR:1;
+    uint16_t C1PWR:1;
+    uint16_t :5;
+    uint16_t SHRPWR:1;
+    uint16_t C0RDY:1;
+    uint16_t C1RDY:1;
+    uint16_t :5;
+    uint16_t SHRRDY:1;
+};
+typedef struct tagADCON5LBITS ADCON5LBITS;
+
+struct tagADCON5HBITS {
+    uint16_t C0CIE:1;
+    uint16_t C1CIE:1;
+    uint16_t :5;
+    uint16_t SHRCIE:1;
+    uint16_t WARMTIME:4;
+    uint16_t :4;
+};
+typedef struct tagADCON5HBITS ADCON5HBITS;
+
+struct tagADTRIG0LBITS {
+    uint16_t TRGSRC0:5;
+    uint16_t :3;
+    uint16_t TRGSRC1:5;
+    uint16_t :3;
+};
+typedef struct tagADTRIG0LBITS ADTRIG0LBITS;
+
+#define ADCON1Lbits     P33C_HOST_SFRBITS(ADCON1L, tagADCON1LBITS)
+#define ADCON1Hbits     P33C_HOST_SFRBITS(ADCON1H, tagADCON1HBITS)
+#define ADCON3Lbits     P33C_HOST_SFRBITS(ADCON3L, tagADCON3LBITS)
+#define ADCON3Hbits     P33C_HOST_SFRBITS(ADCON3H, tagADCON3HBITS)
+#define ADMOD0Lbits     P33C_HOST_SFRBITS(ADMOD0L, tagADMOD0LBITS)
+#define ADIELbits       P33C_HOST_SFRBITS(ADIEL, tagADIELBITS)
+#define ADLVLTRGLbits   P33C_HOST_SFRBITS(ADLVLTRGL, tagADLVLTRGLBITS)
+#define ADCORE0Lbits    P33C_HOST_SFRBITS(ADCORE0L, tagADCORE0LBITS)
+#define ADCORE0Hbits    P33C_HOST_SFRBITS(ADCORE0H, tagADCORE0HBITS)
+#define ADCON5Lbits     P33C_HOST_SFRBITS(ADCON5L, tagADCON5LBITS)
+#define ADCON5Hbits     P33C_HOST_SFRBITS(ADCON5H, tagADCON5HBITS)
+#define ADTRIG0Lbits    P33C_HOST_SFRBITS(ADTRIG0L, tagADTRIG0LBITS)
+
+/* ********************************************************************************************* *
+ * HIGH RESOLUTION PWM MODULE
+ * ********************************************************************************************* */
+
+#define P33C_HOST_PWM_BASE      0x0C00U // start address of the PWM module base registers
+#define P33C_HOST_PG_BASE       0x0C30U // start address of the PWM generator PG1 registers
+#define P33C_HOST_PG_STRIDE     0x0038U // address offset between two PWM generator register sets (27 SFRs + 1 reserved word)
+
+struct tagPCLKCONBITS {
+    uint16_t MCLKSEL:2;
+    uint16_t :2;
+    uint16_t DIVSEL:2;
+    uint16_t :2;
+    uint16_t LOCK:1;
+    uint16_t :5;
+    uint16_t HRERR:1;
+    uint16_t HRRDY:1;
+};
+typedef struct tagPCLKCONBITS PCLKCONBITS;
+
+struct tagCMBTRIGLBITS {
+    uint16_t CTA1EN:1;
+    uint16_t CTA2EN:1;
+    uint16_t CTA3EN:1;
+    uint16_t CTA4EN:1;
+    uint16_t CTA5EN:1;
+    uint16_t CTA6EN:1;
+    uint16_t CTA7EN:1;
+    uint16_t CTA8EN:1;
+    uint16_t :8;
+};
+typedef struct tagCMBTRIGLBITS CMBTRIGLBITS;
+
+struct tagCMBTRIGHBITS {
+    uint16_t CTB1EN:1;
+    uint16_t CTB2EN:1;
+    uint16_t CTB3EN:1;
+    uint16_t CTB4EN:1;
+    uint16_t CTB5EN:1;
+    uint16_t CTB6EN:1;
+    uint16_t CTB7EN:1;
+    uint16_t CTB8EN:1;
+    uint16_t :8;
+};
+typedef struct tagCMBTRIGHBITS CMBTRIGHBITS;
+
+struct tagLOGCONABITS {
+    uint16_t PWMLFAD:3;
+    uint16_t :1;
+    uint16_t PWMLFA:2;
+    uint16_t S2APOL:1;
+    uint16_t S1APOL:1;
+    uint16_t PWMS2A:4;
+    uint16_t PWMS1A:4;
+};
+typedef struct tagLOGCONABITS LOGCONABITS;
+
+struct tagPWMEVTABITS {
+    uint16_t EVTAPGS:3;
+    uint16_t :1;
+    uint16_t EVTASEL:4;
+    uint16_t :4;
+    uint16_t EVTASYNC:1;
+    uint16_t EVTASTRD:1;
+    uint16_t EVTAPOL:1;
+    uint16_t EVTAOEN:1;
+};
+typedef struct tagPWMEVTABITS PWMEVTABITS;
+
+struct tagPG1CONLBITS {
+    uint16_t MODSEL:3;
+    uint16_t CLKSEL:2;
+    uint16_t :2;
+    uint16_t HREN:1;
+    uint16_t TRGCNT:3;
+    uint16_t :4;
+    uint16_t ON:1;
+};
+typedef struct tagPG1CONLBITS PG1CONLBITS;
+
+struct tagPG1CONHBITS {
+    uint16_t SOCS:4;
+    uint16_t :2;
+    uint16_t TRGMOD:1;
+    uint16_t :1;
+    uint16_t UPDMOD:3;
+    uint16_t MSTEN:1;
+    uint16_t :1;
+    uint16_t MPHSEL:1;
+    uint16_t MPERSEL:1;
+    uint16_t MDCSEL:1;
+};
+typedef struct tagPG1CONHBITS PG1CONHBITS;
+
+struct tagPG1STATBITS {
+    uint16_t TRIG:1;
+    uint16_t CAHALF:1;
+    uint16_t STEER:1;
+    uint16_t UPDREQ:1;
+    uint16_t UPDATE:1;
+    uint16_t CAP:1;
+    uint16_t TRCLR:1;
+    uint16_t TRSET:1;
+    uint16_t FFACT:1;
+    uint16_t CLACT:1;
+    uint16_t FLTACT:1;
+    uint16_t SACT:1;
+    uint16_t FFEVT:1;
+    uint16_t CLEVT:1;
+    uint16_t FLTEVT:1;
+    uint16_t SEVT:1;
+};
+typedef struct tagPG1STATBITS PG1STATBITS;
+
+struct tagPG1IOCONLBITS {
+    uint16_t DBDAT:2;
+    uint16_t FFDAT:2;
+    uint16_t CLDAT:2;
+    uint16_t FLTDAT:2;
+    uint16_t OSYNC:2;
+    uint16_t OVRDAT:2;
+    uint16_t OVRENL:1;
+    uint16_t OVRENH:1;
+    uint16_t SWAP:1;
+    uint16_t CLMOD:1;
+};
+typedef struct tagPG1IOCONLBITS PG1IOCONLBITS;
+
+struct tagPG1IOCONHBITS {
+    uint16_t POLL:1;
+    uint16_t POLH:1;
+    uint16_t PENL:1;
+    uint16_t PENH:1;
+    uint16_t PMOD:2;
+    uint16_t :2;
+    uint16_t DTCMPSEL:1;
+    uint16_t :3;
+    uint16_t CAPSRC:3;
+    uint16_t :1;
+};
+typedef struct tagPG1IOCONHBITS PG1IOCONHBITS;
+
+struct tagPG1EVTLBITS {
+    uint16_t PGTRGSEL:3;
+    uint16_t UPDTRG:2;
+    uint16_t :3;
+    uint16_t ADTR1EN1:1;
+    uint16_t ADTR1EN2:1;
+    uint16_t ADTR1EN3:1;
+    uint16_t ADTR1PS:5;
+};
+typedef struct tagPG1EVTLBITS PG1EVTLBITS;
+
+struct tagPG1EVTHBITS {
+    uint16_t ADTR1OFS:5;
+    uint16_t ADTR2EN1:1;
+    uint16_t ADTR2EN2:1;
+    uint16_t ADTR2EN3:1;
+    uint16_t IEVTSEL:2;
+    uint16_t :2;
+    uint16_t SIEN:1;
+    uint16_t FFIEN:1;
+    uint16_t CLIEN:1;
+    uint16_t FLTIEN:1;
+};
+typedef struct tagPG1EVTHBITS PG1EVTHBITS;
+
+// All four PCI register pairs (FPCI, CLPCI, FFPCI, SPCI) share the same bit-field layout
+#define P33C_HOST_PCIL_BITS \
+    uint16_t PSS:5; \
+    uint16_t PPS:1; \
+    uint16_t PSYNC:1; \
+    uint16_t SWTERM:1; \
+    uint16_t AQSS:3; \
+    uint16_t AQPS:1; \
+    uint16_t TERM:3; \
+    uint16_t TSYNCDIS:1;
+
+#define P33C_HOST_PCIH_BITS \
+    uint16_t TQSS:3; \
+    uint16_t TQPS:1; \
+    uint16_t LATMOD:1; \
+    uint16_t SWPCIM:2; \
+    uint16_t SWPCI:1; \
+    uint16_t ACP:3; \
+    uint16_t :1; \
+    uint16_t BPSEL:3; \
+    uint16_t BPEN:1;
+
+struct tagPG1FPCILBITS  { P33C_HOST_PCIL_BITS };
+struct tagPG1FPCIHBITS  { P33C_HOST_PCIH_BITS };
+struct tagPG1CLPCILBITS { P33C_HOST_PCIL_BITS };
+struct tagPG1CLPCIHBITS { P33C_HOST_PCIH_BITS };
+struct tagPG1FFPCILBITS { P33C_HOST_PCIL_BITS };
+struct tagPG1FFPCIHBITS { P33C_HOST_PCIH_BITS };
+struct tagPG1SPCILBITS  { P33C_HOST_PCIL_BITS };
+struct tagPG1SPCIHBITS  { P33C_HOST_PCIH_BITS };
+
+struct tagPG1LEBHBITS {
+    uint16_t PLF:1;
+    uint16_t PLR:1;
+    uint16_t PHF:1;
+    uint16_t PHR:1;
+    uint16_t :4;
+    uint16_t PWMPCI:3;
+    uint16_t :5;
+};
+typedef struct tagPG1LEBHBITS PG1LEBHBITS;
+
+struct tagPG1DCABITS {
+    uint16_t DCA:8;
+    uint16_t :8;
+};
+typedef struct tagPG1DCABITS PG1DCABITS;
+
+struct tagPG1DTLBITS {
+    uint16_t DTL:14;
+    uint16_t :2;
+};
+typedef struct tagPG1DTLBITS PG1DTLBITS;
+
+struct tagPG1DTHBITS {
+    uint16_t DTH:14;
+    uint16_t :2;
+};
+typedef struct tagPG1DTHBITS PG1DTHBITS;
+
+// PWM module base registers
+// (FSCL, FSMINPER, MPHASE, MDC, MPER and LFSR at offsets 0x02 through 0x0C are not
+// declared by name as they would collide with the bit-field names of P33C_PWM_MODULE_s)
+#define PCLKCON     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x00U)
+#define CMBTRIGL    P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x0EU)
+#define CMBTRIGH    P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x10U)
+#define LOGCONA     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x12U)
+#define LOGCONB     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x14U)
+#define LOGCONC     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x16U)
+#define LOGCOND     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x18U)
+#define LOGCONE     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x1AU)
+#define LOGCONF     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x1CU)
+#define PWMEVTA     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x1EU)
+#define PWMEVTB     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x20U)
+#define PWMEVTC     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x22U)
+#define PWMEVTD     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x24U)
+#define PWMEVTE     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x26U)
+#define PWMEVTF     P33C_HOST_SFR(P33C_HOST_PWM_BASE + 0x28U)
+
+#define PCLKCONbits (*(volatile struct tagPCLKCONBITS*)p33c_HostClock_Sync(&PCLKCON)) // HRRDY follows the auxiliary PLL
+
+// PWM generator registers (register offsets within one generator register set)
+#define P33C_HOST_PG_SFR(n, ofs)    P33C_HOST_SFR(P33C_HOST_PG_BASE + (((n)-1U) * P33C_HOST_PG_STRIDE) + (ofs))
+
+#define PG1CONL     P33C_HOST_PG_SFR(1U, 0x00U)
+#define PG2CONL     P33C_HOST_PG_SFR(2U, 0x00U)
+#define PG3CONL     P33C_HOST_PG_SFR(3U, 0x00U)
+#define PG4CONL     P33C_HOST_PG_SFR(4U, 0x00U)
+#define PG5CONL     P33C_HOST_PG_SFR(5U, 0x00U)
+#define PG6CONL     P33C_HOST_PG_SFR(6U, 0x00U)
+#define PG7CONL     P33C_HOST_PG_SFR(7U, 0x00U)
+#define PG8CONL     P33C_HOST_PG_SFR(8U, 0x00U)
+
+
+/* ********************************************************************************************* *
+ * DIGITAL-TO-ANALOG CONVERTER MODULE
+ * ********************************************************************************************* */
+
+#define P33C_HOST_DAC_BASE      0x0F80U // start address of the DAC module base registers
+#define P33C_HOST_DACx_BASE     0x0F88U // start address of the DAC1 instance registers
+#define P33C_HOST_DACx_STRIDE   0x0010U // address offset between two DAC instance register sets (7 SFRs + 1 reserved word)
+
+struct tagDACCTRL1LBITS {
+    uint16_t FCLKDIV:3;
+    uint16_t :1;
+    uint16_t CLKDIV:2;
+    uint16_t CLKSEL:2;
+    uint16_t :5;
+    uint16_t DACSIDL:1;
+    uint16_t :1;
+    uint16_t DACON:1;
+};
+typedef struct tagDACCTRL1LBITS DACCTRL1LBITS;
+
+struct tagDACCTRL2LBITS {
+    uint16_t TMODTIME:10;
+    uint16_t :6;
+};
+typedef struct tagDACCTRL2LBITS DACCTRL2LBITS;
+
+struct tagDACCTRL2HBITS {
+    uint16_t SSTIME:10;
+    uint16_t :6;
+};
+typedef struct tagDACCTRL2HBITS DACCTRL2HBITS;
+
+struct tagDAC1CONLBITS {
+    uint16_t HYSSEL:2;
+    uint16_t HYSPOL:1;
+    uint16_t INSEL:3;
+    uint16_t CMPPOL:1;
+    uint16_t CMPSTAT:1;
+    uint16_t FLTREN:1;
+    uint16_t DACOEN:1;
+    uint16_t CBE:1;
+    uint16_t :2;
+    uint16_t IRQM:2;
+    uint16_t DACEN:1;
+};
+typedef struct tagDAC1CONLBITS DAC1CONLBITS;
+
+struct tagDAC1CONHBITS {
+    uint16_t TMCB:10;
+    uint16_t :6;
+};
+typedef struct tagDAC1CONHBITS DAC1CONHBITS;
+
+struct tagDAC1DATLBITS {
+    uint16_t DACLOW:12;
+    uint16_t :4;
+};
+typedef struct tagDAC1DATLBITS DAC1DATLBITS;
+
+struct tagDAC1DATHBITS {
+    uint16_t DACDAT:12;
+    uint16_t :4;
+};
+typedef struct tagDAC1DATHBITS DAC1DATHBITS;
+
+struct tagSLP1CONLBITS {
+    uint16_t SLPSTRT:4;
+    uint16_t SLPSTOPB:4;
+    uint16_t SLPSTOPA:4;
+    uint16_t HCFSEL:4;
+};
+typedef struct tagSLP1CONLBITS SLP1CONLBITS;
+
+struct tagSLP1CONHBITS {
+    uint16_t :9;
+    uint16_t PSE:1;
+    uint16_t TWME:1;
+    uint16_t HME:1;
+    uint16_t :3;
+    uint16_t SLOPEN:1;
+};
+typedef struct tagSLP1CONHBITS SLP1CONHBITS;
+
+struct tagSLP1DATBITS {
+    uint16_t SLPDAT:16;
+};
+typedef struct tagSLP1DATBITS SLP1DATBITS;
+
+// DAC module base registers (DACCTRL1H is not implemented)
+#define DACCTRL1L   P33C_HOST_SFR(P33C_HOST_DAC_BASE + 0x00U)
+#define DACCTRL2L   P33C_HOST_SFR(P33C_HOST_DAC_BASE + 0x04U)
+#define DACCTRL2H   P33C_HOST_SFR(P33C_HOST_DAC_BASE + 0x06U)
+
+#define DACCTRL1Lbits P33C_HOST_SFRBITS(DACCTRL1L, tagDACCTRL1LBITS)
+
+// DAC instance registers
+#define P33C_HOST_DACx_SFR(n, ofs)  P33C_HOST_SFR(P33C_HOST_DACx_BASE + (((n)-1U) * P33C_HOST_DACx_STRIDE) + (ofs))
+
+#define DAC1CONL    P33C_HOST_DACx_SFR(1U, 0x00U)
+#define DAC2CONL    P33C_HOST_DACx_SFR(2U, 0x00U)
+#define DAC3CONL    P33C_HOST_DACx_SFR(3U, 0x00U)
+
+
+#endif	/* P33C_HOST_DEVICE_HEADER_H */
+// END OF FILE
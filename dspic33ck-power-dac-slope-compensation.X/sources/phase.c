@@ -0,0 +1,406 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: phase.c 
+ * Comments: Multi-phase interleaved PWM generators with per-phase DAC slope compensation
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+#include "phase.h"
+#include "pwm.h"
+
+// Phase driven by the control loop interrupt while the control loop is enabled (see _ADCAN0Interrupt())
+#define PHASE_CONTROLLED(ph)    ((pwm_ctrl.enable) && ((ph)->pg == PWM_CONTROL_PG))
+
+/* @@PHASE_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Configures the PWM generators and DAC instances of all phases
+ * 
+ * Parameters:
+ *     struct PHASE_MANAGER_s* mgr:
+ *          Pointer to the phase manager object
+ *     const struct PHASE_CONFIG_s* config:
+ *          Pointer to the phase assignment table (phase #1 first)
+ *     uint16_t count:
+ *          Number of phases (1 ... PHASE_COUNT_MAX)
+ *     const struct P33C_PWM_GENERATOR_s* pgTemplate:
+ *          Pointer to the register image of the PWM generator configuration
+ *     const struct P33C_DAC_INSTANCE_s* dacTemplate:
+ *          Pointer to the register image of the DAC instance configuration
+ * 
+ * Returns:
+ *     0 = failure, the phase assignment is invalid or a register set could not be written
+ *     1 = success
+ * 
+ * Description:
+ *     Every PWM generator is written with the template, turned off, and its 
+ *     PGxTRIGA register is set to the phase shift of the next phase. All phases
+ *     but phase #1 are then synchronized to the PGxTRIGA event of the previous 
+ *     phase by p33c_PwmGenerator_SyncGeneratorsRoute() and the propagation delay of
+ *     the selected sync route is subtracted from PGxTRIGA of the previous phase 
+ *     (one PWM clock cycle equals P33C_PWM_HRES_COUNTS counts in High-Resolution 
+ *     mode). The sync route of every phase is kept in the phase object. Every 
+ *     DAC instance is written with the template and its slope start/stop 
+ *     signals are routed to the PWM generator of its phase. 
+ * 
+ *     The phase assignment is rejected when it contains more than PHASE_COUNT_MAX
+ *     phases, PWM generator or DAC instances not available on the device or 
+ *     assigned to more than one phase, or PWM generators of different PWM groups 
+ *     (PG1-PG4, PG5-PG8). Phases of different groups could only be synchronized 
+ *     through the PCI Sync function, which carries the PWM output of the previous
+ *     phase instead of its PGxTRIGA event, so the phase shift would be wrong. The
+ *     generators and DAC instances remain disabled until PHASE_Enable() is called.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PHASE_Initialize(struct PHASE_MANAGER_s* mgr, 
+                    const struct PHASE_CONFIG_s* config, uint16_t count,
+                    const struct P33C_PWM_GENERATOR_s* pgTemplate,
+                    const struct P33C_DAC_INSTANCE_s* dacTemplate)
+{
+    volatile uint16_t retval=1;
+    struct P33C_PWM_GENERATOR_s pgConfig;
+    struct P33C_DAC_INSTANCE_s dacConfig;
+    struct PHASE_s* ph;
+    uint16_t used_pg = 0, used_dac = 0;
+    uint32_t start, next;
+    uint16_t delay;
+    uint16_t i;
+
+    if ((mgr == NULL) || (config == NULL) || (pgTemplate == NULL) || (dacTemplate == NULL) ||
+        (count == 0) || (count > PHASE_COUNT_MAX) || (pgTemplate->PGxPER.value == 0))
+        return(0);
+
+    // Validate the phase assignment before any register is written
+    for (i = 0; i < count; i++)
+    {
+        if ((config[i].pg == 0) || (config[i].pg > P33C_PG_COUNT) || (used_pg & (1U << config[i].pg)) ||
+            (config[i].dac > P33C_DAC_COUNT) || ((config[i].dac != 0) && (used_dac & (1U << config[i].dac))) ||
+            (((config[i].pg - 1) >> 2) != ((config[0].pg - 1) >> 2)))
+            return(0);
+        used_pg |= (1U << config[i].pg);
+        if (config[i].dac != 0)
+            used_dac |= (1U << config[i].dac);
+    }
+
+    mgr->count = count;
+    mgr->period = pgTemplate->PGxPER.value;
+    mgr->duty = pgTemplate->PGxDC.value;
+    mgr->level = dacTemplate->DACxDATH.value;
+
+    for (i = 0; i < count; i++)
+    {
+        ph = &mgr->phase[i];
+        ph->pg_instance = config[i].pg;
+        ph->pg = p33c_PwmGenerator_GetHandle(config[i].pg);
+        ph->dac_instance = config[i].dac;
+        ph->dac = (config[i].dac != 0) ? p33c_DacInstance_GetHandle(config[i].dac) : NULL;
+        ph->current = 0;
+        ph->balance = 0;
+        ph->trim = 0;
+
+        // Start of cycle of this phase and the next phase relative to phase #1 (rounded)
+        start = (((uint32_t)i * mgr->period) + (count >> 1)) / count;
+        next = (((uint32_t)(i + 1) * mgr->period) + (count >> 1)) / count;
+        ph->shift = (uint16_t)start;
+
+        // PWM generator: template, turned off, sync trigger output at the start of the next phase
+        pgConfig = *pgTemplate;
+        pgConfig.PGxCONL.bits.ON = 0;
+        pgConfig.PGxTRIGA.value = (uint16_t)(next - start);
+        retval &= p33c_PwmGenerator_ConfigWriteRef(ph->pg_instance, &pgConfig);
+
+        // DAC instance: template with slope start/stop signals of the own PWM generator
+        if (ph->dac != NULL)
+        {
+            dacConfig = *dacTemplate;
+            dacConfig.DACxCONL.bits.DACEN = 0;
+            dacConfig.SLPxCONL.bits.SLPSTRT = PHASE_SLPSTRT(ph->pg_instance);
+            dacConfig.SLPxCONL.bits.SLPSTOPA = PHASE_SLPSTOPA(ph->pg_instance);
+            retval &= p33c_DacInstance_ConfigWriteRef(ph->dac_instance, &dacConfig);
+        }
+    }
+
+    // Synchronize every phase to the PGxTRIGA event of the previous phase
+    mgr->phase[0].sync.route = P33C_PWM_SYNC_NONE;
+    mgr->phase[0].sync.delay = 0;
+    for (i = 1; i < count; i++)
+    {
+        ph = &mgr->phase[i];
+        if (!p33c_PwmGenerator_SyncGeneratorsRoute(mgr->phase[i - 1].pg, PHASE_TRIGGER_OUTPUT, 
+                                              ph->pg, false, &ph->sync))
+            return(0);
+        
+        // Compensate the propagation delay of the sync route
+        delay = ph->sync.delay * ((pgTemplate->PGxCONL.bits.HREN) ? P33C_PWM_HRES_COUNTS : 1U);
+        if (delay >= mgr->phase[i - 1].pg->PGxTRIGA.value)
+            return(0);
+        mgr->phase[i - 1].pg->PGxTRIGA.value -= delay;
+    }
+
+    return(retval);
+}
+
+/* @@PHASE_Enable
+ * ********************************************************************************
+ * Summary:
+ *     Turns on the PWM generators and DAC instances of all phases
+ * 
+ * Parameters:
+ *     struct PHASE_MANAGER_s* mgr:
+ *          Pointer to the phase manager object
+ * 
+ * Returns:
+ *     0 = failure, at least one PWM generator could not be enabled
+ *     1 = success
+ * 
+ * Description:
+ *     The DAC instances and the DAC module are turned on first. The PWM generators 
+ *     are turned on from the last phase to phase #1, so all synchronized phases
+ *     are waiting for their trigger when phase #1 starts the first cycle. All 
+ *     generators wait for the high resolution PWM clock at the same time 
+ *     (p33c_PwmGenerator_EnableStart()). The PWM outputs of all phases are 
+ *     released after all generators are running, and none of them is released
+ *     when the request of any phase has ended in a timeout or a clock error.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PHASE_Enable(struct PHASE_MANAGER_s* mgr)
+{
+    volatile uint16_t retval=1;
+    volatile struct P33C_DAC_MODULE_s* dac_module;
+    struct P33C_PWM_ENABLE_s request[PHASE_COUNT_MAX];
+    uint16_t i, pending;
+
+    if ((mgr == NULL) || (mgr->count == 0))
+        return(0);
+
+    for (i = 0; i < mgr->count; i++)
+    {
+        if (mgr->phase[i].dac != NULL)
+            mgr->phase[i].dac->DACxCONL.bits.DACEN = 1;
+    }
+    dac_module = p33c_DacModule_GetHandle();
+    dac_module->DacModuleCtrl1L.bits.DACON = 1;
+
+    for (i = mgr->count; i > 0; i--)
+        retval &= p33c_PwmGenerator_EnableStart(&request[i - 1], mgr->phase[i - 1].pg, 
+                        P33C_PWM_ENABLE_TIMEOUT_US, NULL);
+    if (!retval)
+        return(0);
+    
+    do {
+        pending = 0;
+        for (i = 0; i < mgr->count; i++)
+            pending += (p33c_PwmGenerator_EnablePoll(&request[i]) == P33C_PWM_ENABLE_PENDING);
+    } while (pending > 0);
+    
+    for (i = 0; i < mgr->count; i++)
+        retval &= (request[i].state == P33C_PWM_ENABLE_READY);
+    if (!retval)
+        return(0); // outputs of all phases remain overridden
+    
+    for (i = 0; i < mgr->count; i++)
+        retval &= p33c_PwmGenerator_Resume(mgr->phase[i].pg);
+
+    return(retval);
+}
+
+/* @@PHASE_Disable
+ * ********************************************************************************
+ * Summary:
+ *     Turns off the PWM generators and DAC instances of all phases
+ * 
+ * Parameters:
+ *     struct PHASE_MANAGER_s* mgr:
+ *          Pointer to the phase manager object
+ * 
+ * Returns:
+ *     0 = failure, invalid phase manager object
+ *     1 = success
+ * 
+ * Description:
+ *     The PWM outputs of all phases are overridden first, then the PWM 
+ *     generators and the DAC instances are turned off. The DAC module remains
+ *     turned on as it may be used by other DAC instances.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PHASE_Disable(struct PHASE_MANAGER_s* mgr)
+{
+    volatile uint16_t retval=1;
+    uint16_t i;
+
+    if ((mgr == NULL) || (mgr->count == 0))
+        return(0);
+
+    for (i = 0; i < mgr->count; i++)
+        retval &= p33c_PwmGenerator_Suspend(mgr->phase[i].pg);
+
+    for (i = 0; i < mgr->count; i++)
+    {
+        retval &= p33c_PwmGenerator_Disable(mgr->phase[i].pg);
+        if (mgr->phase[i].dac != NULL)
+            mgr->phase[i].dac->DACxCONL.bits.DACEN = 0;
+    }
+
+    return(retval);
+}
+
+/* @@PHASE_Update
+ * ********************************************************************************
+ * Summary:
+ *     Updates duty cycle and DAC level of all phases
+ * 
+ * Parameters:
+ *     struct PHASE_MANAGER_s* mgr:
+ *          Pointer to the phase manager object
+ *     uint16_t duty:
+ *          Common duty cycle (limit) of all phases in [PWM ticks]
+ *     uint16_t level:
+ *          Common DAC level (peak current reference) of all phases in [DAC ticks]
+ * 
+ * Returns:
+ *     0 = failure, invalid phase manager object
+ *     1 = success
+ * 
+ * Description:
+ *     The phase current balancing hook is called first and may update the trim
+ *     of every phase based on the phase current samples. The duty cycle is 
+ *     written to all PWM generators, the DAC level plus the trim of the phase, 
+ *     limited to CONTROL_DAC_MIN ... CONTROL_DAC_MAX, to all DAC instances. The
+ *     update is requested on all phases from the last phase to phase #1, so all
+ *     generators transfer the new duty cycle at their next start of cycle.
+ *     While the control loop is enabled, the registers of the phase driven by 
+ *     the control loop interrupt are not written: the duty cycle is passed as 
+ *     duty cycle limit (pwm_ctrl.duty), the DAC level is set by the loop.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PHASE_Update(struct PHASE_MANAGER_s* mgr, uint16_t duty, uint16_t level)
+{
+    struct PHASE_s* ph;
+    int32_t value;
+    uint16_t i;
+
+    if ((mgr == NULL) || (mgr->count == 0))
+        return(0);
+
+    mgr->duty = duty;
+    mgr->level = level;
+
+    if (mgr->balance != NULL)
+        mgr->balance(mgr);
+
+    for (i = 0; i < mgr->count; i++)
+    {
+        ph = &mgr->phase[i];
+        if (PHASE_CONTROLLED(ph))
+        {
+            pwm_ctrl.duty = duty; // PGxDC, DACxDATH and UPDREQ are owned by _ADCAN0Interrupt()
+            continue;
+        }
+        ph->pg->PGxDC.value = duty;
+
+        if (ph->dac != NULL)
+        {
+            value = (int32_t)level + ph->trim;
+            if (value > (int32_t)CONTROL_DAC_MAX)
+                value = CONTROL_DAC_MAX;
+            else if (value < (int32_t)CONTROL_DAC_MIN)
+                value = CONTROL_DAC_MIN;
+            ph->dac->DACxDATH.value = (uint16_t)value;
+        }
+    }
+
+    for (i = mgr->count; i > 0; i--)
+        if (!PHASE_CONTROLLED(&mgr->phase[i - 1]))
+            mgr->phase[i - 1].pg->PGxSTAT.bits.UPDREQ = 1;
+
+    return(1);
+}
+
+/* @@PHASE_BalanceCurrents
+ * ********************************************************************************
+ * Summary:
+ *     Default phase current balancing hook
+ * 
+ * Parameters:
+ *     struct PHASE_MANAGER_s* mgr:
+ *          Pointer to the phase manager object
+ * 
+ * Returns:
+ *     (none)
+ * 
+ * Description:
+ *     The deviation of every phase current sample from the mean current of all 
+ *     phases with slope compensation is integrated into the trim of the DAC 
+ *     level of this phase (integral gain 2^-PHASE_BALANCE_SHIFT). The trim is
+ *     limited to +/- PHASE_TRIM_MAX. The current samples have to be written to 
+ *     the phase objects before PHASE_Update() is called. This function is 
+ *     installed by assigning it to the balancing hook of the phase manager.
+ * 
+ * ********************************************************************************/
+
+void PHASE_BalanceCurrents(struct PHASE_MANAGER_s* mgr)
+{
+    struct PHASE_s* ph;
+    int32_t sum = 0, mean, balance;
+    uint16_t i, n = 0;
+
+    for (i = 0; i < mgr->count; i++)
+    {
+        if (mgr->phase[i].dac != NULL)
+        {
+            sum += mgr->phase[i].current;
+            n++;
+        }
+    }
+    if (n < 2)
+        return;
+    mean = sum / n;
+
+    for (i = 0; i < mgr->count; i++)
+    {
+        ph = &mgr->phase[i];
+        if (ph->dac == NULL)
+            continue;
+        
+        balance = ph->balance + (mean - (int32_t)ph->current);
+        if (balance > ((int32_t)PHASE_TRIM_MAX << PHASE_BALANCE_SHIFT))
+            balance = ((int32_t)PHASE_TRIM_MAX << PHASE_BALANCE_SHIFT);
+        else if (balance < -((int32_t)PHASE_TRIM_MAX << PHASE_BALANCE_SHIFT))
+            balance = -((int32_t)PHASE_TRIM_MAX << PHASE_BALANCE_SHIFT);
+        ph->balance = balance;
+        ph->trim = (int16_t)(balance >> PHASE_BALANCE_SHIFT);
+    }
+}
+
+// ________________________
+// end of file
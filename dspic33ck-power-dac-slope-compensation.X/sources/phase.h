@@ -0,0 +1,137 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: phase.h 
+ * Comments: Header file of the multi-phase PWM and slope compensation manager source file phase.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_PHASE_MANAGER_H
+#define	XC_PHASE_MANAGER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "common/p33c_pwm.h" // Include dsPIC33C standard PWM driver header file
+#include "common/p33c_dac.h" // Include dsPIC33C standard DAC driver header file
+
+ /* *********************************************************************************
+ * PHASE MANAGER DECLARATIONS
+ * *********************************************************************************
+ * Each phase of an interleaved converter is driven by its own PWM generator and
+ * its own DAC instance generating the slope compensation ramp of the phase. All 
+ * PWM generators and DAC instances are configured from the same register images
+ * (templates), e.g. the configuration of the user PWM generator and DAC instance
+ * written by PWM_Initialize() and DAC_Initialize().
+ * 
+ * The phases are synchronized as a chain: phase #1 is self-triggered, the start 
+ * of cycle of every other phase is triggered by the PGxTRIGA compare event of the 
+ * previous phase (see p33c_PwmGenerator_SyncGeneratorsRoute()). PGxTRIGA of phase #k
+ * is set to the phase shift round(k * PER / N) - round((k-1) * PER / N), so phase
+ * #k starts round((k-1) * PER / N) after phase #1. Rounding errors do not add up 
+ * across the chain. The propagation delay of the sync route (see 
+ * P33C_PWM_SYNC_ROUTE_s) is subtracted from PGxTRIGA of the previous phase. All 
+ * phases have to be members of the same PWM group (PG1-PG4 or PG5-PG8): across
+ * groups, the PCI Sync function carries the PWM output of the previous phase 
+ * instead of its PGxTRIGA event. PGxPHASE is not used for the phase shift, as it only delays 
+ * the rising edge within the own PWM cycle and would truncate the on-time of 
+ * later phases at high duty ratios.
+ * 
+ * The slope start and stop signals of every DAC instance are routed to PWM 
+ * Trigger 1 (PGxTRIGB) and PWM Trigger 2 (PGxTRIGC) of the PWM generator of its 
+ * own phase, so every ramp is shifted together with its phase. Phases with DAC 
+ * instance 0 are operated without slope compensation (e.g. when the device has
+ * less DAC instances than phases).
+ * 
+ * Phase current balancing is implemented by a hook function called by
+ * PHASE_Update() before the DAC levels are written. It adds a per-phase trim to 
+ * the common DAC level (peak current reference) of all phases.
+ * ********************************************************************************/
+
+#define PHASE_COUNT_MAX         4U      // Maximum number of phases
+#define PHASE_TRIGGER_OUTPUT    1U      // Sync trigger output of the previous phase: PGxTRIGA
+#define PHASE_TRIM_MAX          128     // Maximum phase current balancing trim in [DAC ticks]
+#define PHASE_BALANCE_SHIFT     4       // Integral gain of the current balancing as 2^-n [DAC ticks per ADC tick and update]
+
+// Slope start/stop signal selection codes of the PWM Trigger 1/2 outputs of PWM generator 'pg'
+#if defined (__MA330049_dsPIC33CH_DPPIM__)
+#define PHASE_SLPSTRT(pg)       (pg)            // SLPSTRT: PWMx Trigger 1
+#define PHASE_SLPSTOPA(pg)      ((pg) + 4U)     // SLPSTOPA: PWMx Trigger 2
+#else
+#define PHASE_SLPSTRT(pg)       (pg)            // SLPSTRT: PWMx Trigger 1
+#define PHASE_SLPSTOPA(pg)      (pg)            // SLPSTOPA: PWMx Trigger 2
+#endif
+
+/* Phase assignment table entry */
+struct PHASE_CONFIG_s {
+    uint16_t pg;        // PWM generator instance (1 = PG1, 2 = PG2, etc.)
+    uint16_t dac;       // DAC instance of the slope compensation (1 = DAC1, 2 = DAC2, etc., 0 = none)
+};
+typedef struct PHASE_CONFIG_s PHASE_CONFIG_t;
+
+/* Phase object */
+struct PHASE_s {
+    volatile struct P33C_PWM_GENERATOR_s* pg;   // PWM generator of this phase
+    volatile struct P33C_DAC_INSTANCE_s* dac;   // DAC instance of this phase (NULL = none)
+    uint16_t pg_instance;   // PWM generator instance
+    uint16_t dac_instance;  // DAC instance (0 = none)
+    uint16_t shift;         // Start of cycle delay from phase #1 in [PWM ticks]
+    uint16_t current;       // Phase current sample provided by the user in [ADC ticks]
+    int32_t balance;        // Integrator of the current balancing in [DAC ticks << PHASE_BALANCE_SHIFT]
+    int16_t trim;           // DAC level trim of this phase in [DAC ticks]
+    struct P33C_PWM_SYNC_ROUTE_s sync; // Sync route from the previous phase (phase #1: none)
+};
+typedef struct PHASE_s PHASE_t;
+
+struct PHASE_MANAGER_s;
+typedef void (*PHASE_BALANCE_HOOK_t)(struct PHASE_MANAGER_s* mgr); // Phase current balancing hook
+
+/* Phase manager object */
+struct PHASE_MANAGER_s {
+    uint16_t count;         // Number of phases
+    uint16_t period;        // Common PWM period in [PWM ticks]
+    uint16_t duty;          // Common duty cycle of the most recent update in [PWM ticks]
+    uint16_t level;         // Common DAC level of the most recent update in [DAC ticks]
+    PHASE_BALANCE_HOOK_t balance; // Phase current balancing hook (NULL = none)
+    struct PHASE_s phase[PHASE_COUNT_MAX]; // Phase objects
+};
+typedef struct PHASE_MANAGER_s PHASE_MANAGER_t;
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern volatile uint16_t PHASE_Initialize(struct PHASE_MANAGER_s* mgr, 
+                    const struct PHASE_CONFIG_s* config, uint16_t count,
+                    const struct P33C_PWM_GENERATOR_s* pgTemplate,
+                    const struct P33C_DAC_INSTANCE_s* dacTemplate);
+extern volatile uint16_t PHASE_Enable(struct PHASE_MANAGER_s* mgr);
+extern volatile uint16_t PHASE_Disable(struct PHASE_MANAGER_s* mgr);
+extern volatile uint16_t PHASE_Update(struct PHASE_MANAGER_s* mgr, uint16_t duty, uint16_t level);
+extern void PHASE_BalanceCurrents(struct PHASE_MANAGER_s* mgr);
+
+
+#endif	/* XC_PHASE_MANAGER_H */
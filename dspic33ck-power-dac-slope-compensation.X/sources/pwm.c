@@ -35,15 +35,128 @@
 
 #include "config/demo.h"
 #include "pwm.h"
+#include "timing.h"
+#include "common/p33c_profile.h"
+#include "boot.h"
 
 /* Declaration of user-defined PWM instance */
 volatile struct P33C_PWM_GENERATOR_s* my_pg1 ;    // user-defined PWM generator 1 object 
 
+/* Declaration of the control loop object */
+struct PWM_CONTROL_s pwm_ctrl;
+
+/* Enable request of the user-defined PWM instance */
+struct P33C_PWM_ENABLE_s pwm_enable;
+
+/* @@_ADCAN0Interrupt
+ * ********************************************************************************
+ * Summary:
+ *     Control loop interrupt service routine executed by the PWM-triggered
+ *     conversion of the feedback signal
+ * 
+ * Description:
+ *     The ADC conversion is started by PWM ADC Trigger 1 (PGxTRIGB) of every 
+ *     switching cycle. This routine reads the result, integrates the error 
+ *     against the reference and writes the new DAC level and duty cycle limit
+ *     directly into DACxDATH and PGxDC. Both register sets are accessed through
+ *     their constant addresses, no driver function is called. The PWM update 
+ *     request is set within the switching cycle of the trigger and becomes
+ *     effective at the next start of cycle.
+ * 
+ *     The latency from the ADC trigger to the register update is the fixed 
+ *     conversion and interrupt entry latency plus the execution time measured 
+ *     with Timer1. Updates later than the end of the switching cycle are 
+ *     counted as deadline misses. While the control loop is disabled only the
+ *     sample acquisition is executed and measured.
+ * 
+ *     While the control loop is enabled (pwm_ctrl.enable), this routine is the
+ *     only writer of PGxDC, DACxDATH and UPDREQ of the controlled PWM generator 
+ *     and DAC instance. TIMING_Commit() and PHASE_Update() pass a new duty cycle
+ *     limit through pwm_ctrl.duty instead of writing these registers. The 
+ *     adaptive slope controller passes the amplitude of the compensation ramp
+ *     until the expected turn-off time through pwm_ctrl.ramp, which is added to
+ *     the integrated peak current reference to obtain the ramp start level.
+ * 
+ *     The execution counter pwm_ctrl.count is incremented after all registers
+ *     have been written. Telemetry frames are not written by this routine; 
+ *     the 1 ms telemetry task reads the register snapshot of the most recent 
+ *     execution using this counter (see TELEMETRY_Record()), so the execution
+ *     time and latency of the control loop are independent of the stream.
+ * 
+ * ********************************************************************************/
+
+#if defined (__P33C_HOST__)
+void _ADCAN0Interrupt(void)
+#else
+void __attribute__((__interrupt__, no_auto_psv)) _ADCAN0Interrupt(void)
+#endif
+{
+    uint16_t t_entry, t_exit, level;
+    uint32_t latency;
+    int32_t integrator;
+    
+    t_entry = TMR1;
+    
+    pwm_ctrl.sample = ADCBUF0; // Reading the buffer clears the data ready flag
+    
+    if (pwm_ctrl.enable)
+    {
+        // Integrate the error and limit the DAC level to its valid range
+        integrator = pwm_ctrl.integrator + ((int16_t)pwm_ctrl.reference - (int16_t)pwm_ctrl.sample);
+        if (integrator > ((int32_t)CONTROL_DAC_MAX << CONTROL_KI_SHIFT))
+            integrator = ((int32_t)CONTROL_DAC_MAX << CONTROL_KI_SHIFT);
+        else if (integrator < ((int32_t)CONTROL_DAC_MIN << CONTROL_KI_SHIFT))
+            integrator = ((int32_t)CONTROL_DAC_MIN << CONTROL_KI_SHIFT);
+        pwm_ctrl.integrator = integrator;
+        
+        // Update DAC level (ramp start level) and duty cycle limit of the next switching cycle
+        level = (uint16_t)(integrator >> CONTROL_KI_SHIFT) + pwm_ctrl.ramp;
+        if (level > CONTROL_DAC_MAX)
+            level = CONTROL_DAC_MAX;
+        PWM_CONTROL_DAC->DACxDATH.value = level;
+        PWM_CONTROL_PG->PGxDC.value = pwm_ctrl.duty;
+        PWM_CONTROL_PG->PGxSTAT.bits.UPDREQ = 1;
+    }
+    
+    t_exit = TMR1;
+    if (t_exit < t_entry) // Timer1 period rollover
+        t_exit += (PR1 + 1);
+    
+    pwm_ctrl.exec_time = (t_exit - t_entry);
+    latency = CONTROL_LATENCY + ((uint32_t)pwm_ctrl.exec_time * TIMING_PWM_TICKS_PER_TCY);
+    if (latency > CONTROL_DEADLINE) 
+    {
+        pwm_ctrl.deadline_miss++;
+        latency = CONTROL_DEADLINE;
+    }
+    pwm_ctrl.latency = (uint16_t)latency;
+    if (pwm_ctrl.latency > pwm_ctrl.latency_max)
+        pwm_ctrl.latency_max = pwm_ctrl.latency;
+    pwm_ctrl.count++;
+    
+    _ADCAN0IF = 0;
+}
+
+
+/* Initializes the control loop with the default operating point (output disabled) */
+static void PWM_ControlReset(void)
+{
+    pwm_ctrl.enable = false;
+    pwm_ctrl.reference = CONTROL_REFERENCE;
+    pwm_ctrl.duty = PWM_DUTY_CYCLE;
+    pwm_ctrl.ramp = 0;
+    pwm_ctrl.integrator = ((int32_t)DACOUT_VALUE_HIGH_1 << CONTROL_KI_SHIFT);
+    pwm_ctrl.latency_max = 0;
+    pwm_ctrl.deadline_miss = 0;
+    pwm_ctrl.count = 0;
+}
 
 volatile uint16_t PWM_Initialize(void) {
     
     volatile uint16_t retval=1;
 
+    BOOT_STAGE_BEGIN(BOOT_STAGE_PWM);
+
     // Default PWM Initialization for 500 MHz input clock from AUX PLL
     retval &= p33c_PwmModule_Initialize();
 
@@ -51,7 +164,7 @@ volatile uint16_t PWM_Initialize(void) {
     my_pg1 = p33c_PwmGenerator_GetHandle(PWM_GENERATOR);
    
     // Reset PGx SFRs to RESET conditions
-    retval &= p33c_PwmGenerator_ConfigWrite(PWM_GENERATOR, pgConfigClear);
+    retval &= p33c_PwmGenerator_ConfigWriteRef(PWM_GENERATOR, &pgConfigClear);
   
     
     // Set individual PWM generator configuration for PG1
@@ -77,6 +190,7 @@ volatile uint16_t PWM_Initialize(void) {
     // PGxEVTL: PWM GENERATOR EVENT REGISTER LOW
     my_pg1->PGxEVTL.bits.PGTRGSEL = 0b000; // No PWM Generator Trigger Output
     my_pg1->PGxEVTL.bits.ADTR1EN2 = 1;     // PG1TRIGB register compare event is enabled  as trigger source for Start of Slope Start Signal
+                                           // and the control loop ADC conversion (see adc.c)
     
     /* PGxEVTH: PWM GENERATOR  EVENT REGISTER HIGH */
     my_pg1->PGxEVTH.bits.ADTR2EN3 = 1;     // PG1TRIGC register compare event is enabled as trigger source for Slope Stop A Signal
@@ -134,20 +248,136 @@ volatile uint16_t PWM_Initialize(void) {
     
     #endif
 
-    // Check return value
-    retval &= (bool)(my_pg1->PGxCONL.bits.ON) &&         // Check if PWM generator is turned on
-                   (!my_pg1->PGxIOCONL.bits.OVRENH);  
+    // Initialize the control loop with the default operating point (output disabled)
+    PWM_ControlReset();
+    
+    // Host model: module and generator register sets, 14 bit fields and 6 values written
+    BOOT_HOST_WRITES(BOOT_REGSET_WRITES(struct P33C_PWM_MODULE_s) + BOOT_REGSET_WRITES(struct P33C_PWM_GENERATOR_s) + 20U);
     
+    // Check return value: the generator is configured, but remains turned off with its
+    // outputs overridden until PWM_Enable() is called
+    retval &= (bool)(!my_pg1->PGxCONL.bits.ON) &&        // Check if PWM generator is turned off
+                   (my_pg1->PGxCONL.bits.HREN) &&       // Check if High-Resolution mode is configured
+                   (my_pg1->PGxIOCONL.bits.OVRENH);     // Check if PWMxH output is overridden
+    
+    BOOT_STAGE_END(BOOT_STAGE_PWM);
+
     return(retval); // Return 1=success, 0=failure
     
 }
 
-volatile uint16_t PWM_Enable(void) {
+/* @@PWM_Restore
+ * ********************************************************************************
+ * Summary:
+ *     Applies a retained PWM module and PWM generator configuration
+ * 
+ * Parameters:
+ *     const struct P33C_PWM_MODULE_s* module: PWM module register set
+ *     const struct P33C_PWM_GENERATOR_s* config: Register set of the user PWM generator
+ * 
+ * Returns:
+ *     0 = failure
+ *     1 = success
+ * 
+ * Description:
+ *     The register sets captured after PWM_Initialize() on a previous cold boot
+ *     are written with one block write each, replacing PWM_Initialize() on the 
+ *     warm restart path (see boot.c). The control loop is reset to its default
+ *     operating point. The generator is turned on by PWM_Enable().
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PWM_Restore(const struct P33C_PWM_MODULE_s* module, const struct P33C_PWM_GENERATOR_s* config) {
 
     volatile uint16_t retval=1;
 
-    // Enable PWM generators with outputs DISABLED
-    retval &= p33c_PwmGenerator_Enable(my_pg1); 
+    BOOT_STAGE_BEGIN(BOOT_STAGE_PWM);
+
+    retval &= p33c_PwmModule_ConfigWriteRef(module);
+
+    my_pg1 = p33c_PwmGenerator_GetHandle(PWM_GENERATOR);
+    retval &= p33c_PwmGenerator_ConfigWriteRef(PWM_GENERATOR, config);
+
+    PWM_ControlReset();
+
+    BOOT_HOST_WRITES(BOOT_REGSET_WRITES(struct P33C_PWM_MODULE_s) + BOOT_REGSET_WRITES(struct P33C_PWM_GENERATOR_s));
+
+    BOOT_STAGE_END(BOOT_STAGE_PWM);
+
+    return(retval); // Return 1=success, 0=failure
+
+}
+
+// Completion callback of the PWM generator enable request
+static void PWM_EnableDone(struct P33C_PWM_ENABLE_s* request) {
+    
+    (void)request;
+    BOOT_STAGE_END(BOOT_STAGE_HRRDY);
+    
+}
+
+/* @@PWM_EnableStart
+ * ********************************************************************************
+ * Summary:
+ *     Turns on the user PWM generator without waiting for the PWM clock
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure
+ *     1 = success, generator turned on with outputs DISABLED
+ * 
+ * Description:
+ *     The high resolution PWM clock becomes ready while other peripherals are
+ *     initialized. PWM_EnableWait() completes the enable sequence.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PWM_EnableStart(void) {
+
+    volatile uint16_t retval=1;
+
+    // Enable PWM generator with outputs DISABLED
+    BOOT_STAGE_BEGIN(BOOT_STAGE_HRRDY);
+    retval &= p33c_PwmGenerator_EnableStart(&pwm_enable, my_pg1, 
+                    P33C_PWM_ENABLE_TIMEOUT_US, &PWM_EnableDone); 
+    
+    return(retval); // Return 1=success, 0=failure
+
+}
+
+/* @@PWM_EnableWait
+ * ********************************************************************************
+ * Summary:
+ *     Completes the enable sequence started by PWM_EnableStart()
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, high resolution PWM clock not ready within P33C_PWM_ENABLE_TIMEOUT_US
+ *     1 = success
+ * 
+ * Description:
+ *     Waits for the completion of the enable request and enables the PWM 
+ *     generator outputs. The outputs are not released when the request has
+ *     ended in a timeout or a clock error. The boot time is updated by every 
+ *     poll, as the system clock switch may complete during the wait.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t PWM_EnableWait(void) {
+
+    volatile uint16_t retval=1;
+
+    // Wait for the high resolution PWM clock, keeping track of the boot time across the clock switch
+    while (p33c_PwmGenerator_EnablePoll(&pwm_enable) == P33C_PWM_ENABLE_PENDING)
+        BOOT_Mark();
+    
+    // Outputs remain overridden and owned by the I/O module after a timeout or clock error
+    if (pwm_enable.state != P33C_PWM_ENABLE_READY)
+        return(0);
     
     Nop(); // Place breakpoint to review PWM configuration
     Nop(); // using the Watch Window
@@ -160,5 +390,16 @@ volatile uint16_t PWM_Enable(void) {
 
 }
 
+volatile uint16_t PWM_Enable(void) {
+
+    volatile uint16_t retval=1;
+
+    retval &= PWM_EnableStart();
+    retval &= PWM_EnableWait();
+    
+    return(retval); // Return 1=success, 0=failure
+
+}
+
 // ________________________
 // end of file
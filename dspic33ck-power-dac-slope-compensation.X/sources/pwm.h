@@ -35,6 +35,7 @@
 #include <xc.h> // include processor files - each processor file is guarded.  
 
 #include "common/p33c_pwm.h" // Include dsPIC33C standard PWM driver header file
+#include "common/p33c_dac.h" // Include dsPIC33C standard DAC driver header file
 
 
  /* *********************************************************************************
@@ -52,12 +53,53 @@ extern volatile struct P33C_PWM_GENERATOR_s* my_pg3; // pointer to user-defined
   #pragma message "specified PWM generator peripheral instance not available (out of range)"
 #endif
 
+/* *********************************************************************************
+ * CONTROL LOOP DECLARATIONS
+ * *********************************************************************************
+ * The control loop interrupt service routine is executed once per switching cycle
+ * when the ADC conversion triggered by PWM ADC Trigger 1 is complete. It writes the
+ * new DAC level and duty cycle limit directly into the DACxDATH and PGxDC registers 
+ * and requests the PWM update, which takes effect at the next start of cycle. 
+ * While the control loop is enabled it owns these registers and no TIMING 
+ * transactions must be committed.
+ * 
+ * Latencies are given in PWM ticks from the ADC trigger event. The conversion and 
+ * interrupt entry latency (CONTROL_LATENCY) is a fixed value derived from the ADC
+ * settings in demo.h, the execution time up to the register update is measured
+ * with Timer1.
+ * ********************************************************************************/
+
+#define PWM_CONTROL_PG      p33c_PwmGenerator_GetHandle(PWM_GENERATOR)  // Constant address of the controlled PWM generator
+#define PWM_CONTROL_DAC     p33c_DacInstance_GetHandle(DAC_INSTANCE)    // Constant address of the controlled DAC instance
+
+/* Control loop object */
+struct PWM_CONTROL_s {
+    volatile bool enable;       // Control loop output enable (0 = samples are acquired but not applied)
+    uint16_t reference;         // Feedback reference in [ADC ticks]
+    uint16_t duty;              // Duty cycle limit written to PGxDC in [PWM ticks] (set by TIMING_Commit(), PHASE_Update())
+    uint16_t ramp;              // Slope compensation ramp amplitude added to the DAC level in [DAC ticks] (set by SLOPECTRL_Update())
+    uint16_t sample;            // Most recent feedback sample in [ADC ticks]
+    int32_t integrator;         // Integrator of the DAC level in [DAC ticks << CONTROL_KI_SHIFT]
+    uint16_t exec_time;         // ISR entry to register update of the most recent cycle in [Timer1 counts]
+    uint16_t latency;           // ADC trigger to register update of the most recent cycle in [PWM ticks]
+    uint16_t latency_max;       // Maximum ADC trigger to register update latency in [PWM ticks]
+    uint16_t deadline_miss;     // Number of updates later than the end of the switching cycle
+    volatile uint16_t count;    // Number of executions, incremented after the register update (wraps around)
+};
+typedef struct PWM_CONTROL_s PWM_CONTROL_t;
+
+extern struct PWM_CONTROL_s pwm_ctrl;
+extern struct P33C_PWM_ENABLE_s pwm_enable;
+
 /* *********************************************************************************
  * USER FUNCTION PROTOTYPES
  * ********************************************************************************/    
     
 extern volatile uint16_t PWM_Initialize(void);
+extern volatile uint16_t PWM_Restore(const struct P33C_PWM_MODULE_s* module, const struct P33C_PWM_GENERATOR_s* config);
 extern volatile uint16_t PWM_Enable(void);
+extern volatile uint16_t PWM_EnableStart(void);
+extern volatile uint16_t PWM_EnableWait(void);
 extern volatile uint16_t PWM_Disable(void);
 
 extern volatile struct P33C_PWM_GENERATOR_s* my_pg1;    // user-defined PWM generator 1 object 
@@ -0,0 +1,289 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: sched.c 
+ * Comments: Tick-driven cooperative task scheduler based on the Timer1 period
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "sched.h"
+#include "common/p33c_profile.h"
+
+struct SCHED_s sched; // Scheduler object
+
+/* @@_T1Interrupt
+ * ********************************************************************************
+ * Summary:
+ *     Timer1 interrupt service routine advancing the scheduler tick
+ * 
+ * Description:
+ *     The interrupt service routine only increments the tick counter. All tasks
+ *     are executed from the main loop by SCHED_Execute().
+ * 
+ * ********************************************************************************/
+
+#if defined (__P33C_HOST__)
+void _T1Interrupt(void)
+#else
+void __attribute__((__interrupt__, no_auto_psv)) _T1Interrupt(void)
+#endif
+{
+    sched.tick++;
+    _T1IF = 0;
+}
+
+/* @@SCHED_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Initializes the task scheduler with a user task table
+ * 
+ * Parameters:
+ *     struct SCHED_TASK_s* tasks:
+ *          Pointer to the task table
+ *     uint16_t count:
+ *          Number of tasks in the task table
+ * 
+ * Returns:
+ *     0 = failure, the task table is invalid
+ *     1 = success, the scheduler has been initialized
+ * 
+ * Description:
+ *     Tasks are executed in the order of the task table. Each task is called
+ *     for the first time in tick #(offset + 1) after SCHED_Start() and then 
+ *     every <period> ticks. All execution time statistics are cleared.
+ *     Timer1 must have been initialized by TMR1_Initialize().
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t SCHED_Initialize(struct SCHED_TASK_s* tasks, uint16_t count)
+{
+    uint16_t i;
+    
+    if ((tasks == NULL) || (count == 0))
+        return(0);
+
+    for (i = 0; i < count; i++)
+    {
+        if ((tasks[i].function == NULL) || (tasks[i].period == 0) || 
+            (tasks[i].offset >= tasks[i].period))
+            return(0);
+        
+        tasks[i].countdown = tasks[i].offset + 1;
+        tasks[i].calls     = 0;
+        tasks[i].exec_time = 0;
+        tasks[i].exec_max  = 0;
+        tasks[i].overruns  = 0;
+        tasks[i].skipped   = 0;
+    }
+    
+    sched.task      = tasks;
+    sched.count     = count;
+    sched.tick      = 0;
+    sched.tick_done = 0;
+    sched.busy_time = 0;
+    sched.busy_max  = 0;
+    sched.overruns  = 0;
+    sched.missed    = 0;
+    
+    return(1);
+}
+
+/* @@SCHED_Start
+ * ********************************************************************************
+ * Summary:
+ *     Enables the Timer1 interrupt generating the scheduler tick
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, Timer1 is not running
+ *     1 = success, the scheduler tick is running
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t SCHED_Start(void)
+{
+    _T1IP = SCHED_ISR_PRIORITY;
+    _T1IF = 0;
+    _T1IE = 1;
+
+    return((uint16_t)(T1CONbits.TON));
+}
+
+/* @@SCHED_GetTime
+ * ********************************************************************************
+ * Summary:
+ *     Captures a consistent pair of tick counter and Timer1 count
+ * 
+ * Description:
+ *     The tick counter is read before and after Timer1 and the capture is 
+ *     repeated when the Timer1 interrupt has incremented it in between. A
+ *     Timer1 period match whose interrupt has not been serviced yet (interrupt
+ *     latency) is detected by the pending interrupt flag and counted as tick.
+ * 
+ * ********************************************************************************/
+
+static inline void SCHED_GetTime(uint16_t* tick, uint16_t* tmr)
+{
+    uint16_t first, pending;
+    
+    do {
+        first = sched.tick;
+        *tmr = TMR1;
+        pending = _T1IF;
+        *tick = sched.tick;
+    } while (*tick != first);
+    
+    if ((pending) && (*tmr < (PR1 >> 1)))
+        (*tick)++; // Timer1 has rolled over, tick not yet counted by the ISR
+    
+    return;
+}
+
+/* @@SCHED_GetElapsed
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the time elapsed since a Timer1 count captured in a given tick
+ * 
+ * ********************************************************************************/
+
+static inline uint16_t SCHED_GetElapsed(uint16_t tick, uint16_t tmr)
+{
+    uint16_t tick_now, tmr_now;
+    int32_t elapsed;
+    
+    SCHED_GetTime(&tick_now, &tmr_now);
+    elapsed = (int32_t)(uint16_t)(tick_now - tick) * ((int32_t)PR1 + 1L);
+    elapsed = elapsed + (int32_t)tmr_now - (int32_t)tmr;
+    
+    if (elapsed < 0) return(0);
+    return((elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed);
+}
+
+/* @@SCHED_Execute
+ * ********************************************************************************
+ * Summary:
+ *     Waits for the next scheduler tick and executes all tasks due in this tick
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, tasks of this tick have not been completed within the tick period
+ *     1 = success
+ * 
+ * Description:
+ *     While waiting for the next tick, the CPU enters the low-power mode 
+ *     selected by SCHED_IDLE_HOOK(). The CPU priority is raised while the 
+ *     tick counter is checked, so the Timer1 interrupt cannot occur between 
+ *     the check and the power-saving instruction; it wakes up the CPU and is 
+ *     serviced after the CPU priority has been restored.
+ * 
+ *     When more than one tick has elapsed since the most recent call, tasks
+ *     are executed only once and calls missed in between are counted as
+ *     skipped. Execution time, overrun and missed tick accounting allow to
+ *     monitor the remaining headroom of each tick.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t SCHED_Execute(void)
+{
+    struct SCHED_TASK_s* task;
+    uint16_t i, tick, elapsed, lag, tmr_tick, tick_start, tmr_task, tick_task;
+    #if !defined (__P33C_HOST__)
+    uint16_t ipl;
+    #endif
+    
+    if (sched.task == NULL)
+        return(0);
+
+    // Wait for the next tick in low-power mode
+    while (sched.tick == sched.tick_done)
+    {
+        #if defined (__P33C_HOST__)
+        SCHED_IDLE_HOOK();
+        #else
+        ipl = SRbits.IPL;
+        SRbits.IPL = 7;
+        if (sched.tick == sched.tick_done)
+            SCHED_IDLE_HOOK();
+        SRbits.IPL = ipl;
+        #endif
+    }
+
+    P33C_PROFILE_BEGIN(P33C_PROFILE_MAIN_LOOP);
+    SCHED_GetTime(&tick_start, &tmr_tick);
+    tick = sched.tick;
+    elapsed = (uint16_t)(tick - sched.tick_done);
+    sched.tick_done = tick;
+    if (elapsed > 1)
+        sched.missed += (elapsed - 1);
+    
+    // Execute all tasks due in this tick
+    for (i = 0; i < sched.count; i++)
+    {
+        task = &sched.task[i];
+        
+        if (task->countdown > elapsed)
+        {
+            task->countdown -= elapsed;
+            continue;
+        }
+        
+        lag = (elapsed - task->countdown);
+        if (lag >= task->period)
+        {
+            task->skipped += (lag / task->period);
+            lag = (lag % task->period);
+        }
+        task->countdown = (task->period - lag);
+
+        SCHED_GetTime(&tick_task, &tmr_task);
+        task->function();
+        task->exec_time = SCHED_GetElapsed(tick_task, tmr_task);
+        
+        task->calls++;
+        if (task->exec_time > task->exec_max)
+            task->exec_max = task->exec_time;
+        if (sched.tick != tick_task)
+            task->overruns++;
+    }
+    
+    sched.busy_time = SCHED_GetElapsed(tick_start, tmr_tick);
+    P33C_PROFILE_END(P33C_PROFILE_MAIN_LOOP);
+    if (sched.busy_time > sched.busy_max)
+        sched.busy_max = sched.busy_time;
+
+    if (sched.tick != tick)
+    {
+        sched.overruns++;
+        return(0);
+    }
+    
+    return(1);
+}
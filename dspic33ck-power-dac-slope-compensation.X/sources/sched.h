@@ -0,0 +1,96 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: sched.h 
+ * Comments: Header file of the cooperative task scheduler source file sched.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_TASK_SCHEDULER_H
+#define	XC_TASK_SCHEDULER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+ /* *********************************************************************************
+ * TASK SCHEDULER DECLARATIONS
+ * *********************************************************************************
+ * The scheduler tick is the Timer1 period set by TMR1_Initialize() (100 us). Task 
+ * rates are given as multiples of this tick. Execution times are measured in Timer1 
+ * counts (instruction cycles, 10 ns at 100 MIPS).
+ * ********************************************************************************/
+
+#define SCHED_TICK_PERIOD_US    100U    // Scheduler tick period in [us] (Timer1 period)
+#define SCHED_RATE_100US        1U      // Task period of 100 us in [ticks]
+#define SCHED_RATE_1MS          10U     // Task period of 1 ms in [ticks]
+#define SCHED_RATE_10MS         100U    // Task period of 10 ms in [ticks]
+#define SCHED_ISR_PRIORITY      1U      // Timer1 interrupt priority level
+
+#ifndef SCHED_IDLE_HOOK
+#define SCHED_IDLE_HOOK()       Idle()  // Low-power hook executed while waiting for the next tick
+#endif
+
+typedef void (*SCHED_TASK_f)(void); // Task function prototype
+
+/* Task descriptor */
+struct SCHED_TASK_s {
+    SCHED_TASK_f function;  // Task function
+    uint16_t period;        // Task period in [ticks]
+    uint16_t offset;        // Tick offset of the first call (0 ... period-1), used to distribute tasks of equal rate
+    uint16_t countdown;     // Number of ticks until the next call
+    uint16_t calls;         // Number of calls (wraps around)
+    uint16_t exec_time;     // Execution time of the most recent call in [Timer1 counts]
+    uint16_t exec_max;      // Maximum execution time in [Timer1 counts]
+    uint16_t overruns;      // Number of calls which have not been completed within the tick they were started in
+    uint16_t skipped;       // Number of calls which have been dropped due to missed ticks
+};
+typedef struct SCHED_TASK_s SCHED_TASK_t;
+
+/* Scheduler object */
+struct SCHED_s {
+    struct SCHED_TASK_s* task;  // Pointer to the task table
+    uint16_t count;         // Number of tasks in the task table
+    volatile uint16_t tick; // Tick counter incremented by the Timer1 interrupt service routine
+    uint16_t tick_done;     // Most recent tick processed by the scheduler
+    uint16_t busy_time;     // Execution time of all tasks of the most recent tick in [Timer1 counts]
+    uint16_t busy_max;      // Maximum execution time of all tasks of one tick in [Timer1 counts]
+    uint16_t overruns;      // Number of ticks whose tasks have not been completed within the tick period
+    uint16_t missed;        // Number of ticks which have elapsed without being processed
+};
+typedef struct SCHED_s SCHED_t;
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern struct SCHED_s sched;
+
+extern volatile uint16_t SCHED_Initialize(struct SCHED_TASK_s* tasks, uint16_t count);
+extern volatile uint16_t SCHED_Start(void);
+extern volatile uint16_t SCHED_Execute(void);
+
+
+#endif	/* XC_TASK_SCHEDULER_H */
@@ -0,0 +1,133 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: slope.c 
+ * Comments: Runtime fixed-point conversion of slew rates and voltages into DAC register values
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "slope.h"
+
+/* @@SLOPE_Scale
+ * ********************************************************************************
+ * Summary:
+ *     Multiplies a Q15 input value by a Q16.16 gain and rounds the result
+ * 
+ * Parameters:
+ *     uint16_t input:
+ *          Unsigned Q15 input value (0x0000 ... 0x7FFF)
+ *     uint32_t gain:
+ *          Unsigned Q16.16 gain in [output ticks] per full scale input
+ * 
+ * Returns:
+ *     uint16_t: rounded output value (saturated to 0xFFFF, 0 for negative inputs)
+ * 
+ * Description:
+ *     This function calculates round(input * gain / 2^31) with the rounding 
+ *     direction of ties going up. The 16x32 bit product is split into two 
+ *     16x16 bit hardware multiplications. The rounding offset is added to the 
+ *     low partial product before it is shifted, which makes the result 
+ *     identical to the one of a full-width 48-bit calculation. 
+ * 
+ *     The function has no loops and only one data dependent branch for 
+ *     saturation, hence its execution time is constant for all input values.
+ * 
+ * ********************************************************************************/
+
+uint16_t SLOPE_Scale(uint16_t input, uint32_t gain)
+{
+    uint32_t p_hi, p_lo;
+    
+    if (input & 0x8000) // Negative Q15 numbers are clamped to zero
+        return(0);
+    
+    p_lo = SLOPE_MULUU(input, (uint16_t)(gain & 0xFFFF));
+    p_hi = SLOPE_MULUU(input, (uint16_t)(gain >> 16));
+    p_hi += ((p_lo + 0x40000000UL) >> 16);
+    p_hi >>= 15;
+    
+    if (p_hi > 0xFFFF) // Saturate to register width
+        return(0xFFFF);
+    
+    return((uint16_t)p_hi);
+}
+
+/* @@SLOPE_GetSlopeData
+ * ********************************************************************************
+ * Summary:
+ *     Converts a slew rate into a SLPxDAT register value
+ * 
+ * Parameters:
+ *     uint16_t slew_rate:
+ *          Slew rate as unsigned Q15 number of SLOPE_SLEW_RATE_FS_MV_US
+ * 
+ * Returns:
+ *     uint16_t: SLPxDAT register value
+ * 
+ * Description:
+ *     The result is equivalent to the compile-time values SLP_SLEW_RATE_1/2
+ *     declared in demo.h.
+ * 
+ * ********************************************************************************/
+
+uint16_t SLOPE_GetSlopeData(uint16_t slew_rate)
+{
+    return(SLOPE_Scale(slew_rate, SLOPE_SLEW_RATE_GAIN));
+}
+
+/* @@SLOPE_GetDacData
+ * ********************************************************************************
+ * Summary:
+ *     Converts a voltage into a DACxDATH/DACxDATL register value
+ * 
+ * Parameters:
+ *     uint16_t voltage:
+ *          Voltage as unsigned Q15 number of SLOPE_VOLTAGE_FS_MV
+ * 
+ * Returns:
+ *     uint16_t: DAC data register value (saturated to DAC resolution)
+ * 
+ * Description:
+ *     The result is equivalent to the compile-time values DACOUT_VALUE_HIGH_1/2
+ *     declared in demo.h.
+ * 
+ * ********************************************************************************/
+
+uint16_t SLOPE_GetDacData(uint16_t voltage)
+{
+    uint16_t value;
+    
+    value = SLOPE_Scale(voltage, SLOPE_VOLTAGE_GAIN);
+    
+    if (value > (DAC_FULL_SCALE - 1)) // Saturate to DAC resolution
+        value = (DAC_FULL_SCALE - 1);
+    
+    return(value);
+}
+
+// ________________________
+// end of file
@@ -0,0 +1,90 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: slope.h 
+ * Comments: Header file of the runtime slope compensation calculator source file slope.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_SLOPE_CALCULATOR_H
+#define	XC_SLOPE_CALCULATOR_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+
+ /* *********************************************************************************
+ * RUNTIME SLOPE CALCULATOR DECLARATIONS
+ * *********************************************************************************
+ * Input values are unsigned Q15 numbers (0x0000 = 0.0, 0x7FFF = 0.99997) scaled to
+ * the full scale values declared below. Gains are given in unsigned Q16.16 format
+ * in [register ticks] per full scale input and are derived from the demo.h 
+ * settings using the same relationships as the compile-time register values.
+ * ********************************************************************************/
+
+#define SLOPE_SLEW_RATE_FS_MV_US    1000    // Full scale of Q15 slew rate input values in [mV/us]
+#define SLOPE_VOLTAGE_FS_MV         DAC_REFERENCE_MV // Full scale of Q15 voltage input values in [mV]
+
+#if ((DAC_CLOCK_FREQUENCY % 1000000) != 0)
+  #error "DAC clock frequency must be an integer multiple of 1 MHz"
+#endif
+
+// SLPxDAT ticks per full scale slew rate = 16 * FS [V/us] / DAC granularity [V/tick] * DAC clock period [us]
+#define SLOPE_SLEW_RATE_GAIN_RAW    DEMO_DIV(65536LL * 16 * SLOPE_SLEW_RATE_FS_MV_US * DAC_FULL_SCALE * DAC_CLOCK_DIVIDER, \
+                                        1LL * DAC_REFERENCE_MV * (DAC_CLOCK_FREQUENCY / 1000000))
+// DACxDATH ticks per full scale voltage = FS [V] / DAC granularity [V/tick]
+#define SLOPE_VOLTAGE_GAIN_RAW      DEMO_DIV(65536LL * SLOPE_VOLTAGE_FS_MV * DAC_FULL_SCALE, 1LL * DAC_REFERENCE_MV)
+
+#if ((SLOPE_SLEW_RATE_GAIN_RAW < 1) || (SLOPE_SLEW_RATE_GAIN_RAW > 0xFFFFFFFF))
+  #error "slew rate gain out of range; please check SLOPE_SLEW_RATE_FS_MV_US"
+#endif
+#if ((SLOPE_VOLTAGE_GAIN_RAW < 1) || (SLOPE_VOLTAGE_GAIN_RAW > 0xFFFFFFFF))
+  #error "voltage gain out of range; please check SLOPE_VOLTAGE_FS_MV"
+#endif
+
+#define SLOPE_SLEW_RATE_GAIN        ((uint32_t)SLOPE_SLEW_RATE_GAIN_RAW) // Q16.16 SLPxDAT ticks per full scale slew rate
+#define SLOPE_VOLTAGE_GAIN          ((uint32_t)SLOPE_VOLTAGE_GAIN_RAW)   // Q16.16 DACxDATH ticks per full scale voltage
+
+// Unsigned 16x16 bit hardware multiplication and 32/16 bit hardware division
+#if defined (__XC16__)
+  #define SLOPE_MULUU(a, b)         __builtin_muluu((a), (b))
+  #define SLOPE_DIVUD(a, b)         __builtin_divud((a), (b))
+#else
+  #define SLOPE_MULUU(a, b)         ((uint32_t)(uint16_t)(a) * (uint32_t)(uint16_t)(b))
+  #define SLOPE_DIVUD(a, b)         ((uint16_t)((uint32_t)(a) / (uint16_t)(b)))
+#endif
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern uint16_t SLOPE_Scale(uint16_t input, uint32_t gain);
+extern uint16_t SLOPE_GetSlopeData(uint16_t slew_rate);
+extern uint16_t SLOPE_GetDacData(uint16_t voltage);
+
+
+#endif	/* XC_SLOPE_CALCULATOR_H */
@@ -0,0 +1,214 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: slope_ctrl.c 
+ * Comments: Adaptive slope compensation based on input and output voltage feed-forward
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "slope_ctrl.h"
+
+/* @@SLOPECTRL_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Initializes the adaptive slope controller object
+ * 
+ * Parameters:
+ *     struct SLOPECTRL_s* ctrl:
+ *          Pointer to the adaptive slope controller object
+ * 
+ * Returns:
+ *     0 = failure, initializing the controller object was not successful
+ *     1 = success, initializing the controller object was successful
+ * 
+ * Description:
+ *     This function loads the active PWM timing and DAC slope settings of the 
+ *     user PWM generator and DAC instance into the transaction object of the 
+ *     controller. The peak current reference is set to the default DAC level 
+ *     DACOUT_VALUE_HIGH_1. PWM_Initialize() and DAC_Initialize() have to be 
+ *     called before this function.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t SLOPECTRL_Initialize(struct SLOPECTRL_s* ctrl)
+{
+    volatile uint16_t retval=1;
+    
+    if (ctrl == NULL)
+        return(0);
+    
+    retval &= TIMING_Load(&ctrl->trans);
+    
+    ctrl->reference = DACOUT_VALUE_HIGH_1;
+    ctrl->slope     = ctrl->trans.SLPxDAT;
+    ctrl->dac_high  = ctrl->trans.DACxDATH;
+    ctrl->ramp      = 0;
+    ctrl->ton       = 0;
+    
+    return(retval);
+}
+
+/* @@SLOPECTRL_Calculate
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the optimum slope compensation settings for the given operating point
+ * 
+ * Parameters:
+ *     struct SLOPECTRL_s* ctrl:
+ *          Pointer to the adaptive slope controller object
+ *     uint16_t vin:
+ *          Input voltage feedback as unsigned Q15 number of VIN_FEEDBACK_FS_MV
+ *     uint16_t vout:
+ *          Output voltage feedback as unsigned Q15 number of VOUT_FEEDBACK_FS_MV
+ * 
+ * Returns:
+ *     0 = settings are unchanged or ctrl is NULL
+ *     1 = settings have changed
+ * 
+ * Description:
+ *     The slope rate is set to half the inductor current down-slope (m2/2), 
+ *     which is proportional to the output voltage. The expected on-time is 
+ *     derived from the conversion ratio Vout/Vin (feed-forward) and used to 
+ *     raise the ramp start level DACxDATH by the ramp amplitude accumulated 
+ *     until the expected turn-off time. The ramp amplitude is calculated with
+ *     the selected SLPxDAT value, so the compensated peak current reference 
+ *     at the expected turn-off time stays at the value of ctrl->reference 
+ *     within 0.5 DAC ticks plus the ramp of one PWM tick of on-time 
+ *     quantization, independent of the slope rate. Compared to the ramp start
+ *     level of the exact m2/2 slope rate, the level additionally deviates by 
+ *     the SLPxDAT rounding error of up to 0.5 ticks accumulated across the ramp.
+ * 
+ *     This function only updates the controller object and does not access 
+ *     any peripheral registers. Its execution time is bounded: it uses two 
+ *     16x16 bit multiplications for the slope rate, one 16x16 bit 
+ *     multiplication and one 32/16 bit division for the on-time and one 
+ *     16x16 bit multiplication for the ramp amplitude.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t SLOPECTRL_Calculate(struct SLOPECTRL_s* ctrl, uint16_t vin, uint16_t vout)
+{
+    uint16_t slope, ton, ramp;
+    uint32_t num, drop;
+    
+    if (ctrl == NULL)
+        return(0);
+    
+    // Slope rate m2/2 proportional to output voltage
+    slope = SLOPE_Scale(vout, SLOPECTRL_SLEW_GAIN);
+    
+    // Expected on-time (limited to one PWM period)
+    num = SLOPE_MULUU(vout & 0x7FFF, SLOPECTRL_TON_GAIN);
+    if ((vin & 0x7FFF) == 0)
+        ton = PWM_PERIOD;
+    else if (num >= SLOPE_MULUU(vin & 0x7FFF, PWM_PERIOD))
+        ton = PWM_PERIOD;
+    else
+        ton = SLOPE_DIVUD(num, (vin & 0x7FFF));
+    
+    // Duration of the ramp until the expected turn-off time in [PWM ticks]
+    if (ton <= SLP_TRIG_START)
+        ramp = 0;
+    else if (ton >= SLP_TRIG_STOP)
+        ramp = (SLP_TRIG_STOP - SLP_TRIG_START);
+    else
+        ramp = (ton - SLP_TRIG_START);
+    
+    // Ramp amplitude in [DAC ticks] added to the peak current reference
+    drop = SLOPE_MULUU(slope, ramp);
+    drop = ((drop + (SLOPECTRL_RAMP_DIVIDER >> 1)) / SLOPECTRL_RAMP_DIVIDER);
+    if (drop > (DAC_FULL_SCALE - 1))
+        drop = (DAC_FULL_SCALE - 1);
+    ramp = (uint16_t)drop;
+    drop += ctrl->reference;
+    if (drop > (DAC_FULL_SCALE - 1))
+        drop = (DAC_FULL_SCALE - 1);
+    
+    ctrl->ton = ton;
+    
+    if ((slope == ctrl->slope) && ((uint16_t)drop == ctrl->dac_high) && (ramp == ctrl->ramp))
+        return(0);
+    
+    ctrl->slope = slope;
+    ctrl->dac_high = (uint16_t)drop;
+    ctrl->ramp = ramp;
+    
+    return(1);
+}
+
+/* @@SLOPECTRL_Update
+ * ********************************************************************************
+ * Summary:
+ *     Recalculates and applies the slope compensation settings
+ * 
+ * Parameters:
+ *     struct SLOPECTRL_s* ctrl:
+ *          Pointer to the adaptive slope controller object
+ *     uint16_t vin:
+ *          Input voltage feedback as unsigned Q15 number of VIN_FEEDBACK_FS_MV
+ *     uint16_t vout:
+ *          Output voltage feedback as unsigned Q15 number of VOUT_FEEDBACK_FS_MV
+ * 
+ * Returns:
+ *     0 = failure, applying the new settings was not successful
+ *     1 = success, the new settings are active or no changes were required
+ * 
+ * Description:
+ *     This function is called periodically with the most recent input and 
+ *     output voltage samples. When the slope rate or the ramp start level have 
+ *     changed, both values are applied together within one PWM cycle by the 
+ *     timing update transaction (see TIMING_Commit()).
+ * 
+ *     While the control loop is enabled (pwm_ctrl.enable), its interrupt service
+ *     routine is the only writer of DACxDATH and the ramp start level is not 
+ *     written by the transaction. Instead, the ramp amplitude is handed over to 
+ *     the control loop through pwm_ctrl.ramp and added to the integrated peak 
+ *     current reference from its next execution on.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t SLOPECTRL_Update(struct SLOPECTRL_s* ctrl, uint16_t vin, uint16_t vout)
+{
+    volatile uint16_t retval=1;
+
+    if (ctrl == NULL)
+        return(0);
+    
+    if (!SLOPECTRL_Calculate(ctrl, vin, vout))
+        return(1);
+    
+    ctrl->trans.SLPxDAT  = ctrl->slope;
+    ctrl->trans.DACxDATH = ctrl->dac_high;
+    
+    retval &= TIMING_Commit(&ctrl->trans);
+    pwm_ctrl.ramp = ctrl->ramp; // ramp start level offset of the control loop
+    
+    return(retval);
+}
+
+// ________________________
+// end of file
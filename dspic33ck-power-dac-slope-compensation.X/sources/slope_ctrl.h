@@ -0,0 +1,104 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: slope_ctrl.h 
+ * Comments: Header file of the adaptive slope compensation controller source file slope_ctrl.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_SLOPE_CONTROLLER_H
+#define	XC_SLOPE_CONTROLLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+#include "slope.h"
+#include "timing.h"
+
+ /* *********************************************************************************
+ * ADAPTIVE SLOPE CONTROLLER DECLARATIONS
+ * *********************************************************************************
+ * The optimum compensation ramp of a peak current mode converter has half the 
+ * inductor current down-slope m2 = Vout / L, translated into the current sense 
+ * signal domain by the current sense gain:
+ * 
+ *   slew rate [mV/us] = 0.5 * Vout [mV] * CURRENT_SENSE_GAIN [mV/A] / L [nH]
+ * 
+ * SLOPECTRL_SLEW_GAIN converts a Q15 output voltage feedback value directly into 
+ * SLPxDAT ticks (unsigned Q16.16 in [SLPxDAT ticks] per full scale feedback value).
+ * SLOPECTRL_TON_GAIN converts the ratio of the Q15 output and input voltage 
+ * feedback values into the expected on-time in [PWM ticks].
+ * ********************************************************************************/
+
+#define SLOPECTRL_SLEW_GAIN_RAW     DEMO_DIV(65536LL * VOUT_FEEDBACK_FS_MV * CURRENT_SENSE_GAIN_MV_A * 16 * \
+                                        DAC_FULL_SCALE * DAC_CLOCK_DIVIDER, \
+                                        2LL * POWER_STAGE_INDUCTANCE_NH * DAC_REFERENCE_MV * (DAC_CLOCK_FREQUENCY / 1000000))
+#define SLOPECTRL_TON_GAIN_RAW      DEMO_DIV(1LL * PWM_PERIOD_RAW * VOUT_FEEDBACK_FS_MV, 1LL * VIN_FEEDBACK_FS_MV)
+#define SLOPECTRL_PWM_PER_DAC_CLK   ((1LL * PWM_CLOCK * DAC_CLOCK_DIVIDER) / DAC_CLOCK_FREQUENCY) // PWM ticks per DAC clock period
+#define SLOPECTRL_VIN_NOMINAL_RAW   DEMO_DIV(32768LL * VIN_NOMINAL_MV, 1LL * VIN_FEEDBACK_FS_MV)
+#define SLOPECTRL_VOUT_NOMINAL_RAW  DEMO_DIV(32768LL * VOUT_NOMINAL_MV, 1LL * VOUT_FEEDBACK_FS_MV)
+
+#if ((SLOPECTRL_SLEW_GAIN_RAW < 1) || (SLOPECTRL_SLEW_GAIN_RAW > 0xFFFFFFFF))
+  #error "adaptive slope gain out of range; please check power stage declarations"
+#endif
+#if ((SLOPECTRL_TON_GAIN_RAW < 1) || (SLOPECTRL_TON_GAIN_RAW > 0xFFFF))
+  #error "on-time gain out of range; please check VIN_FEEDBACK_FS_MV and VOUT_FEEDBACK_FS_MV"
+#endif
+#if (((1LL * PWM_CLOCK * DAC_CLOCK_DIVIDER) % DAC_CLOCK_FREQUENCY) != 0)
+  #error "PWM clock must be an integer multiple of the DAC clock"
+#endif
+#if ((SLOPECTRL_VIN_NOMINAL_RAW > 0x7FFF) || (SLOPECTRL_VOUT_NOMINAL_RAW > 0x7FFF))
+  #error "nominal operating point out of the feedback range; please check VIN_NOMINAL_MV and VOUT_NOMINAL_MV"
+#endif
+
+#define SLOPECTRL_SLEW_GAIN         ((uint32_t)SLOPECTRL_SLEW_GAIN_RAW)   // Q16.16 SLPxDAT ticks per full scale Vout feedback
+#define SLOPECTRL_TON_GAIN          ((uint16_t)SLOPECTRL_TON_GAIN_RAW)    // On-time in [PWM ticks] at Vout/Vin feedback ratio = 1
+#define SLOPECTRL_RAMP_DIVIDER      ((uint16_t)(16 * SLOPECTRL_PWM_PER_DAC_CLK)) // SLPxDAT fractional bits and PWM-to-DAC clock ratio
+#define SLOPECTRL_VIN_NOMINAL       ((uint16_t)SLOPECTRL_VIN_NOMINAL_RAW)  // Q15 input voltage feedback of the nominal operating point
+#define SLOPECTRL_VOUT_NOMINAL      ((uint16_t)SLOPECTRL_VOUT_NOMINAL_RAW) // Q15 output voltage feedback of the nominal operating point
+
+/* Adaptive slope controller object */
+struct SLOPECTRL_s {
+    uint16_t reference;     // Peak current reference at the expected turn-off time in [DAC ticks]
+    uint16_t slope;         // Most recent slope rate (SLPxDAT)
+    uint16_t dac_high;      // Most recent ramp start level (DACxDATH)
+    uint16_t ramp;          // Most recent ramp amplitude until the expected turn-off time in [DAC ticks]
+    uint16_t ton;           // Most recent expected on-time in [PWM ticks]
+    struct TIMING_TRANSACTION_s trans; // Transaction applying the settings glitch-free
+};
+typedef struct SLOPECTRL_s SLOPECTRL_t;
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern volatile uint16_t SLOPECTRL_Initialize(struct SLOPECTRL_s* ctrl);
+extern volatile uint16_t SLOPECTRL_Calculate(struct SLOPECTRL_s* ctrl, uint16_t vin, uint16_t vout);
+extern volatile uint16_t SLOPECTRL_Update(struct SLOPECTRL_s* ctrl, uint16_t vin, uint16_t vout);
+
+
+#endif	/* XC_SLOPE_CONTROLLER_H */
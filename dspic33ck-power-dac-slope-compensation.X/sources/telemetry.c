@@ -0,0 +1,334 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: telemetry.c 
+ * Comments: Framed telemetry stream of PWM and DAC registers through a lock-free 
+ *           ring buffer, UART1 and DMA channel 0
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/hal.h"
+#include "telemetry.h"
+#include "pwm.h"
+#include "common/p33c_profile.h"
+
+#define TELEMETRY_TX_RP     p33c_Gpio_GetRP(ECP05) // UART1 transmit output: remappable pin of test point TP05 (ECP05)
+#define TELEMETRY_RPOR_U1TX 0b000001    // PPS output function code of UART1 TX
+
+struct TELEMETRY_s telemetry; // Telemetry stream object
+
+// CRC-16/CCITT-FALSE remainders of all 4-bit values (polynomial 0x1021)
+static const uint16_t telemetry_crc_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/* @@TELEMETRY_Crc16
+ * ********************************************************************************
+ * Summary:
+ *     Calculates the CRC-16/CCITT-FALSE checksum of a telemetry frame
+ * 
+ * Parameters:
+ *     const struct TELEMETRY_FRAME_s* frame: Pointer to the frame
+ * 
+ * Returns:
+ *     Checksum of the first TELEMETRY_CRC_SIZE bytes of the frame
+ * 
+ * Description:
+ *     The checksum is calculated four bits at a time using a table of 16 
+ *     remainders, which takes less program memory than a byte-wise table
+ *     and less time than the bit-wise calculation.
+ * 
+ * ********************************************************************************/
+
+static uint16_t TELEMETRY_Crc16(const struct TELEMETRY_FRAME_s* frame)
+{
+    const uint8_t* data = (const uint8_t*)frame;
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+
+    for (i = 0; i < TELEMETRY_CRC_SIZE; i++)
+    {
+        crc = (crc << 4) ^ telemetry_crc_table[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ telemetry_crc_table[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+
+    return(crc);
+}
+
+/* @@TELEMETRY_Initialize
+ * ********************************************************************************
+ * Summary:
+ *     Initializes the telemetry ring buffer, UART1 and DMA channel 0
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     UART1 is configured for 8 data bits, no parity and one stop bit at
+ *     TELEMETRY_BAUDRATE and its transmit output is assigned to remappable pin
+ *     TELEMETRY_TX_RP. DMA channel 0 transfers single bytes from the ring buffer 
+ *     to the UART transmit register, triggered by the UART transmitter whenever 
+ *     its buffer can accept another byte. The stream remains disabled until 
+ *     TELEMETRY_Enable() is called.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t TELEMETRY_Initialize(void) {
+
+    volatile uint16_t retval=1;
+    
+    // Ring buffer
+    telemetry.enable = false;
+    telemetry.head = 0;
+    telemetry.tail = 0;
+    telemetry.decimation = TELEMETRY_DECIMATION;
+    telemetry.count = 0;
+    telemetry.timestamp = 0;
+    telemetry.sequence = 0;
+    telemetry.dropped = 0;
+    telemetry.high_water = 0;
+    telemetry.dma_frames = 0;
+    telemetry.sent = 0;
+    
+    // UART1: asynchronous 8-bit mode, high speed baud rate generator clocked by FCY
+    U1MODE = 0x0000;
+    U1MODEH = 0x0000;
+    U1MODEbits.MOD = 0b0000;        // Asynchronous 8-bit UART
+    U1MODEbits.BRGH = 1;            // High speed: baud rate = FCY / (4 * (U1BRG + 1))
+    U1MODEHbits.BCLKSEL = 0b00;     // Baud clock source: FOSC/2 (FCY)
+    U1BRG = TELEMETRY_BRG;
+    U1STAHbits.UTXISEL = 0b111;     // Transmit trigger while at least one buffer slot is empty
+    
+    // Assign UART1 TX to the telemetry output pin
+    __builtin_write_RPCON(0x0000);  // Unlock PPS registers
+    ((volatile uint8_t*)&RPOR0)[TELEMETRY_TX_RP - 32] = TELEMETRY_RPOR_U1TX;
+    __builtin_write_RPCON(0x0800);  // Lock PPS registers
+    
+    // DMA channel 0: one-shot byte transfers from RAM to U1TXREG
+    DMACONbits.DMAEN = 1;
+    DMAL = 0x0000;                  // No address limits
+    DMAH = 0xFFFF;
+    DMACH0 = 0x0000;
+    DMACH0bits.SIZE   = 1;          // Byte transfers
+    DMACH0bits.TRMODE = 0b00;       // One-shot: channel is disabled after DMACNT0 transfers
+    DMACH0bits.SAMODE = 0b01;       // Source address is incremented
+    DMACH0bits.DAMODE = 0b00;       // Destination address remains unchanged
+    DMAINT0 = 0x0000;
+    DMAINT0bits.CHSEL = TELEMETRY_DMA_TRIGGER;
+    DMADST0 = (uint16_t)(uintptr_t)&U1TXREG;
+    
+    return(retval); // Return 1=success, 0=failure
+}
+
+/* @@TELEMETRY_Enable
+ * ********************************************************************************
+ * Summary:
+ *     Turns on UART1 and starts recording telemetry frames
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     0 = failure, UART1 is not enabled
+ *     1 = success
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t TELEMETRY_Enable(void) {
+
+    volatile uint16_t retval=1;
+
+    U1MODEbits.UARTEN = 1;
+    U1MODEbits.UTXEN = 1;
+    telemetry.count = pwm_ctrl.count;
+    telemetry.timestamp = 0;
+    telemetry.enable = true;
+    
+    retval &= (uint16_t)(U1MODEbits.UARTEN);
+    
+    return(retval); // Return 1=success, 0=failure
+}
+
+/* @@TELEMETRY_Record
+ * ********************************************************************************
+ * Summary:
+ *     Writes a register snapshot of the control loop into the ring buffer (producer)
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     This function is called by the 1 ms telemetry task before TELEMETRY_Transmit().
+ *     When at least telemetry.decimation control loop executions have passed since 
+ *     the most recent frame, a frame with a snapshot of the PWM generator or DAC 
+ *     instance registers is written, alternating between both types. At most one 
+ *     frame is written per call.
+ * 
+ *     The control loop interrupt increments pwm_ctrl.count after it has written
+ *     PGxDC and DACxDATH. The snapshot is read between two reads of this counter
+ *     and read again when the interrupt has been executed in between, so each 
+ *     frame carries the registers of the execution given by its timestamp. The
+ *     control loop interrupt is neither delayed nor extended by the stream.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t TELEMETRY_Record(void) {
+
+    volatile uint16_t retval=1;
+    struct TELEMETRY_FRAME_s* frame;
+    uint16_t count;
+
+    if ((!telemetry.enable) || ((uint16_t)(pwm_ctrl.count - telemetry.count) < telemetry.decimation))
+        return(retval);
+
+    P33C_PROFILE_BEGIN(P33C_PROFILE_TELEMETRY_PUSH);
+    frame = TELEMETRY_Reserve();
+    if (frame != NULL)
+    {
+        frame->sync = TELEMETRY_SYNC;
+        frame->length = TELEMETRY_PAYLOAD_SIZE;
+        frame->sequence = telemetry.sequence;
+        frame->type = (telemetry.sequence & 0x0001) ? TELEMETRY_TYPE_DAC : TELEMETRY_TYPE_PWM;
+    }
+    
+    // Consistent snapshot of the most recent control loop execution
+    do {
+        count = pwm_ctrl.count;
+        TELEMETRY_BARRIER();
+        if (frame == NULL)
+            break;
+        if (frame->type == TELEMETRY_TYPE_DAC)
+        {
+            frame->payload.dac.DACxCONL = PWM_CONTROL_DAC->DACxCONL.value;
+            frame->payload.dac.DACxDATH = PWM_CONTROL_DAC->DACxDATH.value;
+            frame->payload.dac.DACxDATL = PWM_CONTROL_DAC->DACxDATL.value;
+            frame->payload.dac.SLPxCONL = PWM_CONTROL_DAC->SLPxCONL.value;
+            frame->payload.dac.SLPxCONH = PWM_CONTROL_DAC->SLPxCONH.value;
+            frame->payload.dac.SLPxDAT = PWM_CONTROL_DAC->SLPxDAT.value;
+            frame->payload.dac.sample = pwm_ctrl.sample;
+            frame->payload.dac.status = 
+                (PCLKCONbits.HRERR ? TELEMETRY_STATUS_HRERR : 0) |
+                (PCLKCONbits.HRRDY ? TELEMETRY_STATUS_HRRDY : 0) |
+                (pwm_ctrl.enable ? TELEMETRY_STATUS_CONTROL : 0);
+        }
+        else
+        {
+            frame->payload.pwm.PGxCONL = PWM_CONTROL_PG->PGxCONL.value;
+            frame->payload.pwm.PGxSTAT = PWM_CONTROL_PG->PGxSTAT.value;
+            frame->payload.pwm.PGxPER = PWM_CONTROL_PG->PGxPER.value;
+            frame->payload.pwm.PGxDC = PWM_CONTROL_PG->PGxDC.value;
+            frame->payload.pwm.PGxPHASE = PWM_CONTROL_PG->PGxPHASE.value;
+            frame->payload.pwm.PGxTRIGA = PWM_CONTROL_PG->PGxTRIGA.value;
+            frame->payload.pwm.PGxTRIGB = PWM_CONTROL_PG->PGxTRIGB.value;
+            frame->payload.pwm.PGxTRIGC = PWM_CONTROL_PG->PGxTRIGC.value;
+        }
+        TELEMETRY_BARRIER();
+    } while (count != pwm_ctrl.count);
+    
+    // Timestamp: control loop executions since the stream has been enabled
+    telemetry.timestamp += (uint16_t)(count - telemetry.count);
+    telemetry.count = count;
+    if (frame != NULL)
+    {
+        frame->timestamp = telemetry.timestamp;
+        TELEMETRY_Commit();
+    }
+    P33C_PROFILE_END(P33C_PROFILE_TELEMETRY_PUSH);
+    
+    return(retval);
+}
+
+/* @@TELEMETRY_Transmit
+ * ********************************************************************************
+ * Summary:
+ *     Drains the telemetry ring buffer by DMA (consumer)
+ * 
+ * Parameters:
+ *     (none)
+ * 
+ * Returns:
+ *     1 = success
+ * 
+ * Description:
+ *     This function is called periodically by a background task. When the
+ *     previous DMA transfer has been completed, its frames are released to 
+ *     the producer. Then the checksums of the next block of consecutive frames, 
+ *     up to the end of the buffer memory or TELEMETRY_DMA_FRAMES_MAX frames, are 
+ *     added and the block is transmitted directly from the ring buffer without 
+ *     copying. The checksum is calculated by the consumer to keep the execution
+ *     time of the producer short. The function never waits for the UART or the 
+ *     DMA channel.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t TELEMETRY_Transmit(void) {
+
+    volatile uint16_t retval=1;
+    uint16_t fill, start, count, i;
+
+    // Release the frames of a completed DMA transfer
+    if (telemetry.dma_frames > 0)
+    {
+        if (!DMAINT0bits.DONEIF)
+            return(retval);
+        DMAINT0bits.DONEIF = 0;
+        
+        telemetry.tail += telemetry.dma_frames;
+        telemetry.sent += telemetry.dma_frames;
+        telemetry.dma_frames = 0;
+    }
+    
+    // Start the transfer of the next block of frames
+    fill = (uint16_t)(telemetry.head - telemetry.tail);
+    if (fill == 0)
+        return(retval);
+    
+    start = (telemetry.tail & TELEMETRY_BUFFER_MASK);
+    count = (TELEMETRY_BUFFER_SIZE - start);
+    if (count > fill) count = fill;
+    if (count > TELEMETRY_DMA_FRAMES_MAX) count = TELEMETRY_DMA_FRAMES_MAX;
+    
+    for (i = start; i < (start + count); i++)
+        telemetry.buffer[i].crc = TELEMETRY_Crc16(&telemetry.buffer[i]);
+    
+    DMASRC0 = (uint16_t)(uintptr_t)&telemetry.buffer[start];
+    DMACNT0 = (count * sizeof(struct TELEMETRY_FRAME_s));
+    telemetry.dma_frames = count;
+    DMACH0bits.CHEN = 1;
+    
+    return(retval);
+}
+
+// ________________________
+// end of file
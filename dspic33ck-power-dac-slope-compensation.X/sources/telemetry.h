@@ -0,0 +1,211 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: telemetry.h 
+ * Comments: Header file of the PWM/DAC telemetry stream source file telemetry.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_TELEMETRY_STREAM_H
+#define	XC_TELEMETRY_STREAM_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+ /* *********************************************************************************
+ * TELEMETRY STREAM DECLARATIONS
+ * *********************************************************************************
+ * Telemetry frames with register snapshots of the control loop are written by 
+ * TELEMETRY_Record() (producer) into a single-producer/single-consumer ring buffer. 
+ * The buffer is drained by TELEMETRY_Transmit() (consumer), which adds the frame 
+ * checksum and transmits blocks of consecutive frames by DMA to the UART 
+ * transmitter. Both are called by the 1 ms telemetry task, the control loop 
+ * interrupt service routine does not write into the stream.
+ * 
+ * The producer only writes the head index, the consumer only writes the tail index.
+ * Both indices are free-running 16-bit counters, which are read and written in one
+ * instruction, so no locks or critical sections are required. A frame is released 
+ * to the consumer by incrementing the head index after all of its fields have been 
+ * written; its slot is released to the producer after the DMA transfer of the 
+ * frame has been completed. When the buffer is full, new frames are dropped and 
+ * counted; the frame sequence number is incremented anyway, so gaps are visible 
+ * in the received stream.
+ * ********************************************************************************/
+
+#define TELEMETRY_BUFFER_SIZE       64U     // Number of frames in the ring buffer (power of two)
+#define TELEMETRY_BUFFER_MASK       (TELEMETRY_BUFFER_SIZE - 1U)
+#define TELEMETRY_DMA_FRAMES_MAX    16U     // Maximum number of frames per DMA transfer
+#define TELEMETRY_DMA_TRIGGER       0x0E    // DMA channel trigger source: UART1 transmitter (DMAINTx.CHSEL)
+
+#if ((TELEMETRY_BUFFER_SIZE & TELEMETRY_BUFFER_MASK) != 0)
+  #error "telemetry buffer size must be a power of two"
+#endif
+
+// Compiler barrier: all fields of a frame are written before the head index is updated
+#define TELEMETRY_BARRIER()         __asm__ volatile ("" ::: "memory")
+
+/* *********************************************************************************
+ * TELEMETRY FRAME FORMAT
+ * *********************************************************************************
+ * Every frame has a fixed size of 28 bytes. All fields are transmitted least 
+ * significant byte first:
+ * 
+ *   offset  size  field
+ *        0     2  sync word 0x5AA5 (byte sequence 0xA5, 0x5A)
+ *        2     1  payload type (TELEMETRY_TYPE_xxx)
+ *        3     1  payload length in [byte] (TELEMETRY_PAYLOAD_SIZE)
+ *        4     4  timestamp: control loop executions (switching cycles) since enable
+ *        8     2  sequence number (incremented for dropped frames as well)
+ *       10    16  payload: register snapshot of the given type
+ *       26     2  CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) 
+ *                 of bytes 0 through 25
+ * 
+ * The payload types alternate between a snapshot of the PWM generator registers 
+ * (P33C_PWM_GENERATOR_s) and a snapshot of the DAC instance registers 
+ * (P33C_DAC_INSTANCE_s) of the control loop.
+ * ********************************************************************************/
+
+#define TELEMETRY_SYNC              0x5AA5U // Frame sync word
+#define TELEMETRY_TYPE_PWM          0x01U   // Payload: PWM generator register snapshot
+#define TELEMETRY_TYPE_DAC          0x02U   // Payload: DAC instance register snapshot
+#define TELEMETRY_PAYLOAD_SIZE      16U     // Payload size in [byte]
+#define TELEMETRY_FRAME_SIZE        28U     // Frame size in [byte]
+#define TELEMETRY_CRC_SIZE          26U     // Number of bytes protected by the frame checksum
+
+// DAC snapshot status flags
+#define TELEMETRY_STATUS_HRERR      0x0001U // PCLKCON.HRERR: high resolution PWM clock error
+#define TELEMETRY_STATUS_HRRDY      0x0002U // PCLKCON.HRRDY: high resolution PWM clock ready
+#define TELEMETRY_STATUS_CONTROL    0x0004U // Control loop output enabled
+
+/* PWM generator register snapshot (P33C_PWM_GENERATOR_s fields) */
+struct TELEMETRY_PWM_SNAPSHOT_s {
+    uint16_t PGxCONL;       // PWM generator control register low
+    uint16_t PGxSTAT;       // PWM generator status register
+    uint16_t PGxPER;        // Period in [PWM ticks]
+    uint16_t PGxDC;         // Duty cycle in [PWM ticks]
+    uint16_t PGxPHASE;      // Phase in [PWM ticks]
+    uint16_t PGxTRIGA;      // Trigger A location in [PWM ticks]
+    uint16_t PGxTRIGB;      // Trigger B location (ADC trigger, slope start) in [PWM ticks]
+    uint16_t PGxTRIGC;      // Trigger C location (slope stop) in [PWM ticks]
+};
+typedef struct TELEMETRY_PWM_SNAPSHOT_s TELEMETRY_PWM_SNAPSHOT_t;
+
+/* DAC instance register snapshot (P33C_DAC_INSTANCE_s fields) and control loop state */
+struct TELEMETRY_DAC_SNAPSHOT_s {
+    uint16_t DACxCONL;      // DAC control register low
+    uint16_t DACxDATH;      // DAC level in [DAC ticks]
+    uint16_t DACxDATL;      // DAC slope end level in [DAC ticks]
+    uint16_t SLPxCONL;      // Slope control register low
+    uint16_t SLPxCONH;      // Slope control register high
+    uint16_t SLPxDAT;       // Slope rate
+    uint16_t sample;        // Most recent control loop feedback sample in [ADC ticks]
+    uint16_t status;        // Status flags (TELEMETRY_STATUS_xxx)
+};
+typedef struct TELEMETRY_DAC_SNAPSHOT_s TELEMETRY_DAC_SNAPSHOT_t;
+
+/* Telemetry frame */
+struct TELEMETRY_FRAME_s {
+    uint16_t sync;          // Frame sync word (TELEMETRY_SYNC)
+    uint8_t  type;          // Payload type (TELEMETRY_TYPE_xxx)
+    uint8_t  length;        // Payload length in [byte]
+    uint32_t timestamp;     // Control loop executions since the stream has been enabled
+    uint16_t sequence;      // Frame sequence number
+    union {
+        struct TELEMETRY_PWM_SNAPSHOT_s pwm; // TELEMETRY_TYPE_PWM
+        struct TELEMETRY_DAC_SNAPSHOT_s dac; // TELEMETRY_TYPE_DAC
+        uint16_t word[TELEMETRY_PAYLOAD_SIZE >> 1];
+    } payload;
+    uint16_t crc;           // Frame checksum (added by the consumer)
+};
+typedef struct TELEMETRY_FRAME_s TELEMETRY_FRAME_t;
+
+/* Telemetry stream object */
+struct TELEMETRY_s {
+    struct TELEMETRY_FRAME_s buffer[TELEMETRY_BUFFER_SIZE]; // Ring buffer
+    volatile uint16_t head; // Number of frames written (producer)
+    volatile uint16_t tail; // Number of frames transmitted (consumer)
+    
+    // Producer state (telemetry task)
+    volatile bool enable;   // Stream enable
+    uint16_t decimation;    // Minimum number of control loop executions per frame
+    uint16_t count;         // Control loop execution counter (pwm_ctrl.count) of the most recent frame
+    uint32_t timestamp;     // Control loop executions since the stream has been enabled
+    uint16_t sequence;      // Sequence number of the next frame
+    uint16_t dropped;       // Number of frames dropped due to a full buffer (saturating)
+    uint16_t high_water;    // Maximum number of frames in the buffer
+    
+    // Consumer state (background task)
+    uint16_t dma_frames;    // Number of frames of the active DMA transfer
+    uint32_t sent;          // Number of frames transmitted
+};
+typedef struct TELEMETRY_s TELEMETRY_t;
+
+extern struct TELEMETRY_s telemetry;
+
+/* *********************************************************************************
+ * PRODUCER FUNCTIONS
+ * *********************************************************************************
+ * TELEMETRY_Reserve() returns the buffer slot of the next frame or NULL when the
+ * buffer is full. The producer writes all frame fields except the checksum directly 
+ * into the slot and publishes the frame by calling TELEMETRY_Commit(). Both functions are inlined 
+ * and execute a constant number of instructions.
+ * ********************************************************************************/
+
+static inline struct TELEMETRY_FRAME_s* TELEMETRY_Reserve(void)
+{
+    uint16_t fill = (uint16_t)(telemetry.head - telemetry.tail);
+
+    if (fill >= TELEMETRY_BUFFER_SIZE)
+    {
+        if (telemetry.dropped < 0xFFFF)
+            telemetry.dropped++;
+        telemetry.sequence++;
+        return(NULL);
+    }
+    if (fill >= telemetry.high_water)
+        telemetry.high_water = (fill + 1);
+
+    return(&telemetry.buffer[telemetry.head & TELEMETRY_BUFFER_MASK]);
+}
+
+static inline void TELEMETRY_Commit(void)
+{
+    TELEMETRY_BARRIER();
+    telemetry.sequence++;
+    telemetry.head++;
+}
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern volatile uint16_t TELEMETRY_Initialize(void);
+extern volatile uint16_t TELEMETRY_Enable(void);
+extern volatile uint16_t TELEMETRY_Record(void);
+extern volatile uint16_t TELEMETRY_Transmit(void);
+
+
+#endif	/* XC_TELEMETRY_STREAM_H */
@@ -0,0 +1,211 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: timing.c 
+ * Comments: Glitch-free update of PWM timing and DAC slope settings within one PWM cycle
+ * Revision history: Initial Release
+ */
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "config/demo.h"
+#include "timing.h"
+
+/* @@TIMING_Load
+ * ********************************************************************************
+ * Summary:
+ *     Loads the active PWM timing and DAC slope settings into a transaction object
+ * 
+ * Parameters:
+ *     struct TIMING_TRANSACTION_s* trans:
+ *          Pointer to the transaction object to be loaded
+ * 
+ * Returns:
+ *     0 = failure, loading the transaction object was not successful
+ *     1 = success, loading the transaction object was successful
+ * 
+ * Description:
+ *     This function copies the current values of the user PWM generator timing 
+ *     registers and the user DAC instance data and slope registers into the 
+ *     transaction object. Users modify the staged values of this object and 
+ *     apply all of them at once by calling TIMING_Commit().
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t TIMING_Load(struct TIMING_TRANSACTION_s* trans)
+{
+    if ((trans == NULL) || (my_pg1 == NULL) || (my_dac == NULL))
+        return(0);
+    
+    trans->PGxPER   = my_pg1->PGxPER.value;
+    trans->PGxDC    = my_pg1->PGxDC.value;
+    trans->PGxTRIGB = my_pg1->PGxTRIGB.value;
+    trans->PGxTRIGC = my_pg1->PGxTRIGC.value;
+    trans->DACxDATH = my_dac->DACxDATH.value;
+    trans->DACxDATL = my_dac->DACxDATL.value;
+    trans->SLPxDAT  = my_dac->SLPxDAT.value;
+    trans->latency  = 0;
+    
+    return(1);
+}
+
+/* Returns the Timer1 counts since t_start (Timer1 may roll over once) */
+static uint16_t TIMING_Elapsed(uint16_t t_start)
+{
+    uint16_t now = TMR1;
+
+    if (now < t_start)
+        now += (PR1 + 1);
+    return(now - t_start);
+}
+
+/* Writes the staged DAC slope settings; DACxDATH is owned by the control loop while it is enabled */
+static void TIMING_WriteDac(const struct TIMING_TRANSACTION_s* trans)
+{
+    my_dac->DACxDATL.value = trans->DACxDATL;
+    if (!pwm_ctrl.enable)
+        my_dac->DACxDATH.value = trans->DACxDATH;
+    my_dac->SLPxDAT.value  = trans->SLPxDAT;
+}
+
+/* @@TIMING_Commit
+ * ********************************************************************************
+ * Summary:
+ *     Applies all staged PWM timing and DAC slope settings within one PWM cycle
+ * 
+ * Parameters:
+ *     struct TIMING_TRANSACTION_s* trans:
+ *          Pointer to the transaction object holding the staged settings
+ * 
+ * Returns:
+ *     0 = failure, a PWM update was still pending after TIMING_COMMIT_TIMEOUT_US 
+ *         (no register has been written) or the PWM generator did not accept the
+ *         update in time (all registers have been written, see below)
+ *     1 = success, all staged settings have been applied
+ * 
+ * Description:
+ *     The PWM generator is configured for Start-Of-Cycle updates (UPDMOD = 0b00),
+ *     hence writes to PGxPER, PGxDC, PGxTRIGB and PGxTRIGC only become effective
+ *     when the UPDREQ bit is set and the next PWM cycle starts. This function 
+ *     writes all staged PWM timing values and sets UPDREQ as soon as no previous
+ *     update is pending, then polls until the PWM generator has transferred the 
+ *     new values (UPDATE = 0). The DAC data and slope registers are written in 
+ *     the poll detecting this transfer, early in the new PWM cycle and before 
+ *     the slope start trigger PGxTRIGB. Thus every PWM cycle runs either entirely
+ *     with the previous or entirely with the new operating point.
+ * 
+ *     The control loop interrupt is masked (CPU priority TIMING_COMMIT_IPL) only
+ *     while the register writes and each single poll are executed, so it cannot
+ *     write PGxDC, DACxDATH or UPDREQ in between, but it is never delayed by the
+ *     waits. Both waits are limited to TIMING_COMMIT_TIMEOUT_US, measured with 
+ *     Timer1. Once UPDREQ has been set, the update request cannot be withdrawn:
+ *     when the transfer is not detected in time, the DAC registers are written 
+ *     anyway and 0 is returned, so the PWM timing and the DAC settings of the 
+ *     transaction are never applied partially.
+ * 
+ *     While the control loop is enabled it owns PGxDC and DACxDATH (see 
+ *     _ADCAN0Interrupt()): the staged duty cycle becomes the duty cycle limit 
+ *     of the loop (pwm_ctrl.duty) and the staged DACxDATH value is not applied.
+ * 
+ *     The time between setting UPDREQ and writing the last DAC register is 
+ *     measured with Timer1 and stored in the transaction object in units of 
+ *     PWM clock ticks (same resolution as the PGxPER register). This commit 
+ *     latency is less than one PWM period plus the DAC register access time
+ *     and the execution time of interrupts served during the wait. The PGxTRIGB
+ *     location needs to leave enough time after the start of the cycle for the
+ *     DAC registers to be written.
+ * 
+ * ********************************************************************************/
+
+volatile uint16_t TIMING_Commit(struct TIMING_TRANSACTION_s* trans)
+{
+    volatile uint16_t retval=1;
+    volatile uint16_t t_start=0, t_stop=0;
+    uint16_t ipl, ipl_commit, t_wait;
+    bool staged=false, applied=false;
+
+    if ((trans == NULL) || (my_pg1 == NULL) || (my_dac == NULL))
+        return(0);
+    
+    // CPU priority masking the control loop interrupt
+    ipl = SRbits.IPL;
+    ipl_commit = (ipl < TIMING_COMMIT_IPL) ? TIMING_COMMIT_IPL : ipl;
+    
+    // Stage PWM timing (buffered until UPDREQ is set) and request the update at 
+    // the next Start-Of-Cycle as soon as a previous update has been completed
+    t_wait = TMR1;
+    do {
+        SRbits.IPL = ipl_commit;
+        if (!my_pg1->PGxSTAT.bits.UPDATE)
+        {
+            my_pg1->PGxPER.value   = trans->PGxPER;
+            my_pg1->PGxDC.value    = trans->PGxDC;
+            my_pg1->PGxTRIGB.value = trans->PGxTRIGB;
+            my_pg1->PGxTRIGC.value = trans->PGxTRIGC;
+            pwm_ctrl.duty = trans->PGxDC; // duty cycle limit written by the control loop
+            
+            t_start = TMR1;
+            my_pg1->PGxSTAT.bits.UPDREQ = 1;
+            staged = true;
+        }
+        SRbits.IPL = ipl;
+    } while ((!staged) && (TIMING_Elapsed(t_wait) < TIMING_COMMIT_TIMEOUT));
+    
+    if (!staged)
+        return(0);
+    
+    // Apply DAC slope settings within the PWM cycle starting with the transfer
+    do {
+        SRbits.IPL = ipl_commit;
+        if (!my_pg1->PGxSTAT.bits.UPDATE)
+        {
+            TIMING_WriteDac(trans);
+            t_stop = TMR1;
+            applied = true;
+        }
+        SRbits.IPL = ipl;
+    } while ((!applied) && (TIMING_Elapsed(t_start) < TIMING_COMMIT_TIMEOUT));
+    
+    if (applied)
+    {
+        // Calculate commit latency in PWM clock ticks (Timer1 may roll over once)
+        if (t_stop < t_start)
+            t_stop += (PR1 + 1);
+        trans->latency = ((t_stop - t_start) * TIMING_PWM_TICKS_PER_TCY);
+    }
+    else
+    {
+        // The pending update cannot be withdrawn: complete the transaction
+        SRbits.IPL = ipl_commit;
+        TIMING_WriteDac(trans);
+        SRbits.IPL = ipl;
+        retval = 0;
+    }
+    
+    return(retval);
+}
+
+// ________________________
+// end of file
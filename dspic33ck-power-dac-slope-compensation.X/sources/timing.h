@@ -0,0 +1,78 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File: timing.h 
+ * Comments: Header file of the PWM/DAC timing update transaction source file timing.c
+ * Revision history: Initial Release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef XC_TIMING_TRANSACTION_H
+#define	XC_TIMING_TRANSACTION_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer data types
+#include <stdbool.h> // include standard boolean data types
+#include <stddef.h> // include standard definition data types
+
+#include "pwm.h"
+#include "dac.h"
+
+ /* *********************************************************************************
+ * TIMING UPDATE TRANSACTION DECLARATIONS
+ * *********************************************************************************
+ * TIMING_Commit() applies the staged PWM timing and DAC slope settings within one
+ * PWM cycle. While the control loop is enabled (pwm_ctrl.enable), its interrupt 
+ * service routine is the only writer of PGxDC and DACxDATH: the staged PGxDC value
+ * becomes the duty cycle limit of the loop and the staged DACxDATH value is not 
+ * applied. A commit returning 0 after the update request has been set has still 
+ * written all registers; the PWM timing becomes effective with the next transfer.
+ * ********************************************************************************/    
+
+#define TIMING_PWM_TICKS_PER_TCY    (uint16_t)(PWM_CLOCK / CPU_CLOCK) // Number of PWM clock ticks per CPU instruction cycle
+#define TIMING_COMMIT_TIMEOUT_US    20U     // Maximum time waiting for a PWM update in [us] (shorter than the Timer1 period)
+#define TIMING_COMMIT_TIMEOUT       (uint16_t)(TIMING_COMMIT_TIMEOUT_US * (CPU_CLOCK / 1000000UL)) // in [Timer1 counts]
+#define TIMING_COMMIT_IPL           6U      // CPU priority of the commit register accesses, masks the control loop interrupt (_ADCAN0IP)
+
+/* Timing update transaction object */
+struct TIMING_TRANSACTION_s {
+    uint16_t PGxPER;    // Staged PWM period
+    uint16_t PGxDC;     // Staged PWM duty cycle
+    uint16_t PGxTRIGB;  // Staged slope start trigger location
+    uint16_t PGxTRIGC;  // Staged slope stop trigger location
+    uint16_t DACxDATH;  // Staged DAC high data value (slope start level), not applied while the control loop is enabled
+    uint16_t DACxDATL;  // Staged DAC low data value (slope limit)
+    uint16_t SLPxDAT;   // Staged slope rate
+    uint16_t latency;   // Latency of the most recent commit in [PWM clock ticks]
+};
+typedef struct TIMING_TRANSACTION_s TIMING_TRANSACTION_t;
+
+/* *********************************************************************************
+ * USER FUNCTION PROTOTYPES
+ * ********************************************************************************/    
+
+extern volatile uint16_t TIMING_Load(struct TIMING_TRANSACTION_s* trans);
+extern volatile uint16_t TIMING_Commit(struct TIMING_TRANSACTION_s* trans);
+
+
+#endif	/* XC_TIMING_TRANSACTION_H */